@@ -0,0 +1,188 @@
+#include "AC_AttitudeControl_AIC.h"
+
+#if AP_AIC_ENABLED
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include <GCS_MAVLink/GCS.h>
+
+// AP_Math and the AIC core both define Vector3f/Matrix3f: import only the names used here
+using attitude_controller_aic::AICModuleConfig;
+using attitude_controller_aic::AICModuleInput;
+using attitude_controller_aic::AICTickStatus;
+using attitude_controller_aic::AttitudeControllerAIC;
+using attitude_controller_aic::EnvelopeMonitor;
+
+// table of user settable parameters
+const AP_Param::GroupInfo AC_AttitudeControl_AIC::var_info[] = {
+    // parameters from parent (ATC_* of the multicopter controller)
+    AP_NESTEDGROUPINFO(AC_AttitudeControl_Multi, 0),
+
+    // @Param: AIC_EN
+    // @DisplayName: AIC attitude controller enable
+    // @Description: Runs the adaptive inertia compensation controller in place of the multicopter rate controller. Takes effect immediately; the estimate restarts from ATC_AIC_J on each enable
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("AIC_EN", 50, AC_AttitudeControl_AIC, _aic_enable, 0),
+
+    // @Param: AIC_TMAX_RP
+    // @DisplayName: AIC roll/pitch torque at full motor input
+    // @Description: Roll and pitch torque produced by a full-scale roll or pitch motor input. Also the controller torque saturation
+    // @Units: N.m
+    // @Range: 0.01 5
+    // @User: Advanced
+    AP_GROUPINFO("AIC_TMAX_RP", 51, AC_AttitudeControl_AIC, _aic_tmax_rp, 0.05f),
+
+    // @Param: AIC_TMAX_Y
+    // @DisplayName: AIC yaw torque at full motor input
+    // @Description: Yaw torque produced by a full-scale yaw motor input
+    // @Units: N.m
+    // @Range: 0.005 2
+    // @User: Advanced
+    AP_GROUPINFO("AIC_TMAX_Y", 52, AC_AttitudeControl_AIC, _aic_tmax_y, 0.02f),
+
+    // @Param: AIC_J_X
+    // @DisplayName: AIC initial roll inertia
+    // @Units: kg.m.m
+    // @Range: 0.001 1
+    // @User: Advanced
+
+    // @Param: AIC_J_Y
+    // @DisplayName: AIC initial pitch inertia
+    // @Units: kg.m.m
+    // @Range: 0.001 1
+    // @User: Advanced
+
+    // @Param: AIC_J_Z
+    // @DisplayName: AIC initial yaw inertia
+    // @Units: kg.m.m
+    // @Range: 0.001 1
+    // @User: Advanced
+    AP_GROUPINFO("AIC_J", 53, AC_AttitudeControl_AIC, _aic_inertia, 0),
+
+    // @Param: AIC_GAMMA
+    // @DisplayName: AIC inertia adaptation gain
+    // @Range: 0 10
+    // @User: Advanced
+    AP_GROUPINFO("AIC_GAMMA", 54, AC_AttitudeControl_AIC, _aic_gamma, 1.5f),
+
+    // @Param: AIC_ENV_EN
+    // @DisplayName: AIC envelope monitor enable
+    // @Description: Switches to a fixed-inertia PD law for the rest of the flight on tilt, rate, error growth or estimator violations
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("AIC_ENV_EN", 55, AC_AttitudeControl_AIC, _aic_env_enable, 1),
+
+    AP_GROUPEND
+};
+
+AC_AttitudeControl_AIC::AC_AttitudeControl_AIC(AP_AHRS_View &ahrs, const AP_Vehicle::MultiCopter &aparm, AP_MotorsMulticopter& motors) :
+    AC_AttitudeControl_Multi(ahrs, aparm, motors),
+    _aic_active(false),
+    _aic_param_update_ms(0)
+{
+    AP_Param::setup_object_defaults(this, var_info);
+
+    // module default inertia (quadcopter typical values)
+    _aic_inertia.set_default(Vector3f(0.040f, 0.040f, 0.025f));
+}
+
+void AC_AttitudeControl_AIC::aic_activate()
+{
+    const Vector3f &J_diag = _aic_inertia.get();
+    matrix::Matrix3f J_init;
+    J_init.setZero();
+    J_init(0, 0) = MAX(J_diag.x, 0.001f);
+    J_init(1, 1) = MAX(J_diag.y, 0.001f);
+    J_init(2, 2) = MAX(J_diag.z, 0.001f);
+
+    AttitudeControllerAIC &controller = _aic.controller();
+    controller.init(J_init, true, true);
+    controller.set_control_gains(matrix::Vector3f(5.0f, 5.0f, 3.0f), matrix::Vector3f(0.3f, 0.3f, 0.2f),
+                                 matrix::Vector3f(0.1f, 0.1f, 0.1f), 2.0f);
+    controller.set_disturbance_observer(true, 0.05f);
+
+    _aic.init();
+    aic_update_parameters();
+}
+
+void AC_AttitudeControl_AIC::aic_update_parameters()
+{
+    AttitudeControllerAIC &controller = _aic.controller();
+    controller.set_saturation_limit(MAX(_aic_tmax_rp.get(), 0.001f));
+    controller.set_adaptation_params(MAX(_aic_gamma.get(), 0.0f), 1e-4f, 0.01f, 0.001f);
+
+    AICModuleConfig config;
+    // the fast loop rate is set by the scheduler, not by the flight phase
+    config.governor_enabled = false;
+    config.envelope_enabled = _aic_env_enable != 0;
+    _aic.configure(config);
+
+    _aic_param_update_ms = AP_HAL::millis();
+}
+
+void AC_AttitudeControl_AIC::rate_controller_run()
+{
+    if (_aic_enable == 0) {
+        if (_aic_active) {
+            // hand back to the rate PIDs without a stale integrator
+            _aic_active = false;
+            reset_rate_controller_I_terms();
+        }
+        AC_AttitudeControl_Multi::rate_controller_run();
+        return;
+    }
+
+    if (!_aic_active) {
+        aic_activate();
+        _aic_active = true;
+    } else if (AP_HAL::millis() - _aic_param_update_ms > 1000) {
+        aic_update_parameters();
+    }
+
+    // move throttle vs attitude mixing towards desired (same as the multicopter controller)
+    update_throttle_rpy_mix();
+
+    // latest attitude and gyro straight from the AHRS (body FRD, earth NED: same conventions as PX4)
+    Quaternion attitude_body;
+    _ahrs.get_quat_body_to_ned(attitude_body);
+    const Vector3f &gyro = _ahrs.get_gyro_latest();
+
+    AICModuleInput input;
+    input.q = matrix::Quaternionf(attitude_body.q1, attitude_body.q2, attitude_body.q3, attitude_body.q4);
+    input.omega = matrix::Vector3f(gyro.x, gyro.y, gyro.z);
+    input.q_d = matrix::Quaternionf(_attitude_target.q1, _attitude_target.q2, _attitude_target.q3, _attitude_target.q4);
+    input.omega_d = matrix::Vector3f(_ang_vel_target.x, _ang_vel_target.y, _ang_vel_target.z);
+    input.landed = _motors.get_spool_state() != AP_Motors::SpoolState::THROTTLE_UNLIMITED;
+
+    matrix::Vector3f tau;
+    const AICTickStatus status = _aic.update(AP_HAL::micros64(), input, tau);
+
+    if (status.fallback_engaged) {
+        GCS_SEND_TEXT(MAV_SEVERITY_CRITICAL, "AIC: envelope violation (%s), PD fallback",
+                      EnvelopeMonitor::trip_name(status.trips));
+    } else if (status.fallback_released) {
+        GCS_SEND_TEXT(MAV_SEVERITY_INFO, "AIC: envelope fallback released");
+    }
+
+    if (!status.controlled) {
+        // first tick only initialises the time base
+        return;
+    }
+
+    // torque to normalised motor input
+    const float tmax_rp = MAX(_aic_tmax_rp.get(), 0.001f);
+    const float tmax_y = MAX(_aic_tmax_y.get(), 0.001f);
+    _motors.set_roll(constrain_float(tau(0) / tmax_rp, -1.0f, 1.0f));
+    _motors.set_pitch(constrain_float(tau(1) / tmax_rp, -1.0f, 1.0f));
+    _motors.set_yaw(constrain_float(tau(2) / tmax_y, -1.0f, 1.0f));
+    _motors.set_roll_ff(0.0f);
+    _motors.set_pitch_ff(0.0f);
+    _motors.set_yaw_ff(0.0f);
+
+    // system identification injections target the rate PIDs, which are bypassed
+    _sysid_ang_vel_body.zero();
+    _actuator_sysid.zero();
+}
+
+#endif // AP_AIC_ENABLED
@@ -0,0 +1,68 @@
+#pragma once
+
+/// @file    AC_AttitudeControl_AIC.h
+/// @brief   ArduCopter attitude control backend running the AIC core
+///
+/// Replaces the multicopter rate controller in the 400 Hz fast loop with
+/// the adaptive inertia compensation (AIC) controller of
+/// src/modules/attitude_controller_aic. The controller reads the AHRS
+/// attitude and latest gyro sample directly and writes normalized torques
+/// to the motors, so there is no message hop between estimator, controller
+/// and mixer. The tick pipeline (dt handling, composite error filters,
+/// envelope monitor with PD fallback) is AICModuleCore, the same code the
+/// PX4 module and the host SIL run.
+///
+/// Build: define AP_AIC_ENABLED=1 and put the AIC include directory, the
+/// PX4 matrix library and Eigen on the include path (see
+/// ARDUPILOT_AIC_GUIDE.md). With ATC_AIC_EN=0 the stock multicopter rate
+/// controller runs unchanged.
+
+#ifndef AP_AIC_ENABLED
+#define AP_AIC_ENABLED 0
+#endif
+
+#if AP_AIC_ENABLED
+
+#include "AC_AttitudeControl_Multi.h"
+
+#include <aic_module_core.hpp>
+#include <attitude_controller_aic.hpp>
+
+class AC_AttitudeControl_AIC : public AC_AttitudeControl_Multi {
+public:
+    AC_AttitudeControl_AIC(AP_AHRS_View &ahrs, const AP_Vehicle::MultiCopter &aparm, AP_MotorsMulticopter& motors);
+
+    // run lowest level body-frame rate controller and send outputs to the motors
+    // (AIC: attitude and rate loops in one step)
+    void rate_controller_run() override;
+
+    // true if the AIC controller produced the current motor outputs
+    bool aic_active() const { return _aic_active; }
+
+    // user settable parameters
+    static const struct AP_Param::GroupInfo var_info[];
+
+protected:
+    // parameters
+    AP_Int8         _aic_enable;        // 1: AIC controls attitude, 0: stock rate controller
+    AP_Float        _aic_tmax_rp;       // roll/pitch torque for full-scale motor input (Nm)
+    AP_Float        _aic_tmax_y;        // yaw torque for full-scale motor input (Nm)
+    AP_Vector3f     _aic_inertia;       // initial principal inertia estimate (kg*m^2)
+    AP_Float        _aic_gamma;         // inertia adaptation gain
+    AP_Int8         _aic_env_enable;    // envelope monitor with PD fallback
+
+private:
+    using AICCore = attitude_controller_aic::AICModuleCore<attitude_controller_aic::AttitudeControllerAIC>;
+
+    // (re)initialise the controller from parameters on activation
+    void aic_activate();
+
+    // apply parameters that can change in flight
+    void aic_update_parameters();
+
+    AICCore         _aic;
+    bool            _aic_active;
+    uint32_t        _aic_param_update_ms;
+};
+
+#endif // AP_AIC_ENABLED
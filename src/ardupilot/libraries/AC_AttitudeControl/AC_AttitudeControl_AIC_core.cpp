@@ -0,0 +1,7 @@
+// Explicit instantiations of the AIC controller (aic_core.cpp of the PX4
+// module), compiled into the AC_AttitudeControl library when AIC is enabled
+#include "AC_AttitudeControl_AIC.h"
+
+#if AP_AIC_ENABLED
+#include <aic_core.cpp>
+#endif
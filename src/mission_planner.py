@@ -30,6 +30,7 @@ class MissionPlanner:
         
         self.current_mission: Optional[Dict] = None
         self.waypoints: List[LocationGlobalRelative] = []
+        self.excitation: Optional[Dict] = None
         self.waypoint_radius = self.config.get('mission.waypoint_radius', 2.0)
     
     def load_mission_from_file(self, mission_file: str) -> bool:
@@ -71,6 +72,14 @@ class MissionPlanner:
             self.waypoints.append(location)
         
         self.logger.info(f"Parsed {len(self.waypoints)} waypoints")
+        
+        # Optional attitude excitation maneuver (tools/excitation_planner)
+        self.excitation = self.current_mission.get('excitation')
+        if self.excitation:
+            self.logger.info(
+                f"Mission includes {self.excitation.get('duration_s', 0.0):.0f} s excitation maneuver "
+                f"({len(self.excitation.get('setpoints', []))} attitude setpoints)"
+            )
     
     def create_simple_mission(
         self,
@@ -333,7 +342,8 @@ class MissionPlanner:
             'waypoints': [
                 {'lat': wp.lat, 'lon': wp.lon, 'alt': wp.alt}
                 for wp in self.waypoints
-            ]
+            ],
+            'excitation_duration': self.excitation.get('duration_s') if self.excitation else None
         }
 
 
@@ -4,10 +4,11 @@
  * 
  * Integrates the AIC controller with PX4's attitude control pipeline
  * Subscribes to: vehicle attitude, reference trajectory, IMU
- * Publishes to: motor commands (actuator outputs)
+ * Publishes to: motor commands (actuator controls, or actuator motors with AIC_MIX_FRAME)
  */
 
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
@@ -15,19 +16,52 @@
 
 #include <drivers/drv_hrt.h>
 #include <lib/mathlib/mathlib.h>
+#include <lib/perf/perf_counter.h>
 #include <matrix/matrix/Matrix.hpp>
 
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_attitude_setpoint.h>
 #include <uORB/topics/vehicle_rates_setpoint.h>
 #include <uORB/topics/actuator_controls.h>
+#include <uORB/topics/actuator_motors.h>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/vehicle_land_detected.h>
+#include <uORB/topics/esc_status.h>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "attitude_controller_aic.hpp"
+#include "aic_module_core.hpp"
+#include "config_benchmark.hpp"
+#include "fleet_prior.hpp"
+
+#if defined(AIC_FIXED_GAINS)
+#include "aic_fixed_config.hpp"
+#endif
 
 using namespace attitude_controller_aic;
 using namespace matrix;
 
+// Files of the module on the storage device
+#define AIC_STORAGE_DIR PX4_STORAGEDIR "/aic"
+#define AIC_PRIOR_TABLE AIC_STORAGE_DIR "/priors.bin"
+#define AIC_ESTIMATOR_RECORDS AIC_STORAGE_DIR "/estimates.csv"
+
+// Ticks kept in RAM for the pre-trigger capture (128 bytes each)
+#ifndef AIC_CAPTURE_RECORDS
+#define AIC_CAPTURE_RECORDS 512
+#endif
+
+#if defined(AIC_FIXED_GAINS)
+// Frozen airframe configuration: gains, saturation and inertia model are compile-time constants
+using ModuleController = BasicAttitudeControllerAIC<FixedGains<AICFixedAirframeConfig>>;
+#else
+using ModuleController = AttitudeControllerAIC;
+#endif
+
 class AttitudeControllerAICModule : public ModuleBase<AttitudeControllerAICModule>, public ModuleParams {
 public:
     AttitudeControllerAICModule();
@@ -39,6 +73,7 @@ public:
 
     void init();
     void run();
+    int print_status() override;
 
 private:
     // Vehicle state subscriptions
@@ -46,22 +81,63 @@ private:
     int _vehicle_attitude_setpoint_sub{-1};
     int _vehicle_rates_setpoint_sub{-1};
     int _parameter_update_sub{-1};
+    int _vehicle_land_detected_sub{-1};
+    int _esc_status_sub{-1};
 
     // Actuator output publication
     orb_advert_t _actuator_controls_pub{nullptr};
+    orb_advert_t _actuator_motors_pub{nullptr};
 
-    // Controller instance
-    AttitudeControllerAIC _controller;
+    // Tick pipeline: rate governor, controller, envelope monitor (shared with the host SIL)
+    AICModuleCore<ModuleController> _core;
+    ModuleController &_controller{_core.controller()};
 
     // State data
     vehicle_attitude_s _vehicle_attitude{};
     vehicle_attitude_setpoint_s _attitude_setpoint{};
     vehicle_rates_setpoint_s _rates_setpoint{};
+    uint32_t _setpoint_sequence{0};   // Attitude and rate setpoint messages received (0: none yet)
     actuator_controls_s _actuator_controls{};
-
-    // Timing
-    uint64_t _last_run{0};
-    float _dt{0.01f};  // 100 Hz control loop
+    vehicle_land_detected_s _land_detected{};
+
+    // Pre-trigger capture around anomalies, written out by a low-priority task
+    CaptureBuffer<AIC_CAPTURE_RECORDS> _capture;
+    CaptureTriggerDetector _capture_detector;
+    CaptureSettings _capture_settings;
+    bool _capture_enabled{false};
+    px4::atomic_bool _capture_requested{false};
+    enum CaptureWriterState : int {
+        WRITER_IDLE = 0,
+        WRITER_RUNNING,
+        WRITER_EXITING        // Asked to leave, still using this instance
+    };
+    px4::atomic<int> _capture_writer{WRITER_IDLE};
+    px4::atomic<uint32_t> _capture_files{0};
+
+    // Fleet prior warm start and the estimator record of each flight
+    static constexpr float MIN_RECORD_FLIGHT_TIME = 10.f;   // s
+    int _prior_match{-1};                 // find_prior() result, -1 not looked up
+    PriorEntry _prior{};
+    int32_t _prior_airframe{-1};
+    int32_t _prior_payload{-1};
+    hrt_abstime _takeoff_time{0};         // 0 on the ground
+    bool _flight_excited{false};
+
+    // Configuration chosen by the boot-time benchmark against the CPU budget (AIC_AUTO_CFG)
+    static constexpr uint32_t AUTO_CONFIG_MESSAGES = 250;   // Message rate settled before choosing
+    float _bench_compute_us[BENCH_MODELS] {};
+    bool _auto_config_pending{false};
+    uint32_t _auto_config_messages{0};
+    ConfigurationChoice _auto_config{};
+    bool _over_budget_warned{false};      // The stability bound overrode the base divider
+
+    // Timing instrumentation
+    perf_counter_t _loop_perf{perf_alloc(PC_ELAPSED, "aic: control")};
+    perf_counter_t _loop_interval_perf{perf_alloc(PC_INTERVAL, "aic: control interval")};
+    perf_counter_t _skipped_perf{perf_alloc(PC_COUNT, "aic: governor skipped")};
+    perf_counter_t _fallback_perf{perf_alloc(PC_COUNT, "aic: envelope fallback")};
+    perf_counter_t _motor_failure_perf{perf_alloc(PC_COUNT, "aic: motor failure")};
+    perf_counter_t _capture_perf{perf_alloc(PC_COUNT, "aic: capture trigger")};
 
     // Parameters
     DEFINE_PARAMETERS(
@@ -70,16 +146,81 @@ private:
         (ParamFloat<px4::params::MC_YAW_P>) _param_mc_yaw_p,
         (ParamFloat<px4::params::MC_ROLLRATE_P>) _param_mc_rollrate_p,
         (ParamFloat<px4::params::MC_PITCHRATE_P>) _param_mc_pitchrate_p,
-        (ParamFloat<px4::params::MC_YAWRATE_P>) _param_mc_yawrate_p
+        (ParamFloat<px4::params::MC_YAWRATE_P>) _param_mc_yawrate_p,
+        (ParamBool<px4::params::AIC_GOV_EN>) _param_aic_gov_en,
+        (ParamInt<px4::params::AIC_GOV_IDLE>) _param_aic_gov_idle,
+        (ParamInt<px4::params::AIC_GOV_CRUISE>) _param_aic_gov_cruise,
+        (ParamFloat<px4::params::AIC_GOV_SP_THR>) _param_aic_gov_sp_thr,
+        (ParamFloat<px4::params::AIC_GOV_DIST>) _param_aic_gov_dist,
+        (ParamFloat<px4::params::AIC_GOV_MARGIN>) _param_aic_gov_margin,
+        (ParamBool<px4::params::AIC_DOB_EN>) _param_aic_dob_en,
+        (ParamFloat<px4::params::AIC_DOB_TAU>) _param_aic_dob_tau,
+        (ParamFloat<px4::params::AIC_SF_LP_HZ>) _param_aic_sf_lp_hz,
+        (ParamInt<px4::params::AIC_NOTCH_HARM>) _param_aic_notch_harm,
+        (ParamFloat<px4::params::AIC_NOTCH_BW>) _param_aic_notch_bw,
+        (ParamBool<px4::params::AIC_ENV_EN>) _param_aic_env_en,
+        (ParamFloat<px4::params::AIC_ENV_TILT>) _param_aic_env_tilt,
+        (ParamFloat<px4::params::AIC_ENV_RATE>) _param_aic_env_rate,
+        (ParamFloat<px4::params::AIC_ENV_ERR>) _param_aic_env_err,
+        (ParamFloat<px4::params::AIC_ENV_ERR_T>) _param_aic_env_err_t,
+        (ParamFloat<px4::params::AIC_ENV_PIN_T>) _param_aic_env_pin_t,
+        (ParamBool<px4::params::AIC_VIB_EN>) _param_aic_vib_en,
+        (ParamFloat<px4::params::AIC_VIB_PEAK>) _param_aic_vib_peak,
+        (ParamFloat<px4::params::AIC_VIB_BB>) _param_aic_vib_bb,
+        (ParamInt<px4::params::AIC_MIX_FRAME>) _param_aic_mix_frame,
+        (ParamFloat<px4::params::AIC_MOT_TMAX>) _param_aic_mot_tmax,
+        (ParamFloat<px4::params::AIC_MOT_ARM>) _param_aic_mot_arm,
+        (ParamFloat<px4::params::AIC_MOT_KM>) _param_aic_mot_km,
+        (ParamFloat<px4::params::AIC_MOT_WMAX>) _param_aic_mot_wmax,
+        (ParamBool<px4::params::AIC_MFD_EN>) _param_aic_mfd_en,
+        (ParamFloat<px4::params::AIC_MFD_LOSS>) _param_aic_mfd_loss,
+        (ParamFloat<px4::params::AIC_MFD_TIME>) _param_aic_mfd_time,
+        (ParamBool<px4::params::AIC_EXT_EN>) _param_aic_ext_en,
+        (ParamFloat<px4::params::AIC_PE_WIN>) _param_aic_pe_win,
+        (ParamFloat<px4::params::AIC_PE_MIN>) _param_aic_pe_min,
+        (ParamInt<px4::params::AIC_EST_MODE>) _param_aic_est_mode,
+        (ParamFloat<px4::params::AIC_EKF_GYR_N>) _param_aic_ekf_gyr_n,
+        (ParamFloat<px4::params::AIC_EKF_ACC_N>) _param_aic_ekf_acc_n,
+        (ParamBool<px4::params::AIC_CAP_EN>) _param_aic_cap_en,
+        (ParamFloat<px4::params::AIC_CAP_PRE>) _param_aic_cap_pre,
+        (ParamFloat<px4::params::AIC_CAP_POST>) _param_aic_cap_post,
+        (ParamInt<px4::params::AIC_CAP_TRIG>) _param_aic_cap_trig,
+        (ParamInt<px4::params::AIC_CAP_BUDGET>) _param_aic_cap_budget,
+        (ParamBool<px4::params::AIC_PRIOR_EN>) _param_aic_prior_en,
+        (ParamBool<px4::params::AIC_EST_REC>) _param_aic_est_rec,
+        (ParamInt<px4::params::AIC_AIRFRAME>) _param_aic_airframe,
+        (ParamInt<px4::params::AIC_PAYLOAD>) _param_aic_payload,
+        (ParamBool<px4::params::AIC_AUTO_CFG>) _param_aic_auto_cfg,
+        (ParamFloat<px4::params::AIC_CPU_BUDGET>) _param_aic_cpu_budget,
+        (ParamFloat<px4::params::AIC_CPU_MARGIN>) _param_aic_cpu_margin,
+        (ParamInt<px4::params::MAV_SYS_ID>) _param_mav_sys_id
     );
 
     void update_parameters();
     void update_vehicle_state();
-    void compute_control();
+    void update_esc_status();
+    void update_flight_state();
+    void load_fleet_prior(uint16_t airframe_id, uint16_t payload_id);
+    void write_estimator_record(float flight_time);
+    void run_config_benchmark();
+    void apply_auto_config();
+    AICModuleInput make_input() const;
     void publish_motor_commands(const Vector3f &tau);
+    void publish_motor_outputs();
+    void capture_tick(uint64_t now_us, const AICModuleInput &input, const Vector3f &tau, const AICTickStatus &status,
+                      uint32_t compute_us);
+    void start_capture_writer();
+    void request_capture_writer_exit();
+    void stop_capture_writer();
+    void capture_writer_run();
+    static int capture_writer_main(int argc, char *argv[]);
 };
 
 AttitudeControllerAICModule::AttitudeControllerAICModule() : ModuleBase(), ModuleParams(nullptr) {
+#if defined(AIC_FIXED_GAINS)
+    // Nominal inertia, gains and saturation from the frozen airframe configuration
+    _controller.init(FixedGains<AICFixedAirframeConfig>::nominal_inertia(), true, true);
+#else
     // Initialize default inertia (quadcopter typical values)
     Matrix3f J_init = Matrix3f::Zero();
     J_init(0, 0) = 0.040f;  // Ixx (kg*m^2)
@@ -94,14 +235,26 @@ AttitudeControllerAICModule::AttitudeControllerAICModule() : ModuleBase(), Modul
     Vector3f K_robust(0.1f, 0.1f, 0.1f);
     _controller.set_control_gains(K_R, K_Omega, K_robust, 2.0f);
 
+    // Set actuator limits (typically ±0.05 Nm for quadcopters)
+    _controller.set_saturation_limit(0.05f);
+#endif
+
     // Set adaptation parameters
     _controller.set_adaptation_params(1.5f, 1e-4f, 0.01f, 0.001f);
 
-    // Set actuator limits (typically ±0.05 Nm for quadcopters)
-    _controller.set_saturation_limit(0.05f);
+    // Disturbance torque observer
+    _controller.set_disturbance_observer(true, 0.05f);
+
+    _core.init();
 }
 
 AttitudeControllerAICModule::~AttitudeControllerAICModule() {
+    perf_free(_loop_perf);
+    perf_free(_loop_interval_perf);
+    perf_free(_skipped_perf);
+    perf_free(_fallback_perf);
+    perf_free(_motor_failure_perf);
+    perf_free(_capture_perf);
 }
 
 void AttitudeControllerAICModule::init() {
@@ -110,6 +263,8 @@ void AttitudeControllerAICModule::init() {
     _vehicle_attitude_setpoint_sub = orb_subscribe(ORB_ID(vehicle_attitude_setpoint));
     _vehicle_rates_setpoint_sub = orb_subscribe(ORB_ID(vehicle_rates_setpoint));
     _parameter_update_sub = orb_subscribe(ORB_ID(parameter_update));
+    _vehicle_land_detected_sub = orb_subscribe(ORB_ID(vehicle_land_detected));
+    _esc_status_sub = orb_subscribe(ORB_ID(esc_status));
 
     // Advertise actuator controls output
     _actuator_controls.group[0] = ACTUATOR_CONTROLS_GROUP_MC_ATTITUDE;
@@ -127,6 +282,7 @@ void AttitudeControllerAICModule::update_parameters() {
         // Update module parameters
         updateParams();
 
+#if !defined(AIC_FIXED_GAINS)
         // Extract PX4 gain parameters and apply to controller
         Vector3f K_R(_param_mc_roll_p.get(), _param_mc_pitch_p.get(), _param_mc_yaw_p.get());
         Vector3f K_Omega(_param_mc_rollrate_p.get(), _param_mc_pitchrate_p.get(),
@@ -134,6 +290,75 @@ void AttitudeControllerAICModule::update_parameters() {
 
         Vector3f K_robust(0.1f, 0.1f, 0.1f);  // Default robust gain
         _controller.set_control_gains(K_R, K_Omega, K_robust, 2.0f);
+#endif
+
+        _controller.set_disturbance_observer(_param_aic_dob_en.get(), _param_aic_dob_tau.get());
+        _controller.set_extended_model(_param_aic_ext_en.get());
+
+        // The auto configuration owns the estimator mode once chosen
+        EstimatorMode estimator_mode = static_cast<EstimatorMode>(math::constrain(_param_aic_est_mode.get(), 0, 2));
+
+        if (_auto_config.valid) {
+            estimator_mode = _auto_config.config.estimator;
+        }
+
+        _controller.set_information_window(_param_aic_pe_win.get(), estimator_mode, _param_aic_pe_min.get());
+        _controller.set_ekf_noise(_param_aic_ekf_gyr_n.get(), _param_aic_ekf_acc_n.get());
+
+        AICModuleConfig config;
+        config.governor_enabled = _param_aic_gov_en.get();
+        config.filter_lowpass_hz = _param_aic_sf_lp_hz.get();
+        config.notch_harmonics = _param_aic_notch_harm.get();
+        config.notch_bandwidth_hz = _param_aic_notch_bw.get();
+        config.envelope_enabled = _param_aic_env_en.get();
+        config.vibration_gating = _param_aic_vib_en.get();
+        config.vibration_peak = _param_aic_vib_peak.get();
+        config.vibration_broadband = _param_aic_vib_bb.get();
+        config.motor_frame = static_cast<MotorFrame>(math::constrain(_param_aic_mix_frame.get(), 0, 2));
+        config.motor_geometry.thrust_max = _param_aic_mot_tmax.get();
+        config.motor_geometry.arm = _param_aic_mot_arm.get();
+        config.motor_geometry.moment_ratio = _param_aic_mot_km.get();
+        config.motor_geometry.rotor_speed_max = _param_aic_mot_wmax.get();
+        config.failure_detection = _param_aic_mfd_en.get();
+        config.failure_loss = _param_aic_mfd_loss.get();
+        config.failure_confirm_time = _param_aic_mfd_time.get();
+        _core.configure(config);
+
+        _core.rate_governor().set_parameters(_param_aic_gov_idle.get(), _param_aic_gov_cruise.get(),
+                                             _param_aic_gov_sp_thr.get(), _param_aic_gov_dist.get(),
+                                             _param_aic_gov_margin.get());
+
+        _core.envelope_monitor().set_limits(math::radians(_param_aic_env_tilt.get()),
+                                            math::radians(_param_aic_env_rate.get()),
+                                            _param_aic_env_err.get(), _param_aic_env_err_t.get(),
+                                            _param_aic_env_pin_t.get());
+
+        // Capture window lengths in ticks at the current control rate
+        const float control_rate_hz = (_core.get_control_rate() > 0.f) ? _core.get_control_rate() : 250.f;
+        _capture.configure(static_cast<uint32_t>(math::max(_param_aic_cap_pre.get(), 0.f) * control_rate_hz),
+                           static_cast<uint32_t>(math::max(_param_aic_cap_post.get(), 0.f) * control_rate_hz));
+        _capture_settings.trigger_mask = static_cast<uint16_t>(_param_aic_cap_trig.get() & CAPTURE_TRIGGER_ALL);
+        _capture_settings.compute_budget_us = static_cast<uint32_t>(math::max(_param_aic_cap_budget.get(), 0));
+        _capture_enabled = _param_aic_cap_en.get();
+
+        if (_capture_enabled) {
+            start_capture_writer();
+
+        } else {
+            // Control task: only ask, the writer may be blocked on the SD card (waited for at run() exit)
+            request_capture_writer_exit();
+        }
+
+        // Fleet prior of this airframe and payload: at boot, and again when the payload changes on the ground
+        const int32_t airframe = math::constrain(_param_aic_airframe.get(), (int32_t)0, (int32_t)UINT16_MAX);
+        const int32_t payload = math::constrain(_param_aic_payload.get(), (int32_t)0, (int32_t)PRIOR_ANY_PAYLOAD - 1);
+
+        if (_param_aic_prior_en.get() && _takeoff_time == 0
+            && (airframe != _prior_airframe || payload != _prior_payload)) {
+            _prior_airframe = airframe;
+            _prior_payload = payload;
+            load_fleet_prior(static_cast<uint16_t>(airframe), static_cast<uint16_t>(payload));
+        }
 
         PX4_INFO("AIC Controller parameters updated");
     }
@@ -143,40 +368,249 @@ void AttitudeControllerAICModule::update_vehicle_state() {
     // Get latest attitude measurement
     orb_copy(ORB_ID(vehicle_attitude), _vehicle_attitude_sub, &_vehicle_attitude);
 
-    // Get attitude setpoint (desired attitude)
-    orb_copy(ORB_ID(vehicle_attitude_setpoint), _vehicle_attitude_setpoint_sub, &_attitude_setpoint);
+    // Get attitude setpoint (desired attitude) and rate setpoint (rate feedforward and the governor's
+    // rate error); a new message of either one invalidates the cached setpoint terms
+    bool setpoint_updated = false;
+    orb_check(_vehicle_attitude_setpoint_sub, &setpoint_updated);
+
+    if (setpoint_updated) {
+        orb_copy(ORB_ID(vehicle_attitude_setpoint), _vehicle_attitude_setpoint_sub, &_attitude_setpoint);
+    }
+
+    bool rates_setpoint_updated = false;
+    orb_check(_vehicle_rates_setpoint_sub, &rates_setpoint_updated);
+
+    if (rates_setpoint_updated) {
+        orb_copy(ORB_ID(vehicle_rates_setpoint), _vehicle_rates_setpoint_sub, &_rates_setpoint);
+    }
+
+    if (setpoint_updated || rates_setpoint_updated) {
+        _setpoint_sequence = (_setpoint_sequence == UINT32_MAX) ? 1 : _setpoint_sequence + 1;
+    }
+
+    // Get landed state (rate governor ground idle phase)
+    bool land_detected_updated = false;
+    orb_check(_vehicle_land_detected_sub, &land_detected_updated);
+
+    if (land_detected_updated) {
+        orb_copy(ORB_ID(vehicle_land_detected), _vehicle_land_detected_sub, &_land_detected);
+        update_flight_state();
+    }
+}
+
+void AttitudeControllerAICModule::update_flight_state() {
+    const hrt_abstime now = hrt_absolute_time();
+
+    if (!_land_detected.landed && _takeoff_time == 0) {
+        _takeoff_time = now;
+        _flight_excited = false;
+
+    } else if (_land_detected.landed && _takeoff_time != 0) {
+        const float flight_time = static_cast<float>(now - _takeoff_time) * 1e-6f;
+        _takeoff_time = 0;
+
+        // Landed: file I/O does not delay a control update that matters
+        if (_param_aic_est_rec.get() && flight_time >= MIN_RECORD_FLIGHT_TIME) {
+            write_estimator_record(flight_time);
+        }
+    }
+}
+
+void AttitudeControllerAICModule::load_fleet_prior(uint16_t airframe_id, uint16_t payload_id) {
+    const int fd = ::open(AIC_PRIOR_TABLE, O_RDONLY);
+
+    if (fd < 0) {
+        _prior_match = 0;
+        PX4_WARN("AIC fleet prior: no table %s", AIC_PRIOR_TABLE);
+        return;
+    }
+
+    PriorEntry prior;
+    _prior_match = find_prior([fd](void *buffer, size_t size) {
+        return ::read(fd, buffer, size) == static_cast<ssize_t>(size);
+    }, airframe_id, payload_id, prior);
+    ::close(fd);
+
+    if (_prior_match == 0) {
+        PX4_WARN("AIC fleet prior: none for airframe %u payload %u", (unsigned)airframe_id, (unsigned)payload_id);
+        return;
+    }
+
+    Matrix3f J_prior;
+    J_prior(0, 0) = prior.theta[0];
+    J_prior(1, 1) = prior.theta[1];
+    J_prior(2, 2) = prior.theta[2];
+    J_prior(0, 1) = J_prior(1, 0) = prior.theta[3];
+    J_prior(0, 2) = J_prior(2, 0) = prior.theta[4];
+    J_prior(1, 2) = J_prior(2, 1) = prior.theta[5];
+    _controller.set_inertia_prior(J_prior, prior.information);
+    _prior = prior;
+
+    PX4_INFO("AIC fleet prior (%s, %u vehicles): J %.4f %.4f %.4f +- %.4f %.4f %.4f",
+             (_prior_match == 2) ? "payload" : "airframe", (unsigned)prior.vehicles,
+             (double)prior.theta[0], (double)prior.theta[1], (double)prior.theta[2],
+             (double)prior.sigma[0], (double)prior.sigma[1], (double)prior.sigma[2]);
+}
+
+void AttitudeControllerAICModule::write_estimator_record(float flight_time) {
+    EstimatorRecord record{};
+    record.vehicle_id = static_cast<uint16_t>(_param_mav_sys_id.get());
+    record.airframe_id = static_cast<uint16_t>(math::constrain(_param_aic_airframe.get(), (int32_t)0,
+                         (int32_t)UINT16_MAX));
+    record.payload_id = static_cast<uint16_t>(math::constrain(_param_aic_payload.get(), (int32_t)0,
+                        (int32_t)PRIOR_ANY_PAYLOAD - 1));
+    record.flight_time = flight_time;
+    record.excited = _flight_excited;
+
+    const Matrix3f J_hat = _controller.get_inertia_estimate();
+    const float theta[PRIOR_PARAMETERS] = {J_hat(0, 0), J_hat(1, 1), J_hat(2, 2), J_hat(0, 1), J_hat(0, 2), J_hat(1, 2)};
+    memcpy(record.theta, theta, sizeof(theta));
+    _controller.get_gathered_information(record.information);
+
+    char line[256];
+    const int length = format_estimator_record(record, line, sizeof(line));
+
+    mkdir(AIC_STORAGE_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+    const int fd = ::open(AIC_ESTIMATOR_RECORDS, O_WRONLY | O_CREAT | O_APPEND, PX4_O_MODE_666);
+
+    if (fd < 0 || length == 0) {
+        PX4_ERR("AIC estimator record: cannot write %s", AIC_ESTIMATOR_RECORDS);
+
+    } else {
+        const ssize_t header = sizeof(ESTIMATOR_RECORD_HEADER) - 1;
+        bool written = (lseek(fd, 0, SEEK_END) > 0) || (::write(fd, ESTIMATOR_RECORD_HEADER, header) == header);
+        written = written && (::write(fd, line, length) == length);
+
+        if (!written) {
+            PX4_ERR("AIC estimator record: cannot write %s", AIC_ESTIMATOR_RECORDS);
+        }
+    }
+
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void AttitudeControllerAICModule::run_config_benchmark() {
+    // Scratch controller: the benchmark must not touch the state of the one that flies
+    ModuleController *scratch = new ModuleController();
+
+    if (scratch == nullptr) {
+        PX4_ERR("AIC benchmark: alloc failed, keeping the configured controller");
+        return;
+    }
+
+    scratch->set_extended_model(_param_aic_ext_en.get());
+
+    BenchmarkSettings settings;
+    settings.window_length = (_param_aic_pe_win.get() > 0.f) ? _param_aic_pe_win.get() : settings.window_length;
+    benchmark_models(*scratch, _controller.get_inertia_estimate(), hrt_absolute_time, settings, _bench_compute_us);
+    delete scratch;
+
+    for (int model = 0; model < BENCH_MODELS; ++model) {
+        PX4_INFO("AIC benchmark: %s %.1f us", configuration_name(bench_model(model)),
+                 (double)_bench_compute_us[model]);
+    }
+
+    _auto_config_pending = true;
+    _auto_config_messages = 0;
+}
+
+void AttitudeControllerAICModule::apply_auto_config() {
+    const float message_rate_hz = _core.get_message_rate();
+
+    if (!(message_rate_hz > 0.f)) {
+        return;
+    }
+
+    const float message_interval = 1.f / message_rate_hz;
+
+    // Models this build and the settings permit
+    unsigned allowed = 0;
+
+    for (int model = 0; model < BENCH_MODELS; ++model) {
+        const ControllerConfiguration config = bench_model(model);
+#if defined(AIC_FIXED_GAINS)
+        const bool model_ok = config.full_inertia != FixedGains<AICFixedAirframeConfig>::use_diagonal();
+#else
+        const bool model_ok = true;
+#endif
+        const bool estimator_ok = config.estimator == EstimatorMode::IWG || _param_aic_pe_win.get() > 0.f;
+        allowed |= (model_ok && estimator_ok) ? (1u << model) : 0u;
+    }
+
+    // Largest divider keeping the rate loop within the governor's stability margin
+    int max_divider = BENCH_MAX_DIVIDER;
+    const float rate_loop_gain = _controller.get_rate_loop_gain();
+
+    if (rate_loop_gain > 0.f) {
+        max_divider = static_cast<int>(math::min(2.f * _param_aic_gov_margin.get() / (rate_loop_gain * message_interval),
+                                                 static_cast<float>(BENCH_MAX_DIVIDER)));
+    }
 
-    // Get rate setpoint (if using rate control mode)
-    orb_copy(ORB_ID(vehicle_rates_setpoint), _vehicle_rates_setpoint_sub, &_rates_setpoint);
+    _auto_config = select_configuration(_bench_compute_us, allowed, message_interval, max_divider,
+                                        _param_aic_cpu_budget.get() * 0.01f, _param_aic_cpu_margin.get());
+    _auto_config_pending = false;
+
+    if (!_auto_config.valid) {
+        PX4_WARN("AIC auto configuration: no candidate, keeping the configured controller");
+        return;
+    }
+
+    const ControllerConfiguration &config = _auto_config.config;
+#if !defined(AIC_FIXED_GAINS)
+    _controller.set_inertia_model(!config.full_inertia);
+#endif
+    _controller.set_information_window(_param_aic_pe_win.get(), config.estimator, _param_aic_pe_min.get());
+    _core.rate_governor().set_base_divider(config.divider);
+
+    if (_auto_config.within_budget) {
+        PX4_INFO("AIC auto configuration: %s at %.0f Hz, load %.1f %% (budget %.1f %%)", configuration_name(config),
+                 (double)(message_rate_hz / config.divider), (double)(_auto_config.load * 100.f),
+                 (double)_param_aic_cpu_budget.get());
+
+    } else {
+        PX4_WARN("AIC auto configuration: nothing fits the budget of %.1f %%, %s at %.0f Hz, load %.1f %%",
+                 (double)_param_aic_cpu_budget.get(), configuration_name(config),
+                 (double)(message_rate_hz / config.divider), (double)(_auto_config.load * 100.f));
+    }
 }
 
-void AttitudeControllerAICModule::compute_control() {
-    // Convert PX4 quaternion to rotation matrix
-    Quaternionf q(_vehicle_attitude.q[0], _vehicle_attitude.q[1], _vehicle_attitude.q[2],
-                  _vehicle_attitude.q[3]);
-    Matrix3f R = q.to_dcm();
+void AttitudeControllerAICModule::update_esc_status() {
+    // Track the motor vibration fundamental from the ESC RPM telemetry
+    bool esc_updated = false;
+    orb_check(_esc_status_sub, &esc_updated);
+
+    if (esc_updated) {
+        esc_status_s esc_status{};
+        orb_copy(ORB_ID(esc_status), _esc_status_sub, &esc_status);
 
-    // Current angular velocity (from gyro)
-    Vector3f omega(_vehicle_attitude.rollspeed, _vehicle_attitude.pitchspeed,
-                   _vehicle_attitude.yawspeed);
+        float rpm_sum = 0.f;
+        int rpm_count = 0;
 
-    // Convert desired quaternion to rotation matrix
-    Quaternionf q_d(_attitude_setpoint.q_d[0], _attitude_setpoint.q_d[1],
-                    _attitude_setpoint.q_d[2], _attitude_setpoint.q_d[3]);
-    Matrix3f R_d = q_d.to_dcm();
+        for (int i = 0; i < math::min((int)esc_status.esc_count, (int)esc_status_s::CONNECTED_ESC_MAX); ++i) {
+            if (esc_status.esc[i].esc_rpm > 0) {
+                rpm_sum += (float)esc_status.esc[i].esc_rpm;
+                ++rpm_count;
+            }
+        }
 
-    // Desired rates
-    Vector3f omega_d(_attitude_setpoint.roll_body, _attitude_setpoint.pitch_body,
-                     _attitude_setpoint.yaw_body);
+        _core.set_rotor_frequency((rpm_count > 0) ? rpm_sum / rpm_count / 60.f : 0.f);
+    }
+}
 
-    // Desired angular acceleration (can be zero for nominal tracking)
-    Vector3f alpha_d = Vector3f::Zero();
+AICModuleInput AttitudeControllerAICModule::make_input() const {
+    AICModuleInput input;
 
-    // Compute control torque
-    Vector3f tau = _controller.compute_torque(R, omega, R_d, omega_d, alpha_d, _dt);
+    input.q = Quaternionf(_vehicle_attitude.q[0], _vehicle_attitude.q[1], _vehicle_attitude.q[2],
+                          _vehicle_attitude.q[3]);
+    input.omega = Vector3f(_vehicle_attitude.rollspeed, _vehicle_attitude.pitchspeed,
+                           _vehicle_attitude.yawspeed);
 
-    // Publish control torque as motor commands
-    publish_motor_commands(tau);
+    set_setpoint_input(input, _attitude_setpoint, _rates_setpoint);
+    input.setpoint_sequence = _setpoint_sequence;
+    input.landed = _land_detected.landed;
+    return input;
 }
 
 void AttitudeControllerAICModule::publish_motor_commands(const Vector3f &tau) {
@@ -213,9 +647,178 @@ void AttitudeControllerAICModule::publish_motor_commands(const Vector3f &tau) {
     orb_publish(ORB_ID(actuator_controls_0), _actuator_controls_pub, &_actuator_controls);
 }
 
+void AttitudeControllerAICModule::publish_motor_outputs() {
+    // Allocated by the module (AIC_MIX_FRAME), bypassing the flight stack's control allocation
+    actuator_motors_s actuator_motors{};
+    const int motor_count = _core.allocation().motor_count();
+
+    for (int i = 0; i < actuator_motors_s::NUM_CONTROLS; ++i) {
+        actuator_motors.control[i] = (i < motor_count) ? _core.motor_outputs()[i] : NAN;
+    }
+
+    actuator_motors.timestamp = hrt_absolute_time();
+
+    if (_actuator_motors_pub == nullptr) {
+        _actuator_motors_pub = orb_advertise(ORB_ID(actuator_motors), &actuator_motors);
+
+    } else {
+        orb_publish(ORB_ID(actuator_motors), _actuator_motors_pub, &actuator_motors);
+    }
+}
+
+void AttitudeControllerAICModule::capture_tick(uint64_t now_us, const AICModuleInput &input, const Vector3f &tau,
+        const AICTickStatus &status, uint32_t compute_us) {
+    CaptureRecord record;
+    _core.fill_capture_record(now_us, input, tau, status, compute_us, record);
+    record.triggers = _capture_detector.update(record, _capture_settings);
+
+    if (_capture_requested.load()) {
+        _capture_requested.store(false);
+        record.triggers |= CAPTURE_TRIGGER_MANUAL;
+    }
+
+    if (record.triggers != 0) {
+        perf_count(_capture_perf);
+    }
+
+    // A tick dropped here only means the writer is behind; the record after it is flagged
+    _capture.push(record);
+}
+
+void AttitudeControllerAICModule::start_capture_writer() {
+    int state = _capture_writer.load();
+
+    // A writer asked to leave but still running is taken back (it only leaves through EXITING -> IDLE)
+    while (state == WRITER_EXITING && !_capture_writer.compare_exchange(&state, WRITER_RUNNING)) {}
+
+    if (state != WRITER_IDLE) {
+        return;
+    }
+
+    _capture_writer.store(WRITER_RUNNING);
+
+    const int task_id = px4_task_spawn_cmd("aic_capture",
+                                           SCHED_DEFAULT,
+                                           SCHED_PRIORITY_LOG_WRITER,
+                                           1800,
+                                           (px4_main_t)&capture_writer_main,
+                                           nullptr);
+
+    if (task_id < 0) {
+        _capture_writer.store(WRITER_IDLE);
+        PX4_ERR("capture writer spawn failed");
+    }
+}
+
+void AttitudeControllerAICModule::request_capture_writer_exit() {
+    int running = WRITER_RUNNING;
+    _capture_writer.compare_exchange(&running, WRITER_EXITING);
+}
+
+void AttitudeControllerAICModule::stop_capture_writer() {
+    request_capture_writer_exit();
+
+    // The writer uses this instance: wait for it however long a write blocks (slow SD card),
+    // the module must not be deleted under it. Only at run() exit, never on the control path
+    for (int i = 0; _capture_writer.load() != WRITER_IDLE; ++i) {
+        if (i == 200) {
+            PX4_WARN("waiting for the capture writer");
+        }
+
+        px4_usleep(10000);
+    }
+}
+
+int AttitudeControllerAICModule::capture_writer_main(int argc, char *argv[]) {
+    AttitudeControllerAICModule *instance = get_instance();
+
+    if (instance) {
+        instance->capture_writer_run();
+    }
+
+    return 0;
+}
+
+void AttitudeControllerAICModule::capture_writer_run() {
+    mkdir(AIC_STORAGE_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+
+    CaptureRecord chunk[8];
+
+    for (;;) {
+        if (_capture_writer.load() != WRITER_RUNNING) {
+            int exiting = WRITER_EXITING;
+
+            // Fails if capture was enabled again in the meantime: keep writing
+            if (_capture_writer.compare_exchange(&exiting, WRITER_IDLE)) {
+                break;
+            }
+
+            continue;
+        }
+
+        CaptureWindow window;
+
+        if (!_capture.window(window)) {
+            px4_usleep(20000);
+            continue;
+        }
+
+        char path[64];
+        snprintf(path, sizeof(path), "%s/cap_%llu.bin", AIC_STORAGE_DIR, (unsigned long long)(window.trigger_us / 1000));
+        const int fd = ::open(path, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_666);
+
+        CaptureFileHeader header{};
+        header.magic = CAPTURE_FILE_MAGIC;
+        header.version = CAPTURE_FILE_VERSION;
+        header.record_size = sizeof(CaptureRecord);
+        header.trigger_us = window.trigger_us;
+        header.pre_records = window.trigger - window.start;
+        bool written = (fd >= 0) && (::write(fd, &header, sizeof(header)) == sizeof(header));
+
+        // Drain as records come in; the post-trigger part may still be recording
+        for (;;) {
+            const uint32_t count = _capture.read(chunk, 8);
+
+            if (count == 0) {
+                if (_capture.complete() || _capture_writer.load() != WRITER_RUNNING) {
+                    break;
+                }
+
+                px4_usleep(5000);
+                continue;
+            }
+
+            const ssize_t size = count * sizeof(CaptureRecord);
+            written = written && (::write(fd, chunk, size) == size);
+            header.records += count;
+        }
+
+        _capture.window(window);
+        header.triggers = window.triggers;
+        header.dropped = window.dropped;
+        _capture.release();
+
+        if (fd >= 0) {
+            written = written && (lseek(fd, 0, SEEK_SET) == 0) && (::write(fd, &header, sizeof(header)) == sizeof(header));
+            ::close(fd);
+        }
+
+        if (written) {
+            _capture_files.fetch_add(1);
+            PX4_INFO("AIC capture %s: %u records, triggers 0x%02x", path, (unsigned)header.records,
+                     (unsigned)header.triggers);
+
+        } else {
+            PX4_ERR("AIC capture %s: write failed", path);
+        }
+    }
+}
+
 void AttitudeControllerAICModule::run() {
-    // Wait for first measurement
-    bool first_run = true;
+    // On the ground at boot: the benchmark delays the first control update by a few hundred ms at most
+    if (_param_aic_auto_cfg.get()) {
+        run_config_benchmark();
+    }
 
     while (!should_exit()) {
         // Wait for new attitude measurement (poll-based)
@@ -227,28 +830,81 @@ void AttitudeControllerAICModule::run() {
 
         uint64_t now = hrt_absolute_time();
 
-        if (first_run) {
-            _last_run = now;
-            first_run = false;
+        // Get latest vehicle state
+        update_vehicle_state();
+
+        // Update parameters
+        update_parameters();
+
+        // Track vibration peaks for the composite error filter bank
+        update_esc_status();
+
+        // Auto configuration once the message rate is known, on the ground
+        if (_auto_config_pending && ++_auto_config_messages >= AUTO_CONFIG_MESSAGES && _takeoff_time == 0) {
+            apply_auto_config();
+        }
+
+        // Governor decision, dt, controller and envelope monitor
+        Vector3f tau;
+        const AICModuleInput input = make_input();
+        perf_begin(_loop_perf);
+        const hrt_abstime update_start = hrt_absolute_time();
+        const AICTickStatus status = _core.update(now, input, tau);
+
+        if (!status.controlled) {
+            perf_cancel(_loop_perf);
+
+            if (status.skipped) {
+                perf_count(_skipped_perf);
+            }
+
             continue;
         }
 
-        // Calculate timestep
-        _dt = (now - _last_run) * 1e-6f;  // Convert microseconds to seconds
-        _last_run = now;
+        perf_end(_loop_perf);
+        perf_count(_loop_interval_perf);
 
-        // Clamp dt to reasonable bounds
-        _dt = math::constrain(_dt, 0.002f, 0.1f);  // 5 Hz to 500 Hz
+        if (_capture_enabled) {
+            capture_tick(now, input, tau, status, static_cast<uint32_t>(hrt_absolute_time() - update_start));
+        }
 
-        // Update parameters
-        update_parameters();
+        // Estimator record: whether this flight excited the inertia
+        _flight_excited = _flight_excited || (_takeoff_time != 0 && _controller.is_persistently_excited());
 
-        // Get latest vehicle state
-        update_vehicle_state();
+        if (status.fallback_engaged) {
+            perf_count(_fallback_perf);
+            PX4_ERR("AIC envelope violation (%s), switching to fixed-inertia PD",
+                    EnvelopeMonitor::trip_name(status.trips));
+
+        } else if (status.fallback_released) {
+            PX4_INFO("AIC envelope fallback released after landing");
+        }
+
+        if (status.motor_failure_detected) {
+            perf_count(_motor_failure_perf);
+            PX4_ERR("AIC motor %d failure detected, reduced allocation%s", _core.allocation().failed_motor() + 1,
+                    _core.allocation().is_yaw_controllable() ? "" : " (yaw uncontrolled)");
+
+        } else if (status.motor_failure_cleared) {
+            PX4_INFO("AIC motor failure cleared after landing");
+        }
+
+        if (!_over_budget_warned && _core.rate_governor().get_over_budget_messages() > 0) {
+            _over_budget_warned = true;
+            PX4_WARN("AIC base divider %d exceeds the stability bound (max %d), over the CPU budget",
+                     _core.rate_governor().get_base_divider(), _core.rate_governor().max_stable_divider());
+        }
 
-        // Compute control torque
-        compute_control();
+        if (_core.allocation().is_enabled()) {
+            publish_motor_outputs();
+
+        } else {
+            // Publish control torque as motor commands
+            publish_motor_commands(tau);
+        }
     }
+
+    stop_capture_writer();
 }
 
 int AttitudeControllerAICModule::task_spawn(int argc, char *argv[]) {
@@ -278,8 +934,116 @@ int AttitudeControllerAICModule::task_spawn(int argc, char *argv[]) {
     return -ENOMEM;
 }
 
+int AttitudeControllerAICModule::print_status() {
+    PX4_INFO("Running");
+#if defined(AIC_FIXED_GAINS)
+    PX4_INFO("gains: fixed airframe configuration (MC_*_P parameters ignored)");
+#endif
+    PX4_INFO("rate governor: %s, phase %s, divider %d (base %d, max stable %d), message interval %.2f ms",
+             _param_aic_gov_en.get() ? "enabled" : "disabled",
+             RateGovernor::phase_name(_core.rate_governor().get_phase()),
+             _core.rate_governor().get_divider(), _core.rate_governor().get_base_divider(),
+             _core.rate_governor().max_stable_divider(),
+             (double)(_core.rate_governor().get_message_interval() * 1e3f));
+    PX4_INFO("  messages over the CPU budget (base divider cut by the stability bound): %u",
+             (unsigned)_core.rate_governor().get_over_budget_messages());
+    PX4_INFO("composite error notches: %.1f Hz, %.1f Hz (update rate %.1f Hz)",
+             (double)_controller.get_filter_notch_frequency(0), (double)_controller.get_filter_notch_frequency(1),
+             (double)_core.get_control_rate());
+    const Vector3f &d_hat = _controller.get_disturbance_estimate();
+    PX4_INFO("disturbance estimate: [%.4f, %.4f, %.4f] Nm", (double)d_hat(0), (double)d_hat(1), (double)d_hat(2));
+    const EstimatorMode estimator_mode = _controller.get_estimator_mode();
+    PX4_INFO("estimator: %s, window excitation %.4f (rad/s^2)^2, persistently excited: %s",
+             (estimator_mode == EstimatorMode::EKF) ? "rate and inertia EKF"
+             : (estimator_mode == EstimatorMode::WINDOWED_LS) ? "gradient + windowed LS" : "gradient",
+             (double)_controller.get_window_excitation(), _controller.is_persistently_excited() ? "yes" : "no");
+    float inertia_variance[6];
+
+    if (_controller.get_inertia_variance(inertia_variance)) {
+        PX4_INFO("  inertia std: [%.2e, %.2e, %.2e], products [%.2e, %.2e, %.2e] kg*m^2",
+                 (double)sqrtf(inertia_variance[0]), (double)sqrtf(inertia_variance[1]),
+                 (double)sqrtf(inertia_variance[2]), (double)sqrtf(inertia_variance[3]),
+                 (double)sqrtf(inertia_variance[4]), (double)sqrtf(inertia_variance[5]));
+    }
+
+    if (_controller.is_extended_model()) {
+        const Vector3f r = _controller.get_com_offset_estimate();
+        PX4_INFO("extended model: CoM offset [%.4f, %.4f], yaw drag %.5f Nm/(rad/s), rotor inertia %.2e kg*m^2",
+                 (double)r(0), (double)r(1), (double)_controller.get_yaw_drag_estimate(),
+                 (double)_controller.get_rotor_inertia_estimate());
+    }
+
+    PX4_INFO("envelope monitor: %s, fallback %s (trips: %s)",
+             _param_aic_env_en.get() ? "enabled" : "disabled",
+             _controller.is_fallback_active() ? "active" : "inactive",
+             EnvelopeMonitor::trip_name(_core.envelope_monitor().get_trip_reasons()));
+    const VibrationMonitor &vibration = _core.vibration_monitor();
+    const float message_rate_hz = _core.get_message_rate();
+    PX4_INFO("vibration gating: %s, adaptation scale [%.2f, %.2f, %.2f]",
+             _param_aic_vib_en.get() ? "enabled" : "disabled",
+             (double)vibration.get_scale(0), (double)vibration.get_scale(1), (double)vibration.get_scale(2));
+
+    for (int i = 0; i < 3; ++i) {
+        PX4_INFO("  axis %d: peak %.3f rad/s at %.0f Hz, broadband %.3f rad/s", i,
+                 (double)vibration.get_peak_level(i), (double)vibration.get_peak_frequency(i, message_rate_hz),
+                 (double)vibration.get_broadband_level(i));
+    }
+
+    if (_auto_config.valid) {
+        PX4_INFO("auto configuration: %s, divider %d, load %.1f %% of %.1f %%%s",
+                 configuration_name(_auto_config.config), _auto_config.config.divider, (double)(_auto_config.load * 100.f), (double)_param_aic_cpu_budget.get(),
+                 _auto_config.within_budget ? "" : " (over budget)");
+        PX4_INFO("  benchmark: %.1f / %.1f / %.1f / %.1f us (full LS / full / diagonal LS / diagonal)",
+                 (double)_bench_compute_us[0], (double)_bench_compute_us[1], (double)_bench_compute_us[2],
+                 (double)_bench_compute_us[3]);
+
+    } else if (_auto_config_pending) {
+        PX4_INFO("auto configuration: benchmarked, waiting for the message rate on the ground");
+    }
+
+    if (_prior_match >= 0) {
+        PX4_INFO("fleet prior: airframe %d payload %d, %s", (int)_prior_airframe, (int)_prior_payload,
+                 (_prior_match == 2) ? "payload entry" : ((_prior_match == 1) ? "airframe entry" : "none"));
+    }
+
+    PX4_INFO("capture: %s, %u windows, %u files, %u ticks dropped, %u triggers suppressed",
+             _capture_enabled ? "enabled" : "disabled", (unsigned)_capture.windows(),
+             (unsigned)_capture_files.load(), (unsigned)_capture.dropped(), (unsigned)_capture.suppressed());
+
+    const MotorAllocation &allocation = _core.allocation();
+
+    if (allocation.is_enabled()) {
+        PX4_INFO("motor allocation: %d motors, failed motor %d, yaw %s; detection %s, residual noise %.4f Nm",
+                 allocation.motor_count(), allocation.failed_motor() + 1,
+                 allocation.is_yaw_controllable() ? "controlled" : "uncontrolled",
+                 _param_aic_mfd_en.get() ? "enabled" : "disabled",
+                 (double)_core.motor_failure_detector().get_residual_noise());
+
+    } else {
+        PX4_INFO("motor allocation: disabled (torque to actuator controls)");
+    }
+
+    perf_print_counter(_loop_perf);
+    perf_print_counter(_loop_interval_perf);
+    perf_print_counter(_skipped_perf);
+    perf_print_counter(_fallback_perf);
+    perf_print_counter(_motor_failure_perf);
+    perf_print_counter(_capture_perf);
+    return 0;
+}
+
 int AttitudeControllerAICModule::custom_command(int argc, char *argv[]) {
-    // Custom shell commands can be added here
+    if (argc > 0 && !strcmp(argv[0], "capture")) {
+        if (!is_running()) {
+            PX4_ERR("not running");
+            return 1;
+        }
+
+        // Written on the next controlled tick (AIC_CAP_EN)
+        get_instance()->_capture_requested.store(true);
+        return 0;
+    }
+
     return print_usage("unknown command");
 }
 
@@ -300,6 +1064,7 @@ Implements geometric PD control on SO(3) with online adaptive inertia estimation
     start [-d <device>] [-a <address>]
     stop
     status
+    capture    Write the capture window around the next tick (AIC_CAP_EN)
 }
 )DESCR_STR"
     );
@@ -0,0 +1,30 @@
+############################################################################
+#
+# aic_core: prebuilt AIC controller core for host tools
+#
+# Simulator, replay, tuner and bindings link this library instead of
+# instantiating the controller templates (and the Eigen math behind them)
+# in every binary. Requires PX4_SOURCE_DIR for the matrix library.
+#
+#   include(${PX4_SOURCE_DIR}/src/modules/attitude_controller_aic/aic_core.cmake)
+#   target_link_libraries(my_tool PRIVATE aic_core)
+#
+############################################################################
+
+if(NOT TARGET aic_core)
+    add_library(aic_core STATIC ${CMAKE_CURRENT_LIST_DIR}/aic_core.cpp)
+
+    target_include_directories(aic_core PUBLIC
+        ${CMAKE_CURRENT_LIST_DIR}/include
+        ${PX4_SOURCE_DIR}/src/lib/matrix
+    )
+
+    find_package(Eigen3 QUIET)
+    if(Eigen3_FOUND)
+        target_link_libraries(aic_core PUBLIC Eigen3::Eigen)
+    else()
+        target_include_directories(aic_core PUBLIC /usr/include/eigen3)
+    endif()
+
+    target_compile_features(aic_core PUBLIC cxx_std_14)
+endif()
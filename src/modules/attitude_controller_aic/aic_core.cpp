@@ -0,0 +1,22 @@
+/**
+ * @file aic_core.cpp
+ * @brief Explicit instantiations of the common AIC controller configurations
+ * 
+ * Compiled once into the aic_core library (and the PX4 module). Translation
+ * units that include attitude_controller_aic.hpp see the matching extern
+ * template declarations and link against this object code instead of
+ * instantiating the controller and the estimator math themselves.
+ */
+
+#include "attitude_controller_aic.hpp"
+#include "aic_fixed_config.hpp"
+
+namespace attitude_controller_aic {
+
+// Runtime-configurable controller (module default, host tools)
+template class BasicAttitudeControllerAIC<RuntimeGains>;
+
+// Frozen airframe configuration (AIC_FIXED_GAINS)
+template class BasicAttitudeControllerAIC<FixedGains<AICFixedAirframeConfig>>;
+
+} // namespace attitude_controller_aic
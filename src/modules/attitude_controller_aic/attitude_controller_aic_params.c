@@ -0,0 +1,617 @@
+/**
+ * @file attitude_controller_aic_params.c
+ * @brief Parameters of the Adaptive Inertia-aware Composite attitude controller
+ */
+
+/**
+ * Enable flight-phase rate governor
+ *
+ * Runs the control and adaptation update at a reduced rate while landed
+ * or in steady flight. Setpoint changes, disturbances and saturation raise
+ * the rate back to the full attitude message rate immediately.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_GOV_EN, 1);
+
+/**
+ * Rate governor divider while landed
+ *
+ * The controller runs on every N-th attitude message on the ground.
+ *
+ * @min 1
+ * @max 20
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_GOV_IDLE, 8);
+
+/**
+ * Rate governor divider in steady flight
+ *
+ * @min 1
+ * @max 10
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_GOV_CRUISE, 2);
+
+/**
+ * Rate governor setpoint change threshold
+ *
+ * Setpoint change (quaternion distance plus rate setpoint change) that
+ * forces the full control rate.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_GOV_SP_THR, 0.02f);
+
+/**
+ * Rate governor disturbance threshold
+ *
+ * Rate tracking error or composite error norm that forces the full
+ * control rate.
+ *
+ * @unit rad/s
+ * @min 0.0
+ * @max 5.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_GOV_DIST, 0.3f);
+
+/**
+ * Rate governor stability margin
+ *
+ * Fraction of the forward-Euler stability limit (K_Omega + K) / J * dt < 2
+ * that a reduced control rate may use.
+ *
+ * @min 0.05
+ * @max 1.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_GOV_MARGIN, 0.5f);
+
+/**
+ * Enable disturbance torque observer
+ *
+ * Estimates the external torque as the low-pass filtered residual between
+ * the applied torque and the adaptive model torque at the measured angular
+ * acceleration, and compensates it in the control law.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_DOB_EN, 1);
+
+/**
+ * Disturbance observer time constant
+ *
+ * Low-pass time constant of the disturbance estimate. Smaller values react
+ * faster to gusts but pass more gyro noise from the differentiated rate.
+ *
+ * @unit s
+ * @min 0.005
+ * @max 1.0
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_DOB_TAU, 0.05f);
+
+/**
+ * Composite error low-pass cutoff
+ *
+ * Cutoff of the second-order Butterworth low-pass in the composite error
+ * filter bank. Set to 0 to use the legacy one-pole filter (alpha = 0.1).
+ *
+ * @unit Hz
+ * @min 0.0
+ * @max 200.0
+ * @decimal 1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_SF_LP_HZ, 0.0f);
+
+/**
+ * Composite error notch harmonics
+ *
+ * Number of rotor frequency harmonics (from ESC RPM telemetry) notched out
+ * of the composite error. 0 disables the notches.
+ *
+ * @min 0
+ * @max 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_NOTCH_HARM, 0);
+
+/**
+ * Composite error notch bandwidth
+ *
+ * @unit Hz
+ * @min 1.0
+ * @max 100.0
+ * @decimal 1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_NOTCH_BW, 20.0f);
+
+/**
+ * Enable attitude envelope monitor
+ *
+ * Checks tilt, body rate, attitude error growth, inertia estimator
+ * divergence and non-finite outputs on every control update. A violation
+ * switches to the fixed-inertia PD fallback within the same update; the
+ * fallback stays latched until the vehicle has landed.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_ENV_EN, 1);
+
+/**
+ * Envelope monitor maximum tilt
+ *
+ * @unit deg
+ * @min 10.0
+ * @max 180.0
+ * @decimal 1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_ENV_TILT, 70.0f);
+
+/**
+ * Envelope monitor maximum body rate
+ *
+ * @unit deg/s
+ * @min 90.0
+ * @max 2000.0
+ * @decimal 0
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_ENV_RATE, 600.0f);
+
+/**
+ * Envelope monitor attitude error floor
+ *
+ * Attitude error norm above which continuous growth is treated as a
+ * divergence.
+ *
+ * @min 0.05
+ * @max 2.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_ENV_ERR, 0.3f);
+
+/**
+ * Envelope monitor attitude error growth time
+ *
+ * Time the attitude error must keep growing above the floor to trip.
+ *
+ * @unit s
+ * @min 0.02
+ * @max 5.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_ENV_ERR_T, 0.3f);
+
+/**
+ * Envelope monitor estimator divergence time
+ *
+ * Time an inertia estimate must stay pinned at its projection bounds to trip.
+ *
+ * @unit s
+ * @min 0.1
+ * @max 30.0
+ * @decimal 1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_ENV_PIN_T, 2.0f);
+
+/**
+ * Vibration-aware adaptation gating
+ *
+ * Scales the inertia adaptation of each axis down (to frozen) while the
+ * upper band (above 1/16 of the attitude message rate) of its angular rate
+ * spectrum exceeds AIC_VIB_PEAK or AIC_VIB_BB.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_VIB_EN, 1);
+
+/**
+ * Vibration gating peak threshold
+ *
+ * Amplitude of a single vibration line in the body rates at which the
+ * adaptation scale starts dropping; adaptation freezes at twice this value.
+ *
+ * @unit rad/s
+ * @min 0.01
+ * @max 5.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_VIB_PEAK, 0.2f);
+
+/**
+ * Vibration gating broadband threshold
+ *
+ * Upper-band noise level of the body rates at which the adaptation scale
+ * starts dropping; adaptation freezes at twice this value.
+ *
+ * @unit rad/s
+ * @min 0.01
+ * @max 5.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_VIB_BB, 0.3f);
+
+/**
+ * Motor allocation frame
+ *
+ * With a frame selected, the module allocates the torque and the collective
+ * thrust of the attitude setpoint to the motors itself and publishes
+ * actuator_motors (disable the flight stack's control allocator). This
+ * enables motor failure detection and the reduced single-failure
+ * allocations. Motor order follows the PX4 airframe geometry.
+ *
+ * @value 0 Disabled (torque to the flight stack's mixer)
+ * @value 1 Quadrotor X
+ * @value 2 Hexarotor X
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_MIX_FRAME, 0);
+
+/**
+ * Motor maximum thrust
+ *
+ * Thrust of one motor at full command.
+ *
+ * @unit N
+ * @min 0.1
+ * @max 100.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_MOT_TMAX, 8.0f);
+
+/**
+ * Motor arm length
+ *
+ * Distance of the motors from the center of mass.
+ *
+ * @unit m
+ * @min 0.02
+ * @max 2.0
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_MOT_ARM, 0.25f);
+
+/**
+ * Motor yaw moment ratio
+ *
+ * Rotor reaction torque per unit thrust.
+ *
+ * @unit m
+ * @min 0.001
+ * @max 0.1
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_MOT_KM, 0.016f);
+
+/**
+ * Motor maximum rotor speed
+ *
+ * Rotor speed at full command. Rotor speeds are estimated from the motor
+ * commands for the rotor inertia term of the extended model (AIC_EXT_EN).
+ *
+ * @unit rad/s
+ * @min 100.0
+ * @max 10000.0
+ * @decimal 0
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_MOT_WMAX, 2500.0f);
+
+/**
+ * Enable motor failure detection
+ *
+ * Matches the torque prediction residual against each motor's signature
+ * (effectiveness column times command). A confirmed failure switches to the
+ * precomputed allocation without that motor on the same control update and
+ * freezes the inertia adaptation until the vehicle has landed. Requires
+ * AIC_MIX_FRAME.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_MFD_EN, 1);
+
+/**
+ * Motor failure detection loss threshold
+ *
+ * Fraction of a motor's expected torque that must be missing.
+ *
+ * @min 0.2
+ * @max 1.0
+ * @decimal 2
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_MFD_LOSS, 0.5f);
+
+/**
+ * Motor failure detection confirmation time
+ *
+ * Time the same motor must keep matching the residual before the failure
+ * is declared.
+ *
+ * @unit s
+ * @min 0.0
+ * @max 0.1
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_MFD_TIME, 0.008f);
+
+/**
+ * Enable extended adaptive model
+ *
+ * Adds center-of-mass offset (coupled with the collective thrust), yaw drag
+ * and rotor inertia to the adapted inertia, so an off-center payload is
+ * learned as a model parameter instead of being fought as a torque bias.
+ * The CoM offset is in m with AIC_MIX_FRAME set (thrust known in N),
+ * otherwise in Nm at full thrust. The rotor inertia term needs
+ * AIC_MIX_FRAME (rotor speeds from the motor commands).
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_EXT_EN, 0);
+
+/**
+ * Information window length
+ *
+ * Window of recent flight over which persistent excitation is judged (and
+ * the windowed least-squares fit of AIC_EST_MODE 1 is computed). The window
+ * is 10 blocks of a tenth of this length. 0 disables it: excitation is then
+ * judged on the information accumulated since the last reset.
+ *
+ * @unit s
+ * @min 0.0
+ * @max 20.0
+ * @decimal 1
+ * @increment 0.5
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_PE_WIN, 2.0f);
+
+/**
+ * Persistent excitation threshold
+ *
+ * Smallest eigenvalue of the inertia block of the window information, per
+ * second of window, above which the recent flight counts as persistently
+ * excited. Hover noise stays around 0.005, roll/pitch steps of 0.2 rad
+ * reach about 0.1.
+ *
+ * @unit (rad/s^2)^2
+ * @min 0.0
+ * @max 10.0
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_PE_MIN, 0.05f);
+
+/**
+ * Inertia estimation mode
+ *
+ * Information-weighted gradient alone, or additionally pulled toward the
+ * least-squares fit of the information window while the window is
+ * persistently excited (relearns a changed payload within a few window
+ * lengths of maneuvering, without a reset). Windowed least squares needs
+ * AIC_PE_WIN > 0. The extended Kalman filter estimates the body rates and
+ * the full inertia jointly from the applied torque and the gyro and gives
+ * the inertia variance (noise model AIC_EKF_GYR_N, AIC_EKF_ACC_N).
+ *
+ * @value 0 Information-weighted gradient
+ * @value 1 Gradient and windowed least squares
+ * @value 2 Rate and inertia extended Kalman filter
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_EST_MODE, 0);
+
+/**
+ * Inertia EKF gyro noise
+ *
+ * Standard deviation of the body rate measurement (AIC_EST_MODE 2).
+ *
+ * @unit rad/s
+ * @min 0.0001
+ * @max 0.5
+ * @decimal 4
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_EKF_GYR_N, 0.005f);
+
+/**
+ * Inertia EKF acceleration noise
+ *
+ * Angular acceleration not explained by the applied torque and the inertia
+ * (disturbances, actuator lag) in the rate prediction (AIC_EST_MODE 2).
+ * Larger values trust the gyro more and learn the inertia more slowly.
+ *
+ * @unit rad/s^2/sqrt(Hz)
+ * @min 0.001
+ * @max 10.0
+ * @decimal 3
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_EKF_ACC_N, 0.03f);
+
+/**
+ * Enable pre-trigger capture
+ *
+ * Keeps the last ticks of controller state (attitude, errors, torque,
+ * estimates, timing) in RAM and writes the window around a trigger event
+ * to PX4_STORAGEDIR/aic/cap_<time ms>.bin from a low-priority task, so
+ * that anomalies are captured without logging every tick.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_CAP_EN, 0);
+
+/**
+ * Capture time before the trigger
+ *
+ * Limited by the RAM buffer (AIC_CAPTURE_RECORDS ticks at build time).
+ *
+ * @unit s
+ * @min 0.0
+ * @max 10.0
+ * @decimal 2
+ * @increment 0.1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_CAP_PRE, 1.0f);
+
+/**
+ * Capture time after the trigger
+ *
+ * A further trigger inside this time extends the same capture.
+ *
+ * @unit s
+ * @min 0.0
+ * @max 10.0
+ * @decimal 2
+ * @increment 0.1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_CAP_POST, 0.5f);
+
+/**
+ * Capture triggers
+ *
+ * @bit 0 Sustained actuator saturation
+ * @bit 1 Payload change (inertia estimate jump)
+ * @bit 2 Loss of persistent excitation
+ * @bit 3 Loop overrun (dt clamped or over AIC_CAP_BUDGET)
+ * @bit 4 Non-finite controller state
+ * @bit 5 Manual (attitude_controller_aic capture)
+ * @min 0
+ * @max 63
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_CAP_TRIG, 63);
+
+/**
+ * Capture compute budget
+ *
+ * A controller update taking longer than this triggers an overrun capture.
+ * 0 only triggers on clamped dt.
+ *
+ * @unit us
+ * @min 0
+ * @max 10000
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_CAP_BUDGET, 0);
+
+/**
+ * Load the fleet inertia prior at boot
+ *
+ * Looks up AIC_AIRFRAME and AIC_PAYLOAD in PX4_STORAGEDIR/aic/priors.bin
+ * (written by the aic_fleet_prior tool) and starts the adaptation from the
+ * prior inertia with the prior information, so it only corrects what the
+ * fleet is unsure of. A payload change on the ground loads its prior again.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_PRIOR_EN, 0);
+
+/**
+ * Record the inertia estimate after each flight
+ *
+ * Appends the estimate and the information gathered in flight to
+ * PX4_STORAGEDIR/aic/estimates.csv on landing after at least 10 s in air,
+ * as input for the fleet prior.
+ *
+ * @boolean
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_EST_REC, 0);
+
+/**
+ * Airframe ID for the fleet prior
+ *
+ * Identifies vehicles of the same build in the estimator records and the
+ * prior table.
+ *
+ * @min 0
+ * @max 65535
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_AIRFRAME, 0);
+
+/**
+ * Payload ID for the fleet prior
+ *
+ * 0 for no payload. Without a prior for this payload the airframe-wide
+ * prior (pooled over payloads, less informative) is used.
+ *
+ * @min 0
+ * @max 65534
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_PAYLOAD, 0);
+
+/**
+ * Choose the controller configuration by a boot-time benchmark
+ *
+ * Times compute_torque in each inertia model (full, diagonal) and
+ * estimator mode at boot and, once the attitude message rate is known on
+ * the ground, runs the richest configuration within AIC_CPU_BUDGET:
+ * control rate first (every message, then every 2nd up to every 4th,
+ * within the AIC_GOV_MARGIN stability bound), then the full model, then
+ * the windowed least squares. Overrides AIC_EST_MODE.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_INT32(AIC_AUTO_CFG, 0);
+
+/**
+ * CPU budget of the controller
+ *
+ * Share of the attitude message interval the controller update may take
+ * (auto configuration).
+ *
+ * @unit %
+ * @min 1.0
+ * @max 100.0
+ * @decimal 1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_CPU_BUDGET, 20.0f);
+
+/**
+ * CPU budget margin
+ *
+ * Factor on the benchmarked compute time for interrupts, cache misses and
+ * preemption in flight (auto configuration).
+ *
+ * @min 1.0
+ * @max 5.0
+ * @decimal 1
+ * @group AIC Attitude Control
+ */
+PARAM_DEFINE_FLOAT(AIC_CPU_MARGIN, 1.5f);
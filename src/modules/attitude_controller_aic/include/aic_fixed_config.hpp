@@ -0,0 +1,51 @@
+/**
+ * @file aic_fixed_config.hpp
+ * @brief Frozen gain configuration for certified airframes
+ * 
+ * Used when the module is built with AIC_FIXED_GAINS. Gains, saturation and
+ * inertia model become compile-time constants and the corresponding
+ * parameters (MC_*_P, MC_*RATE_P) are ignored.
+ * 
+ * Values below match the runtime defaults of the module; replace them with
+ * the certified values of the airframe.
+ */
+
+#pragma once
+
+#include "attitude_controller_aic.hpp"
+
+namespace attitude_controller_aic {
+
+struct AICFixedAirframeConfig {
+    // Attitude error gain
+    static constexpr float K_R_x = 5.0f;
+    static constexpr float K_R_y = 5.0f;
+    static constexpr float K_R_z = 3.0f;
+
+    // Angular velocity error gain
+    static constexpr float K_Omega_x = 0.3f;
+    static constexpr float K_Omega_y = 0.3f;
+    static constexpr float K_Omega_z = 0.2f;
+
+    // Robust damping gain
+    static constexpr float K_x = 0.1f;
+    static constexpr float K_y = 0.1f;
+    static constexpr float K_z = 0.1f;
+
+    // Composite error weight
+    static constexpr float c = 2.0f;
+
+    // Actuator saturation (Nm)
+    static constexpr float tau_max = 0.05f;
+
+    // Inertia model and nominal inertia (kg*m^2)
+    static constexpr bool use_diagonal = true;
+    static constexpr float J_xx = 0.040f;
+    static constexpr float J_yy = 0.040f;
+    static constexpr float J_zz = 0.025f;
+};
+
+// Instantiated in aic_core.cpp
+extern template class BasicAttitudeControllerAIC<FixedGains<AICFixedAirframeConfig>>;
+
+} // namespace attitude_controller_aic
@@ -0,0 +1,447 @@
+/**
+ * @file aic_module_core.hpp
+ * @brief Per-message tick pipeline of the AIC module, free of PX4 runtime dependencies
+ *
+ * Everything AttitudeControllerAICModule does between receiving an attitude
+ * message and publishing a torque:
+ *
+ *   vibration monitor -> first message -> governor decision -> dt (clamped)
+ *   -> filter bank design -> adaptation gating -> actuation state -> compute_torque
+ *   -> envelope monitor / fallback -> motor failure detection -> allocation
+ *
+ * Allocation is optional (motor_frame NONE: the torque goes to the flight
+ * stack's mixer). With it, a detected motor failure switches to the
+ * precomputed reduced allocation on the same tick and freezes adaptation.
+ *
+ * The PX4 module feeds it from uORB; the host SIL (tools/aic_sil) feeds it
+ * from a discrete-event timing model, so both run the same code under the
+ * same message timing.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include "rate_governor.hpp"
+#include "envelope_monitor.hpp"
+#include "filter_bank.hpp"
+#include "vibration_monitor.hpp"
+#include "motor_allocation.hpp"
+#include "motor_failure_detector.hpp"
+#include "capture_buffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+using Matrix3f = matrix::Matrix3f;
+using Quaternionf = matrix::Quaternionf;
+
+/**
+ * @brief Module-level settings (from AIC_* parameters)
+ */
+struct AICModuleConfig {
+    bool governor_enabled{true};
+    float filter_lowpass_hz{0.f};     // 0: legacy one-pole composite error filter
+    int notch_harmonics{0};
+    float notch_bandwidth_hz{20.f};
+    bool envelope_enabled{true};
+    bool vibration_gating{true};
+    float vibration_peak{0.2f};       // Sinusoid amplitude where gating starts (rad/s)
+    float vibration_broadband{0.3f};  // Noise level where gating starts (rad/s)
+    MotorFrame motor_frame{MotorFrame::NONE};
+    MotorGeometry motor_geometry;
+    bool failure_detection{true};
+    float failure_loss{0.5f};         // Missing fraction of a motor's torque that counts as failed
+    float failure_confirm_time{0.008f}; // Time the same motor must match (s)
+};
+
+/**
+ * @brief Latest vehicle state and setpoint as seen by one tick
+ */
+struct AICModuleInput {
+    Quaternionf q;          // Attitude
+    Vector3f omega;         // Body rates (rad/s)
+    Quaternionf q_d;        // Attitude setpoint
+    Vector3f omega_d;       // Rate setpoint (rad/s)
+    uint32_t setpoint_sequence{0}; // Changes with each new attitude or rate setpoint message (0: unknown, never cached)
+    float thrust{0.f};      // Collective thrust [0, 1] (motor allocation, extended model)
+    bool landed{false};
+};
+
+/**
+ * @brief Fill the setpoint of a tick from the attitude and rate setpoint messages
+ *
+ * The rate setpoint comes from the rate setpoint message: the Euler angles
+ * of the attitude setpoint are no rates, and as omega_d any heading would
+ * read as a rate error to the governor (AGILE for good).
+ *
+ * @tparam AttitudeSetpoint q_d[4], thrust_body[3] (vehicle_attitude_setpoint_s)
+ * @tparam RatesSetpoint roll, pitch, yaw (vehicle_rates_setpoint_s)
+ */
+template<typename AttitudeSetpoint, typename RatesSetpoint>
+void set_setpoint_input(AICModuleInput &input, const AttitudeSetpoint &attitude, const RatesSetpoint &rates) {
+    input.q_d = Quaternionf(attitude.q_d[0], attitude.q_d[1], attitude.q_d[2], attitude.q_d[3]);
+    input.omega_d = Vector3f(rates.roll, rates.pitch, rates.yaw);
+    input.thrust = std::max(0.f, std::min(-attitude.thrust_body[2], 1.f));
+}
+
+/**
+ * @brief Outcome of one tick
+ */
+struct AICTickStatus {
+    bool controlled{false};           // A torque was computed (publish it)
+    bool skipped{false};              // Message decimated by the rate governor
+    bool dt_clamped{false};           // Message interval outside [MIN_DT, MAX_DT]
+    bool fallback_engaged{false};     // Envelope violation switched to the fallback on this tick
+    bool fallback_released{false};    // Fallback released after landing on this tick
+    bool motor_failure_detected{false}; // Motor failure confirmed, reduced allocation from this tick
+    bool motor_failure_cleared{false};  // Latched motor failure cleared after landing on this tick
+    uint8_t trips{EnvelopeMonitor::TRIP_NONE};
+};
+
+/**
+ * @class AICModuleCore
+ * @brief Attitude message -> torque pipeline of the AIC module
+ *
+ * @tparam Controller BasicAttitudeControllerAIC configuration
+ */
+template<typename Controller>
+class AICModuleCore {
+public:
+    static constexpr float MIN_DT = 0.002f;   // 500 Hz
+    static constexpr float MAX_DT = 0.1f;     // 10 Hz
+
+    /**
+     * @brief Initialize the governor and monitor (the controller is initialized by the owner)
+     */
+    void init() {
+        rate_governor_.init();
+        rate_governor_.set_max_period(MAX_DT);  // Same bound as the dt clamp
+        envelope_monitor_.init();
+        vibration_monitor_.init();
+        failure_detector_.init();
+        reset_timing();
+    }
+
+    /**
+     * @brief Apply module-level settings
+     */
+    void configure(const AICModuleConfig &config) {
+        config_ = config;
+        vibration_monitor_.set_thresholds(config_.vibration_peak, config_.vibration_broadband);
+        failure_detector_.set_parameters(config_.failure_loss, config_.failure_confirm_time);
+
+        // Precomputes all reduced allocations; a latched failure stays in effect
+        allocation_.configure(config_.motor_frame, config_.motor_geometry);
+        allocation_.set_failed_motor(failure_detector_.get_failed_motor());
+
+        if (config_.filter_lowpass_hz <= 0.f) {
+            // Legacy one-pole composite error filter
+            controller_.set_filter_bandwidth(0.1f);
+        }
+    }
+
+    /**
+     * @brief Motor vibration fundamental from ESC RPM telemetry (Hz, 0 if unknown)
+     */
+    void set_rotor_frequency(float rotor_hz) {
+        rotor_hz_ = rotor_hz;
+    }
+
+    /**
+     * @brief Process one attitude message
+     *
+     * @param now_us time the module handles the message (us)
+     * @param input latest state and setpoint
+     * @param tau torque command, written if status.controlled
+     */
+    AICTickStatus update(uint64_t now_us, const AICModuleInput &input, Vector3f &tau) {
+        AICTickStatus status;
+
+        // Every message is a sample of the rate spectrum, whether or not it is controlled on
+        vibration_monitor_.update(input.omega(0), input.omega(1), input.omega(2));
+
+        if (last_message_us_ != 0 && now_us > last_message_us_) {
+            const float rate_hz = 1e6f / static_cast<float>(now_us - last_message_us_);
+            message_rate_hz_ = (message_rate_hz_ > 0.f) ? 0.99f * message_rate_hz_ + 0.01f * rate_hz : rate_hz;
+        }
+
+        last_message_us_ = now_us;
+
+        if (first_run_) {
+            last_run_us_ = now_us;
+            first_run_ = false;
+            return status;
+        }
+
+        // Skip this message if the current flight phase allows a lower rate
+        if (!governor_should_run(now_us, input)) {
+            status.skipped = true;
+            return status;
+        }
+
+        // Timestep spans all messages skipped by the governor
+        const float dt = static_cast<float>(now_us - last_run_us_) * 1e-6f;
+        last_run_us_ = now_us;
+        dt_ = (dt < MIN_DT) ? MIN_DT : ((dt > MAX_DT) ? MAX_DT : dt);   // No std::min/max: by reference ODR-uses them
+        status.dt_clamped = (dt_ != dt);
+
+        update_filter_bank();
+
+        // Vibration-corrupted axes do not adapt, nothing adapts after a motor failure
+        if (allocation_.failed_motor() >= 0) {
+            controller_.set_adaptation_scale(Vector3f(0.f, 0.f, 0.f));
+
+        } else if (config_.vibration_gating) {
+            controller_.set_adaptation_scale(Vector3f(vibration_monitor_.get_scale(0), vibration_monitor_.get_scale(1),
+                                                      vibration_monitor_.get_scale(2)));
+
+        } else {
+            controller_.set_adaptation_scale(Vector3f(1.f, 1.f, 1.f));
+        }
+
+        update_actuation(input);
+
+        const Matrix3f R = input.q.to_dcm();
+
+        // The setpoint arrives slower than the attitude: its terms are kept until the next one
+        if (input.setpoint_sequence == 0 || input.setpoint_sequence != setpoint_sequence_) {
+            R_d_ = input.q_d.to_dcm();
+            setpoint_sequence_ = input.setpoint_sequence;
+        }
+
+        // Desired angular acceleration (zero for nominal tracking)
+        tau = controller_.compute_torque(R, input.omega, R_d_, input.omega_d, Vector3f::Zero(), dt_,
+                                         input.setpoint_sequence);
+
+        // Envelope violations switch to the fallback before this command is published
+        if (config_.envelope_enabled) {
+            tau = check_envelope(R, input, tau, status);
+        }
+
+        if (allocation_.is_enabled()) {
+            allocate(input, tau, status);
+        }
+
+        rate_governor_.report_control(controller_.get_composite_error().norm(), controller_.is_saturated(),
+                                      controller_.get_rate_loop_gain());
+
+        status.controlled = true;
+        return status;
+    }
+
+    /**
+     * @brief Capture record of the tick that produced tau (status.controlled)
+     *
+     * @param compute_us time spent in update() (overrun detection)
+     */
+    void fill_capture_record(uint64_t now_us, const AICModuleInput &input, const Vector3f &tau,
+                             const AICTickStatus &status, uint32_t compute_us, CaptureRecord &record) const {
+        record.timestamp_us = now_us;
+        record.dt = dt_;
+
+        for (int i = 0; i < 4; ++i) {
+            record.q[i] = input.q(i);
+        }
+
+        const Matrix3f J_hat = controller_.get_inertia_estimate();
+
+        for (int i = 0; i < 3; ++i) {
+            record.omega[i] = input.omega(i);
+            record.omega_d[i] = input.omega_d(i);
+            record.e_R[i] = controller_.get_attitude_error()(i);
+            record.s[i] = controller_.get_composite_error()(i);
+            record.tau[i] = tau(i);
+            record.d_hat[i] = controller_.get_disturbance_estimate()(i);
+            record.J_diag[i] = J_hat(i, i);
+        }
+
+        record.excitation = controller_.get_window_excitation();
+        record.thrust = input.thrust;
+        record.compute_us = compute_us;
+        record.flags = static_cast<uint16_t>((controller_.is_saturated() ? CAPTURE_SATURATED : 0)
+                                             | (controller_.is_fallback_active() ? CAPTURE_FALLBACK : 0)
+                                             | (controller_.is_persistently_excited() ? CAPTURE_EXCITED : 0)
+                                             | (status.dt_clamped ? CAPTURE_DT_CLAMPED : 0));
+        record.triggers = 0;
+    }
+
+    /**
+     * @brief Restart timing (next message only initializes the time base)
+     */
+    void reset_timing() {
+        first_run_ = true;
+        last_run_us_ = 0;
+        dt_ = 0.01f;
+        control_rate_hz_ = 0.f;
+        last_message_us_ = 0;
+        message_rate_hz_ = 0.f;
+        base_skipped_ = 0;
+        motor_outputs_valid_ = false;
+        last_q_d_ = Quaternionf();
+        last_omega_d_ = Vector3f::Zero();
+    }
+
+    Controller &controller() { return controller_; }
+    const Controller &controller() const { return controller_; }
+    RateGovernor &rate_governor() { return rate_governor_; }
+    const RateGovernor &rate_governor() const { return rate_governor_; }
+    EnvelopeMonitor &envelope_monitor() { return envelope_monitor_; }
+    const EnvelopeMonitor &envelope_monitor() const { return envelope_monitor_; }
+    const VibrationMonitor &vibration_monitor() const { return vibration_monitor_; }
+    const MotorAllocation &allocation() const { return allocation_; }
+    const MotorFailureDetector &motor_failure_detector() const { return failure_detector_; }
+
+    /**
+     * @brief Motor commands of the last controlled tick (allocation().motor_count() entries)
+     */
+    const float *motor_outputs() const { return motor_outputs_; }
+
+    float get_dt() const { return dt_; }
+    float get_control_rate() const { return control_rate_hz_; }
+    float get_message_rate() const { return message_rate_hz_; }
+    const AICModuleConfig &get_config() const { return config_; }
+
+private:
+    bool governor_should_run(uint64_t now_us, const AICModuleInput &input) {
+        if (!config_.governor_enabled) {
+            // Only the base divider the CPU budget asks for, within the stability bound
+            rate_governor_.observe_message(now_us);
+
+            if (++base_skipped_ < rate_governor_.stable_base_divider()) {
+                return false;
+            }
+
+            base_skipped_ = 0;
+            return true;
+        }
+
+        // Setpoint change since the last control update (cheap, evaluated on every message)
+        const float setpoint_change = (1.f - std::fabs(input.q_d.dot(last_q_d_)))
+                                      + (input.omega_d - last_omega_d_).norm();
+
+        // Rate tracking error as a disturbance proxy between control updates
+        const float rate_error = (input.omega - input.omega_d).norm();
+
+        if (rate_governor_.update(now_us, input.landed, setpoint_change, rate_error)) {
+            last_q_d_ = input.q_d;
+            last_omega_d_ = input.omega_d;
+            return true;
+        }
+
+        return false;
+    }
+
+    void update_filter_bank() {
+        // Filter bank is designed for the actual controller update rate (changes with the governor divider)
+        const float rate_hz = 1.f / dt_;
+        control_rate_hz_ = (control_rate_hz_ > 0.f) ? 0.9f * control_rate_hz_ + 0.1f * rate_hz : rate_hz;
+
+        // Coefficients are only recomputed when the frequencies or the rate move
+        if (config_.filter_lowpass_hz > 0.f) {
+            controller_.set_filter_lowpass(config_.filter_lowpass_hz, control_rate_hz_);
+        }
+
+        for (int i = 0; i < FilterBank::MAX_NOTCHES; ++i) {
+            const float center_hz = (i < config_.notch_harmonics) ? (i + 1) * rotor_hz_ : 0.f;
+            controller_.set_filter_notch(i, center_hz, config_.notch_bandwidth_hz, control_rate_hz_);
+        }
+    }
+
+    /**
+     * @brief Thrust and rotor speeds for the extended model
+     *
+     * With allocation the thrust is converted to N and the rotor speeds
+     * follow the previous motor commands; without it the thrust stays
+     * normalized and the rotor speeds are unknown (zero).
+     */
+    void update_actuation(const AICModuleInput &input) {
+        if (allocation_.is_enabled()) {
+            controller_.set_actuation(input.thrust * allocation_.max_thrust(),
+                                      motor_outputs_valid_ ? allocation_.rotor_momentum(motor_outputs_) : 0.f);
+
+        } else {
+            controller_.set_actuation(input.thrust, 0.f);
+        }
+    }
+
+    Vector3f check_envelope(const Matrix3f &R, const AICModuleInput &input, const Vector3f &tau,
+                            AICTickStatus &status) {
+        // The fallback stays latched for the rest of the flight
+        if (input.landed && controller_.is_fallback_active()) {
+            controller_.release_fallback();
+            envelope_monitor_.clear();
+            status.fallback_released = true;
+            return tau;
+        }
+
+        status.trips = envelope_monitor_.update(R, input.omega, controller_.get_attitude_error(), tau,
+                                                controller_.is_estimate_at_bound(), !input.landed, dt_);
+
+        if (status.trips != EnvelopeMonitor::TRIP_NONE && !controller_.is_fallback_active()) {
+            status.fallback_engaged = true;
+            return controller_.engage_fallback();
+        }
+
+        return tau;
+    }
+
+    void allocate(const AICModuleInput &input, const Vector3f &tau, AICTickStatus &status) {
+        // The motor stays failed for the rest of the flight
+        if (input.landed && allocation_.failed_motor() >= 0) {
+            failure_detector_.reset();
+            allocation_.set_failed_motor(-1);
+            status.motor_failure_cleared = true;
+        }
+
+        // Torque the previous commands should have produced against the torque the motion shows
+        if (config_.failure_detection && !input.landed && motor_outputs_valid_
+            && controller_.is_model_torque_valid()) {
+            const Vector3f residual = allocation_.torque(motor_outputs_) - controller_.get_model_torque();
+
+            if (failure_detector_.update(residual, allocation_, motor_outputs_, dt_)) {
+                allocation_.set_failed_motor(failure_detector_.get_failed_motor());
+                status.motor_failure_detected = true;
+            }
+        }
+
+        allocation_.allocate(tau, input.thrust, motor_outputs_);
+        motor_outputs_valid_ = true;
+    }
+
+    Controller controller_;
+    RateGovernor rate_governor_;
+    EnvelopeMonitor envelope_monitor_;
+    VibrationMonitor vibration_monitor_;
+    MotorAllocation allocation_;
+    MotorFailureDetector failure_detector_;
+    AICModuleConfig config_;
+
+    // Timing
+    bool first_run_{true};
+    uint64_t last_run_us_{0};
+    float dt_{0.01f};
+    float control_rate_hz_{0.f};   // Filtered controller update rate (filter bank design rate)
+    uint64_t last_message_us_{0};
+    float message_rate_hz_{0.f};   // Filtered attitude message rate (vibration monitor sample rate)
+    int base_skipped_{0};          // Messages since the last control update without the governor
+
+    // Composite error filter bank: motor vibration fundamental (Hz)
+    float rotor_hz_{0.f};
+
+    // Motor commands of the last controlled tick (failure residual)
+    float motor_outputs_[MotorAllocation::MAX_MOTORS]{};
+    bool motor_outputs_valid_{false};
+
+    // Setpoint used by the last control update (rate governor change detection)
+    Quaternionf last_q_d_;
+    Vector3f last_omega_d_;
+
+    // Desired attitude of the setpoint message setpoint_sequence_
+    Matrix3f R_d_;
+    uint32_t setpoint_sequence_{0};
+};
+
+} // namespace attitude_controller_aic
@@ -3,13 +3,19 @@
  * @brief Composite attitude controller combining geometric PD, adaptive feedforward, and robust damping
  * 
  * Implements the complete control law:
- * tau = -K_R * e_R - K_Omega * e_Omega + Y * theta_hat - K * s + tau_ee
+ * tau = -K_R * e_R - K_Omega * e_Omega + Y * theta_hat - K * s + d_hat + tau_ee
  * 
  * where:
  * - Geometric PD: -K_R * e_R - K_Omega * e_Omega
- * - Adaptive feedforward: Y * theta_hat (learned inertia compensation)
+ * - Adaptive feedforward: Y * theta_hat (learned inertia compensation, optionally
+ *   with CoM offset, yaw drag and rotor inertia: set_extended_model())
  * - Robust damping: -K * s (attenuates unmodeled effects and noise)
+ * - Disturbance compensation: d_hat (low-pass filtered torque residual, optional)
  * - Internal excitation: tau_ee (activates when information is insufficient)
+ * 
+ * A latched fallback mode (engage_fallback()) replaces the law with geometric
+ * PD plus rigid-body feedforward at the fixed nominal inertia, with adaptation
+ * and disturbance compensation frozen.
  */
 
 #pragma once
@@ -18,8 +24,11 @@
 #include "so3_utils.hpp"
 #include "regressor.hpp"
 #include "iwg_adapter.hpp"
+#include "control_gains.hpp"
+#include "filter_bank.hpp"
 #include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 namespace attitude_controller_aic {
 
@@ -28,43 +37,24 @@ using Matrix3f = matrix::Matrix3f;
 using Quaternionf = matrix::Quaternionf;
 
 /**
- * @class AttitudeControllerAIC
+ * @class BasicAttitudeControllerAIC
  * @brief Adaptive Inertia-aware Composite attitude controller on SO(3)
+ * 
+ * @tparam Gains gain policy: RuntimeGains (parameter-configurable) or
+ *               FixedGains<Config> (compile-time constants, see control_gains.hpp)
  */
-class AttitudeControllerAIC {
+template<typename Gains>
+class BasicAttitudeControllerAIC {
 public:
     /**
      * @brief Initialize controller
      * 
      * @param J_init initial inertia estimate
      * @param use_diagonal use diagonal inertia model if true, else full symmetric
+     *                     (ignored with FixedGains, the model is part of the configuration)
      * @param use_iwg use information-weighted gradient if true, else standard gradient
      */
-    void init(const Matrix3f &J_init, bool use_diagonal = true, bool use_iwg = true) {
-        use_diagonal_ = use_diagonal;
-        use_iwg_ = use_iwg;
-        
-        if (use_iwg_) {
-            iwg_adapter_.init(J_init, use_diagonal);
-        } else {
-            // Use basic adaptive estimator instead
-            // (implementation would be similar but without IWG)
-        }
-        
-        // Set default control gains (tuning dependent)
-        // These values are conservative; tune based on vehicle dynamics
-        K_R_ = Vector3f(5.0f, 5.0f, 3.0f);           // Attitude error gain
-        K_Omega_ = Vector3f(0.3f, 0.3f, 0.2f);       // Angular velocity error gain
-        K_ = Vector3f(0.1f, 0.1f, 0.1f);             // Robust damping gain
-        c_ = 2.0f;                                     // Composite error weight
-        
-        // Actuator saturation (Nm)
-        tau_max_ = 0.05f;
-        
-        // Composite error smoothing (low-pass filter for noise rejection)
-        s_filter_alpha_ = 0.1f;  // Filter coefficient (larger = more smoothing)
-        s_filtered_ = Vector3f::Zero();
-    }
+    void init(const Matrix3f &J_init, bool use_diagonal = true, bool use_iwg = true);
 
     /**
      * @brief Set control gains
@@ -74,12 +64,10 @@ public:
      * @param K robust damping gain (diagonal elements)
      * @param c composite error weight
      */
+    template<typename G = Gains, typename = typename std::enable_if<!G::is_fixed>::type>
     void set_control_gains(const Vector3f &K_R, const Vector3f &K_Omega,
                           const Vector3f &K, float c) {
-        K_R_ = K_R;
-        K_Omega_ = K_Omega;
-        K_ = K;
-        c_ = c;
+        gains_.set_control_gains(K_R, K_Omega, K, c);
     }
 
     /**
@@ -97,6 +85,94 @@ public:
         }
     }
 
+    /**
+     * @brief Add CoM offset, yaw drag and rotor inertia to the adaptive model
+     * 
+     * The CoM offset columns need the collective thrust and the rotor
+     * inertia column the rotor speeds (set_actuation()); without them these
+     * parameters see no excitation and stay at zero. Switching restarts the
+     * adaptation from the current inertia estimate.
+     */
+    void set_extended_model(bool enable, const ExtendedBounds &bounds = ExtendedBounds()) {
+        iwg_adapter_.set_extended_bounds(bounds);
+        iwg_adapter_.set_extended(enable);
+    }
+
+    bool is_extended_model() const {
+        return iwg_adapter_.is_extended();
+    }
+
+    /**
+     * @brief Switch between the diagonal and the full symmetric inertia model
+     * 
+     * Restarts the adaptation from the current inertia estimate; the gains
+     * are kept (unlike init()).
+     */
+    template<typename G = Gains, typename = typename std::enable_if<!G::is_fixed>::type>
+    void set_inertia_model(bool use_diagonal) {
+        gains_.set_inertia_model(use_diagonal);
+        iwg_adapter_.set_diagonal(use_diagonal);
+    }
+
+    bool is_diagonal_model() const {
+        return gains_.use_diagonal();
+    }
+
+    /**
+     * @brief Actuation state for the extended model columns (held until the next call)
+     * 
+     * @param thrust collective thrust along body -z (N; normalized thrust gives the
+     *               CoM offset in Nm at full thrust)
+     * @param rotor_momentum signed sum of rotor speeds along body +z (rad/s)
+     */
+    void set_actuation(float thrust, float rotor_momentum) {
+        thrust_ = std::isfinite(thrust) ? thrust : 0.f;
+        rotor_momentum_ = std::isfinite(rotor_momentum) ? rotor_momentum : 0.f;
+    }
+
+    /**
+     * @brief Extended model estimates: CoM offset (r_x, r_y, 0), yaw drag, rotor inertia
+     */
+    Vector3f get_com_offset_estimate() const {
+        return iwg_adapter_.get_com_offset();
+    }
+
+    float get_yaw_drag_estimate() const {
+        return iwg_adapter_.get_yaw_drag();
+    }
+
+    float get_rotor_inertia_estimate() const {
+        return iwg_adapter_.get_rotor_inertia();
+    }
+
+    /**
+     * @brief Configure the sliding information window and the estimation mode
+     * 
+     * The window collects the measured angular acceleration against the
+     * applied torque (both through the same low-pass, which keeps the model
+     * linear in the filtered signals). Persistent excitation is then judged
+     * on the recent window instead of everything since the last reset, and
+     * WINDOWED_LS pulls the estimate toward the window's least-squares fit.
+     * 
+     * @param window_length window length (s), 0 disables the window
+     * @param mode estimation mode
+     * @param pe_threshold excitation threshold ((rad/s^2)^2, see IWGAdapter::set_information_window())
+     */
+    void set_information_window(float window_length, EstimatorMode mode, float pe_threshold) {
+        iwg_adapter_.set_information_window(window_length, mode, pe_threshold);
+    }
+
+    /**
+     * @brief Excitation of the information window ((rad/s^2)^2)
+     */
+    float get_window_excitation() const {
+        return iwg_adapter_.get_window_excitation();
+    }
+
+    EstimatorMode get_estimator_mode() const {
+        return iwg_adapter_.get_mode();
+    }
+
     /**
      * @brief Compute attitude control torque
      * 
@@ -113,76 +189,46 @@ public:
     Vector3f compute_torque(const Matrix3f &R, const Vector3f &Omega,
                            const Matrix3f &R_d, const Vector3f &Omega_d,
                            const Vector3f &dot_Omega_d, float dt) {
-        // 1. Compute attitude errors
-        Vector3f e_R = SO3Utils::attitude_error(R, R_d);
-        Vector3f e_Omega = SO3Utils::angular_velocity_error(Omega, R, R_d, Omega_d);
-        
-        // 2. Compute composite error: s = e_Omega + c * e_R
-        Vector3f s = e_Omega + c_ * e_R;
-        
-        // Low-pass filter composite error (noise rejection)
-        s_filtered_ = s_filter_alpha_ * s + (1.f - s_filter_alpha_) * s_filtered_;
-        
-        // 3. Compute body-frame commanded angular acceleration
-        Vector3f alpha = SO3Utils::commanded_angular_accel(R, R_d, Omega, Omega_d, dot_Omega_d);
-        
-        // 4. Get regressor matrix Y(Omega, alpha)
-        Vector3f tau_adaptive;
-        if (use_diagonal_) {
-            auto Y = Regressor::regressor_diagonal(Omega, alpha);
-            
-            // 5. Update adaptive parameters and get estimate
-            if (use_iwg_) {
-                iwg_adapter_.update_diagonal(Y, s_filtered_, dt);
-            }
-            
-            // Get inertia estimate
-            Matrix3f J_hat = iwg_adapter_.get_inertia_estimate();
-            
-            // Compute adaptive feedforward: Y * J_hat parameters
-            matrix::Vector<float, 3> theta_hat;
-            theta_hat(0) = J_hat(0, 0);
-            theta_hat(1) = J_hat(1, 1);
-            theta_hat(2) = J_hat(2, 2);
-            tau_adaptive = Y * theta_hat;
-        } else {
-            auto Y = Regressor::regressor_full(Omega, alpha);
-            
-            if (use_iwg_) {
-                iwg_adapter_.update_full(Y, s_filtered_, dt);
-            }
-            
-            Matrix3f J_hat = iwg_adapter_.get_inertia_estimate();
-            
-            matrix::Vector<float, 6> theta_hat;
-            theta_hat(0) = J_hat(0, 0);
-            theta_hat(1) = J_hat(1, 1);
-            theta_hat(2) = J_hat(2, 2);
-            theta_hat(3) = J_hat(0, 1);
-            theta_hat(4) = J_hat(0, 2);
-            theta_hat(5) = J_hat(1, 2);
-            tau_adaptive = Y * theta_hat;
-        }
-        
-        // 6. Compute geometric PD feedback
-        Vector3f tau_pd;
-        for (int i = 0; i < 3; ++i) {
-            tau_pd(i) = -K_R_(i) * e_R(i) - K_Omega_(i) * e_Omega(i);
-        }
-        
-        // 7. Compute robust damping term
-        Vector3f tau_robust;
-        for (int i = 0; i < 3; ++i) {
-            tau_robust(i) = -K_(i) * s_filtered_(i);
-        }
-        
-        // 8. Compose total torque: tau = tau_pd + tau_adaptive + tau_robust
-        Vector3f tau = tau_pd + tau_adaptive + tau_robust;
-        
-        // 9. Apply actuator saturation
-        tau = saturate(tau, tau_max_);
-        
-        return tau;
+        return compute_torque(R, Omega, R_d, Omega_d, dot_Omega_d, dt, 0);
+    }
+
+    /**
+     * @brief Compute attitude control torque, reusing the terms of an unchanged setpoint
+     * 
+     * The setpoint usually arrives slower than the loop runs. Its terms
+     * (R_d^T, R_d * Omega_d, R_d * dot_Omega_d) are only recomputed when
+     * setpoint_sequence differs from the previous call, so per tick only the
+     * state-dependent products remain:
+     * E * Omega_d = R^T * (R_d * Omega_d), E * dot_Omega_d = R^T * (R_d * dot_Omega_d).
+     * 
+     * @param setpoint_sequence counter of the attitude and rate setpoint messages R_d, Omega_d and
+     *                          dot_Omega_d come from; 0 if unknown (always recomputed)
+     */
+    Vector3f compute_torque(const Matrix3f &R, const Vector3f &Omega,
+                           const Matrix3f &R_d, const Vector3f &Omega_d,
+                           const Vector3f &dot_Omega_d, float dt, uint32_t setpoint_sequence);
+
+    /**
+     * @brief Warm start from an inertia prior (e.g. the fleet prior of this airframe and payload)
+     * 
+     * Restarts the adaptation from J_prior with the prior information in
+     * place of the uninformative initial information matrix. Both are kept
+     * across reset() and release_fallback(); J_prior also becomes the
+     * nominal inertia of the fallback law.
+     * 
+     * @param information initial information [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz]
+     */
+    void set_inertia_prior(const Matrix3f &J_prior, const float information[6]) {
+        J_nominal_ = J_prior;
+        iwg_adapter_.set_prior_information(information);
+        reset(J_prior);
+    }
+
+    /**
+     * @brief Information gathered since the last reset, without the prior (estimator records)
+     */
+    void get_gathered_information(float information[6]) const {
+        iwg_adapter_.get_gathered_information(information);
     }
 
     /**
@@ -207,19 +253,184 @@ public:
         return iwg_adapter_.get_information_determinant();
     }
 
+    /**
+     * @brief Variance of the inertia estimate [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz] (EKF mode only)
+     *
+     * @return false if the estimator gives no covariance
+     */
+    bool get_inertia_variance(float variance[6]) const {
+        return iwg_adapter_.get_inertia_variance(variance);
+    }
+
+    /**
+     * @brief Gyro innovations rejected by the EKF estimator since the last reset
+     */
+    uint32_t get_ekf_rejections() const {
+        return iwg_adapter_.get_ekf_rejections();
+    }
+
+    /**
+     * @brief EKF rate restarts after a run of rejected innovations since the last reset
+     */
+    uint32_t get_ekf_resyncs() const {
+        return iwg_adapter_.get_ekf_resyncs();
+    }
+
+    /**
+     * @brief Noise model of the EKF estimator (see IWGAdapter::set_ekf_noise())
+     */
+    void set_ekf_noise(float gyro_noise, float acceleration_noise) {
+        iwg_adapter_.set_ekf_noise(gyro_noise, acceleration_noise);
+    }
+
+    /**
+     * @brief Flip one bit of the estimator state: theta, then the information matrix, or the EKF state
+     *        (fault injection)
+     *
+     * @param word 0..get_estimator_state_words() - 1, others are ignored
+     */
+    void flip_estimator_bit(int word, int bit) {
+        iwg_adapter_.flip_state_bit(word, bit);
+    }
+
+    int get_estimator_state_words() const {
+        return iwg_adapter_.get_state_words();
+    }
+
+    /**
+     * @brief Per-axis adaptation scale from the vibration monitor (1: normal, 0: frozen)
+     */
+    void set_adaptation_scale(const Vector3f &scale) {
+        iwg_adapter_.set_axis_weights(scale);
+    }
+
+    /**
+     * @brief Check whether the inertia estimate is pinned at its projection bounds
+     */
+    bool is_estimate_at_bound() const {
+        return iwg_adapter_.is_at_bound();
+    }
+
+    /**
+     * @brief Switch to the fixed-inertia PD fallback (latched)
+     * 
+     * Recomputes the command of the last compute_torque() call from its
+     * cached errors, so the fallback takes effect within the same control
+     * tick. Later compute_torque() calls use the fallback law until
+     * release_fallback().
+     * 
+     * @return fallback torque command for the last update (Nm)
+     */
+    Vector3f engage_fallback() {
+        fallback_active_ = true;
+        return fallback_torque();
+    }
+
+    /**
+     * @brief Leave the fallback and restart adaptation from the nominal inertia
+     */
+    void release_fallback() {
+        fallback_active_ = false;
+        reset(J_nominal_);
+    }
+
+    bool is_fallback_active() const {
+        return fallback_active_;
+    }
+
+    /**
+     * @brief Get attitude error from the last update
+     */
+    const Vector3f &get_attitude_error() const {
+        return e_R_;
+    }
+
+    /**
+     * @brief Check whether the last torque command hit the saturation limit
+     */
+    bool is_saturated() const {
+        return saturated_;
+    }
+
+    /**
+     * @brief Get filtered composite error from the last update
+     */
+    const Vector3f &get_composite_error() const {
+        return s_filtered_;
+    }
+
+    /**
+     * @brief Largest per-axis rate-loop gain (K_Omega + K) / J_hat
+     * 
+     * Used to check that a given control period keeps the discretized
+     * rate loop stable: the forward-Euler pole 1 - gain*dt must stay inside
+     * the unit circle, i.e. gain*dt < 2.
+     * 
+     * @return rate-loop gain (1/s)
+     */
+    float get_rate_loop_gain() const {
+        Matrix3f J_hat = iwg_adapter_.get_inertia_estimate();
+        float gain = 0.f;
+        for (int i = 0; i < 3; ++i) {
+            gain = std::max(gain, (gains_.K_Omega(i) + gains_.K(i)) / std::max(J_hat(i, i), 1e-6f));
+        }
+        return gain;
+    }
+
     /**
      * @brief Reset controller state
      */
-    void reset(const Matrix3f &J_init) {
-        iwg_adapter_.reset(J_init);
-        s_filtered_ = Vector3f::Zero();
+    void reset(const Matrix3f &J_init);
+
+    /**
+     * @brief Configure the disturbance torque observer
+     * 
+     * d_hat = LPF(tau_applied - Y(Omega, alpha_meas) * theta_hat)
+     * 
+     * The model torque at the measured acceleration reuses the adaptive
+     * feedforward already evaluated for the commanded acceleration: the
+     * regressor is linear in alpha, so
+     * Y(Omega, alpha_meas) * theta_hat = Y(Omega, alpha) * theta_hat + J_hat * (alpha_meas - alpha).
+     * 
+     * @param enable add d_hat to the control law if true
+     * @param time_constant low-pass time constant of the estimate (s)
+     */
+    void set_disturbance_observer(bool enable, float time_constant) {
+        dob_enabled_ = enable;
+        dob_time_constant_ = std::max(0.001f, time_constant);
+        
+        if (!dob_enabled_) {
+            d_hat_ = Vector3f::Zero();
+        }
+    }
+
+    /**
+     * @brief Get current disturbance compensation torque estimate (Nm)
+     */
+    const Vector3f &get_disturbance_estimate() const {
+        return d_hat_;
+    }
+
+    /**
+     * @brief Torque explaining the motion since the previous update: Y(Omega, alpha_meas) * theta_hat (Nm)
+     * 
+     * Only valid if is_model_torque_valid(): the adaptive law ran on this and
+     * the previous update (not in the fallback).
+     */
+    const Vector3f &get_model_torque() const {
+        return tau_model_;
+    }
+
+    bool is_model_torque_valid() const {
+        return model_torque_valid_;
     }
 
     /**
      * @brief Set actuator saturation limit
      */
+    template<typename G = Gains, typename = typename std::enable_if<!G::is_fixed>::type>
     void set_saturation_limit(float tau_max) {
-        tau_max_ = std::max(0.01f, tau_max);  // Ensure positive
+        gains_.set_saturation_limit(tau_max);
     }
 
     /**
@@ -227,7 +438,38 @@ public:
      * @param alpha filter coefficient (0-1, larger = faster response)
      */
     void set_filter_bandwidth(float alpha) {
-        s_filter_alpha_ = std::max(0.0f, std::min(alpha, 1.0f));
+        s_filter_.set_first_order_lowpass(alpha);
+    }
+
+    /**
+     * @brief Use a second-order Butterworth low-pass on the composite error
+     * @param cutoff_hz cutoff frequency (Hz)
+     * @param sample_rate_hz controller update rate (Hz)
+     */
+    void set_filter_lowpass(float cutoff_hz, float sample_rate_hz) {
+        s_filter_.set_lowpass(cutoff_hz, sample_rate_hz);
+    }
+
+    /**
+     * @brief Place a composite error notch (e.g. at a motor vibration peak)
+     * 
+     * Coefficients are only recomputed when the frequency moves, so this can
+     * be called whenever a new RPM or peak frequency is received.
+     * 
+     * @param index notch index (0 .. FilterBank::MAX_NOTCHES-1)
+     * @param center_hz notch center frequency (Hz), <= 0 disables the notch
+     * @param bandwidth_hz notch bandwidth (Hz)
+     * @param sample_rate_hz controller update rate (Hz)
+     */
+    void set_filter_notch(int index, float center_hz, float bandwidth_hz, float sample_rate_hz) {
+        s_filter_.set_notch(index, center_hz, bandwidth_hz, sample_rate_hz);
+    }
+
+    /**
+     * @brief Get active notch center frequency (0 if disabled)
+     */
+    float get_filter_notch_frequency(int index) const {
+        return s_filter_.get_notch_frequency(index);
     }
 
 private:
@@ -248,25 +490,277 @@ private:
         return tau_sat;
     }
 
+    /**
+     * @brief Fixed-inertia PD law on the errors cached by the last update
+     * 
+     * tau = -K_R * e_R - K_Omega * e_Omega + J_0 * alpha + Omega x (J_0 * Omega)
+     * 
+     * Non-finite components (e.g. from a corrupted measurement) are zeroed.
+     */
+    Vector3f fallback_torque() {
+        Vector3f tau = J_nominal_ * alpha_ + Omega_.cross(J_nominal_ * Omega_);
+        
+        for (int i = 0; i < 3; ++i) {
+            tau(i) += -gains_.K_R(i) * e_R_(i) - gains_.K_Omega(i) * e_Omega_(i);
+            
+            if (!std::isfinite(tau(i))) {
+                tau(i) = 0.f;
+            }
+        }
+        
+        tau = saturate(tau, gains_.tau_max());
+        saturated_ = false;
+        for (int i = 0; i < 3; ++i) {
+            saturated_ = saturated_ || (std::abs(tau(i)) >= gains_.tau_max());
+        }
+        
+        // The observer residual is meaningless across a law switch
+        tau_applied_ = tau;
+        dob_valid_ = false;
+        model_torque_valid_ = false;
+        window_filter_valid_ = false;
+        d_hat_ = Vector3f::Zero();
+        
+        return tau;
+    }
+
     // Adaptive estimator (IWG)
     IWGAdapter iwg_adapter_;
     
-    // Control gains
-    Vector3f K_R_;        // Attitude error gain
-    Vector3f K_Omega_;    // Angular velocity gain
-    Vector3f K_;          // Robust damping gain
-    float c_{2.0f};       // Composite error weight
-    
-    // Actuator constraints
-    float tau_max_{0.05f};
+    // Control gains, actuator constraints and inertia model
+    Gains gains_;
     
     // Filtering for noise rejection
     Vector3f s_filtered_;
-    float s_filter_alpha_{0.1f};
+    FilterBank s_filter_;
+    
+    // Status of the last command
+    bool saturated_{false};
+    
+    // Disturbance observer
+    Vector3f d_hat_;             // Disturbance compensation torque (Nm)
+    Vector3f tau_applied_;       // Last (saturated) torque command
+    Vector3f Omega_prev_;        // Angular velocity at the last update
+    bool dob_valid_{false};      // Omega_prev_ and tau_applied_ hold a previous update
+    bool dob_enabled_{false};
+    float dob_time_constant_{0.05f};
+    Vector3f tau_model_;         // Model torque at the measured acceleration
+    bool model_torque_valid_{false};
+    
+    // Information window samples: measured acceleration and applied torque, same low-pass
+    static constexpr float WINDOW_FILTER_TIME_CONSTANT = 0.02f;
+    Vector3f alpha_meas_filtered_;
+    Vector3f tau_applied_filtered_;
+    bool window_filter_valid_{false};
+    
+    // Actuation state of the extended model
+    float thrust_{0.f};
+    float rotor_momentum_{0.f};
+    float rotor_momentum_prev_{0.f};
+    
+    // Envelope fallback: nominal inertia and the errors of the last update
+    Matrix3f J_nominal_;
+    Vector3f e_R_;
+    Vector3f e_Omega_;
+    Vector3f alpha_;
+    Vector3f Omega_;
+    bool fallback_active_{false};
+    
+    // Setpoint terms, kept while the setpoint message is unchanged
+    void update_setpoint_terms(const Matrix3f &R_d, const Vector3f &Omega_d, const Vector3f &dot_Omega_d) {
+        R_d_T_ = R_d.transpose();
+        Omega_d_world_ = R_d * Omega_d;
+        dot_Omega_d_world_ = R_d * dot_Omega_d;
+    }
+    
+    Matrix3f R_d_T_;
+    Vector3f Omega_d_world_;        // R_d * Omega_d
+    Vector3f dot_Omega_d_world_;    // R_d * dot_Omega_d
+    uint32_t setpoint_sequence_{0}; // 0: no terms cached
     
     // Configuration
-    bool use_diagonal_{true};
     bool use_iwg_{true};
 };
 
+template<typename Gains>
+void BasicAttitudeControllerAIC<Gains>::init(const Matrix3f &J_init, bool use_diagonal, bool use_iwg) {
+    // Set default control gains (tuning dependent)
+    gains_.init(use_diagonal);
+    use_iwg_ = use_iwg;
+    J_nominal_ = J_init;
+    fallback_active_ = false;
+    setpoint_sequence_ = 0;
+    
+    if (use_iwg_) {
+        iwg_adapter_.init(J_init, gains_.use_diagonal(), iwg_adapter_.is_extended());
+    } else {
+        // Use basic adaptive estimator instead
+        // (implementation would be similar but without IWG)
+    }
+    
+    // Composite error smoothing (one-pole low-pass alpha = 0.1, no notches)
+    s_filter_.init();
+    s_filtered_ = Vector3f::Zero();
+    
+    d_hat_ = Vector3f::Zero();
+    dob_valid_ = false;
+    tau_model_ = Vector3f::Zero();
+    model_torque_valid_ = false;
+    window_filter_valid_ = false;
+    thrust_ = 0.f;
+    rotor_momentum_ = 0.f;
+    rotor_momentum_prev_ = 0.f;
+    
+    e_R_ = Vector3f::Zero();
+    e_Omega_ = Vector3f::Zero();
+    alpha_ = Vector3f::Zero();
+    Omega_ = Vector3f::Zero();
+}
+
+template<typename Gains>
+Vector3f BasicAttitudeControllerAIC<Gains>::compute_torque(const Matrix3f &R, const Vector3f &Omega,
+                                                          const Matrix3f &R_d, const Vector3f &Omega_d,
+                                                          const Vector3f &dot_Omega_d, float dt,
+                                                          uint32_t setpoint_sequence) {
+    if (setpoint_sequence == 0 || setpoint_sequence != setpoint_sequence_) {
+        update_setpoint_terms(R_d, Omega_d, dot_Omega_d);
+        setpoint_sequence_ = setpoint_sequence;
+    }
+    
+    // 1. Compute attitude errors (SO3Utils::attitude_error() and angular_velocity_error()
+    //    on the cached setpoint terms)
+    const Matrix3f R_T = R.transpose();
+    const Matrix3f R_error = R_d_T_ * R;
+    Vector3f e_R = 0.5f * SO3Utils::vee(R_error - R_error.transpose());
+    const Vector3f Omega_d_body = R_T * Omega_d_world_;
+    Vector3f e_Omega = Omega - Omega_d_body;
+    
+    // 2. Compute composite error: s = e_Omega + c * e_R
+    Vector3f s = e_Omega + gains_.c() * e_R;
+    
+    // Filter composite error (noise and vibration rejection)
+    s_filtered_ = s_filter_.apply(s);
+    
+    // 3. Compute body-frame commanded angular acceleration
+    //    (SO3Utils::commanded_angular_accel(): E * dot_Omega_d - Omega x (E * Omega_d))
+    Vector3f alpha = R_T * dot_Omega_d_world_ - Omega.cross(Omega_d_body);
+    
+    // Cache for the envelope monitor and the fallback law
+    e_R_ = e_R;
+    e_Omega_ = e_Omega;
+    alpha_ = alpha;
+    Omega_ = Omega;
+    
+    if (fallback_active_) {
+        return fallback_torque();
+    }
+    
+    // 4. Regressor variables (the extended columns use thrust and rotor momentum)
+    RegressorInput x;
+    x.Omega = Omega;
+    x.alpha = alpha;
+    x.thrust = thrust_;
+    x.rotor_momentum = rotor_momentum_;
+    x.rotor_momentum_rate = (dob_valid_ && dt > 0.f) ? (rotor_momentum_ - rotor_momentum_prev_) / dt : 0.f;
+    rotor_momentum_prev_ = rotor_momentum_;
+    
+    // 5. Update adaptive parameters and compute the adaptive feedforward Y * theta_hat
+    //    (one regressor evaluation of the selected layout for both). The EKF mode
+    //    first filters the rates against the torque applied since the last tick.
+    if (use_iwg_) {
+        iwg_adapter_.filter(Omega, tau_applied_, dob_valid_ ? dt : 0.f);
+    }
+    
+    Vector3f tau_adaptive = use_iwg_ ? iwg_adapter_.update(x, s_filtered_, dt) : iwg_adapter_.model_torque(x);
+    Matrix3f J_hat = iwg_adapter_.get_inertia_estimate();
+    
+    // 6. Compute geometric PD feedback
+    Vector3f tau_pd;
+    for (int i = 0; i < 3; ++i) {
+        tau_pd(i) = -gains_.K_R(i) * e_R(i) - gains_.K_Omega(i) * e_Omega(i);
+    }
+    
+    // 7. Compute robust damping term
+    Vector3f tau_robust;
+    for (int i = 0; i < 3; ++i) {
+        tau_robust(i) = -gains_.K(i) * s_filtered_(i);
+    }
+    
+    // 8. Disturbance observer: residual between the applied torque and the
+    //    model torque at the measured acceleration (shares Y * theta_hat).
+    //    The model torque is also kept for motor failure detection.
+    model_torque_valid_ = dob_valid_ && dt > 0.f;
+    
+    if (model_torque_valid_) {
+        Vector3f alpha_meas = (Omega - Omega_prev_) / dt;
+        tau_model_ = tau_adaptive + J_hat * (alpha_meas - alpha);
+        
+        // Information window: the measured motion against the torque that produced it
+        if (iwg_adapter_.is_window_enabled()) {
+            if (window_filter_valid_) {
+                const float k = dt / (WINDOW_FILTER_TIME_CONSTANT + dt);
+                alpha_meas_filtered_ = alpha_meas_filtered_ + k * (alpha_meas - alpha_meas_filtered_);
+                tau_applied_filtered_ = tau_applied_filtered_ + k * (tau_applied_ - tau_applied_filtered_);
+                
+            } else {
+                alpha_meas_filtered_ = alpha_meas;
+                tau_applied_filtered_ = tau_applied_;
+                window_filter_valid_ = true;
+            }
+            
+            RegressorInput x_meas = x;
+            x_meas.alpha = alpha_meas_filtered_;
+            iwg_adapter_.observe(x_meas, tau_applied_filtered_, dt);
+        }
+    }
+    
+    if (dob_enabled_ && model_torque_valid_) {
+        Vector3f residual = tau_applied_ - tau_model_;
+        
+        float k = dt / (dob_time_constant_ + dt);
+        d_hat_ = d_hat_ + k * (residual - d_hat_);
+        d_hat_ = saturate(d_hat_, gains_.tau_max());
+    }
+    
+    // 9. Compose total torque: tau = tau_pd + tau_adaptive + tau_robust + d_hat
+    Vector3f tau = tau_pd + tau_adaptive + tau_robust;
+    if (dob_enabled_) {
+        tau = tau + d_hat_;
+    }
+    
+    // 10. Apply actuator saturation
+    tau = saturate(tau, gains_.tau_max());
+    saturated_ = false;
+    for (int i = 0; i < 3; ++i) {
+        saturated_ = saturated_ || (std::abs(tau(i)) >= gains_.tau_max());
+    }
+    
+    tau_applied_ = tau;
+    Omega_prev_ = Omega;
+    dob_valid_ = true;
+    
+    return tau;
+}
+
+template<typename Gains>
+void BasicAttitudeControllerAIC<Gains>::reset(const Matrix3f &J_init) {
+    iwg_adapter_.reset(J_init);
+    s_filter_.reset();
+    s_filtered_ = Vector3f::Zero();
+    saturated_ = false;
+    d_hat_ = Vector3f::Zero();
+    dob_valid_ = false;
+    model_torque_valid_ = false;
+    window_filter_valid_ = false;
+}
+
+/**
+ * @brief Runtime-configurable AIC controller (gains reloaded from parameters)
+ */
+using AttitudeControllerAIC = BasicAttitudeControllerAIC<RuntimeGains>;
+
+// The common configurations are instantiated once in aic_core.cpp: including
+// translation units only instantiate the inline accessors.
+extern template class BasicAttitudeControllerAIC<RuntimeGains>;
+
 } // namespace attitude_controller_aic
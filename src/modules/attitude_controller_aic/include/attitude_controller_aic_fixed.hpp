@@ -0,0 +1,246 @@
+/**
+ * @file attitude_controller_aic_fixed.hpp
+ * @brief Fixed-point AIC controller (diagonal inertia) for FPU-less microcontrollers
+ *
+ * Integer-only counterpart of AttitudeControllerAIC for the IO coprocessor
+ * (STM32F1) and boards without an FPU, intended as a failsafe controller:
+ *
+ *   tau = -K_R * e_R - K_Omega * e_Omega + Y(Omega, alpha) * theta_hat - K * s_f
+ *   dot_theta_hat = -gamma * (Y^T * s_f + sigma * theta_hat),  J_min <= theta_hat <= J_max
+ *
+ * with the same errors, regressor and one-pole composite error filter as
+ * the float controller. The estimator is the plain leaky gradient law: the
+ * information weighting of IWGAdapter needs matrix inversions that do not
+ * pay off in fixed point.
+ *
+ * Formats: signals, gains and torques are Q16.16 (range +-32768, resolution
+ * 1.5e-5); the inertia estimate is Q8.24 so that per-step increments of
+ * order gamma * dt * |Y^T s| ~ 1e-5 are not lost to rounding. All
+ * arithmetic saturates (see fixed_point.hpp). Floats only appear in the
+ * configuration setters.
+ */
+
+#pragma once
+
+#include "fixed_point.hpp"
+
+namespace attitude_controller_aic {
+
+using q16 = fixed::Q<16>;
+using q24 = fixed::Q<24>;
+
+/**
+ * @brief Three-vector of Q16.16 values
+ */
+struct FixedVector3 {
+    q16 v[3];
+
+    q16 &operator()(int i) { return v[i]; }
+    q16 operator()(int i) const { return v[i]; }
+
+    static FixedVector3 from_float(const float x[3]) {
+        return FixedVector3{{q16::from_float(x[0]), q16::from_float(x[1]), q16::from_float(x[2])}};
+    }
+};
+
+/**
+ * @brief Row-major 3x3 matrix of Q16.16 values
+ */
+struct FixedMatrix3 {
+    q16 m[3][3];
+
+    q16 &operator()(int i, int j) { return m[i][j]; }
+    q16 operator()(int i, int j) const { return m[i][j]; }
+
+    static FixedMatrix3 from_float(const float x[3][3]) {
+        FixedMatrix3 r;
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                r.m[i][j] = q16::from_float(x[i][j]);
+            }
+        }
+
+        return r;
+    }
+};
+
+/**
+ * @class FixedPointAttitudeControllerAIC
+ * @brief Q-format diagonal-inertia AIC controller with gradient adaptation
+ */
+class FixedPointAttitudeControllerAIC {
+public:
+    /**
+     * @brief Initialize with the default gains of the float controller
+     * @param J_diag initial principal inertia estimate (kg*m^2)
+     */
+    void init(const float J_diag[3]) {
+        const float K_R[3] = {5.0f, 5.0f, 3.0f};
+        const float K_Omega[3] = {0.3f, 0.3f, 0.2f};
+        const float K[3] = {0.1f, 0.1f, 0.1f};
+        set_control_gains(K_R, K_Omega, K, 2.0f);
+        set_saturation_limit(0.05f);
+        set_adaptation_params(1.5f, 1e-4f, 0.01f, 1.0f);
+        set_filter_bandwidth(0.1f);
+        reset(J_diag);
+    }
+
+    void set_control_gains(const float K_R[3], const float K_Omega[3], const float K[3], float c) {
+        for (int i = 0; i < 3; ++i) {
+            K_R_[i] = q16::from_float(K_R[i]);
+            K_Omega_[i] = q16::from_float(K_Omega[i]);
+            K_[i] = q16::from_float(K[i]);
+        }
+
+        c_ = q16::from_float(c);
+    }
+
+    void set_saturation_limit(float tau_max) {
+        tau_max_ = q16::from_float(tau_max);
+    }
+
+    /**
+     * @param gamma adaptation gain
+     * @param sigma leakage coefficient
+     * @param J_min lower projection bound of the inertia estimate
+     * @param J_max upper projection bound of the inertia estimate
+     */
+    void set_adaptation_params(float gamma, float sigma, float J_min, float J_max) {
+        gamma_ = q16::from_float(gamma);
+        sigma_ = q24::from_float(sigma);
+        J_min_ = q24::from_float(J_min);
+        J_max_ = q24::from_float(J_max);
+    }
+
+    /**
+     * @brief One-pole composite error filter s_f += alpha * (s - s_f)
+     */
+    void set_filter_bandwidth(float alpha) {
+        filter_alpha_ = fixed::constrain(q16::from_float(alpha), q16::from_int(0), q16::from_int(1));
+    }
+
+    /**
+     * @brief Compute attitude control torque
+     *
+     * @param R current attitude (rotation matrix)
+     * @param Omega current angular velocity (rad/s)
+     * @param R_d desired attitude
+     * @param Omega_d desired angular velocity
+     * @param dot_Omega_d desired angular acceleration
+     * @param dt timestep (s)
+     * @return torque command (Nm)
+     */
+    FixedVector3 compute_torque(const FixedMatrix3 &R, const FixedVector3 &Omega,
+                                const FixedMatrix3 &R_d, const FixedVector3 &Omega_d,
+                                const FixedVector3 &dot_Omega_d, q16 dt) {
+        // E = R^T * R_d
+        FixedMatrix3 E;
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                E(i, j) = R(0, i) * R_d(0, j) + R(1, i) * R_d(1, j) + R(2, i) * R_d(2, j);
+            }
+        }
+
+        // 1. e_R = 0.5 * vee(E^T - E), since R_d^T * R = E^T
+        const q16 half = q16::from_raw(1 << 15);
+        FixedVector3 e_R;
+        e_R(0) = half * (E(1, 2) - E(2, 1));
+        e_R(1) = half * (E(2, 0) - E(0, 2));
+        e_R(2) = half * (E(0, 1) - E(1, 0));
+
+        // e_Omega = Omega - E * Omega_d, alpha = E * dot_Omega_d - Omega x (E * Omega_d)
+        FixedVector3 E_Omega_d, alpha, e_Omega, s;
+
+        for (int i = 0; i < 3; ++i) {
+            E_Omega_d(i) = E(i, 0) * Omega_d(0) + E(i, 1) * Omega_d(1) + E(i, 2) * Omega_d(2);
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            const int j = (i + 1) % 3, k = (i + 2) % 3;
+            alpha(i) = E(i, 0) * dot_Omega_d(0) + E(i, 1) * dot_Omega_d(1) + E(i, 2) * dot_Omega_d(2)
+                       - (Omega(j) * E_Omega_d(k) - Omega(k) * E_Omega_d(j));
+            e_Omega(i) = Omega(i) - E_Omega_d(i);
+
+            // 2. Composite error and its low-pass filter
+            s(i) = e_Omega(i) + c_ * e_R(i);
+            s_filtered_(i) += filter_alpha_ * (s(i) - s_filtered_(i));
+        }
+
+        // 3. Diagonal regressor Y(Omega, alpha) (see Regressor::regressor_diagonal)
+        const q16 wxwy = Omega(0) * Omega(1);
+        const q16 wxwz = Omega(0) * Omega(2);
+        const q16 wywz = Omega(1) * Omega(2);
+        const q16 Y[3][3] = {
+            {alpha(0), -wywz, wywz},
+            {wxwz, alpha(1), -wxwz},
+            {-wxwy, wxwy, alpha(2)},
+        };
+
+        // 4. Leaky gradient adaptation with projection onto [J_min, J_max]
+        const q24 gamma_dt = fixed::mul<24>(gamma_, dt);
+
+        for (int i = 0; i < 3; ++i) {
+            // Y^T * s in Q12.20: keeps 4 more bits than Q16.16 of the small products near convergence
+            const fixed::Q<20> Yts = fixed::mul<20>(Y[0][i], s_filtered_(0)) + fixed::mul<20>(Y[1][i], s_filtered_(1))
+                                     + fixed::mul<20>(Y[2][i], s_filtered_(2));
+            const q24 drive = Yts.convert<24>() + sigma_ * theta_[i];
+            theta_[i] = fixed::constrain(theta_[i] - gamma_dt * drive, J_min_, J_max_);
+        }
+
+        // 5. Compose and saturate the torque
+        FixedVector3 tau;
+
+        for (int i = 0; i < 3; ++i) {
+            const q16 tau_adaptive = fixed::mul<16>(Y[i][0], theta_[0]) + fixed::mul<16>(Y[i][1], theta_[1])
+                                     + fixed::mul<16>(Y[i][2], theta_[2]);
+            const q16 t = tau_adaptive - K_R_[i] * e_R(i) - K_Omega_[i] * e_Omega(i) - K_[i] * s_filtered_(i);
+            tau(i) = fixed::constrain(t, -tau_max_, tau_max_);
+        }
+
+        return tau;
+    }
+
+    /**
+     * @brief Reset filter state and inertia estimate
+     */
+    void reset(const float J_diag[3]) {
+        for (int i = 0; i < 3; ++i) {
+            theta_[i] = fixed::constrain(q24::from_float(J_diag[i]), J_min_, J_max_);
+            s_filtered_(i) = q16();
+        }
+    }
+
+    /**
+     * @brief Get principal inertia estimate (Q8.24)
+     */
+    q24 get_inertia_estimate(int i) const {
+        return theta_[i];
+    }
+
+    const FixedVector3 &get_composite_error() const {
+        return s_filtered_;
+    }
+
+private:
+    // Gains and limits
+    q16 K_R_[3];
+    q16 K_Omega_[3];
+    q16 K_[3];
+    q16 c_;
+    q16 tau_max_;
+    q16 filter_alpha_;
+
+    // Adaptation
+    q16 gamma_;
+    q24 sigma_;
+    q24 J_min_;
+    q24 J_max_;
+    q24 theta_[3];
+
+    // Filtered composite error
+    FixedVector3 s_filtered_;
+};
+
+} // namespace attitude_controller_aic
@@ -0,0 +1,437 @@
+/**
+ * @file capture_buffer.hpp
+ * @brief Pre-trigger RAM capture of per-tick controller data around anomalies
+ *
+ * Logging every controller internal at the full loop rate costs more SD card
+ * bandwidth than the flight controller can spare. Instead the last CAPACITY
+ * ticks are kept in RAM and only the window around an event is written:
+ *
+ *   ... | pre-trigger records | trigger tick | post-trigger records | ...
+ *
+ * CaptureTriggerDetector raises a trigger on the edges of: saturation bursts,
+ * inertia estimate jumps (payload change), loss of persistent excitation,
+ * overruns (compute time over budget or dt clamped) and non-finite values.
+ * CaptureBuffer freezes the window around the trigger and hands it to a
+ * low-priority writer, which may start before the post-trigger records are
+ * in and drain at the storage's pace.
+ *
+ * The control loop (producer) and the writer (consumer) share the buffer
+ * without locks. While a window is open the producer never overwrites a
+ * record the writer has not read yet; if the writer falls that far behind,
+ * ticks are dropped and the next stored record carries CAPTURE_GAP.
+ * Triggers during the post-trigger part extend the window (up to the
+ * buffer size); later ones, until the writer releases the window, are only
+ * counted.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+enum CaptureTrigger : uint16_t {
+    CAPTURE_TRIGGER_SATURATION = 1 << 0,   // Saturated for a large share of the recent ticks
+    CAPTURE_TRIGGER_PAYLOAD = 1 << 1,      // Inertia estimate jumped away from its slow average
+    CAPTURE_TRIGGER_PE_LOSS = 1 << 2,      // Persistent excitation lost
+    CAPTURE_TRIGGER_OVERRUN = 1 << 3,      // Compute time over budget or dt clamped
+    CAPTURE_TRIGGER_NON_FINITE = 1 << 4,   // NaN or infinity in the record
+    CAPTURE_TRIGGER_MANUAL = 1 << 5,       // Requested (shell command, test)
+    CAPTURE_TRIGGER_ALL = 0x3f,
+};
+
+enum CaptureFlag : uint16_t {
+    CAPTURE_SATURATED = 1 << 0,
+    CAPTURE_FALLBACK = 1 << 1,
+    CAPTURE_EXCITED = 1 << 2,
+    CAPTURE_DT_CLAMPED = 1 << 3,
+    CAPTURE_GAP = 1 << 4,                  // Ticks were dropped before this record
+};
+
+/**
+ * @brief One controlled tick (128 bytes)
+ */
+struct CaptureRecord {
+    uint64_t timestamp_us;
+    float dt;
+    float q[4];            // Attitude
+    float omega[3];        // Body rates (rad/s)
+    float omega_d[3];      // Rate setpoint (rad/s)
+    float e_R[3];          // Attitude error
+    float s[3];            // Filtered composite error
+    float tau[3];          // Published torque (Nm)
+    float d_hat[3];        // Disturbance estimate (Nm)
+    float J_diag[3];       // Inertia estimate diagonal (kg*m^2)
+    float excitation;      // Window excitation ((rad/s^2)^2)
+    float thrust;
+    uint32_t compute_us;   // Tick compute time
+    uint16_t flags;        // CaptureFlag
+    uint16_t triggers;     // CaptureTrigger raised on this tick
+};
+
+static_assert(sizeof(CaptureRecord) == 128, "capture record layout changed: bump CAPTURE_FILE_VERSION");
+
+static constexpr uint32_t CAPTURE_FILE_MAGIC = 0x43434941;   // "AICC"
+static constexpr uint16_t CAPTURE_FILE_VERSION = 1;
+
+/**
+ * @brief Header of a capture file, followed by `records` CaptureRecord
+ */
+struct CaptureFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint64_t trigger_us;   // Timestamp of the first trigger
+    uint32_t triggers;     // CaptureTrigger of all ticks in the window
+    uint32_t records;
+    uint32_t pre_records;  // Records before the first trigger
+    uint32_t dropped;      // Ticks dropped while the window was open
+};
+
+static_assert(sizeof(CaptureFileHeader) == 32, "unexpected capture file header size");
+
+/**
+ * @brief Trigger thresholds
+ */
+struct CaptureSettings {
+    uint16_t trigger_mask{CAPTURE_TRIGGER_ALL};
+    float saturation_fraction{0.5f};   // Share of saturated ticks ...
+    float saturation_time{0.1f};       // ... averaged over this time (s)
+    float payload_change{0.25f};       // Relative deviation of a J_hat diagonal entry ...
+    float payload_time{5.f};           // ... from its average over this time (s)
+    uint32_t compute_budget_us{0};     // 0: overrun only on a clamped dt
+};
+
+/**
+ * @class CaptureTriggerDetector
+ * @brief Edge-triggered anomaly detection on the capture records
+ *
+ * Each condition raises its trigger once when it starts; it must clear
+ * (with hysteresis for the averaged ones) before it can trigger again.
+ */
+class CaptureTriggerDetector {
+public:
+    void reset() {
+        saturation_average_ = 0.f;
+        saturation_active_ = false;
+        payload_time_ = 0.f;
+        payload_active_ = false;
+        excited_ = false;
+        overrun_ = false;
+        non_finite_ = false;
+    }
+
+    /**
+     * @return CaptureTrigger raised on this tick (within settings.trigger_mask)
+     */
+    uint16_t update(const CaptureRecord &record, const CaptureSettings &settings) {
+        uint16_t triggers = 0;
+        const float dt = (record.dt > 0.f && record.dt < 1.f) ? record.dt : 0.f;
+
+        // Saturation burst: exponential average of the saturated flag
+        const float saturation_alpha = std::fmin(dt / std::fmax(settings.saturation_time, 1e-3f), 1.f);
+        const float saturated = (record.flags & CAPTURE_SATURATED) ? 1.f : 0.f;
+        saturation_average_ += saturation_alpha * (saturated - saturation_average_);
+
+        if (!saturation_active_ && saturation_average_ > settings.saturation_fraction) {
+            saturation_active_ = true;
+            triggers |= CAPTURE_TRIGGER_SATURATION;
+
+        } else if (saturation_active_ && saturation_average_ < 0.5f * settings.saturation_fraction) {
+            saturation_active_ = false;
+        }
+
+        // Payload change: inertia estimate against its slow average, once the average has settled
+        const bool finite = is_finite(record);
+
+        if (finite) {
+            const float payload_alpha = std::fmin(dt / std::fmax(settings.payload_time, 1e-3f), 1.f);
+            float deviation = 0.f;
+
+            for (int i = 0; i < 3; ++i) {
+                if (payload_time_ == 0.f) {
+                    J_average_[i] = record.J_diag[i];
+                }
+
+                const float reference = std::fmax(std::fabs(J_average_[i]), 1e-6f);
+                deviation = std::fmax(deviation, std::fabs(record.J_diag[i] - J_average_[i]) / reference);
+                J_average_[i] += payload_alpha * (record.J_diag[i] - J_average_[i]);
+            }
+
+            const bool settled = payload_time_ >= settings.payload_time;
+            payload_time_ += (dt > 0.f) ? dt : 1e-6f;
+
+            if (!payload_active_ && settled && deviation > settings.payload_change) {
+                payload_active_ = true;
+                triggers |= CAPTURE_TRIGGER_PAYLOAD;
+
+            } else if (payload_active_ && deviation < 0.5f * settings.payload_change) {
+                payload_active_ = false;
+            }
+        }
+
+        // Persistent excitation lost
+        const bool excited = (record.flags & CAPTURE_EXCITED) != 0;
+
+        if (excited_ && !excited) {
+            triggers |= CAPTURE_TRIGGER_PE_LOSS;
+        }
+
+        excited_ = excited;
+
+        // Overrun
+        const bool overrun = (record.flags & CAPTURE_DT_CLAMPED)
+                             || (settings.compute_budget_us > 0 && record.compute_us > settings.compute_budget_us);
+
+        if (overrun && !overrun_) {
+            triggers |= CAPTURE_TRIGGER_OVERRUN;
+        }
+
+        overrun_ = overrun;
+
+        // Non-finite values
+        if (!finite && !non_finite_) {
+            triggers |= CAPTURE_TRIGGER_NON_FINITE;
+        }
+
+        non_finite_ = !finite;
+
+        return triggers & settings.trigger_mask;
+    }
+
+    static bool is_finite(const CaptureRecord &record) {
+        const float *arrays[] = {record.q, record.omega, record.omega_d, record.e_R, record.s, record.tau,
+                                 record.d_hat, record.J_diag};
+        bool finite = std::isfinite(record.dt) && std::isfinite(record.excitation) && std::isfinite(record.thrust);
+
+        for (int a = 0; a < 8; ++a) {
+            const int size = (a == 0) ? 4 : 3;
+
+            for (int i = 0; i < size; ++i) {
+                finite = finite && std::isfinite(arrays[a][i]);
+            }
+        }
+
+        return finite;
+    }
+
+private:
+    float saturation_average_{0.f};
+    bool saturation_active_{false};
+    float J_average_[3] {};
+    float payload_time_{0.f};
+    bool payload_active_{false};
+    bool excited_{false};
+    bool overrun_{false};
+    bool non_finite_{false};
+};
+
+/**
+ * @brief Window handed to the writer
+ */
+struct CaptureWindow {
+    uint64_t trigger_us;
+    uint32_t start;          // Record counter of the first record
+    uint32_t trigger;        // Record counter of the trigger tick
+    uint32_t end;            // One past the last record (moves while triggers extend the window)
+    uint16_t triggers;
+    uint32_t dropped;
+};
+
+/**
+ * @class CaptureBuffer
+ * @brief Single-producer single-consumer pre-trigger ring
+ *
+ * @tparam CAPACITY records kept in RAM
+ */
+template<uint32_t CAPACITY>
+class CaptureBuffer {
+public:
+    static_assert(CAPACITY >= 4, "capture buffer too small");
+
+    /**
+     * @brief Records kept before and after a trigger (clamped to the capacity)
+     *
+     * Takes effect at the next trigger; safe while a window is open.
+     */
+    void configure(uint32_t pre_records, uint32_t post_records) {
+        post_ = (post_records < CAPACITY - 1) ? post_records : CAPACITY - 2;
+        pre_ = (pre_records < CAPACITY - 1 - post_) ? pre_records : CAPACITY - 1 - post_;
+    }
+
+    uint32_t pre_records() const { return pre_; }
+    uint32_t post_records() const { return post_; }
+
+    /**
+     * @brief Producer: store one tick; record.triggers opens or extends a window
+     * @return false if the tick was dropped (writer too far behind)
+     */
+    bool push(const CaptureRecord &record) {
+        const uint32_t head = head_;
+        uint32_t state = load(&state_);
+
+        if (state == STATE_DONE) {
+            store(&state_, STATE_IDLE);
+            state = STATE_IDLE;
+        }
+
+        // Only unread records of the window are protected; past its end the ring runs on
+        const uint32_t read = load(&read_);
+
+        if (state != STATE_IDLE && head - read >= CAPACITY && read - window_.start < window_end_ - window_.start) {
+            store(&dropped_, dropped_ + 1);
+            gap_ = true;
+
+            if (record.triggers != 0) {
+                store(&suppressed_, suppressed_ + 1);
+            }
+
+            return false;
+        }
+
+        if (record.triggers != 0) {
+            if (state == STATE_IDLE) {
+                open_window(head, record);
+
+            } else if (head - window_.start < window_end_ - window_.start) {
+                // Still collecting post-trigger records: extend, within the buffer
+                const uint32_t end = head + post_ + 1;
+                const uint32_t limit = window_.start + CAPACITY;
+                store(&window_end_, (end < limit) ? end : limit);
+                store(&window_triggers_, window_triggers_ | record.triggers);
+
+            } else {
+                store(&suppressed_, suppressed_ + 1);
+            }
+        }
+
+        CaptureRecord &slot = records_[head % CAPACITY];
+        slot = record;
+
+        if (gap_) {
+            slot.flags |= CAPTURE_GAP;
+            gap_ = false;
+        }
+
+        store(&head_, head + 1);
+        return true;
+    }
+
+    /**
+     * @brief Writer: window to write, if one is open
+     */
+    bool window(CaptureWindow &window) const {
+        if (load(&state_) != STATE_OPEN) {
+            return false;
+        }
+
+        window = window_;
+        window.end = load(&window_end_);
+        window.triggers = static_cast<uint16_t>(load(&window_triggers_));
+        window.dropped = load(&dropped_) - window_.dropped;
+        return true;
+    }
+
+    /**
+     * @brief Writer: copy the next records of the open window that are already stored
+     * @return records copied (0 if none are ready yet)
+     */
+    uint32_t read(CaptureRecord *records, uint32_t max) {
+        if (load(&state_) != STATE_OPEN) {
+            return 0;
+        }
+
+        // head before end: an extension is published before the records that need it
+        const uint32_t head = load(&head_);
+        const uint32_t end = load(&window_end_);
+        const uint32_t read = read_;
+        uint32_t count = (head - read < end - read) ? head - read : end - read;
+        count = (count < max) ? count : max;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            records[i] = records_[(read + i) % CAPACITY];
+        }
+
+        store(&read_, read + count);
+        return count;
+    }
+
+    /**
+     * @brief Writer: all records of the window have been read
+     */
+    bool complete() const {
+        const uint32_t head = load(&head_);
+        const uint32_t end = load(&window_end_);
+        return load(&state_) == STATE_OPEN && read_ == end && end - window_.start <= head - window_.start;
+    }
+
+    /**
+     * @brief Writer: done with the window; the producer can open the next one
+     */
+    void release() {
+        store(&state_, STATE_DONE);
+    }
+
+    bool is_open() const { return load(&state_) == STATE_OPEN; }
+
+    uint32_t windows() const { return load(&windows_); }
+    uint32_t dropped() const { return load(&dropped_); }
+    uint32_t suppressed() const { return load(&suppressed_); }
+
+private:
+    enum : uint32_t {
+        STATE_IDLE = 0,     // Producer owns everything, overwrites the oldest record
+        STATE_OPEN = 1,     // Window handed to the writer
+        STATE_DONE = 2,     // Writer released the window
+    };
+
+    // Shared between the control loop and the writer task
+    static uint32_t load(const uint32_t *value) {
+        return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+    }
+
+    static void store(uint32_t *value, uint32_t desired) {
+        __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+    }
+
+    void open_window(uint32_t head, const CaptureRecord &record) {
+        // Records head + 1 - CAPACITY .. head - 1 are still in the ring (slot of head is reused now)
+        const uint32_t oldest = (head + 1 >= CAPACITY) ? head + 1 - CAPACITY : 0;
+        const uint32_t start = (head - oldest > pre_) ? head - pre_ : oldest;
+
+        window_.trigger_us = record.timestamp_us;
+        window_.start = start;
+        window_.trigger = head;
+        window_.end = head + post_ + 1;
+        window_.dropped = dropped_;
+
+        read_ = start;
+        store(&window_end_, window_.end);
+        store(&window_triggers_, record.triggers);
+        store(&windows_, windows_ + 1);
+        store(&state_, STATE_OPEN);   // Publishes the window
+    }
+
+    CaptureRecord records_[CAPACITY];
+
+    uint32_t pre_{CAPACITY / 2};
+    uint32_t post_{CAPACITY / 4};
+
+    // Producer
+    uint32_t head_{0};              // Records stored since boot (read by the writer)
+    bool gap_{false};
+    CaptureWindow window_{};        // Fixed once published
+    uint32_t window_end_{0};        // May grow while collecting post-trigger records
+    uint32_t window_triggers_{0};
+    uint32_t windows_{0};
+    uint32_t dropped_{0};
+    uint32_t suppressed_{0};        // Triggers that did not open or extend a window
+
+    // Writer (the producer sets it only while no window is open)
+    uint32_t read_{0};
+
+    uint32_t state_{STATE_IDLE};
+};
+
+} // namespace attitude_controller_aic
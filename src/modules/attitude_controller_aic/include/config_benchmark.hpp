@@ -0,0 +1,206 @@
+/**
+ * @file config_benchmark.hpp
+ * @brief Boot-time benchmark of the controller configurations and choice of the richest affordable one
+ *
+ * compute_torque() time differs by more than an order of magnitude between
+ * the boards the module runs on (F4 up to Linux). Instead of setting the
+ * loop rate and estimator per board, the module times compute_torque() at
+ * boot in each inertia model and estimator mode on a scratch controller
+ * and picks the richest configuration whose load
+ *
+ *   margin * compute time / (divider * attitude message interval)
+ *
+ * stays within the CPU budget. Richness: a lower divider (higher control
+ * rate) first, since it bounds the feedback bandwidth; then the full
+ * inertia model over the diagonal one, then the windowed least-squares
+ * estimator over the gradient alone, which only change how fast the
+ * inertia converges.
+ *
+ * Timing: after a warm-up (caches, branch predictors, lazy FPU context
+ * switch) the ticks are timed in batches and the median batch is taken, so
+ * a preemption during one batch does not count. A batch spans at least one
+ * information window block: the block solve of the windowed estimator is
+ * part of the cost.
+ */
+
+#pragma once
+
+#include "iwg_adapter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+/**
+ * @brief Inertia model, estimator mode and control rate
+ */
+struct ControllerConfiguration {
+    bool full_inertia{false};
+    EstimatorMode estimator{EstimatorMode::IWG};
+    int divider{1};              // Attitude messages per control update at full rate
+};
+
+static constexpr int BENCH_MODELS = 4;        // Inertia model x estimator mode
+static constexpr int BENCH_MAX_DIVIDER = 4;
+static constexpr int BENCH_MAX_BATCHES = 15;
+
+/**
+ * @brief Model and estimator of a benchmark index, richest first (divider 1)
+ */
+inline ControllerConfiguration bench_model(int model) {
+    ControllerConfiguration config;
+    config.full_inertia = model < 2;
+    config.estimator = (model % 2 == 0) ? EstimatorMode::WINDOWED_LS : EstimatorMode::IWG;
+    return config;
+}
+
+inline const char *configuration_name(const ControllerConfiguration &config) {
+    if (config.full_inertia) {
+        return (config.estimator == EstimatorMode::WINDOWED_LS) ? "full, windowed LS" : "full, gradient";
+    }
+
+    return (config.estimator == EstimatorMode::WINDOWED_LS) ? "diagonal, windowed LS" : "diagonal, gradient";
+}
+
+struct BenchmarkSettings {
+    float dt{0.004f};            // Tick interval the estimators integrate with (s)
+    float window_length{2.f};    // Information window of the windowed estimator (s)
+    int warmup_ticks{64};
+    int batches{9};
+    int batch_ticks{64};         // Raised to one information window block
+};
+
+/**
+ * @brief Time compute_torque() in each benchmark model
+ *
+ * The scratch controller is re-initialized for every model (gains back to
+ * their defaults, the extended model setting kept); it must not be the one
+ * flying.
+ *
+ * @param now monotonic time (us): uint64_t now()
+ * @param compute_us median time per tick of each model (us)
+ */
+template<typename Controller, typename Clock>
+void benchmark_models(Controller &scratch, const Matrix3f &J_init, Clock now, const BenchmarkSettings &settings,
+                      float compute_us[BENCH_MODELS]) {
+    const float dt = std::max(settings.dt, 1e-4f);
+    const int block_ticks = static_cast<int>(std::ceil(settings.window_length
+                                             / IWGEstimator<DiagonalInertiaLayout>::Window::BLOCK_COUNT / dt));
+    const int batch_ticks = std::max(std::max(settings.batch_ticks, block_ticks), 1);
+    const int batches = std::max(1, std::min(settings.batches, BENCH_MAX_BATCHES));
+    volatile float sink = 0.f;
+
+    for (int model = 0; model < BENCH_MODELS; ++model) {
+        const ControllerConfiguration config = bench_model(model);
+        scratch.init(J_init, !config.full_inertia, true);
+        scratch.set_information_window(settings.window_length, config.estimator, 0.f);   // Always excited
+
+        Matrix3f R_d;
+        uint32_t sequence = 0;
+        int k = 0;
+
+        // Maneuvering flight with a new setpoint every 4 ticks, as from the module
+        auto tick = [&]() {
+            const float t = k * dt;
+
+            if (k % 4 == 0) {
+                const float yaw = 0.2f * std::sin(0.7f * t);
+                R_d = Quaternionf(std::cos(0.5f * yaw), 0.f, 0.f, std::sin(0.5f * yaw)).to_dcm();
+                ++sequence;
+            }
+
+            const float tilt = 0.3f * std::sin(2.1f * t);
+            const float st = std::sin(0.5f * tilt);
+            const Quaternionf q(std::cos(0.5f * tilt), 0.6f * st, -0.48f * st, 0.64f * st);
+            const Vector3f omega(1.5f * std::sin(4.f * t), -1.2f * std::cos(3.f * t), 0.8f * std::sin(2.f * t));
+            const Vector3f Omega_d(0.5f * std::sin(t), 0.f, 0.1f);
+            const Vector3f tau = scratch.compute_torque(q.to_dcm(), omega, R_d, Omega_d, Vector3f(), dt, sequence);
+            sink = sink + tau(0);
+            ++k;
+        };
+
+        for (int i = 0; i < settings.warmup_ticks; ++i) {
+            tick();
+        }
+
+        float batch_us[BENCH_MAX_BATCHES];
+
+        for (int b = 0; b < batches; ++b) {
+            const uint64_t start = now();
+
+            for (int i = 0; i < batch_ticks; ++i) {
+                tick();
+            }
+
+            batch_us[b] = static_cast<float>(now() - start) / batch_ticks;
+        }
+
+        std::nth_element(batch_us, batch_us + batches / 2, batch_us + batches);
+        compute_us[model] = batch_us[batches / 2];
+    }
+}
+
+/**
+ * @brief Outcome of select_configuration()
+ */
+struct ConfigurationChoice {
+    ControllerConfiguration config;
+    float load{0.f};             // Share of the message interval, margin included
+    bool within_budget{false};   // Otherwise the cheapest allowed model at the largest divider
+    bool valid{false};           // No allowed model or unknown message interval: nothing chosen
+};
+
+/**
+ * @brief Richest configuration within the CPU budget
+ *
+ * @param compute_us benchmark_models() result (us per tick)
+ * @param allowed bit per benchmark model the build and settings permit
+ * @param message_interval attitude message interval (s)
+ * @param max_divider largest divider the rate loop stability allows
+ * @param budget share of the message interval available to the controller (0..1)
+ * @param margin factor on the benchmark time (interrupts, cache misses in flight)
+ */
+inline ConfigurationChoice select_configuration(const float compute_us[BENCH_MODELS], unsigned allowed,
+                                                float message_interval, int max_divider, float budget,
+                                                float margin) {
+    ConfigurationChoice choice;
+    max_divider = std::max(1, std::min(max_divider, BENCH_MAX_DIVIDER));
+    int cheapest = -1;
+
+    for (int model = 0; model < BENCH_MODELS; ++model) {
+        if ((allowed & (1u << model)) && (cheapest < 0 || compute_us[model] < compute_us[cheapest])) {
+            cheapest = model;
+        }
+    }
+
+    if (cheapest < 0 || !(message_interval > 0.f)) {
+        return choice;
+    }
+
+    auto load = [&](int model, int divider) {
+        return margin * compute_us[model] * 1e-6f / (divider * message_interval);
+    };
+
+    choice.valid = true;
+
+    for (int divider = 1; divider <= max_divider; ++divider) {
+        for (int model = 0; model < BENCH_MODELS; ++model) {
+            if ((allowed & (1u << model)) && load(model, divider) <= budget) {
+                choice.config = bench_model(model);
+                choice.config.divider = divider;
+                choice.load = load(model, divider);
+                choice.within_budget = true;
+                return choice;
+            }
+        }
+    }
+
+    choice.config = bench_model(cheapest);
+    choice.config.divider = max_divider;
+    choice.load = load(cheapest, max_divider);
+    return choice;
+}
+
+} // namespace attitude_controller_aic
@@ -0,0 +1,138 @@
+/**
+ * @file control_gains.hpp
+ * @brief Gain policies for the AIC controller (runtime or compile-time)
+ *
+ * The controller reads its gains, saturation limit and inertia model through
+ * a policy class:
+ * - RuntimeGains: stored in members, reloadable from parameters
+ * - FixedGains<Config>: constexpr values from a configuration struct, so the
+ *   compiler folds constants (e.g. drops multiplies by unity gains) and the
+ *   diagonal/full model branch
+ *
+ * A fixed configuration is a struct with static constexpr members:
+ *
+ *   struct MyAirframe {
+ *       static constexpr float K_R_x = 5.f, K_R_y = 5.f, K_R_z = 3.f;
+ *       static constexpr float K_Omega_x = 0.3f, K_Omega_y = 0.3f, K_Omega_z = 0.2f;
+ *       static constexpr float K_x = 0.1f, K_y = 0.1f, K_z = 0.1f;
+ *       static constexpr float c = 2.f;
+ *       static constexpr float tau_max = 0.05f;
+ *       static constexpr bool use_diagonal = true;
+ *       static constexpr float J_xx = 0.04f, J_yy = 0.04f, J_zz = 0.025f;
+ *   };
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include <algorithm>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+using Matrix3f = matrix::Matrix3f;
+
+/**
+ * @class RuntimeGains
+ * @brief Runtime-configurable gains (default)
+ */
+class RuntimeGains {
+public:
+    static constexpr bool is_fixed = false;
+
+    /**
+     * @brief Set default gains and the inertia model
+     * @param use_diagonal diagonal inertia model if true, else full symmetric
+     */
+    void init(bool use_diagonal) {
+        use_diagonal_ = use_diagonal;
+
+        // These values are conservative; tune based on vehicle dynamics
+        K_R_ = Vector3f(5.0f, 5.0f, 3.0f);           // Attitude error gain
+        K_Omega_ = Vector3f(0.3f, 0.3f, 0.2f);       // Angular velocity error gain
+        K_ = Vector3f(0.1f, 0.1f, 0.1f);             // Robust damping gain
+        c_ = 2.0f;                                     // Composite error weight
+
+        // Actuator saturation (Nm)
+        tau_max_ = 0.05f;
+    }
+
+    void set_control_gains(const Vector3f &K_R, const Vector3f &K_Omega,
+                           const Vector3f &K, float c) {
+        K_R_ = K_R;
+        K_Omega_ = K_Omega;
+        K_ = K;
+        c_ = c;
+    }
+
+    void set_saturation_limit(float tau_max) {
+        tau_max_ = std::max(0.01f, tau_max);  // Ensure positive
+    }
+
+    void set_inertia_model(bool use_diagonal) {
+        use_diagonal_ = use_diagonal;
+    }
+
+    float K_R(int i) const { return K_R_(i); }
+    float K_Omega(int i) const { return K_Omega_(i); }
+    float K(int i) const { return K_(i); }
+    float c() const { return c_; }
+    float tau_max() const { return tau_max_; }
+    bool use_diagonal() const { return use_diagonal_; }
+
+private:
+    Vector3f K_R_;        // Attitude error gain
+    Vector3f K_Omega_;    // Angular velocity gain
+    Vector3f K_;          // Robust damping gain
+    float c_{2.0f};       // Composite error weight
+    float tau_max_{0.05f};
+    bool use_diagonal_{true};
+};
+
+/**
+ * @class FixedGains
+ * @brief Compile-time gains for frozen (certified) airframe configurations
+ *
+ * Has no setters: the controller setters are disabled for fixed configurations.
+ *
+ * @tparam Config configuration struct (see file header)
+ */
+template<typename Config>
+class FixedGains {
+public:
+    static constexpr bool is_fixed = true;
+
+    /**
+     * @brief No-op, the inertia model is fixed by Config::use_diagonal
+     */
+    void init(bool /* use_diagonal */) {}
+
+    static constexpr float K_R(int i) {
+        return (i == 0) ? Config::K_R_x : ((i == 1) ? Config::K_R_y : Config::K_R_z);
+    }
+
+    static constexpr float K_Omega(int i) {
+        return (i == 0) ? Config::K_Omega_x : ((i == 1) ? Config::K_Omega_y : Config::K_Omega_z);
+    }
+
+    static constexpr float K(int i) {
+        return (i == 0) ? Config::K_x : ((i == 1) ? Config::K_y : Config::K_z);
+    }
+
+    static constexpr float c() { return Config::c; }
+    static constexpr float tau_max() { return Config::tau_max; }
+    static constexpr bool use_diagonal() { return Config::use_diagonal; }
+
+    /**
+     * @brief Nominal inertia of the airframe (initial estimate)
+     */
+    static Matrix3f nominal_inertia() {
+        Matrix3f J = Matrix3f::Zero();
+        J(0, 0) = Config::J_xx;
+        J(1, 1) = Config::J_yy;
+        J(2, 2) = Config::J_zz;
+        return J;
+    }
+};
+
+} // namespace attitude_controller_aic
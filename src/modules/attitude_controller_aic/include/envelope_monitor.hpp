@@ -0,0 +1,191 @@
+/**
+ * @file envelope_monitor.hpp
+ * @brief Fast-path attitude envelope monitor for the AIC control loop
+ *
+ * Runs inside the control loop right after the torque is computed, so a
+ * violation switches the vehicle to the fixed-inertia PD fallback within the
+ * same tick instead of waiting for the companion computer (safety_manager.py
+ * acts at MAVLink rates, i.e. hundreds of milliseconds).
+ *
+ * Checks, all branch-light and free of trigonometry:
+ * - tilt: R(2,2) = cos(tilt) against a precomputed cosine limit
+ * - body rate: |Omega|^2 against the squared limit
+ * - error growth: |e_R| above a floor and non-decreasing for a minimum time
+ * - estimator divergence: inertia estimate pinned at J_min/J_max for a minimum time
+ * - non-finite torque command or angular velocity
+ *
+ * Trips latch until clear() is called (e.g. after landing).
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+using Matrix3f = matrix::Matrix3f;
+
+/**
+ * @class EnvelopeMonitor
+ * @brief Per-tick envelope checks with latched trip reasons
+ */
+class EnvelopeMonitor {
+public:
+    enum Trip : uint8_t {
+        TRIP_NONE = 0,
+        TRIP_TILT = 1 << 0,
+        TRIP_RATE = 1 << 1,
+        TRIP_ERROR_GROWTH = 1 << 2,
+        TRIP_ESTIMATOR = 1 << 3,
+        TRIP_NON_FINITE = 1 << 4,
+    };
+
+    /**
+     * @brief Initialize with default limits
+     */
+    void init() {
+        set_limits(1.22f, 10.f, 0.3f, 0.3f, 2.f);
+        clear();
+    }
+
+    /**
+     * @brief Set envelope limits
+     *
+     * @param max_tilt maximum tilt of the body z axis from vertical (rad)
+     * @param max_rate maximum body rate magnitude (rad/s)
+     * @param error_floor attitude error norm below which growth is ignored
+     * @param growth_time time the attitude error must keep growing to trip (s)
+     * @param pinned_time time the inertia estimate must stay at its bounds to trip (s)
+     */
+    void set_limits(float max_tilt, float max_rate, float error_floor, float growth_time, float pinned_time) {
+        cos_max_tilt_ = cosf(std::fmin(std::fmax(max_tilt, 0.f), static_cast<float>(M_PI)));
+        max_rate_sq_ = max_rate * max_rate;
+        error_floor_ = error_floor;
+        growth_time_ = growth_time;
+        pinned_time_ = pinned_time;
+    }
+
+    /**
+     * @brief Check one control tick
+     *
+     * @param R current attitude
+     * @param Omega current angular velocity (rad/s)
+     * @param e_R attitude error of this tick
+     * @param tau torque command of this tick
+     * @param estimate_at_bound inertia estimate is pinned at a projection bound
+     * @param in_flight apply the flight envelope checks (non-finite checks always run)
+     * @param dt timestep (s)
+     * @return trip reasons of this tick (Trip bitmask), also latched
+     */
+    uint8_t update(const Matrix3f &R, const Vector3f &Omega, const Vector3f &e_R,
+                   const Vector3f &tau, bool estimate_at_bound, bool in_flight, float dt) {
+        uint8_t trips = TRIP_NONE;
+
+        // Any NaN/Inf poisons the sums below
+        const float omega_sq = Omega(0) * Omega(0) + Omega(1) * Omega(1) + Omega(2) * Omega(2);
+
+        if (!std::isfinite(omega_sq) || !std::isfinite(tau(0) + tau(1) + tau(2))) {
+            trips |= TRIP_NON_FINITE;
+        }
+
+        if (in_flight) {
+            if (R(2, 2) < cos_max_tilt_) {
+                trips |= TRIP_TILT;
+            }
+
+            if (omega_sq > max_rate_sq_) {
+                trips |= TRIP_RATE;
+            }
+
+            const float error_sq = e_R(0) * e_R(0) + e_R(1) * e_R(1) + e_R(2) * e_R(2);
+
+            if (error_sq > error_floor_ * error_floor_ && error_sq >= error_sq_prev_) {
+                growth_elapsed_ += dt;
+
+            } else {
+                growth_elapsed_ = 0.f;
+            }
+
+            error_sq_prev_ = error_sq;
+
+            if (growth_elapsed_ > growth_time_) {
+                trips |= TRIP_ERROR_GROWTH;
+            }
+
+            pinned_elapsed_ = estimate_at_bound ? pinned_elapsed_ + dt : 0.f;
+
+            if (pinned_elapsed_ > pinned_time_) {
+                trips |= TRIP_ESTIMATOR;
+            }
+
+        } else {
+            growth_elapsed_ = 0.f;
+            pinned_elapsed_ = 0.f;
+            error_sq_prev_ = 0.f;
+        }
+
+        latched_ |= trips;
+        return trips;
+    }
+
+    /**
+     * @brief Check whether any trip is latched
+     */
+    bool tripped() const {
+        return latched_ != TRIP_NONE;
+    }
+
+    /**
+     * @brief Get latched trip reasons (Trip bitmask)
+     */
+    uint8_t get_trip_reasons() const {
+        return latched_;
+    }
+
+    /**
+     * @brief Release the latch and restart the timed checks
+     */
+    void clear() {
+        latched_ = TRIP_NONE;
+        growth_elapsed_ = 0.f;
+        pinned_elapsed_ = 0.f;
+        error_sq_prev_ = 0.f;
+    }
+
+    /**
+     * @brief Name of the most significant trip reason in a bitmask
+     */
+    static const char *trip_name(uint8_t trips) {
+        if (trips & TRIP_NON_FINITE) { return "non-finite"; }
+
+        if (trips & TRIP_ESTIMATOR) { return "estimator divergence"; }
+
+        if (trips & TRIP_TILT) { return "tilt"; }
+
+        if (trips & TRIP_RATE) { return "rate"; }
+
+        if (trips & TRIP_ERROR_GROWTH) { return "error growth"; }
+
+        return "none";
+    }
+
+private:
+    // Limits
+    float cos_max_tilt_{0.34f};
+    float max_rate_sq_{100.f};
+    float error_floor_{0.3f};
+    float growth_time_{0.3f};
+    float pinned_time_{2.f};
+
+    // Timed check state
+    float error_sq_prev_{0.f};
+    float growth_elapsed_{0.f};
+    float pinned_elapsed_{0.f};
+
+    uint8_t latched_{TRIP_NONE};
+};
+
+} // namespace attitude_controller_aic
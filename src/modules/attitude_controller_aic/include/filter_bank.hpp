@@ -0,0 +1,237 @@
+/**
+ * @file filter_bank.hpp
+ * @brief Composite error filter bank: low-pass plus tracking notches
+ *
+ * Cascade of biquad sections evaluated on all three axes at once:
+ * - one low-pass section (first-order IIR or second-order Butterworth)
+ * - up to MAX_NOTCHES notch sections tracking motor vibration peaks
+ *
+ * Section states are stored per lane (x, y, z, padding) so that the inner
+ * loop maps onto one 4-wide SIMD operation (SSE/NEON) on targets that have
+ * it; on FPU-only microcontrollers it stays a plain unrolled loop.
+ * Coefficients are only recomputed by the setters, and only when the
+ * requested frequency or the sample rate moves beyond a small hysteresis
+ * (or a notch bandwidth changes).
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+
+/**
+ * @class FilterBank
+ * @brief Three-axis biquad cascade for the composite error
+ */
+class FilterBank {
+public:
+    static constexpr int MAX_NOTCHES = 2;
+    static constexpr int LANES = 4;  // 3 axes padded to the SIMD width
+
+    // Relative change of frequency or sample rate that triggers a coefficient update
+    static constexpr float HYSTERESIS = 0.02f;
+
+    /**
+     * @brief Initialize as the legacy one-pole low-pass (alpha = 0.1), notches disabled
+     */
+    void init() {
+        for (int k = 0; k < MAX_SECTIONS; ++k) {
+            sections_[k] = Section{};
+        }
+
+        set_first_order_lowpass(0.1f);
+        reset();
+    }
+
+    /**
+     * @brief First-order low-pass y = alpha * x + (1 - alpha) * y_prev
+     * @param alpha filter coefficient (0-1, larger = faster response)
+     */
+    void set_first_order_lowpass(float alpha) {
+        alpha = std::max(0.0f, std::min(alpha, 1.0f));
+        Section &lp = sections_[0];
+        lp.b0 = alpha;
+        lp.b1 = 0.f;
+        lp.b2 = 0.f;
+        lp.a1 = -(1.f - alpha);
+        lp.a2 = 0.f;
+        lp.active = true;
+        lp.design_hz = 0.f;
+        lp.sample_rate_hz = 0.f;
+    }
+
+    /**
+     * @brief Second-order Butterworth low-pass
+     *
+     * Less phase lag than a one-pole filter with the same noise attenuation
+     * above cutoff.
+     *
+     * @param cutoff_hz cutoff frequency (Hz), <= 0 or above Nyquist bypasses the section
+     * @param sample_rate_hz update rate of the filter (Hz)
+     */
+    void set_lowpass(float cutoff_hz, float sample_rate_hz) {
+        Section &lp = sections_[0];
+
+        if (!lp.design_moved(cutoff_hz, sample_rate_hz)) {
+            return;
+        }
+
+        lp.design_hz = cutoff_hz;
+        lp.sample_rate_hz = sample_rate_hz;
+
+        if (cutoff_hz <= 0.f || sample_rate_hz <= 0.f || cutoff_hz >= 0.5f * sample_rate_hz) {
+            lp.set_passthrough();
+            return;
+        }
+
+        const float ohm = tanf(static_cast<float>(M_PI) * cutoff_hz / sample_rate_hz);
+        const float c = 1.f + 2.f * cosf(static_cast<float>(M_PI) / 4.f) * ohm + ohm * ohm;
+        lp.b0 = ohm * ohm / c;
+        lp.b1 = 2.f * lp.b0;
+        lp.b2 = lp.b0;
+        lp.a1 = 2.f * (ohm * ohm - 1.f) / c;
+        lp.a2 = (1.f - 2.f * cosf(static_cast<float>(M_PI) / 4.f) * ohm + ohm * ohm) / c;
+        lp.active = true;
+    }
+
+    /**
+     * @brief Place a notch at the given center frequency
+     *
+     * Cheap when nothing moved: coefficients are only recomputed when the
+     * center frequency or sample rate changes by more than the hysteresis,
+     * or the bandwidth changes.
+     *
+     * @param index notch index (0 .. MAX_NOTCHES-1)
+     * @param center_hz notch center (Hz), <= 0 or above Nyquist disables the notch
+     * @param bandwidth_hz notch -3 dB bandwidth (Hz)
+     * @param sample_rate_hz update rate of the filter (Hz)
+     */
+    void set_notch(int index, float center_hz, float bandwidth_hz, float sample_rate_hz) {
+        if (index < 0 || index >= MAX_NOTCHES) {
+            return;
+        }
+
+        Section &notch = sections_[1 + index];
+
+        if (!notch.design_moved(center_hz, sample_rate_hz) && bandwidth_hz == notch.bandwidth_hz) {
+            return;
+        }
+
+        notch.design_hz = center_hz;
+        notch.bandwidth_hz = bandwidth_hz;
+        notch.sample_rate_hz = sample_rate_hz;
+
+        if (center_hz <= 0.f || bandwidth_hz <= 0.f || sample_rate_hz <= 0.f
+            || center_hz + 0.5f * bandwidth_hz >= 0.5f * sample_rate_hz) {
+            notch.active = false;
+            return;
+        }
+
+        const float alpha = tanf(static_cast<float>(M_PI) * bandwidth_hz / sample_rate_hz);
+        const float beta = -cosf(2.f * static_cast<float>(M_PI) * center_hz / sample_rate_hz);
+        const float a0_inv = 1.f / (alpha + 1.f);
+        notch.b0 = a0_inv;
+        notch.b1 = 2.f * beta * a0_inv;
+        notch.b2 = a0_inv;
+        notch.a1 = notch.b1;
+        notch.a2 = (1.f - alpha) * a0_inv;
+
+        if (!notch.active) {
+            // Clear stale state of a re-enabled notch
+            for (int l = 0; l < LANES; ++l) {
+                notch.z1[l] = 0.f;
+                notch.z2[l] = 0.f;
+            }
+        }
+
+        notch.active = true;
+    }
+
+    /**
+     * @brief Disable a notch
+     */
+    void disable_notch(int index) {
+        if (index >= 0 && index < MAX_NOTCHES) {
+            sections_[1 + index].active = false;
+            sections_[1 + index].design_hz = 0.f;
+        }
+    }
+
+    /**
+     * @brief Filter one three-axis sample through the active sections
+     */
+    Vector3f apply(const Vector3f &x) {
+        alignas(16) float v[LANES] = {x(0), x(1), x(2), 0.f};
+
+        for (int k = 0; k < MAX_SECTIONS; ++k) {
+            Section &sec = sections_[k];
+
+            if (!sec.active) {
+                continue;
+            }
+
+            // Transposed direct form II, one lane per axis
+            for (int l = 0; l < LANES; ++l) {
+                const float y = sec.b0 * v[l] + sec.z1[l];
+                sec.z1[l] = sec.b1 * v[l] - sec.a1 * y + sec.z2[l];
+                sec.z2[l] = sec.b2 * v[l] - sec.a2 * y;
+                v[l] = y;
+            }
+        }
+
+        return Vector3f(v[0], v[1], v[2]);
+    }
+
+    /**
+     * @brief Clear filter states (output restarts from zero)
+     */
+    void reset() {
+        for (int k = 0; k < MAX_SECTIONS; ++k) {
+            for (int l = 0; l < LANES; ++l) {
+                sections_[k].z1[l] = 0.f;
+                sections_[k].z2[l] = 0.f;
+            }
+        }
+    }
+
+    float get_notch_frequency(int index) const {
+        return (index >= 0 && index < MAX_NOTCHES && sections_[1 + index].active) ? sections_[1 + index].design_hz : 0.f;
+    }
+
+private:
+    static constexpr int MAX_SECTIONS = 1 + MAX_NOTCHES;
+
+    struct Section {
+        alignas(16) float z1[LANES] {};
+        alignas(16) float z2[LANES] {};
+        float b0{1.f};
+        float b1{0.f};
+        float b2{0.f};
+        float a1{0.f};
+        float a2{0.f};
+        float design_hz{0.f};        // Cutoff / center frequency of the current coefficients
+        float bandwidth_hz{0.f};     // Notch bandwidth of the current coefficients
+        float sample_rate_hz{0.f};   // Sample rate of the current coefficients
+        bool active{false};
+
+        bool design_moved(float requested_hz, float requested_sample_rate_hz) const {
+            return std::fabs(requested_hz - design_hz) > HYSTERESIS * std::max(std::fabs(design_hz), 1.f)
+                   || std::fabs(requested_sample_rate_hz - sample_rate_hz) > HYSTERESIS * sample_rate_hz;
+        }
+
+        void set_passthrough() {
+            b0 = 1.f;
+            b1 = b2 = a1 = a2 = 0.f;
+            active = false;
+        }
+    };
+
+    Section sections_[MAX_SECTIONS];  // [0]: low-pass, [1..]: notches
+};
+
+} // namespace attitude_controller_aic
@@ -0,0 +1,135 @@
+/**
+ * @file fixed_point.hpp
+ * @brief Saturating Q-format fixed-point arithmetic for FPU-less targets
+ *
+ * Q<F> stores a value x as the int32 round(x * 2^F). All arithmetic goes
+ * through 64-bit intermediates (a single SMULL/UMULL on Cortex-M3) and
+ * saturates to the int32 range instead of wrapping, so an overflowing
+ * product or sum clips at the representable limit with the right sign.
+ *
+ * Products of different formats are written mul<F_out>(a, b), which
+ * shifts the 64-bit product once with round-to-nearest.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace attitude_controller_aic {
+namespace fixed {
+
+/**
+ * @brief Clip a 64-bit intermediate to the int32 range
+ */
+inline int32_t saturate32(int64_t x) {
+    return (x > INT32_MAX) ? INT32_MAX : (x < INT32_MIN) ? INT32_MIN : static_cast<int32_t>(x);
+}
+
+/**
+ * @brief Arithmetic right shift with round-to-nearest (shift > 0), or left shift (shift <= 0)
+ */
+inline int64_t shift_round(int64_t x, int shift) {
+    if (shift > 0) {
+        return (x + (int64_t(1) << (shift - 1))) >> shift;
+    }
+
+    return x * (int64_t(1) << -shift);
+}
+
+/**
+ * @class Q
+ * @brief Signed 32-bit fixed-point number with F fractional bits
+ */
+template<int F>
+class Q {
+public:
+    static_assert(F > 0 && F < 31, "fractional bits must be in [1, 30]");
+    static constexpr int FRAC_BITS = F;
+
+    constexpr Q() = default;
+
+    static constexpr Q from_raw(int32_t raw) {
+        return Q(raw, 0);
+    }
+
+    /**
+     * @brief Convert from float (configuration time only: soft-float on FPU-less targets)
+     */
+    static Q from_float(float x) {
+        const float scaled = x * static_cast<float>(int64_t(1) << F);
+        const float rounded = scaled + ((scaled >= 0.f) ? 0.5f : -0.5f);
+
+        if (rounded >= 2147483647.f) {
+            return from_raw(INT32_MAX);
+        }
+
+        if (rounded <= -2147483648.f) {
+            return from_raw(INT32_MIN);
+        }
+
+        return from_raw(static_cast<int32_t>(rounded));
+    }
+
+    static constexpr Q from_int(int32_t x) {
+        return Q(static_cast<int32_t>(x * (int64_t(1) << F)), 0);
+    }
+
+    float to_float() const {
+        return static_cast<float>(raw_) / static_cast<float>(int64_t(1) << F);
+    }
+
+    constexpr int32_t raw() const { return raw_; }
+
+    /**
+     * @brief Convert to another format (saturating)
+     */
+    template<int G>
+    Q<G> convert() const {
+        return Q<G>::from_raw(saturate32(shift_round(raw_, F - G)));
+    }
+
+    Q operator+(Q b) const { return from_raw(saturate32(int64_t(raw_) + b.raw_)); }
+    Q operator-(Q b) const { return from_raw(saturate32(int64_t(raw_) - b.raw_)); }
+    Q operator-() const { return from_raw(saturate32(-int64_t(raw_))); }
+    Q operator*(Q b) const { return from_raw(saturate32(shift_round(int64_t(raw_) * b.raw_, F))); }
+
+    Q &operator+=(Q b) { return *this = *this + b; }
+    Q &operator-=(Q b) { return *this = *this - b; }
+
+    bool operator<(Q b) const { return raw_ < b.raw_; }
+    bool operator>(Q b) const { return raw_ > b.raw_; }
+    bool operator<=(Q b) const { return raw_ <= b.raw_; }
+    bool operator>=(Q b) const { return raw_ >= b.raw_; }
+    bool operator==(Q b) const { return raw_ == b.raw_; }
+
+private:
+    constexpr Q(int32_t raw, int) : raw_(raw) {}
+
+    int32_t raw_{0};
+};
+
+/**
+ * @brief Product of two formats rounded into a third (saturating)
+ */
+template<int FOut, int A, int B>
+inline Q<FOut> mul(Q<A> a, Q<B> b) {
+    return Q<FOut>::from_raw(saturate32(shift_round(int64_t(a.raw()) * b.raw(), A + B - FOut)));
+}
+
+template<int F>
+inline Q<F> min(Q<F> a, Q<F> b) {
+    return (a < b) ? a : b;
+}
+
+template<int F>
+inline Q<F> max(Q<F> a, Q<F> b) {
+    return (a > b) ? a : b;
+}
+
+template<int F>
+inline Q<F> constrain(Q<F> x, Q<F> lo, Q<F> hi) {
+    return max(lo, min(x, hi));
+}
+
+} // namespace fixed
+} // namespace attitude_controller_aic
@@ -0,0 +1,184 @@
+/**
+ * @file fleet_prior.hpp
+ * @brief Estimator records of a flight and the fleet inertia prior table
+ *
+ * After each flight the module appends an estimator record (inertia
+ * estimate, information gathered in flight, airframe and payload IDs) to a
+ * CSV file. The offline fleet tool (tools/aic_fleet_prior) fits a prior per
+ * airframe and payload from the records of many vehicles and writes a
+ * binary prior table; at boot the module looks up its airframe and payload
+ * in the table and starts from the prior inertia with the prior information
+ * instead of the uninformative default.
+ *
+ * Parameter order everywhere: [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz]. A product of
+ * inertia with zero information was not estimated (diagonal model).
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace attitude_controller_aic {
+
+static constexpr int PRIOR_PARAMETERS = 6;
+
+/**
+ * @brief Inertia estimate at the end of one flight
+ */
+struct EstimatorRecord {
+    uint16_t vehicle_id;
+    uint16_t airframe_id;
+    uint16_t payload_id;
+    float flight_time;                      // Time in air (s)
+    bool excited;                           // Persistent excitation seen during the flight
+    float theta[PRIOR_PARAMETERS];          // Inertia estimate (kg*m^2)
+    float information[PRIOR_PARAMETERS];    // Information diagonal gathered since boot, without the prior
+};
+
+static constexpr char ESTIMATOR_RECORD_HEADER[] =
+    "vehicle_id,airframe_id,payload_id,flight_time,excited,"
+    "Jxx,Jyy,Jzz,Jxy,Jxz,Jyz,P_xx,P_yy,P_zz,P_xy,P_xz,P_yz\n";
+
+/**
+ * @brief CSV line of a record (with newline)
+ * @return characters written (excluding the terminator), or 0 if the buffer is too small
+ */
+inline int format_estimator_record(const EstimatorRecord &record, char *buffer, size_t size) {
+    const float *t = record.theta;
+    const float *p = record.information;
+    const int length = snprintf(buffer, size,
+                                "%u,%u,%u,%.1f,%d,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+                                (unsigned)record.vehicle_id, (unsigned)record.airframe_id,
+                                (unsigned)record.payload_id, (double)record.flight_time, record.excited ? 1 : 0,
+                                (double)t[0], (double)t[1], (double)t[2], (double)t[3], (double)t[4], (double)t[5],
+                                (double)p[0], (double)p[1], (double)p[2], (double)p[3], (double)p[4], (double)p[5]);
+    return (length > 0 && static_cast<size_t>(length) < size) ? length : 0;
+}
+
+/**
+ * @brief Parse a CSV line (the header line and malformed lines return false)
+ */
+inline bool parse_estimator_record(const char *line, EstimatorRecord &record) {
+    unsigned ids[3];
+    int excited;
+    float *t = record.theta;
+    float *p = record.information;
+
+    if (sscanf(line, "%u,%u,%u,%f,%d,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f",
+               &ids[0], &ids[1], &ids[2], &record.flight_time, &excited,
+               &t[0], &t[1], &t[2], &t[3], &t[4], &t[5], &p[0], &p[1], &p[2], &p[3], &p[4], &p[5]) != 17) {
+        return false;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        if (ids[i] > 0xffff) {
+            return false;
+        }
+    }
+
+    record.vehicle_id = static_cast<uint16_t>(ids[0]);
+    record.airframe_id = static_cast<uint16_t>(ids[1]);
+    record.payload_id = static_cast<uint16_t>(ids[2]);
+    record.excited = (excited != 0);
+
+    for (int i = 0; i < PRIOR_PARAMETERS; ++i) {
+        if (!std::isfinite(t[i]) || !std::isfinite(p[i]) || p[i] < 0.f) {
+            return false;
+        }
+    }
+
+    return std::isfinite(record.flight_time);
+}
+
+// Prior table: header followed by the entries, little-endian
+static constexpr uint32_t PRIOR_TABLE_MAGIC = 0x50434941;   // "AICP"
+static constexpr uint16_t PRIOR_TABLE_VERSION = 1;
+static constexpr uint16_t PRIOR_ANY_PAYLOAD = 0xffff;       // Airframe-wide entry, pooled over payloads
+
+#pragma pack(push, 1)
+
+struct PriorTableHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_size;
+    uint32_t entries;
+    uint32_t reserved;
+};
+
+struct PriorEntry {
+    uint16_t airframe_id;
+    uint16_t payload_id;                    // PRIOR_ANY_PAYLOAD: any payload of the airframe
+    uint16_t vehicles;                      // Vehicles the prior was fitted on (after outlier rejection)
+    uint16_t rejected;                      // Vehicles rejected as outliers
+    float theta[PRIOR_PARAMETERS];          // Prior inertia (kg*m^2)
+    float sigma[PRIOR_PARAMETERS];          // Prior standard deviation (kg*m^2)
+    float information[PRIOR_PARAMETERS];    // Initial information diagonal of the estimator
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(PriorTableHeader) == 16, "unexpected prior table header size");
+static_assert(sizeof(PriorEntry) == 80, "unexpected prior entry size");
+
+/**
+ * @brief Entry usable as an initial estimate
+ */
+inline bool is_valid_prior(const PriorEntry &entry) {
+    for (int i = 0; i < PRIOR_PARAMETERS; ++i) {
+        if (!std::isfinite(entry.theta[i]) || !std::isfinite(entry.sigma[i]) || !std::isfinite(entry.information[i])
+            || entry.sigma[i] < 0.f || entry.information[i] < 0.f) {
+            return false;
+        }
+    }
+
+    return entry.theta[0] > 0.f && entry.theta[1] > 0.f && entry.theta[2] > 0.f;
+}
+
+/**
+ * @brief Look up the prior of an airframe and payload in a table
+ *
+ * An exact entry is preferred over the airframe-wide one; invalid entries
+ * are skipped.
+ *
+ * @param read reads the next n bytes of the table into a buffer: bool read(void *buffer, size_t n)
+ * @return 2 exact match, 1 airframe-wide match, 0 none (or a malformed table)
+ */
+template<typename Read>
+int find_prior(Read read, uint16_t airframe_id, uint16_t payload_id, PriorEntry &prior) {
+    PriorTableHeader header;
+
+    if (!read(&header, sizeof(header)) || header.magic != PRIOR_TABLE_MAGIC
+        || header.version != PRIOR_TABLE_VERSION || header.entry_size != sizeof(PriorEntry)) {
+        return 0;
+    }
+
+    int match = 0;
+
+    for (uint32_t i = 0; i < header.entries && match < 2; ++i) {
+        PriorEntry entry;
+
+        if (!read(&entry, sizeof(entry))) {
+            return 0;
+        }
+
+        if (entry.airframe_id != airframe_id || !is_valid_prior(entry)) {
+            continue;
+        }
+
+        if (entry.payload_id == payload_id) {
+            prior = entry;
+            match = 2;
+
+        } else if (entry.payload_id == PRIOR_ANY_PAYLOAD && match == 0) {
+            prior = entry;
+            match = 1;
+        }
+    }
+
+    return match;
+}
+
+} // namespace attitude_controller_aic
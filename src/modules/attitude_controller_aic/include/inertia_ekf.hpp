@@ -0,0 +1,479 @@
+/**
+ * @file inertia_ekf.hpp
+ * @brief Joint angular rate and inertia extended Kalman filter
+ *
+ * The gradient estimators take the measured rates as exact and adapt theta
+ * from the tracking error. This filter instead estimates the rates and the
+ * full inertia together, x = [Omega (3), theta (6)] with
+ * theta = [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz]:
+ *
+ *   predict  J * dOmega/dt = tau - Omega x (J * Omega)   (applied torque as the input)
+ *            theta constant (random walk: payload changes)
+ *   update   gyro = Omega + noise
+ *
+ * The prediction is the regressor's model (regressor.hpp) solved for
+ * dOmega/dt, so the EKF and the gradient estimators fit the same theta.
+ *
+ * so the inertia is learned from how the rates respond to the torque, the
+ * gyro noise is weighed against the model, and P gives the covariance of
+ * theta (how far to trust J_hat).
+ *
+ * Cost: P is symmetric 9x9, kept packed (45 floats), and both steps are
+ * written out for the structure of the model instead of as general 9x9
+ * products:
+ *
+ *   F = [M  Bd]   M = I + dt * da/dOmega (3x3), Bd = dt * da/dtheta (3x6)
+ *       [0  I ]
+ *
+ *   P_tt   += Q_theta
+ *   P_wt    = M * P_wt + Bd * P_tt
+ *   P_ww    = (M * P_ww + Bd * P_tw) * M^T + P_wt' * Bd^T + Q_Omega
+ *
+ * and the gyro update (H = [I 0]) is a symmetric rank-3 downdate with a
+ * closed-form 3x3 inverse. About 1000 flops per tick, no Eigen.
+ *
+ * Innovations beyond the chi-square gate are rejected (a gyro glitch must
+ * not move theta); theta is projected to principal moments within
+ * [J_min, J_max] and products small enough to keep J diagonally dominant,
+ * so J stays positive definite for the next prediction.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+using Matrix3f = matrix::Matrix3f;
+
+struct InertiaEKFSettings {
+    float gyro_noise{0.005f};            // Rate measurement noise (rad/s, 1 sigma)
+    float acceleration_noise{0.03f};     // Unmodeled angular acceleration (rad/s^2 / sqrt(Hz))
+    float inertia_drift{0.01f};          // Inertia random walk, relative to the initial moments (1 / sqrt(s))
+    float initial_uncertainty{0.3f};     // Initial inertia standard deviation, relative
+    float innovation_gate{16.3f};        // Chi-square, 3 degrees of freedom (99.9 %)
+    float J_min{0.01f};
+    float J_max{1.0f};
+    float product_ratio{0.45f};          // |J_ij| <= ratio * min(J_ii, J_jj): J diagonally dominant
+};
+
+/**
+ * @class InertiaEKF
+ * @brief Extended Kalman filter of [Omega, theta] with the applied torque as input
+ */
+class InertiaEKF {
+public:
+    static constexpr int N = 9;
+    static constexpr int PACKED = N * (N + 1) / 2;
+    static constexpr int STATE_WORDS = N + PACKED;
+
+    /**
+     * @brief Start from an inertia estimate; the rates are set by the first measurement
+     */
+    void init(const Matrix3f &J_init, const InertiaEKFSettings &settings) {
+        settings_ = settings;
+
+        for (int i = 0; i < N; ++i) {
+            x_[i] = 0.f;
+        }
+
+        x_[3] = J_init(0, 0);
+        x_[4] = J_init(1, 1);
+        x_[5] = J_init(2, 2);
+        x_[6] = J_init(0, 1);
+        x_[7] = J_init(0, 2);
+        x_[8] = J_init(1, 2);
+
+        scale_ = std::max((std::fabs(x_[3]) + std::fabs(x_[4]) + std::fabs(x_[5])) / 3.f, settings_.J_min);
+        project();
+
+        for (int i = 0; i < PACKED; ++i) {
+            P_[i] = 0.f;
+        }
+
+        const float theta_variance = square(settings_.initial_uncertainty * scale_);
+
+        for (int i = 0; i < 3; ++i) {
+            p(i, i) = square(settings_.gyro_noise);
+            p(3 + i, 3 + i) = theta_variance;
+            p(6 + i, 6 + i) = 0.25f * theta_variance;   // Products: a fraction of the moments
+        }
+
+        started_ = false;
+        rejected_ = 0;
+    }
+
+    /**
+     * @brief Change the noise model without restarting
+     */
+    void set_noise(float gyro_noise, float acceleration_noise) {
+        settings_.gyro_noise = gyro_noise;
+        settings_.acceleration_noise = acceleration_noise;
+    }
+
+    /**
+     * @brief Restart the rates from a measurement, inertia and its covariance kept
+     */
+    void restart_rate(const Vector3f &Omega) {
+        if (!finite(Omega)) {
+            return;
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            x_[i] = Omega(i);
+
+            for (int j = 0; j < N; ++j) {
+                p(i, j) = 0.f;
+            }
+
+            p(i, i) = square(settings_.gyro_noise);
+        }
+
+        started_ = true;
+    }
+
+    /**
+     * @brief Propagate over dt with the torque applied during the interval
+     */
+    void predict(const Vector3f &tau, float dt) {
+        if (!started_ || !(dt > 0.f) || !finite(tau)) {
+            return;
+        }
+
+        const float *w = x_;
+        const float *t = x_ + 3;
+
+        // J, J^-1 (symmetric, cofactors)
+        const float J[3][3] = {{t[0], t[3], t[4]}, {t[3], t[1], t[5]}, {t[4], t[5], t[2]}};
+        float Ji[3][3];
+
+        if (!invert_symmetric(J, Ji)) {
+            return;
+        }
+
+        // a = J^-1 (tau - w x Jw)
+        const float Jw[3] = {dot(J[0], w), dot(J[1], w), dot(J[2], w)};
+        float h[3];
+        cross(w, Jw, h);
+        h[0] = tau(0) - h[0];
+        h[1] = tau(1) - h[1];
+        h[2] = tau(2) - h[2];
+        const float a[3] = {dot(Ji[0], h), dot(Ji[1], h), dot(Ji[2], h)};
+
+        // da/dw = -J^-1 ([w]x J - [Jw]x): column k is -J^-1 (w x J e_k - Jw x e_k)
+        float D[3][3];
+
+        for (int k = 0; k < 3; ++k) {
+            const float Je[3] = {J[0][k], J[1][k], J[2][k]};
+            const float e[3] = {k == 0 ? 1.f : 0.f, k == 1 ? 1.f : 0.f, k == 2 ? 1.f : 0.f};
+            float c1[3], c2[3];
+            cross(w, Je, c1);
+            cross(Jw, e, c2);
+
+            for (int r = 0; r < 3; ++r) {
+                D[r][k] = c1[r] - c2[r];
+            }
+        }
+
+        // da/dtheta_i = -J^-1 (E_i a + w x (E_i w)), E_i = dJ/dtheta_i
+        float Y[3][6];
+
+        for (int i = 0; i < 6; ++i) {
+            float Ea[3], Ew[3], c[3];
+            unit_product(i, a, Ea);
+            unit_product(i, w, Ew);
+            cross(w, Ew, c);
+
+            for (int r = 0; r < 3; ++r) {
+                Y[r][i] = Ea[r] + c[r];
+            }
+        }
+
+        // M = I + dt * da/dw, Bd = dt * da/dtheta
+        float M[3][3];
+        float Bd[3][6];
+
+        for (int r = 0; r < 3; ++r) {
+            for (int k = 0; k < 3; ++k) {
+                M[r][k] = ((r == k) ? 1.f : 0.f) - dt * (Ji[r][0] * D[0][k] + Ji[r][1] * D[1][k] + Ji[r][2] * D[2][k]);
+            }
+
+            for (int i = 0; i < 6; ++i) {
+                Bd[r][i] = -dt * (Ji[r][0] * Y[0][i] + Ji[r][1] * Y[1][i] + Ji[r][2] * Y[2][i]);
+            }
+        }
+
+        // G = M * P_wt + Bd * P_tt (the new P_wt), K1 = M * P_ww + Bd * P_tw
+        float G[3][6];
+        float K1[3][3];
+
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 6; ++c) {
+                float g = 0.f;
+
+                for (int k = 0; k < 3; ++k) {
+                    g += M[r][k] * p(k, 3 + c);
+                }
+
+                for (int k = 0; k < 6; ++k) {
+                    g += Bd[r][k] * p(3 + k, 3 + c);
+                }
+
+                G[r][c] = g;
+            }
+
+            for (int c = 0; c < 3; ++c) {
+                float k1 = 0.f;
+
+                for (int k = 0; k < 3; ++k) {
+                    k1 += M[r][k] * p(k, c);
+                }
+
+                for (int k = 0; k < 6; ++k) {
+                    k1 += Bd[r][k] * p(3 + k, c);
+                }
+
+                K1[r][c] = k1;
+            }
+        }
+
+        // P_ww = K1 * M^T + G * Bd^T (upper triangle)
+        for (int r = 0; r < 3; ++r) {
+            for (int c = r; c < 3; ++c) {
+                float v = 0.f;
+
+                for (int k = 0; k < 3; ++k) {
+                    v += K1[r][k] * M[c][k];
+                }
+
+                for (int k = 0; k < 6; ++k) {
+                    v += G[r][k] * Bd[c][k];
+                }
+
+                p(r, c) = v;
+            }
+        }
+
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 6; ++c) {
+                p(r, 3 + c) = G[r][c];
+            }
+        }
+
+        // Process noise
+        const float q_w = square(settings_.acceleration_noise) * dt;
+        const float q_t = square(settings_.inertia_drift * scale_) * dt;
+
+        for (int i = 0; i < 3; ++i) {
+            p(i, i) += q_w;
+            p(3 + i, 3 + i) += q_t;
+            p(6 + i, 6 + i) += q_t;
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            x_[i] += dt * a[i];
+        }
+    }
+
+    /**
+     * @brief Gyro update
+     *
+     * @param weight per-axis confidence in the measurement (0..1, vibration gating): the
+     *               noise variance is divided by it
+     * @return false if the innovation was rejected (gate, non-finite) or the filter has not started
+     */
+    bool update(const Vector3f &Omega, const float weight[3]) {
+        if (!started_ || !finite(Omega)) {
+            return false;
+        }
+
+        // S = P_ww + R, innovation
+        float S[3][3];
+        float nu[3];
+
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                S[r][c] = p(r, c);
+            }
+
+            S[r][r] += square(settings_.gyro_noise) / std::max(weight[r], 1e-3f);
+            nu[r] = Omega(r) - x_[r];
+        }
+
+        float Si[3][3];
+
+        if (!invert_symmetric(S, Si)) {
+            return false;
+        }
+
+        const float d2 = nu[0] * dot(Si[0], nu) + nu[1] * dot(Si[1], nu) + nu[2] * dot(Si[2], nu);
+
+        if (!std::isfinite(d2) || d2 > settings_.innovation_gate) {
+            ++rejected_;
+            return false;
+        }
+
+        // C = P H^T = P(:, 0:3), W = C * S^-1 (the gain)
+        float C[N][3];
+        float W[N][3];
+
+        for (int i = 0; i < N; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                C[i][k] = p(i, k);
+            }
+
+            for (int k = 0; k < 3; ++k) {
+                W[i][k] = C[i][0] * Si[0][k] + C[i][1] * Si[1][k] + C[i][2] * Si[2][k];
+            }
+        }
+
+        // x += W * nu, P -= W * C^T (upper triangle, symmetric by construction)
+        for (int i = 0; i < N; ++i) {
+            x_[i] += dot(W[i], nu);
+
+            for (int j = i; j < N; ++j) {
+                p(i, j) -= W[i][0] * C[j][0] + W[i][1] * C[j][1] + W[i][2] * C[j][2];
+            }
+
+            p(i, i) = std::max(p(i, i), 1e-12f);
+        }
+
+        project();
+        return true;
+    }
+
+    bool is_started() const { return started_; }
+
+    Vector3f rate() const { return Vector3f(x_[0], x_[1], x_[2]); }
+
+    /**
+     * @brief Inertia parameter [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz] (index < 6)
+     */
+    float parameter(int index) const { return x_[3 + index]; }
+
+    Matrix3f inertia() const {
+        Matrix3f J;
+        J(0, 0) = x_[3];
+        J(1, 1) = x_[4];
+        J(2, 2) = x_[5];
+        J(0, 1) = J(1, 0) = x_[6];
+        J(0, 2) = J(2, 0) = x_[7];
+        J(1, 2) = J(2, 1) = x_[8];
+        return J;
+    }
+
+    /**
+     * @brief Covariance of two states (0..2 rates, 3..8 inertia parameters)
+     */
+    float covariance(int i, int j) const { return P_[packed(i, j)]; }
+
+    float inertia_variance(int index) const { return covariance(3 + index, 3 + index); }
+
+    uint32_t rejected() const { return rejected_; }
+
+    /**
+     * @brief Flip one bit of the filter state: x, then the packed P (memory upset injection)
+     */
+    void flip_state_bit(int word, int bit) {
+        float *value = (word < N) ? &x_[word] : &P_[word - N];
+        uint32_t bits;
+        memcpy(&bits, value, sizeof(bits));
+        bits ^= 1u << (bit & 31);
+        memcpy(value, &bits, sizeof(bits));
+    }
+
+private:
+    // Row-major upper triangle: (i, j), i <= j
+    static constexpr int packed(int i, int j) {
+        return (i <= j) ? i * N - i * (i - 1) / 2 + (j - i) : packed(j, i);
+    }
+
+    float &p(int i, int j) { return P_[packed(i, j)]; }
+    float p(int i, int j) const { return P_[packed(i, j)]; }
+
+    static float square(float v) { return v * v; }
+    static float dot(const float a[3], const float b[3]) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+    static bool finite(const Vector3f &v) {
+        return std::isfinite(v(0)) && std::isfinite(v(1)) && std::isfinite(v(2));
+    }
+
+    static void cross(const float a[3], const float b[3], float c[3]) {
+        c[0] = a[1] * b[2] - a[2] * b[1];
+        c[1] = a[2] * b[0] - a[0] * b[2];
+        c[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    /**
+     * @brief E_i * v with E_i = dJ/dtheta_i
+     */
+    static void unit_product(int i, const float v[3], float out[3]) {
+        out[0] = out[1] = out[2] = 0.f;
+
+        switch (i) {
+        case 0: out[0] = v[0]; break;
+
+        case 1: out[1] = v[1]; break;
+
+        case 2: out[2] = v[2]; break;
+
+        case 3: out[0] = v[1]; out[1] = v[0]; break;
+
+        case 4: out[0] = v[2]; out[2] = v[0]; break;
+
+        default: out[1] = v[2]; out[2] = v[1]; break;
+        }
+    }
+
+    static bool invert_symmetric(const float A[3][3], float Ai[3][3]) {
+        const float c00 = A[1][1] * A[2][2] - A[1][2] * A[1][2];
+        const float c01 = A[0][2] * A[1][2] - A[0][1] * A[2][2];
+        const float c02 = A[0][1] * A[1][2] - A[0][2] * A[1][1];
+        const float det = A[0][0] * c00 + A[0][1] * c01 + A[0][2] * c02;
+
+        if (!(std::fabs(det) > 1e-30f) || !std::isfinite(det)) {
+            return false;
+        }
+
+        const float k = 1.f / det;
+        Ai[0][0] = k * c00;
+        Ai[0][1] = Ai[1][0] = k * c01;
+        Ai[0][2] = Ai[2][0] = k * c02;
+        Ai[1][1] = k * (A[0][0] * A[2][2] - A[0][2] * A[0][2]);
+        Ai[1][2] = Ai[2][1] = k * (A[0][1] * A[0][2] - A[0][0] * A[1][2]);
+        Ai[2][2] = k * (A[0][0] * A[1][1] - A[0][1] * A[0][1]);
+        return true;
+    }
+
+    void project() {
+        float *t = x_ + 3;
+
+        for (int i = 0; i < 3; ++i) {
+            // NaN fails both comparisons and ends at J_min
+            t[i] = (t[i] <= settings_.J_max) ? std::max(t[i], settings_.J_min) : settings_.J_max;
+            t[i] = std::isfinite(t[i]) ? t[i] : settings_.J_min;
+        }
+
+        const int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+
+        for (int k = 0; k < 3; ++k) {
+            const float bound = settings_.product_ratio * std::min(t[pairs[k][0]], t[pairs[k][1]]);
+            t[3 + k] = std::isfinite(t[3 + k]) ? std::max(-bound, std::min(t[3 + k], bound)) : 0.f;
+        }
+    }
+
+    InertiaEKFSettings settings_;
+    float x_[N] {};
+    float P_[PACKED] {};
+    float scale_{0.01f};          // Mean principal moment at init() (noise scaling)
+    bool started_{false};
+    uint32_t rejected_{0};
+};
+
+} // namespace attitude_controller_aic
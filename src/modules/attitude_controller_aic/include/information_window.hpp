@@ -0,0 +1,346 @@
+/**
+ * @file information_window.hpp
+ * @brief Sliding-window regressor information for excitation monitoring and windowed least squares
+ *
+ * The information matrix of the IWG estimator integrates Y^T * Y since boot:
+ * after the first maneuvers it stays large, so an excitation check on it
+ * says nothing about the recent flight. This window keeps the information
+ * of the last BLOCKS blocks of samples only:
+ *
+ *   W_YY = sum of dt * Y^T * Y     (N x N, packed upper triangle)
+ *   W_Yt = sum of dt * Y^T * tau   (N)
+ *
+ * Samples are summed into an open block. Once it spans the block duration
+ * it is added to the window sums and, with the ring full, the oldest block
+ * is subtracted: O(N^2) per sample and per closed block, independent of the
+ * window length. Every BLOCKS closed blocks the sums are recomputed from the
+ * ring, which discards the round-off of the running add/subtract.
+ *
+ * On top of the sums:
+ * - min_eigenvalue(): smallest eigenvalue of a leading block of W_YY (cyclic Jacobi)
+ * - solve(): ridge least squares (W_YY + R) * theta = W_Yt + R * theta_prior (Cholesky),
+ *   R = mu * diag(W_YY) + epsilon * I, so directions the window does not
+ *   excite stay at the prior
+ *
+ * Both cost O(N^3) and only change when a block closes; callers evaluate
+ * them then (add() returns true). Memory is (BLOCKS + 2) * (N(N+1)/2 + N)
+ * floats, fixed at compile time.
+ */
+
+#pragma once
+
+#include <cmath>
+
+namespace attitude_controller_aic {
+
+/**
+ * @class InformationWindow
+ * @brief Ring of per-block Y^T * Y and Y^T * tau partial sums
+ *
+ * @tparam N parameters (regressor columns)
+ * @tparam BLOCKS blocks in the window (window length = BLOCKS * block duration)
+ */
+template<int N, int BLOCKS = 10>
+class InformationWindow {
+public:
+    static constexpr int PACKED = N * (N + 1) / 2;   // Upper triangle of W_YY, row by row
+    static constexpr int SIZE = PACKED + N;          // One block: W_YY, then W_Yt
+    static constexpr int BLOCK_COUNT = BLOCKS;
+
+    static_assert(BLOCKS >= 2, "the window needs at least two blocks");
+
+    /**
+     * @param block_duration time summed into one block (s)
+     */
+    void init(float block_duration) {
+        set_block_duration(block_duration);
+        reset();
+    }
+
+    /**
+     * @brief Block duration (s); takes effect from the next block
+     */
+    void set_block_duration(float block_duration) {
+        block_duration_ = (block_duration > 1e-3f) ? block_duration : 1e-3f;
+    }
+
+    float block_duration() const { return block_duration_; }
+
+    /**
+     * @brief Drop all samples
+     */
+    void reset() {
+        clear(open_);
+        clear(sum_);
+
+        for (int b = 0; b < BLOCKS; ++b) {
+            clear(ring_[b]);
+            ring_time_[b] = 0.f;
+        }
+
+        open_time_ = 0.f;
+        sum_time_ = 0.f;
+        head_ = 0;
+        count_ = 0;
+    }
+
+    /**
+     * @brief Add one sample
+     *
+     * @param Y regressor, row-major 3 x N
+     * @param tau torque explained by Y * theta (3)
+     * @param dt sample weight (s)
+     * @return true if the sample closed a block (the window sums changed)
+     */
+    bool add(const float *Y, const float *tau, float dt) {
+        int k = 0;
+
+        for (int i = 0; i < N; ++i) {
+            for (int j = i; j < N; ++j) {
+                open_[k++] += dt * (Y[i] * Y[j] + Y[N + i] * Y[N + j] + Y[2 * N + i] * Y[2 * N + j]);
+            }
+        }
+
+        for (int i = 0; i < N; ++i) {
+            open_[PACKED + i] += dt * (Y[i] * tau[0] + Y[N + i] * tau[1] + Y[2 * N + i] * tau[2]);
+        }
+
+        open_time_ += dt;
+
+        if (open_time_ < block_duration_) {
+            return false;
+        }
+
+        close_block();
+        return true;
+    }
+
+    /**
+     * @brief True once the ring holds BLOCKS closed blocks
+     */
+    bool full() const { return count_ == BLOCKS; }
+
+    /**
+     * @brief Time covered by the closed blocks in the window (s)
+     */
+    float duration() const { return sum_time_; }
+
+    /**
+     * @brief Entry (i, j) of W_YY
+     */
+    float information(int i, int j) const {
+        return (i <= j) ? sum_[index(i, j)] : sum_[index(j, i)];
+    }
+
+    /**
+     * @brief Entry i of W_Yt
+     */
+    float correlation(int i) const {
+        return sum_[PACKED + i];
+    }
+
+    /**
+     * @brief Smallest eigenvalue of the leading size x size block of W_YY (size <= N)
+     */
+    float min_eigenvalue(int size) const {
+        float a[N][N];
+
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                a[i][j] = information(i, j);
+            }
+        }
+
+        // Cyclic Jacobi: each rotation zeroes a(p, q); eigenvalues are left on the diagonal
+        for (int sweep = 0; sweep < 8; ++sweep) {
+            float off = 0.f;
+            float diagonal = 0.f;
+
+            for (int p = 0; p < size; ++p) {
+                diagonal += a[p][p] * a[p][p];
+
+                for (int q = p + 1; q < size; ++q) {
+                    off += a[p][q] * a[p][q];
+                }
+            }
+
+            if (off <= 1e-14f * diagonal) {
+                break;
+            }
+
+            for (int p = 0; p < size; ++p) {
+                for (int q = p + 1; q < size; ++q) {
+                    if (a[p][q] == 0.f) {
+                        continue;
+                    }
+
+                    const float theta = (a[q][q] - a[p][p]) / (2.f * a[p][q]);
+                    const float t = ((theta >= 0.f) ? 1.f : -1.f)
+                                    / (std::fabs(theta) + std::sqrt(theta * theta + 1.f));
+                    const float c = 1.f / std::sqrt(t * t + 1.f);
+                    const float s = t * c;
+
+                    for (int k = 0; k < size; ++k) {
+                        const float a_kp = a[k][p];
+                        const float a_kq = a[k][q];
+                        a[k][p] = c * a_kp - s * a_kq;
+                        a[k][q] = s * a_kp + c * a_kq;
+                    }
+
+                    for (int k = 0; k < size; ++k) {
+                        const float a_pk = a[p][k];
+                        const float a_qk = a[q][k];
+                        a[p][k] = c * a_pk - s * a_qk;
+                        a[q][k] = s * a_pk + c * a_qk;
+                    }
+                }
+            }
+        }
+
+        float lambda_min = a[0][0];
+
+        for (int i = 1; i < size; ++i) {
+            lambda_min = (a[i][i] < lambda_min) ? a[i][i] : lambda_min;
+        }
+
+        return lambda_min;
+    }
+
+    /**
+     * @brief Ridge least-squares parameters of the window
+     *
+     * @param prior parameters kept in unexcited directions (N)
+     * @param mu ridge relative to the diagonal of W_YY
+     * @param epsilon absolute ridge (must be positive for an empty window)
+     * @param theta solution (N), unchanged on failure
+     * @return false if the regularized system is not positive definite
+     */
+    bool solve(const float *prior, float mu, float epsilon, float *theta) const {
+        float L[N][N];
+        float b[N];
+
+        for (int i = 0; i < N; ++i) {
+            const float ridge = mu * information(i, i) + epsilon;
+            b[i] = correlation(i) + ridge * prior[i];
+
+            for (int j = 0; j <= i; ++j) {
+                L[i][j] = information(j, i) + ((i == j) ? ridge : 0.f);
+            }
+        }
+
+        // A = L * L^T in place (lower triangle)
+        for (int j = 0; j < N; ++j) {
+            float d = L[j][j];
+
+            for (int k = 0; k < j; ++k) {
+                d -= L[j][k] * L[j][k];
+            }
+
+            if (!(d > 0.f)) {
+                return false;
+            }
+
+            L[j][j] = std::sqrt(d);
+
+            for (int i = j + 1; i < N; ++i) {
+                float v = L[i][j];
+
+                for (int k = 0; k < j; ++k) {
+                    v -= L[i][k] * L[j][k];
+                }
+
+                L[i][j] = v / L[j][j];
+            }
+        }
+
+        // L * y = b, L^T * theta = y
+        float y[N];
+
+        for (int i = 0; i < N; ++i) {
+            float v = b[i];
+
+            for (int k = 0; k < i; ++k) {
+                v -= L[i][k] * y[k];
+            }
+
+            y[i] = v / L[i][i];
+        }
+
+        for (int i = N - 1; i >= 0; --i) {
+            float v = y[i];
+
+            for (int k = i + 1; k < N; ++k) {
+                v -= L[k][i] * theta[k];
+            }
+
+            theta[i] = v / L[i][i];
+        }
+
+        return true;
+    }
+
+private:
+    static constexpr int index(int i, int j) {
+        // Row i starts after the rows 0 .. i-1 of lengths N, N-1, ...
+        return i * N - i * (i - 1) / 2 + (j - i);
+    }
+
+    static void clear(float *block) {
+        for (int e = 0; e < SIZE; ++e) {
+            block[e] = 0.f;
+        }
+    }
+
+    void close_block() {
+        float *slot = ring_[head_];
+
+        if (count_ == BLOCKS) {
+            for (int e = 0; e < SIZE; ++e) {
+                sum_[e] -= slot[e];
+            }
+
+            sum_time_ -= ring_time_[head_];
+
+        } else {
+            ++count_;
+        }
+
+        for (int e = 0; e < SIZE; ++e) {
+            slot[e] = open_[e];
+            sum_[e] += open_[e];
+        }
+
+        ring_time_[head_] = open_time_;
+        sum_time_ += open_time_;
+        head_ = (head_ + 1) % BLOCKS;
+
+        clear(open_);
+        open_time_ = 0.f;
+
+        // Once per lap of the ring: sums from scratch
+        if (head_ == 0 && count_ == BLOCKS) {
+            clear(sum_);
+            sum_time_ = 0.f;
+
+            for (int b = 0; b < BLOCKS; ++b) {
+                for (int e = 0; e < SIZE; ++e) {
+                    sum_[e] += ring_[b][e];
+                }
+
+                sum_time_ += ring_time_[b];
+            }
+        }
+    }
+
+    float ring_[BLOCKS][SIZE];      // Closed blocks, oldest at head_ once full
+    float ring_time_[BLOCKS];
+    float open_[SIZE];              // Block being filled
+    float open_time_{0.f};
+    float sum_[SIZE];               // Window sums over the closed blocks
+    float sum_time_{0.f};
+    float block_duration_{0.2f};
+    int head_{0};
+    int count_{0};
+};
+
+} // namespace attitude_controller_aic
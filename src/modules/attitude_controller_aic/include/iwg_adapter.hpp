@@ -9,24 +9,383 @@
  * - Well-excited directions: reduced adaptation (prevent noise)
  * - Poorly-excited directions: increased adaptation (boost convergence)
  * 
+ * The update is written once for any parameter layout (IWGEstimator, see
+ * parameter_layout.hpp); IWGAdapter owns one estimator per layout and runs
+ * the selected one.
+ * 
+ * Each estimator also keeps a sliding information window of (regressor,
+ * applied torque) samples (information_window.hpp). Persistent excitation is
+ * judged on the window, i.e. on the recent flight, and in the WINDOWED_LS
+ * mode the parameters are additionally pulled toward the least-squares fit
+ * of the window, so a changed payload is relearned without a reset.
+ * 
+ * In the EKF mode the inertia comes from the joint rate and inertia filter
+ * (inertia_ekf.hpp) instead of the gradient; the estimators keep gathering
+ * information and adapting the extended parameters.
+ * 
  * Reference: Boffa et al., "Excitation-Aware Least-Squares..."
  */
 
 #pragma once
 
 #include <matrix/matrix.hpp>
+#include "regressor.hpp"
+#include "information_window.hpp"
+#include "inertia_ekf.hpp"
 #include <Eigen/Dense>
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
 namespace attitude_controller_aic {
 
 using Vector3f = matrix::Vector3f;
 using Matrix3f = matrix::Matrix3f;
 
+/**
+ * @brief Parameter estimation mode
+ */
+enum class EstimatorMode {
+    IWG = 0,            // Information-weighted gradient
+    WINDOWED_LS = 1,    // IWG, relaxed toward the windowed least-squares fit while the window is excited
+    EKF = 2             // Inertia from the joint rate and inertia EKF (IWGAdapter::filter())
+};
+
+/**
+ * @brief Adaptation settings shared by the estimators of all layouts
+ */
+struct IWGSettings {
+    float lambda{0.04f};     // Information weighting factor
+    float gamma{1.5f};       // Adaptation gain
+    float sigma{1e-4f};      // Leakage
+    float beta{0.01f};       // Regularization
+    float gamma_ee{0.001f};  // Excitation enhancing
+    float J_min{0.01f};
+    float J_max{1.0f};
+    ExtendedBounds bounds;
+
+    // Vibration gating weights
+    float axis_weight[3]{1.0f, 1.0f, 1.0f};
+    float cross_weight{1.0f};
+
+    // Information window
+    EstimatorMode mode{EstimatorMode::IWG};
+    bool window_enabled{true};
+    float pe_threshold{0.05f};      // Smallest inertia-block eigenvalue of the window per second ((rad/s^2)^2)
+};
+
+/**
+ * @class IWGEstimator
+ * @brief IWG update of the parameter vector of one layout
+ *
+ * Excitation (persistent excitation check, excitation-enhancing term) is
+ * judged on the inertia block of the information matrix, so the thresholds
+ * mean the same for every layout.
+ *
+ * The information window holds the samples of observe(); when a block
+ * closes, the window excitation and (WINDOWED_LS) the ridge least-squares
+ * solution around the current estimate are refreshed.
+ *
+ * @tparam Layout ParameterLayout
+ */
+template<typename Layout>
+class IWGEstimator {
+public:
+    static constexpr int N = Layout::N;
+    static constexpr int INERTIA = Layout::INERTIA;
+
+    using LayoutType = Layout;
+    using RegressorMatrix = matrix::Matrix<float, 3, N>;
+    using Window = InformationWindow<N>;
+
+    /**
+     * @brief Start from an inertia estimate, extended parameters zero
+     *
+     * @param prior_information initial information of the inertia parameters
+     *                          [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz] (at least the default)
+     */
+    void init(const Matrix3f &J_init, const float prior_information[6]) {
+        theta_.setZero();
+        theta_(0) = J_init(0, 0);
+        theta_(1) = J_init(1, 1);
+        theta_(2) = J_init(2, 2);
+
+        if (Layout::FULL_INERTIA) {
+            theta_(3) = J_init(0, 1);
+            theta_(4) = J_init(0, 2);
+            theta_(5) = J_init(1, 2);
+        }
+
+        P_ = Eigen::Matrix<float, N, N>::Identity() * 1e-4f;
+
+        for (int i = 0; i < INERTIA; ++i) {
+            P_(i, i) = prior_information[i];
+            P_initial_[i] = prior_information[i];
+        }
+
+        window_.reset();
+        window_excitation_ = 0.f;
+        window_solution_valid_ = false;
+    }
+
+    /**
+     * @brief Information window block duration (s); drops the window
+     */
+    void set_window_block(float block_duration) {
+        window_.init(block_duration);
+        window_excitation_ = 0.f;
+        window_solution_valid_ = false;
+    }
+
+    /**
+     * @brief IWG update
+     *
+     * Implements: dot_theta = -Gamma * (I + lambda*P)^{-1} * Y^T * s - sigma*Gamma*theta - beta*Gamma^{-1}*theta
+     *                         + gamma_ee * Y^T * sign(det(P))
+     *
+     * Regressor entries and parameter updates are weighted by the vibration
+     * gating weights of the axes they involve (see IWGAdapter::set_axis_weights()).
+     */
+    void update(const RegressorMatrix &Y, const Vector3f &s, float dt, const IWGSettings &settings) {
+        Eigen::Matrix<float, 3, N> Y_eigen;
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < N; ++j) {
+                Y_eigen(i, j) = entry_weight(i, j, settings) * Y(i, j);
+            }
+        }
+
+        // Accumulate information: P = P + dt * Y^T * Y
+        P_ = P_ + dt * (Y_eigen.transpose() * Y_eigen);
+
+        // EKF: the inertia is set by the filter (set_inertia()), the gradient adapts the rest
+        const int first = (settings.mode == EstimatorMode::EKF) ? INERTIA : 0;
+
+        if (first == N) {
+            return;
+        }
+
+        // (I + lambda*P)^{-1}, SPD: closed form for N <= 4, LU beyond
+        const Eigen::Matrix<float, N, N> P_inv =
+            (Eigen::Matrix<float, N, N>::Identity() + settings.lambda * P_).inverse();
+
+        const Eigen::Vector3f s_eigen(s(0), s(1), s(2));
+        const Eigen::Matrix<float, N, 1> Yts = Y_eigen.transpose() * s_eigen;
+
+        // Information-weighted gradient
+        const Eigen::Matrix<float, N, 1> grad_weighted = P_inv * Yts;
+
+        // Leakage and regularization
+        const Eigen::Matrix<float, N, 1> leak_term = settings.sigma * theta_;
+        const Eigen::Matrix<float, N, 1> reg_term = (settings.beta / settings.gamma) * theta_;
+
+        // Excitation-enhancing term (internal excitation while the inertia information is rank-deficient)
+        Eigen::Matrix<float, N, 1> ee_term = Eigen::Matrix<float, N, 1>::Zero();
+
+        if (settings.gamma_ee > 0 && std::abs(information_determinant()) < 1e-6f) {
+            ee_term = settings.gamma_ee * Yts.normalized();
+        }
+
+        // Composite update: dot_theta = -gamma*grad - leak - reg + ee
+        const Eigen::Matrix<float, N, 1> dtheta = -settings.gamma * grad_weighted - leak_term - reg_term + ee_term;
+
+        for (int i = first; i < N; ++i) {
+            theta_(i) += parameter_weight(i, settings) * dtheta(i) * dt;
+        }
+
+        // Windowed least squares: first-order relaxation toward the fit over one block duration
+        if (settings.mode == EstimatorMode::WINDOWED_LS && window_solution_valid_
+            && is_window_excited(settings)) {
+            const float k = std::min(dt / window_.block_duration(), 1.f);
+
+            for (int i = 0; i < N; ++i) {
+                theta_(i) += parameter_weight(i, settings) * k * (window_solution_[i] - theta_(i));
+            }
+        }
+
+        project(settings);
+    }
+
+    /**
+     * @brief Add a sample to the information window
+     *
+     * @param Y regressor at the measured motion
+     * @param tau applied torque over the same interval (Nm)
+     * @param dt sample duration (s)
+     */
+    void observe(const RegressorMatrix &Y, const Vector3f &tau, float dt, const IWGSettings &settings) {
+        float Y_rows[3 * N];
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < N; ++j) {
+                Y_rows[i * N + j] = Y(i, j);
+            }
+        }
+
+        const float tau_rows[3] = {tau(0), tau(1), tau(2)};
+
+        if (!window_.add(Y_rows, tau_rows, dt)) {
+            return;
+        }
+
+        window_excitation_ = window_.min_eigenvalue(INERTIA) / std::max(window_.duration(), 1e-3f);
+
+        if (settings.mode == EstimatorMode::WINDOWED_LS) {
+            // Ridge 1% of each diagonal entry: unexcited directions stay at the current estimate
+            float prior[N];
+
+            for (int i = 0; i < N; ++i) {
+                prior[i] = theta_(i);
+            }
+
+            window_solution_valid_ = window_.solve(prior, 0.01f, 1e-6f, window_solution_);
+        }
+    }
+
+    /**
+     * @brief Smallest eigenvalue of the inertia block of the window information per second
+     */
+    float window_excitation() const {
+        return window_excitation_;
+    }
+
+    /**
+     * @brief Full window with excitation above the threshold
+     */
+    bool is_window_excited(const IWGSettings &settings) const {
+        return window_.full() && window_excitation_ > settings.pe_threshold;
+    }
+
+    /**
+     * @brief Model torque Y * theta
+     */
+    Vector3f torque(const RegressorMatrix &Y) const {
+        Vector3f tau(0.f, 0.f, 0.f);
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < N; ++j) {
+                tau(i) += Y(i, j) * theta_(j);
+            }
+        }
+
+        return tau;
+    }
+
+    Matrix3f inertia() const {
+        Matrix3f J_hat = Matrix3f::Zero();
+        J_hat(0, 0) = theta_(0);
+        J_hat(1, 1) = theta_(1);
+        J_hat(2, 2) = theta_(2);
+
+        if (Layout::FULL_INERTIA) {
+            J_hat(0, 1) = J_hat(1, 0) = theta_(3);
+            J_hat(0, 2) = J_hat(2, 0) = theta_(4);
+            J_hat(1, 2) = J_hat(2, 1) = theta_(5);
+        }
+
+        return J_hat;
+    }
+
+    /**
+     * @brief Replace the inertia parameters (the EKF estimate)
+     *
+     * @param inertia [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz], products ignored by the diagonal layouts
+     */
+    void set_inertia(const float inertia[6]) {
+        for (int i = 0; i < INERTIA; ++i) {
+            theta_(i) = inertia[i];
+        }
+    }
+
+    /**
+     * @brief Parameter of the layout (index < N)
+     */
+    float parameter(int index) const {
+        return theta_(index);
+    }
+
+    /**
+     * @brief Determinant of the inertia block of the information matrix
+     */
+    float information_determinant() const {
+        return P_.template topLeftCorner<INERTIA, INERTIA>().determinant();
+    }
+
+    /**
+     * @brief Information of an inertia parameter gathered since init(), without the prior
+     */
+    float gathered_information(int index) const {
+        return P_(index, index) - P_initial_[index];
+    }
+
+    static constexpr int STATE_WORDS = N + N * N;
+
+    /**
+     * @brief Flip one bit of the estimator state (memory upset injection)
+     *
+     * @param word theta (0..N-1), then P in storage order
+     * @param bit 0..31 of the IEEE 754 word
+     */
+    void flip_state_bit(int word, int bit) {
+        float *value = (word < N) ? &theta_(word) : P_.data() + (word - N);
+        uint32_t bits;
+        memcpy(&bits, value, sizeof(bits));
+        bits ^= 1u << (bit & 31);
+        memcpy(value, &bits, sizeof(bits));
+    }
+
+private:
+    static float entry_weight(int row, int column, const IWGSettings &settings) {
+        return (Layout::axis(column) == row) ? settings.axis_weight[row] : settings.cross_weight;
+    }
+
+    static float parameter_weight(int index, const IWGSettings &settings) {
+        const int axis = Layout::axis(index);
+        return (axis >= 0) ? settings.axis_weight[axis] : settings.cross_weight;
+    }
+
+    void project(const IWGSettings &settings) {
+        // Principal inertia to [J_min, J_max] (products of inertia are kept as they are)
+        for (int i = 0; i < 3; ++i) {
+            theta_(i) = std::max(settings.J_min, std::min(theta_(i), settings.J_max));
+        }
+
+        if (Layout::COM_OFFSET) {
+            const float r_max = settings.bounds.com_offset;
+            theta_(Layout::COM) = std::max(-r_max, std::min(theta_(Layout::COM), r_max));
+            theta_(Layout::COM + 1) = std::max(-r_max, std::min(theta_(Layout::COM + 1), r_max));
+        }
+
+        if (Layout::YAW_DRAG) {
+            theta_(Layout::DRAG) = std::max(0.f, std::min(theta_(Layout::DRAG), settings.bounds.yaw_drag));
+        }
+
+        if (Layout::ROTOR_INERTIA) {
+            theta_(Layout::ROTOR) = std::max(0.f, std::min(theta_(Layout::ROTOR),
+                                                               settings.bounds.rotor_inertia));
+        }
+    }
+
+    Eigen::Matrix<float, N, 1> theta_;
+    Eigen::Matrix<float, N, N> P_;       // Information matrix P(t)
+    float P_initial_[INERTIA] {};        // Inertia diagonal of P at init() (prior information)
+
+    Window window_;                      // Recent information (observe())
+    float window_excitation_{0.f};
+    float window_solution_[N] {};
+    bool window_solution_valid_{false};
+};
+
 /**
  * @class IWGAdapter
  * @brief Information-weighted gradient adaptation with internal excitation
+ *
+ * Holds the estimators of the inertia-only and the extended layouts for the
+ * diagonal and the full inertia model; init() and set_extended() select the
+ * one that runs.
  */
 class IWGAdapter {
 public:
@@ -35,44 +394,33 @@ public:
      * 
      * @param J_init initial inertia estimate
      * @param use_diagonal if true use diagonal model (3 params), else full (6 params)
+     * @param extended add CoM offset, yaw drag and rotor inertia to the model
      */
-    void init(const Matrix3f &J_init, bool use_diagonal = true) {
+    void init(const Matrix3f &J_init, bool use_diagonal = true, bool extended = false) {
         use_diagonal_ = use_diagonal;
-        n_theta_ = use_diagonal ? 3 : 6;
-        
-        // Extract initial parameters
-        if (use_diagonal) {
-            theta_diag_(0) = J_init(0, 0);
-            theta_diag_(1) = J_init(1, 1);
-            theta_diag_(2) = J_init(2, 2);
-        } else {
-            theta_full_(0) = J_init(0, 0);
-            theta_full_(1) = J_init(1, 1);
-            theta_full_(2) = J_init(2, 2);
-            theta_full_(3) = J_init(0, 1);
-            theta_full_(4) = J_init(0, 2);
-            theta_full_(5) = J_init(1, 2);
-        }
-        
-        // Initialize information matrices
-        if (use_diagonal) {
-            P_diag_ = Eigen::Matrix3f::Identity() * 1e-4f;
-            P_inv_diag_ = Eigen::Matrix3f::Identity() * 1e4f; // Approximate inverse
-        } else {
-            P_full_ = Eigen::Matrix6f::Identity() * 1e-4f;
-            P_inv_full_ = Eigen::Matrix6f::Identity() * 1e4f;
-        }
-        
-        // Default IWG parameters
-        lambda_ = 0.04f;    // Information weighting factor
-        gamma_ = 1.5f;      // Adaptation gain
-        sigma_ = 1e-4f;     // Leakage
-        beta_ = 0.01f;      // Regularization
-        gamma_ee_ = 0.001f; // Excitation enhancing
+        extended_ = extended;
+
+        diag_.init(J_init, prior_information_);
+        full_.init(J_init, prior_information_);
+        extended_diag_.init(J_init, prior_information_);
+        extended_full_.init(J_init, prior_information_);
+
+        // Default IWG parameters (bounds, gating weights and the information window are kept)
+        settings_.lambda = 0.04f;
+        settings_.gamma = 1.5f;
+        settings_.sigma = 1e-4f;
+        settings_.beta = 0.01f;
+        settings_.gamma_ee = 0.001f;
         
         // SPD bounds
-        J_min_ = 0.01f;
-        J_max_ = 1.0f;
+        settings_.J_min = 0.01f;
+        settings_.J_max = 1.0f;
+
+        ekf_settings_.J_min = settings_.J_min;
+        ekf_settings_.J_max = settings_.J_max;
+        ekf_.init(J_init, ekf_settings_);
+        ekf_rejection_run_ = 0;
+        ekf_resyncs_ = 0;
     }
 
     /**
@@ -85,78 +433,303 @@ public:
      * @param gamma_ee excitation-enhancing weight
      */
     void set_parameters(float lambda, float gamma, float sigma, float beta, float gamma_ee) {
-        lambda_ = std::max(0.0f, std::min(lambda, 1.0f));
-        gamma_ = gamma;
-        sigma_ = sigma;
-        beta_ = beta;
-        gamma_ee_ = gamma_ee;
+        settings_.lambda = std::max(0.0f, std::min(lambda, 1.0f));
+        settings_.gamma = gamma;
+        settings_.sigma = sigma;
+        settings_.beta = beta;
+        settings_.gamma_ee = gamma_ee;
+    }
+
+    /**
+     * @brief Configure the information window and the estimation mode
+     *
+     * @param window_length window over which excitation and the windowed fit are evaluated (s),
+     *                      0 disables the window (excitation judged on the accumulated information)
+     * @param mode IWG, WINDOWED_LS (needs the window) or EKF
+     * @param pe_threshold smallest inertia-block eigenvalue of the window information per
+     *                     second counted as persistently excited ((rad/s^2)^2)
+     */
+    void set_information_window(float window_length, EstimatorMode mode, float pe_threshold) {
+        settings_.window_enabled = window_length > 0.f;
+        settings_.mode = (settings_.window_enabled || mode == EstimatorMode::EKF) ? mode : EstimatorMode::IWG;
+        settings_.pe_threshold = std::max(0.f, pe_threshold);
+
+        // A new block duration drops the windows
+        const float block = window_length / IWGEstimator<DiagonalInertiaLayout>::Window::BLOCK_COUNT;
+
+        if (settings_.window_enabled && block != window_block_) {
+            window_block_ = block;
+            diag_.set_window_block(block);
+            full_.set_window_block(block);
+            extended_diag_.set_window_block(block);
+            extended_full_.set_window_block(block);
+        }
+    }
+
+    bool is_window_enabled() const { return settings_.window_enabled; }
+
+    /**
+     * @brief Noise model of the EKF (taken over by the running filter)
+     *
+     * @param gyro_noise rate measurement noise (rad/s, 1 sigma)
+     * @param acceleration_noise unmodeled angular acceleration (rad/s^2 / sqrt(Hz))
+     */
+    void set_ekf_noise(float gyro_noise, float acceleration_noise) {
+        ekf_settings_.gyro_noise = std::max(gyro_noise, 1e-5f);
+        ekf_settings_.acceleration_noise = std::max(acceleration_noise, 1e-3f);
+        ekf_.set_noise(ekf_settings_.gyro_noise, ekf_settings_.acceleration_noise);
+    }
+
+    /**
+     * @brief Initial information of the inertia parameters (e.g. a fleet prior)
+     *
+     * Replaces the uninformative default from the next init() or reset():
+     * the IWG gain (I + lambda*P)^{-1} then moves the estimate slowly in the
+     * directions the prior is sure of.
+     *
+     * @param information [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz], entries below the default keep it
+     */
+    void set_prior_information(const float information[6]) {
+        for (int i = 0; i < 6; ++i) {
+            const bool informative = std::isfinite(information[i]) && information[i] > DEFAULT_INFORMATION;
+            prior_information_[i] = informative ? information[i] : 1e-4f;
+        }
+    }
+
+    /**
+     * @brief Information of the inertia parameters gathered since the last reset, without the prior
+     *
+     * @param information [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz], products 0 with the diagonal model
+     */
+    void get_gathered_information(float information[6]) const {
+        visit([information](const auto &estimator) {
+            using Estimator = typename std::decay<decltype(estimator)>::type;
+
+            for (int i = 0; i < 6; ++i) {
+                information[i] = (i < Estimator::INERTIA) ? estimator.gathered_information(i) : 0.f;
+            }
+        });
+    }
+
+    EstimatorMode get_mode() const { return settings_.mode; }
+
+    /**
+     * @brief Add a sample of the measured motion to the information window of the selected model
+     *
+     * Samples are skipped while vibration gating scales any axis down (the
+     * window would otherwise fill with the corrupted motion).
+     *
+     * @param x regressor variables at the measured motion (measured angular acceleration)
+     * @param tau torque applied over the same interval (Nm)
+     * @param dt sample duration (s)
+     */
+    void observe(const RegressorInput &x, const Vector3f &tau, float dt) {
+        if (!settings_.window_enabled || settings_.cross_weight < 1.f) {
+            return;
+        }
+
+        visit([this, &x, &tau, dt](auto &estimator) -> void {
+            using Estimator = typename std::decay<decltype(estimator)>::type;
+            estimator.observe(Regressor::evaluate<typename Estimator::LayoutType>(x), tau, dt, settings_);
+        });
+    }
+
+    /**
+     * @brief EKF step: predict with the torque applied since the last measurement, update with the rates
+     *
+     * Only in the EKF mode. The rates restart from the measurement while all
+     * axes are frozen by the vibration gating or without a valid interval;
+     * otherwise the gating weights scale the confidence in the gyro. The
+     * inertia estimate is handed to the selected estimator.
+     *
+     * After EKF_REJECTION_LIMIT consecutive rejected innovations (a torque
+     * step or motor loss the model did not predict moves the rates out of the
+     * gate for good) the rates are restarted from the measurement, which
+     * resets P_ww; the inertia estimate and its covariance are kept.
+     *
+     * @param Omega measured body rates (rad/s)
+     * @param tau torque applied since the previous call (Nm)
+     * @param dt time since the previous call (s), 0 if there was none
+     */
+    void filter(const Vector3f &Omega, const Vector3f &tau, float dt) {
+        if (settings_.mode != EstimatorMode::EKF) {
+            return;
+        }
+
+        if (is_frozen() || !(dt > 0.f) || !ekf_.is_started()) {
+            ekf_.restart_rate(Omega);
+
+        } else {
+            ekf_.predict(tau, dt);
+
+            if (ekf_.update(Omega, settings_.axis_weight)) {
+                ekf_rejection_run_ = 0;
+
+            } else if (++ekf_rejection_run_ >= EKF_REJECTION_LIMIT) {
+                ekf_.restart_rate(Omega);
+                ekf_rejection_run_ = 0;
+                ++ekf_resyncs_;
+            }
+        }
+
+        float inertia[6];
+
+        for (int i = 0; i < 6; ++i) {
+            inertia[i] = ekf_.parameter(i);
+        }
+
+        visit([&inertia](auto &estimator) -> void { estimator.set_inertia(inertia); });
+    }
+
+    /**
+     * @brief Variance of the EKF inertia estimate
+     *
+     * @param variance [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz] ((kg*m^2)^2)
+     * @return false outside the EKF mode (variance untouched)
+     */
+    bool get_inertia_variance(float variance[6]) const {
+        if (settings_.mode != EstimatorMode::EKF) {
+            return false;
+        }
+
+        for (int i = 0; i < 6; ++i) {
+            variance[i] = ekf_.inertia_variance(i);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Gyro innovations rejected by the EKF since the last reset
+     */
+    uint32_t get_ekf_rejections() const { return ekf_.rejected(); }
+
+    /**
+     * @brief EKF rate restarts after a run of rejected innovations since the last init
+     */
+    uint32_t get_ekf_resyncs() const { return ekf_resyncs_; }
+
+    /**
+     * @brief Excitation of the information window of the selected model ((rad/s^2)^2)
+     */
+    float get_window_excitation() const {
+        return visit([](const auto &estimator) { return estimator.window_excitation(); });
+    }
+
+    /**
+     * @brief Switch between the inertia-only and the extended model
+     *
+     * The newly selected estimator restarts from the current inertia
+     * estimate with zero extended parameters.
+     */
+    void set_extended(bool extended) {
+        if (extended != extended_) {
+            const Matrix3f J_hat = get_inertia_estimate();
+            extended_ = extended;
+            visit([this, &J_hat](auto &estimator) -> void { estimator.init(J_hat, prior_information_); });
+        }
+    }
+
+    bool is_extended() const { return extended_; }
+
+    /**
+     * @brief Switch between the diagonal and the full inertia model
+     *
+     * Restarts the adaptation from the current inertia estimate, like set_extended().
+     */
+    void set_diagonal(bool use_diagonal) {
+        if (use_diagonal != use_diagonal_) {
+            const Matrix3f J_hat = get_inertia_estimate();
+            use_diagonal_ = use_diagonal;
+            visit([this, &J_hat](auto &estimator) -> void { estimator.init(J_hat, prior_information_); });
+        }
+    }
+
+    bool is_diagonal() const { return use_diagonal_; }
+
+    /**
+     * @brief Bounds of the extended parameters
+     */
+    void set_extended_bounds(const ExtendedBounds &bounds) {
+        settings_.bounds = bounds;
+    }
+
+    /**
+     * @brief Per-axis adaptation weights (vibration gating)
+     *
+     * Vibration on an axis corrupts s_i and every gyroscopic product
+     * Omega_j * Omega_k it enters, i.e. all cross-axis regressor entries.
+     * Entries are therefore weighted by the axes they involve:
+     * - Y(i, i) (alpha_i, principal inertia of axis i): w_i
+     * - single-axis extended entries (CoM offset, yaw drag): w of their axis
+     * - all other entries (gyroscopic coupling, products of inertia, rotor inertia): w_x * w_y * w_z
+     * and the update of each parameter is scaled by the same weight, so the
+     * principal inertia of a gated axis and the products of inertia stay
+     * frozen (no leakage either) while clean axes keep adapting.
+     *
+     * @param weights per-axis weights in [0, 1] (1: normal adaptation, 0: frozen)
+     */
+    void set_axis_weights(const Vector3f &weights) {
+        for (int i = 0; i < 3; ++i) {
+            settings_.axis_weight[i] = std::max(0.0f, std::min(weights(i), 1.0f));
+        }
+
+        settings_.cross_weight = settings_.axis_weight[0] * settings_.axis_weight[1] * settings_.axis_weight[2];
+    }
+
+    /**
+     * @brief True if all parameters are frozen by the axis weights
+     */
+    bool is_frozen() const {
+        return settings_.axis_weight[0] <= 0.f && settings_.axis_weight[1] <= 0.f && settings_.axis_weight[2] <= 0.f;
+    }
+
+    /**
+     * @brief Adapt the selected model and return its torque
+     *
+     * Evaluates the regressor of the selected layout once for both the
+     * update and the feedforward.
+     *
+     * @param x regressor variables
+     * @param s composite error
+     * @param dt timestep
+     * @return model torque Y(x) * theta_hat with the updated parameters (Nm)
+     */
+    Vector3f update(const RegressorInput &x, const Vector3f &s, float dt) {
+        return visit([this, &x, &s, dt](auto &estimator) -> Vector3f {
+            using Estimator = typename std::decay<decltype(estimator)>::type;
+            const auto Y = Regressor::evaluate<typename Estimator::LayoutType>(x);
+
+            if (!is_frozen()) {
+                estimator.update(Y, s, dt, settings_);
+            }
+
+            return estimator.torque(Y);
+        });
+    }
+
+    /**
+     * @brief Model torque Y(x) * theta_hat of the selected model without adapting (Nm)
+     */
+    Vector3f model_torque(const RegressorInput &x) const {
+        return visit([&x](const auto &estimator) {
+            using Estimator = typename std::decay<decltype(estimator)>::type;
+            return estimator.torque(Regressor::evaluate<typename Estimator::LayoutType>(x));
+        });
     }
 
     /**
      * @brief Update parameters using IWG method (diagonal inertia)
      * 
-     * Implements: dot_theta = -Gamma * (I + lambda*P)^{-1} * Y^T * s - sigma*Gamma*theta - beta*Gamma^{-1}*theta
-     *                         + gamma_ee * Y^T * sign(det(P))
-     * 
      * @param Y regressor matrix (3x3)
      * @param s composite error
      * @param dt timestep
      */
     void update_diagonal(const matrix::Matrix<float, 3, 3> &Y,
                          const Vector3f &s, float dt) {
-        // Convert to Eigen for matrix operations
-        Eigen::Matrix3f Y_eigen;
-        for (int i = 0; i < 3; ++i) {
-            for (int j = 0; j < 3; ++j) {
-                Y_eigen(i, j) = Y(i, j);
-            }
-        }
-        
-        // Accumulate information: P = P + dt * Y^T * Y
-        Eigen::Matrix3f YtY = Y_eigen.transpose() * Y_eigen;
-        P_diag_ = P_diag_ + dt * YtY;
-        
-        // Update (I + lambda*P) inverse using Sherman-Morrison or direct inversion
-        // For 3x3 this is efficient
-        Eigen::Matrix3f I_plus_lambdaP = Eigen::Matrix3f::Identity() + lambda_ * P_diag_;
-        
-        try {
-            P_inv_diag_ = I_plus_lambdaP.inverse();
-        } catch (...) {
-            // If inversion fails, use previous inverse (numerical stability)
-            P_inv_diag_ = (I_plus_lambdaP + Eigen::Matrix3f::Identity() * 1e-6f).inverse();
-        }
-        
-        // Information-weighted gradient: (I + lambda*P)^{-1} * Y^T * s
-        Eigen::Vector3f s_eigen;
-        for (int i = 0; i < 3; ++i) s_eigen(i) = s(i);
-        
-        Eigen::Vector3f grad_weighted = P_inv_diag_ * (Y_eigen.transpose() * s_eigen);
-        
-        // Leakage term
-        Eigen::Vector3f leak_term = sigma_ * Eigen::Map<Eigen::Vector3f>(theta_diag_.data(), 3);
-        
-        // Regularization term
-        Eigen::Vector3f reg_term = (beta_ / gamma_) * Eigen::Map<Eigen::Vector3f>(theta_diag_.data(), 3);
-        
-        // Excitation-enhancing term (internal excitation based on rank deficiency)
-        Eigen::Vector3f ee_term = Eigen::Vector3f::Zero();
-        float det_P = P_diag_.determinant();
-        if (gamma_ee_ > 0 && std::abs(det_P) < 1e-6f) {
-            // P is rank-deficient, add internal excitation
-            ee_term = gamma_ee_ * (Y_eigen.transpose() * s_eigen).normalized();
-        }
-        
-        // Composite update: dot_theta = -gamma*grad - leak - reg + ee
-        Eigen::Vector3f dtheta = -gamma_ * grad_weighted - leak_term - reg_term + ee_term;
-        
-        // Apply update
-        for (int i = 0; i < 3; ++i) {
-            theta_diag_(i) += dtheta(i) * dt;
+        if (!is_frozen()) {
+            diag_.update(Y, s, dt, settings_);
         }
-        
-        // Project to SPD
-        project_spd_diagonal();
     }
 
     /**
@@ -168,168 +741,179 @@ public:
      */
     void update_full(const matrix::Matrix<float, 3, 6> &Y,
                      const Vector3f &s, float dt) {
-        // Convert to Eigen
-        Eigen::MatrixXf Y_eigen = Eigen::MatrixXf::Zero(3, 6);
-        for (int i = 0; i < 3; ++i) {
-            for (int j = 0; j < 6; ++j) {
-                Y_eigen(i, j) = Y(i, j);
-            }
-        }
-        
-        // Accumulate information
-        Eigen::Matrix6f YtY = Y_eigen.transpose() * Y_eigen;
-        P_full_ = P_full_ + dt * YtY;
-        
-        // Compute (I + lambda*P)^{-1}
-        Eigen::Matrix6f I_plus_lambdaP = Eigen::Matrix6f::Identity() + lambda_ * P_full_;
-        
-        try {
-            P_inv_full_ = I_plus_lambdaP.inverse();
-        } catch (...) {
-            P_inv_full_ = (I_plus_lambdaP + Eigen::Matrix6f::Identity() * 1e-6f).inverse();
-        }
-        
-        // Information-weighted gradient
-        Eigen::Vector6f s_eigen(3);
-        for (int i = 0; i < 3; ++i) s_eigen(i) = s(i);
-        for (int i = 3; i < 6; ++i) s_eigen(i) = 0; // Pad for 6D vector
-        
-        Eigen::Vector6f grad_weighted = P_inv_full_ * (Y_eigen.transpose() * s_eigen.head(3));
-        
-        // Leakage and regularization
-        Eigen::Vector6f leak_term = sigma_ * Eigen::Map<Eigen::Vector6f>(theta_full_.data(), 6);
-        Eigen::Vector6f reg_term = (beta_ / gamma_) * Eigen::Map<Eigen::Vector6f>(theta_full_.data(), 6);
-        
-        // Excitation-enhancing
-        Eigen::Vector6f ee_term = Eigen::Vector6f::Zero();
-        float det_P = P_full_.determinant();
-        if (gamma_ee_ > 0 && std::abs(det_P) < 1e-6f) {
-            ee_term = gamma_ee_ * (Y_eigen.transpose() * s_eigen.head(3)).normalized();
-        }
-        
-        // Update
-        Eigen::Vector6f dtheta = -gamma_ * grad_weighted - leak_term - reg_term + ee_term;
-        
-        for (int i = 0; i < 6; ++i) {
-            theta_full_(i) += dtheta(i) * dt;
+        if (!is_frozen()) {
+            full_.update(Y, s, dt, settings_);
         }
-        
-        // Project to SPD
-        project_spd_full();
     }
 
     /**
      * @brief Get inertia matrix estimate
      */
     Matrix3f get_inertia_estimate() const {
-        Matrix3f J_hat = Matrix3f::Zero();
-        
-        if (use_diagonal_) {
-            J_hat(0, 0) = theta_diag_(0);
-            J_hat(1, 1) = theta_diag_(1);
-            J_hat(2, 2) = theta_diag_(2);
-        } else {
-            J_hat(0, 0) = theta_full_(0);
-            J_hat(1, 1) = theta_full_(1);
-            J_hat(2, 2) = theta_full_(2);
-            J_hat(0, 1) = J_hat(1, 0) = theta_full_(3);
-            J_hat(0, 2) = J_hat(2, 0) = theta_full_(4);
-            J_hat(1, 2) = J_hat(2, 1) = theta_full_(5);
+        return visit([](const auto &estimator) { return estimator.inertia(); });
+    }
+
+    /**
+     * @brief Center-of-mass offset estimate (r_x, r_y, 0), zero without the extended model
+     */
+    Vector3f get_com_offset() const {
+        if (!extended_) {
+            return Vector3f(0.f, 0.f, 0.f);
         }
-        
-        return J_hat;
+
+        return use_diagonal_
+               ? Vector3f(extended_diag_.parameter(ExtendedDiagonalLayout::COM),
+                          extended_diag_.parameter(ExtendedDiagonalLayout::COM + 1), 0.f)
+               : Vector3f(extended_full_.parameter(ExtendedFullLayout::COM),
+                          extended_full_.parameter(ExtendedFullLayout::COM + 1), 0.f);
+    }
+
+    /**
+     * @brief Yaw drag coefficient estimate (Nm per rad/s), zero without the extended model
+     */
+    float get_yaw_drag() const {
+        if (!extended_) {
+            return 0.f;
+        }
+
+        return use_diagonal_ ? extended_diag_.parameter(ExtendedDiagonalLayout::DRAG)
+               : extended_full_.parameter(ExtendedFullLayout::DRAG);
+    }
+
+    /**
+     * @brief Rotor inertia estimate (kg*m^2), zero without the extended model
+     */
+    float get_rotor_inertia() const {
+        if (!extended_) {
+            return 0.f;
+        }
+
+        return use_diagonal_ ? extended_diag_.parameter(ExtendedDiagonalLayout::ROTOR)
+               : extended_full_.parameter(ExtendedFullLayout::ROTOR);
     }
 
     /**
      * @brief Get information matrix determinant (for excitation monitoring)
      */
     float get_information_determinant() const {
-        if (use_diagonal_) {
-            return P_diag_.determinant();
-        } else {
-            return P_full_.determinant();
-        }
+        return visit([](const auto &estimator) { return estimator.information_determinant(); });
     }
 
     /**
      * @brief Check if system is persistently excited
-     * @return true if information matrix is well-conditioned
+     *
+     * With the information window: the window is full and its excitation
+     * exceeds the threshold, i.e. the recent flight excites every inertia
+     * direction. Without it: the information accumulated since the last
+     * reset is well-conditioned.
      */
     bool is_persistently_excited() const {
+        if (settings_.window_enabled) {
+            return visit([this](const auto &estimator) { return estimator.is_window_excited(settings_); });
+        }
+
         float det = get_information_determinant();
         return std::abs(det) > 1e-4f;
     }
 
+    /**
+     * @brief Check whether a principal inertia estimate is pinned at J_min or J_max
+     *
+     * A persistently pinned estimate means the adaptation is pushing against
+     * the SPD projection, i.e. the estimator is diverging.
+     *
+     * @param tolerance relative distance to the bound counted as pinned
+     */
+    bool is_at_bound(float tolerance = 1e-3f) const {
+        const Matrix3f J_hat = get_inertia_estimate();
+
+        for (int i = 0; i < 3; ++i) {
+            const float J_ii = J_hat(i, i);
+
+            if (J_ii <= settings_.J_min * (1.f + tolerance) || J_ii >= settings_.J_max * (1.f - tolerance)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Words of the selected estimator's state (theta, then P; the EKF state in the EKF mode)
+     */
+    int get_state_words() const {
+        if (settings_.mode == EstimatorMode::EKF) {
+            return InertiaEKF::STATE_WORDS;
+        }
+
+        return visit([](const auto &estimator) {
+            return std::decay<decltype(estimator)>::type::STATE_WORDS;
+        });
+    }
+
+    /**
+     * @brief Flip one bit of the selected estimator's state (fault injection, see IWGEstimator::flip_state_bit())
+     */
+    void flip_state_bit(int word, int bit) {
+        if (word < 0 || word >= get_state_words()) {
+            return;
+        }
+
+        if (settings_.mode == EstimatorMode::EKF) {
+            ekf_.flip_state_bit(word, bit);
+
+        } else {
+            visit([word, bit](auto &estimator) -> void { estimator.flip_state_bit(word, bit); });
+        }
+    }
+
     /**
      * @brief Reset adapter
      */
     void reset(const Matrix3f &J_init) {
-        init(J_init, use_diagonal_);
+        init(J_init, use_diagonal_, extended_);
     }
 
 private:
     /**
-     * @brief Project diagonal inertia to SPD
+     * @brief Call f with the selected estimator
      */
-    void project_spd_diagonal() {
-        for (int i = 0; i < 3; ++i) {
-            theta_diag_(i) = std::max(J_min_, std::min(theta_diag_(i), J_max_));
+    template<typename F>
+    auto visit(F f) -> decltype(f(std::declval<IWGEstimator<DiagonalInertiaLayout> &>())) {
+        if (extended_) {
+            return use_diagonal_ ? f(extended_diag_) : f(extended_full_);
         }
+
+        return use_diagonal_ ? f(diag_) : f(full_);
     }
 
-    /**
-     * @brief Project full symmetric inertia to SPD
-     */
-    void project_spd_full() {
-        // Reconstruct matrix
-        Eigen::Matrix3f J_hat;
-        J_hat(0, 0) = theta_full_(0);
-        J_hat(1, 1) = theta_full_(1);
-        J_hat(2, 2) = theta_full_(2);
-        J_hat(0, 1) = J_hat(1, 0) = theta_full_(3);
-        J_hat(0, 2) = J_hat(2, 0) = theta_full_(4);
-        J_hat(1, 2) = J_hat(2, 1) = theta_full_(5);
-        
-        // Clip diagonals
-        for (int i = 0; i < 3; ++i) {
-            J_hat(i, i) = std::max(J_min_, std::min(J_hat(i, i), J_max_));
+    template<typename F>
+    auto visit(F f) const -> decltype(f(std::declval<const IWGEstimator<DiagonalInertiaLayout> &>())) {
+        if (extended_) {
+            return use_diagonal_ ? f(extended_diag_) : f(extended_full_);
         }
-        
-        // Ensure symmetry and clip off-diagonal
-        J_hat(0, 1) = J_hat(1, 0) = (J_hat(0, 1) + J_hat(1, 0)) / 2.f;
-        J_hat(0, 2) = J_hat(2, 0) = (J_hat(0, 2) + J_hat(2, 0)) / 2.f;
-        J_hat(1, 2) = J_hat(2, 1) = (J_hat(1, 2) + J_hat(2, 1)) / 2.f;
-        
-        // Extract back
-        theta_full_(0) = J_hat(0, 0);
-        theta_full_(1) = J_hat(1, 1);
-        theta_full_(2) = J_hat(2, 2);
-        theta_full_(3) = J_hat(0, 1);
-        theta_full_(4) = J_hat(0, 2);
-        theta_full_(5) = J_hat(1, 2);
-    }
-
-    // Parameter vectors
-    Eigen::Vector3f theta_diag_;
-    Eigen::Vector6f theta_full_;
-    
-    // Information matrices P(t)
-    Eigen::Matrix3f P_diag_;
-    Eigen::Matrix3f P_inv_diag_;
-    Eigen::Matrix6f P_full_;
-    Eigen::Matrix6f P_inv_full_;
-    
-    // IWG parameters
-    float lambda_{0.04f};    // Information weighting factor
-    float gamma_{1.5f};      // Adaptation gain
-    float sigma_{1e-4f};     // Leakage
-    float beta_{0.01f};      // Regularization
-    float gamma_ee_{0.001f}; // Excitation enhancing
-    float J_min_{0.01f};
-    float J_max_{1.0f};
-    
-    int n_theta_{3};
+
+        return use_diagonal_ ? f(diag_) : f(full_);
+    }
+
+    IWGEstimator<DiagonalInertiaLayout> diag_;
+    IWGEstimator<FullInertiaLayout> full_;
+    IWGEstimator<ExtendedDiagonalLayout> extended_diag_;
+    IWGEstimator<ExtendedFullLayout> extended_full_;
+    IWGSettings settings_;
+    float window_block_{0.f};
+
+    InertiaEKF ekf_;
+    InertiaEKFSettings ekf_settings_;
+    static constexpr int EKF_REJECTION_LIMIT = 25;         // Consecutive rejections before the rates restart
+    int ekf_rejection_run_{0};
+    uint32_t ekf_resyncs_{0};
+
+    static constexpr float DEFAULT_INFORMATION = 1e-4f;   // Uninformative initial information
+    float prior_information_[6] {1e-4f, 1e-4f, 1e-4f, 1e-4f, 1e-4f, 1e-4f};
+
     bool use_diagonal_{true};
+    bool extended_{false};
 };
 
 } // namespace attitude_controller_aic
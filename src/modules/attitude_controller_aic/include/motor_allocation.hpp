@@ -0,0 +1,395 @@
+/**
+ * @file motor_allocation.hpp
+ * @brief Torque/thrust allocation with precomputed single-motor-failure pseudo-inverses
+ *
+ * The effectiveness matrix B (4 x N) maps normalized motor commands u in
+ * [0, 1] to [roll, pitch, yaw torque (Nm), thrust (N)]. Column i is built
+ * from the PX4 mixer geometry of the frame (roll, pitch and yaw scales of
+ * motor i) and the motor constants:
+ *
+ *   B(:, i) = T_max * [roll_i * arm, pitch_i * arm, yaw_i * k_m, 1]
+ *
+ * configure() precomputes, for the nominal frame and for every frame with
+ * one motor removed (its column zeroed), two minimum-norm right inverses
+ * P = B_r^T (B_r B_r^T)^-1: one over all four rows and one without the yaw
+ * row (B_r: the rows used). Yaw is the first axis given up:
+ * - if the remaining columns lose rank (e.g. a quadrotor), only the yaw-free
+ *   inverse exists and yaw is uncontrolled;
+ * - if the full solution u_f leaves [0, 1] (e.g. a hexarotor, whose motor
+ *   opposite the failed one hovers at zero), u = u_f + k * (u_n - u_f) with
+ *   the smallest k in [0, 1] that brings it back, u_n being the yaw-free
+ *   solution, then clipped. Roll, pitch and thrust are kept, yaw degrades.
+ *
+ * At runtime allocation is at most two (N x 4) matrix-vector products;
+ * switching to a reduced allocation is an index change, so no matrix is
+ * factorized in the control loop.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+
+/**
+ * @brief Multirotor frames with a built-in effectiveness matrix (PX4 motor order)
+ */
+enum class MotorFrame : uint8_t {
+    NONE = 0,      // No allocation: the torque is published for the flight stack's mixer
+    QUAD_X = 1,
+    HEX_X = 2,
+};
+
+/**
+ * @brief Motor constants of the effectiveness matrix
+ */
+struct MotorGeometry {
+    float thrust_max{8.f};      // Thrust of one motor at full command (N)
+    float arm{0.25f};           // Motor distance from the center of mass (m)
+    float moment_ratio{0.016f}; // Yaw reaction torque per unit thrust (m)
+    float rotor_speed_max{2500.f}; // Rotor speed at full command (rad/s)
+};
+
+/**
+ * @class MotorAllocation
+ * @brief Nominal and single-failure allocation of torque and collective thrust to motors
+ */
+class MotorAllocation {
+public:
+    static constexpr int MAX_MOTORS = 8;
+
+    /**
+     * @brief Build the effectiveness matrix and precompute all allocations
+     * @return false if the frame is NONE or unknown (allocation disabled)
+     */
+    bool configure(MotorFrame frame, const MotorGeometry &geometry) {
+        failed_motor_ = -1;
+        const float (*scales)[3] = frame_scales(frame, motor_count_);
+
+        if (scales == nullptr) {
+            return false;
+        }
+
+        for (int i = 0; i < motor_count_; ++i) {
+            B_[0][i] = geometry.thrust_max * scales[i][0] * geometry.arm;
+            B_[1][i] = geometry.thrust_max * scales[i][1] * geometry.arm;
+            B_[2][i] = geometry.thrust_max * scales[i][2] * geometry.moment_ratio;
+            B_[3][i] = geometry.thrust_max;
+        }
+
+        thrust_max_total_ = geometry.thrust_max * motor_count_;
+        rotor_speed_max_ = geometry.rotor_speed_max;
+
+        // A rotor reacts against its spin: positive yaw torque spins it about body -z
+        for (int i = 0; i < motor_count_; ++i) {
+            spin_[i] = (scales[i][2] > 0.f) ? -1.f : 1.f;
+        }
+
+        for (int removed = -1; removed < motor_count_; ++removed) {
+            compute_allocation(removed, allocations_[removed + 1]);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Allocate with the reduced pseudo-inverse of a failed motor (-1: nominal)
+     */
+    void set_failed_motor(int motor) {
+        failed_motor_ = (motor >= 0 && motor < motor_count_) ? motor : -1;
+    }
+
+    /**
+     * @brief Motor commands for a torque and a collective thrust
+     *
+     * @param tau torque (Nm)
+     * @param thrust collective thrust normalized to all motors at full command [0, 1]
+     * @param u motor commands in [0, 1] (motor_count() entries, a failed motor gets 0)
+     */
+    void allocate(const Vector3f &tau, float thrust, float u[MAX_MOTORS]) const {
+        const Allocation &allocation = allocations_[failed_motor_ + 1];
+        const float T = thrust * thrust_max_total_;
+        float k = allocation.yaw_controllable ? 0.f : 1.f;
+
+        float u_full[MAX_MOTORS];
+        float u_no_yaw[MAX_MOTORS];
+
+        for (int i = 0; i < motor_count_; ++i) {
+            u_full[i] = apply(allocation.P_full[i], tau, T);
+            u_no_yaw[i] = apply(allocation.P_no_yaw[i], tau, T);
+
+            // Smallest blend towards the yaw-free solution that keeps this motor in [0, 1]
+            const float d = u_no_yaw[i] - u_full[i];
+
+            if (u_full[i] < 0.f && d > 0.f) {
+                k = std::fmax(k, -u_full[i] / d);
+
+            } else if (u_full[i] > 1.f && d < 0.f) {
+                k = std::fmax(k, (1.f - u_full[i]) / d);
+            }
+        }
+
+        k = std::fmin(k, 1.f);
+
+        for (int i = 0; i < motor_count_; ++i) {
+            const float ui = u_full[i] + k * (u_no_yaw[i] - u_full[i]);
+            u[i] = std::isfinite(ui) ? std::fmin(std::fmax(ui, 0.f), 1.f) : 0.f;
+        }
+    }
+
+    /**
+     * @brief Torque the commands produce if all commanded motors respond
+     */
+    Vector3f torque(const float u[MAX_MOTORS]) const {
+        Vector3f tau(0.f, 0.f, 0.f);
+
+        for (int i = 0; i < motor_count_; ++i) {
+            tau(0) += B_[0][i] * u[i];
+            tau(1) += B_[1][i] * u[i];
+            tau(2) += B_[2][i] * u[i];
+        }
+
+        return tau;
+    }
+
+    /**
+     * @brief Torque of a motor per unit command (effectiveness column)
+     */
+    Vector3f torque_effectiveness(int motor) const {
+        return Vector3f(B_[0][motor], B_[1][motor], B_[2][motor]);
+    }
+
+    /**
+     * @brief Signed sum of rotor speeds along body +z (rad/s)
+     *
+     * Thrust grows with the square of the rotor speed, so each speed is
+     * taken as rotor_speed_max * sqrt(u_i).
+     */
+    float rotor_momentum(const float u[MAX_MOTORS]) const {
+        float h = 0.f;
+
+        for (int i = 0; i < motor_count_; ++i) {
+            h += spin_[i] * std::sqrt(std::fmax(u[i], 0.f));
+        }
+
+        return h * rotor_speed_max_;
+    }
+
+    bool is_enabled() const { return motor_count_ > 0; }
+    int motor_count() const { return motor_count_; }
+    int failed_motor() const { return failed_motor_; }
+    float max_thrust() const { return thrust_max_total_; }
+
+    /**
+     * @brief False if the active allocation leaves yaw uncontrolled
+     */
+    bool is_yaw_controllable() const { return allocations_[failed_motor_ + 1].yaw_controllable; }
+
+private:
+    struct Allocation {
+        float P_full[MAX_MOTORS][4];      // All rows (zero if yaw is not controllable)
+        float P_no_yaw[MAX_MOTORS][4];    // Roll, pitch and thrust rows only
+        bool yaw_controllable;
+    };
+
+    static float apply(const float (&P)[4], const Vector3f &tau, float T) {
+        return P[0] * tau(0) + P[1] * tau(1) + P[2] * tau(2) + P[3] * T;
+    }
+
+    /**
+     * @brief Both pseudo-inverses with column `removed` zeroed (-1: none)
+     */
+    void compute_allocation(int removed, Allocation &allocation) const {
+        static const int ALL_ROWS[4] = {0, 1, 2, 3};
+        static const int NO_YAW_ROWS[3] = {0, 1, 3};
+
+        allocation.yaw_controllable = compute_pseudo_inverse(removed, ALL_ROWS, 4, allocation.P_full);
+        compute_pseudo_inverse(removed, NO_YAW_ROWS, 3, allocation.P_no_yaw);
+    }
+
+    /**
+     * @brief P = B_r^T (B_r B_r^T)^-1 on the selected rows, B_r = B with column `removed` zeroed
+     *
+     * Configuration time only: Gauss-Jordan inversion of the (at most 4 x 4)
+     * Gram matrix. Rows not selected get zero columns in P.
+     *
+     * @return false (and P zero) if the Gram matrix is singular
+     */
+    bool compute_pseudo_inverse(int removed, const int *rows, int n, float (&P)[MAX_MOTORS][4]) const {
+        for (int i = 0; i < MAX_MOTORS; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                P[i][j] = 0.f;
+            }
+        }
+
+        float G_inv[4][4];
+
+        if (!gram_inverse(removed, rows, n, G_inv)) {
+            return false;
+        }
+
+        for (int i = 0; i < motor_count_; ++i) {
+            if (i == removed) {
+                continue;
+            }
+
+            for (int a = 0; a < n; ++a) {
+                float sum = 0.f;
+
+                for (int b = 0; b < n; ++b) {
+                    sum += B_[rows[b]][i] * G_inv[b][a];
+                }
+
+                P[i][rows[a]] = sum;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Invert the Gram matrix of the selected rows of B (column `removed` excluded)
+     *
+     * The torque and thrust rows differ by orders of magnitude, so the Gram
+     * matrix G is equilibrated to unit diagonal (G = D C D) before inverting.
+     *
+     * @return false if it is singular
+     */
+    bool gram_inverse(int removed, const int *rows, int n, float (&G_inv)[4][4]) const {
+        double G[4][4];
+
+        for (int a = 0; a < n; ++a) {
+            for (int b = 0; b < n; ++b) {
+                double sum = 0.0;
+
+                for (int i = 0; i < motor_count_; ++i) {
+                    if (i != removed) {
+                        sum += static_cast<double>(B_[rows[a]][i]) * B_[rows[b]][i];
+                    }
+                }
+
+                G[a][b] = sum;
+            }
+        }
+
+        double d[4];
+
+        for (int a = 0; a < n; ++a) {
+            if (G[a][a] <= 0.0) {
+                return false;
+            }
+
+            d[a] = 1.0 / std::sqrt(G[a][a]);
+        }
+
+        // Gauss-Jordan on [C | I] with partial pivoting
+        double A[4][8];
+
+        for (int a = 0; a < n; ++a) {
+            for (int b = 0; b < n; ++b) {
+                A[a][b] = d[a] * G[a][b] * d[b];
+                A[a][n + b] = (a == b) ? 1.0 : 0.0;
+            }
+        }
+
+        for (int c = 0; c < n; ++c) {
+            int pivot = c;
+
+            for (int r = c + 1; r < n; ++r) {
+                if (std::fabs(A[r][c]) > std::fabs(A[pivot][c])) {
+                    pivot = r;
+                }
+            }
+
+            if (std::fabs(A[pivot][c]) < 1e-6) {
+                return false;
+            }
+
+            for (int b = 0; b < 2 * n; ++b) {
+                const double t = A[c][b];
+                A[c][b] = A[pivot][b];
+                A[pivot][b] = t;
+            }
+
+            const double inv = 1.0 / A[c][c];
+
+            for (int b = 0; b < 2 * n; ++b) {
+                A[c][b] *= inv;
+            }
+
+            for (int r = 0; r < n; ++r) {
+                if (r != c) {
+                    const double f = A[r][c];
+
+                    for (int b = 0; b < 2 * n; ++b) {
+                        A[r][b] -= f * A[c][b];
+                    }
+                }
+            }
+        }
+
+        // G^-1 = D C^-1 D
+        for (int a = 0; a < n; ++a) {
+            for (int b = 0; b < n; ++b) {
+                G_inv[a][b] = static_cast<float>(d[a] * A[a][n + b] * d[b]);
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief PX4 mixer geometry of a frame: roll, pitch, yaw scale per motor
+     */
+    static const float (*frame_scales(MotorFrame frame, int &count))[3] {
+        static const float quad_x[4][3] = {
+            {-0.707107f, 0.707107f, 1.f},
+            {0.707107f, -0.707107f, 1.f},
+            {0.707107f, 0.707107f, -1.f},
+            {-0.707107f, -0.707107f, -1.f},
+        };
+
+        static const float hex_x[6][3] = {
+            {-1.f, 0.f, 1.f},
+            {1.f, 0.f, -1.f},
+            {0.5f, 0.866025f, 1.f},
+            {-0.5f, -0.866025f, -1.f},
+            {-0.5f, 0.866025f, -1.f},
+            {0.5f, -0.866025f, 1.f},
+        };
+
+        switch (frame) {
+        case MotorFrame::QUAD_X:
+            count = 4;
+            return quad_x;
+
+        case MotorFrame::HEX_X:
+            count = 6;
+            return hex_x;
+
+        default:
+            count = 0;
+            return nullptr;
+        }
+    }
+
+    int motor_count_{0};
+    int failed_motor_{-1};
+    float thrust_max_total_{0.f};
+    float rotor_speed_max_{0.f};
+
+    // Rotor spin direction along body z (+1 / -1)
+    float spin_[MAX_MOTORS]{};
+
+    // Effectiveness: roll, pitch, yaw torque and thrust rows
+    float B_[4][MAX_MOTORS]{};
+
+    // Nominal, then with motor 0 .. N-1 removed
+    Allocation allocations_[MAX_MOTORS + 1]{};
+};
+
+} // namespace attitude_controller_aic
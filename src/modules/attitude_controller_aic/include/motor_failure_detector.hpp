@@ -0,0 +1,198 @@
+/**
+ * @file motor_failure_detector.hpp
+ * @brief Single motor failure detection from the torque prediction residual
+ *
+ * The controller's disturbance observer already evaluates the model torque
+ * at the measured angular acceleration. Against the torque the motor
+ * commands should have produced (allocation effectiveness times commands),
+ * the residual
+ *
+ *   r = B_tau * u - tau_model
+ *
+ * is near zero in nominal flight and jumps to b_i * u_i when motor i stops
+ * producing thrust (b_i: its effectiveness column, u_i: its command). Each
+ * motor's signature g_i = b_i * u_i is matched against the step of r over a
+ * slow baseline (which absorbs constant disturbances and model errors):
+ *
+ *   loss_i = (step . g_i) / |g_i|^2      fraction of motor i's torque missing
+ *   cos_i  = (step . g_i) / (|step| |g_i|)   direction match
+ *
+ * The best candidate with cos_i >= MIN_DIRECTION_MATCH and loss_i between
+ * the loss threshold and MAX_LOSS (a motor cannot lose much more than all
+ * of its torque) must persist for the confirmation time; the failure is then
+ * latched until reset(). Steps within NOISE_RATIO times their own nominal
+ * RMS (e.g. from aliased vibration in the measured acceleration) are not
+ * attributed to a motor. Nothing is declared until baseline and noise have
+ * settled for BASELINE_TIME_CONSTANT. Per tick this is N dot products.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+#include "motor_allocation.hpp"
+#include <cmath>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+
+/**
+ * @class MotorFailureDetector
+ * @brief Residual signature matching against the motor effectiveness columns
+ */
+class MotorFailureDetector {
+public:
+    static constexpr float FAST_TIME_CONSTANT = 0.006f;     // Residual noise filter (s)
+    static constexpr float BASELINE_TIME_CONSTANT = 1.f;    // Slow residual baseline (s)
+    static constexpr float MIN_DIRECTION_MATCH = 0.9f;      // cos between step and signature
+    static constexpr float MIN_COMMAND = 0.05f;             // Motors below this have no observable signature
+    static constexpr float MAX_LOSS = 1.5f;                 // Larger missing fractions are not a motor
+    static constexpr float NOISE_RATIO = 3.f;               // Minimum step over its nominal RMS
+
+    /**
+     * @brief Initialize with default thresholds
+     */
+    void init() {
+        set_parameters(0.5f, 0.008f);
+        reset();
+    }
+
+    /**
+     * @param loss_threshold fraction of a motor's torque that must be missing [0, 1]
+     * @param confirm_time time the same candidate must persist (s)
+     */
+    void set_parameters(float loss_threshold, float confirm_time) {
+        loss_threshold_ = loss_threshold;
+        confirm_time_ = confirm_time;
+    }
+
+    /**
+     * @brief Clear the latched failure and the residual filters
+     */
+    void reset() {
+        residual_fast_ = Vector3f(0.f, 0.f, 0.f);
+        residual_baseline_ = Vector3f(0.f, 0.f, 0.f);
+        noise_variance_ = 0.f;
+        settled_time_ = 0.f;
+        initialized_ = false;
+        candidate_ = -1;
+        candidate_time_ = 0.f;
+        loss_ = 0.f;
+        failed_motor_ = -1;
+    }
+
+    /**
+     * @brief Process one control tick
+     *
+     * @param residual torque the last commands should have produced minus the model torque (Nm)
+     * @param allocation allocation the last commands came from
+     * @param u last motor commands
+     * @param dt timestep (s)
+     * @return true on the tick the failure is confirmed
+     */
+    bool update(const Vector3f &residual, const MotorAllocation &allocation, const float u[MotorAllocation::MAX_MOTORS],
+                float dt) {
+        if (failed_motor_ >= 0 || dt <= 0.f || !std::isfinite(residual(0) + residual(1) + residual(2))) {
+            return false;
+        }
+
+        if (!initialized_) {
+            residual_fast_ = residual;
+            residual_baseline_ = residual;
+            initialized_ = true;
+            return false;
+        }
+
+        residual_fast_ += (residual - residual_fast_) * (dt / (FAST_TIME_CONSTANT + dt));
+        const Vector3f step = residual_fast_ - residual_baseline_;
+        const float step_sq = step.dot(step);
+        const float step_norm = std::sqrt(step_sq);
+        const bool settled = settled_time_ >= BASELINE_TIME_CONSTANT;
+        const bool above_noise = step_sq > NOISE_RATIO * NOISE_RATIO * noise_variance_;
+
+        int best = -1;
+        float best_loss = 0.f;
+
+        for (int i = 0; i < allocation.motor_count(); ++i) {
+            if (u[i] < MIN_COMMAND) {
+                continue;
+            }
+
+            const Vector3f g = allocation.torque_effectiveness(i) * u[i];
+            const float g_sq = g.dot(g);
+            const float projection = step.dot(g);
+
+            if (g_sq <= 0.f || projection < MIN_DIRECTION_MATCH * step_norm * std::sqrt(g_sq)) {
+                continue;
+            }
+
+            const float loss = projection / g_sq;
+
+            if (loss > best_loss && loss <= MAX_LOSS) {
+                best_loss = loss;
+                best = i;
+            }
+        }
+
+        loss_ = best_loss;
+
+        if (settled && above_noise && best >= 0 && best_loss >= loss_threshold_) {
+            candidate_time_ = (best == candidate_) ? candidate_time_ + dt : dt;
+            candidate_ = best;
+
+            if (candidate_time_ >= confirm_time_) {
+                failed_motor_ = best;
+                return true;
+            }
+
+        } else {
+            candidate_ = -1;
+            candidate_time_ = 0.f;
+
+            // Baseline and noise only track while no failure is suspected, so a step is not absorbed
+            const float k = dt / (BASELINE_TIME_CONSTANT + dt);
+            residual_baseline_ += (residual_fast_ - residual_baseline_) * k;
+            noise_variance_ += (step_sq - noise_variance_) * k;
+            settled_time_ += dt;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Latched failed motor (-1: none)
+     */
+    int get_failed_motor() const { return failed_motor_; }
+
+    /**
+     * @brief Missing torque fraction of the best matching motor on the last tick
+     */
+    float get_loss_estimate() const { return loss_; }
+
+    /**
+     * @brief Filtered residual step over the baseline (Nm)
+     */
+    Vector3f get_residual_step() const { return residual_fast_ - residual_baseline_; }
+
+    /**
+     * @brief Nominal RMS of the residual step (Nm)
+     */
+    float get_residual_noise() const { return std::sqrt(noise_variance_); }
+
+private:
+    float loss_threshold_{0.5f};
+    float confirm_time_{0.008f};
+
+    Vector3f residual_fast_;
+    Vector3f residual_baseline_;
+    float noise_variance_{0.f};    // Nominal mean square of the residual step (Nm^2)
+    float settled_time_{0.f};      // Time baseline and noise have been tracking (s)
+    bool initialized_{false};
+
+    int candidate_{-1};
+    float candidate_time_{0.f};
+    float loss_{0.f};
+    int failed_motor_{-1};
+};
+
+} // namespace attitude_controller_aic
@@ -0,0 +1,99 @@
+/**
+ * @file parameter_layout.hpp
+ * @brief Parameter layouts of the adaptive torque model
+ *
+ * A layout fixes at compile time which parameters theta holds, in order:
+ *
+ *   [ inertia (3 diagonal or 6 full) | CoM offset r_x, r_y | yaw drag c_z | rotor inertia J_r ]
+ *
+ * Every parameter enters the torque linearly, so the model stays
+ * tau = Y(x) * theta with one regressor column per parameter
+ * (Regressor::evaluate() fills all columns of a layout in one pass).
+ * The extra columns model torques the inertia alone turns into a persistent
+ * bias for the robust term:
+ *
+ * - CoM offset: the collective thrust T acts along body -z at the rotor
+ *   centroid. With the center of mass displaced by r from it, thrust
+ *   exerts r x (0, 0, T) about the center of mass, so the actuators must
+ *   supply T * (-r_y, r_x, 0). r_z is parallel to the thrust and not
+ *   observable from it.
+ * - Yaw drag: aerodynamic rotor drag damps yaw rotation, c_z * Omega_z.
+ * - Rotor inertia: the rotors carry angular momentum J_r * h along body z
+ *   (h: signed sum of rotor speeds, positive along +z), which needs
+ *   J_r * (Omega x (0, 0, h) + (0, 0, dh/dt)).
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+
+namespace attitude_controller_aic {
+
+using Vector3f = matrix::Vector3f;
+
+/**
+ * @brief Variables the regressor columns of any layout are built from
+ */
+struct RegressorInput {
+    Vector3f Omega;                   // Angular velocity (rad/s)
+    Vector3f alpha;                   // Angular acceleration (rad/s^2)
+    float thrust{0.f};                // Collective thrust along body -z (N, or normalized [0, 1])
+    float rotor_momentum{0.f};        // Signed rotor speed sum h along body +z (rad/s)
+    float rotor_momentum_rate{0.f};   // dh/dt (rad/s^2)
+};
+
+/**
+ * @brief Bounds of the parameters beyond inertia (projection after every update)
+ */
+struct ExtendedBounds {
+    float com_offset{0.05f};          // |r_x|, |r_y| (m, or Nm at full thrust with normalized thrust)
+    float yaw_drag{0.05f};            // c_z in [0, bound] (Nm per rad/s)
+    float rotor_inertia{1e-3f};       // J_r in [0, bound] (kg*m^2)
+};
+
+/**
+ * @struct ParameterLayout
+ * @brief Compile-time parameter vector layout
+ *
+ * @tparam FullInertia full symmetric inertia (6) instead of principal moments (3)
+ * @tparam ComOffset center-of-mass offset r_x, r_y (thrust coupled)
+ * @tparam YawDrag yaw drag coefficient c_z
+ * @tparam RotorInertia rotor inertia J_r (gyroscopic and spin-up torque)
+ */
+template<bool FullInertia, bool ComOffset, bool YawDrag, bool RotorInertia>
+struct ParameterLayout {
+    static constexpr bool FULL_INERTIA = FullInertia;
+    static constexpr bool COM_OFFSET = ComOffset;
+    static constexpr bool YAW_DRAG = YawDrag;
+    static constexpr bool ROTOR_INERTIA = RotorInertia;
+
+    // Parameter indices (a disabled group has no entries)
+    static constexpr int INERTIA = FullInertia ? 6 : 3;       // Jxx, Jyy, Jzz [, Jxy, Jxz, Jyz]
+    static constexpr int COM = INERTIA;                        // r_x, r_y
+    static constexpr int DRAG = COM + (ComOffset ? 2 : 0);     // c_z
+    static constexpr int ROTOR = DRAG + (YawDrag ? 1 : 0);     // J_r
+    static constexpr int N = ROTOR + (RotorInertia ? 1 : 0);
+
+    /**
+     * @brief Axis a parameter acts on alone (vibration gating), -1 if it couples axes
+     *
+     * Principal inertia i: axis i (alpha_i). r_x produces pitch torque, r_y
+     * roll torque, c_z yaw torque. Products of inertia and the rotor inertia
+     * enter through gyroscopic products of several axes.
+     */
+    static constexpr int axis(int index) {
+        return (index < 3) ? index
+               : (index < INERTIA) ? -1
+               : (ComOffset && index == COM) ? 1
+               : (ComOffset && index == COM + 1) ? 0
+               : (YawDrag && index == DRAG) ? 2
+               : -1;
+    }
+};
+
+using DiagonalInertiaLayout = ParameterLayout<false, false, false, false>;
+using FullInertiaLayout = ParameterLayout<true, false, false, false>;
+using ExtendedDiagonalLayout = ParameterLayout<false, true, true, true>;
+using ExtendedFullLayout = ParameterLayout<true, true, true, true>;
+
+} // namespace attitude_controller_aic
@@ -0,0 +1,279 @@
+/**
+ * @file rate_governor.hpp
+ * @brief Flight-phase-adaptive control loop rate governor
+ *
+ * Decimates the attitude message stream so that the control/adaptation
+ * update runs at a reduced rate in benign flight phases:
+ * - GROUND_IDLE: vehicle landed, lowest rate
+ * - CRUISE: steady setpoint, small tracking error, no saturation
+ * - AGILE: full message rate
+ *
+ * Any setpoint change, disturbance or saturation forces AGILE on the very
+ * message it is detected. The decimation factor is additionally limited by
+ * the measured message interval so that the effective control period keeps
+ * the discretized rate loop inside its stability margin.
+ *
+ * A base divider (from the boot-time CPU benchmark) lowers the full rate
+ * itself on boards that cannot afford the controller on every message; the
+ * phase dividers never run faster than it. The stability bound still wins
+ * over it (the inertia estimate, and with it the rate-loop gain, moves in
+ * flight); messages where it cuts the base divider are counted as over the
+ * CPU budget.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+/**
+ * @class RateGovernor
+ * @brief Selects the controller update divider from the flight phase
+ */
+class RateGovernor {
+public:
+    enum class Phase : uint8_t {
+        GROUND_IDLE = 0,
+        CRUISE,
+        AGILE
+    };
+
+    /**
+     * @brief Initialize governor with default thresholds
+     */
+    void init() {
+        base_divider_ = 1;
+        idle_divider_ = 8;
+        cruise_divider_ = 2;
+        setpoint_threshold_ = 0.02f;
+        disturbance_threshold_ = 0.3f;
+        stability_margin_ = 0.5f;
+        agile_hold_time_ = 0.5f;
+        max_dt_ = 0.1f;
+
+        reset();
+    }
+
+    /**
+     * @brief Set governor parameters
+     *
+     * @param idle_divider message divider on the ground
+     * @param cruise_divider message divider in steady flight
+     * @param setpoint_threshold setpoint change that forces full rate
+     * @param disturbance_threshold rate error / composite error norm (rad/s) that forces full rate
+     * @param stability_margin admissible fraction of the forward-Euler limit gain*dt < 2
+     */
+    void set_parameters(int idle_divider, int cruise_divider, float setpoint_threshold,
+                        float disturbance_threshold, float stability_margin) {
+        idle_divider_ = std::max(1, idle_divider);
+        cruise_divider_ = std::max(1, cruise_divider);
+        setpoint_threshold_ = std::max(0.f, setpoint_threshold);
+        disturbance_threshold_ = std::max(0.f, disturbance_threshold);
+        stability_margin_ = std::max(0.01f, std::min(stability_margin, 1.f));
+    }
+
+    /**
+     * @brief Divider at full rate (AGILE), lower bound of the phase dividers
+     */
+    void set_base_divider(int base_divider) {
+        base_divider_ = std::max(1, base_divider);
+    }
+
+    int get_base_divider() const { return base_divider_; }
+
+    /**
+     * @brief Base divider within the stability bound
+     *
+     * Counts the messages where the bound cuts the base divider (the CPU
+     * budget is not met on them). Before the first interval is measured
+     * there is no bound to apply.
+     */
+    int stable_base_divider() {
+        if (message_interval_ <= 0.f) {
+            return base_divider_;
+        }
+
+        const int stable = std::min(base_divider_, max_stable_divider());
+        over_budget_messages_ += (stable < base_divider_) ? 1u : 0u;
+        return stable;
+    }
+
+    /**
+     * @brief Messages on which the stability bound overrode the base divider
+     */
+    uint32_t get_over_budget_messages() const { return over_budget_messages_; }
+
+    /**
+     * @brief Track the attitude message interval (every message, also without the phase selection)
+     */
+    void observe_message(uint64_t timestamp_us) {
+        if (last_timestamp_us_ != 0 && timestamp_us > last_timestamp_us_) {
+            const float interval = (timestamp_us - last_timestamp_us_) * 1e-6f;
+            message_interval_ = (message_interval_ > 0.f)
+                                ? 0.95f * message_interval_ + 0.05f * interval
+                                : interval;
+        }
+
+        last_timestamp_us_ = timestamp_us;
+    }
+
+    /**
+     * @brief Upper bound on the effective control period (matches the module dt clamp)
+     */
+    void set_max_period(float max_dt) {
+        max_dt_ = std::max(0.001f, max_dt);
+    }
+
+    /**
+     * @brief Process one attitude message and decide whether to run the controller
+     *
+     * Cheap enough to evaluate on every message, including skipped ones.
+     *
+     * @param timestamp_us message timestamp (microseconds)
+     * @param landed true if the vehicle is on the ground
+     * @param setpoint_change change of the setpoint since the last control update
+     * @param rate_error |Omega - Omega_d| (rad/s), disturbance proxy between updates
+     * @return true if the controller should run on this message
+     */
+    bool update(uint64_t timestamp_us, bool landed, float setpoint_change, float rate_error) {
+        // Track the message interval (timing instrumentation for the margin check)
+        observe_message(timestamp_us);
+
+        // Phase selection: any trigger raises the rate immediately
+        const bool triggered = (setpoint_change > setpoint_threshold_)
+                               || (rate_error > disturbance_threshold_)
+                               || last_disturbed_ || last_saturated_;
+
+        if (triggered) {
+            agile_until_us_ = timestamp_us + static_cast<uint64_t>(agile_hold_time_ * 1e6f);
+        }
+
+        const Phase previous = phase_;
+
+        if (triggered || timestamp_us < agile_until_us_) {
+            phase_ = Phase::AGILE;
+
+        } else if (landed) {
+            phase_ = Phase::GROUND_IDLE;
+
+        } else {
+            phase_ = Phase::CRUISE;
+        }
+
+        // The base divider is what the CPU affords, within the stability bound
+        divider_ = std::max(std::min(phase_divider(phase_), max_stable_divider()), stable_base_divider());
+
+        ++skipped_;
+
+        if ((phase_ == Phase::AGILE && previous != Phase::AGILE) || skipped_ >= divider_) {
+            skipped_ = 0;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Report the result of a control update
+     *
+     * @param composite_error_norm |s_filtered|
+     * @param saturated true if the torque command was saturated
+     * @param rate_loop_gain (K_Omega + K) / J_hat, see AttitudeControllerAIC::get_rate_loop_gain()
+     */
+    void report_control(float composite_error_norm, bool saturated, float rate_loop_gain) {
+        last_disturbed_ = composite_error_norm > disturbance_threshold_;
+        last_saturated_ = saturated;
+        rate_loop_gain_ = rate_loop_gain;
+    }
+
+    /**
+     * @brief Largest divider keeping the effective period within the stability margin
+     *
+     * Effective period dt_eff = divider * message_interval must satisfy
+     * rate_loop_gain * dt_eff < 2 * stability_margin and dt_eff <= max_dt.
+     */
+    int max_stable_divider() const {
+        if (message_interval_ <= 0.f) {
+            return 1;
+        }
+
+        float dt_limit = max_dt_;
+
+        if (rate_loop_gain_ > 0.f) {
+            dt_limit = std::min(dt_limit, 2.f * stability_margin_ / rate_loop_gain_);
+        }
+
+        return std::max(1, static_cast<int>(dt_limit / message_interval_));
+    }
+
+    /**
+     * @brief Reset phase and timing state
+     */
+    void reset() {
+        phase_ = Phase::AGILE;
+        divider_ = 1;
+        skipped_ = 0;
+        last_timestamp_us_ = 0;
+        agile_until_us_ = 0;
+        message_interval_ = 0.f;
+        rate_loop_gain_ = 0.f;
+        last_disturbed_ = false;
+        last_saturated_ = false;
+    }
+
+    Phase get_phase() const { return phase_; }
+    int get_divider() const { return divider_; }
+    float get_message_interval() const { return message_interval_; }
+
+    static const char *phase_name(Phase phase) {
+        switch (phase) {
+        case Phase::GROUND_IDLE: return "ground idle";
+
+        case Phase::CRUISE: return "cruise";
+
+        case Phase::AGILE: return "agile";
+        }
+
+        return "unknown";
+    }
+
+private:
+    int phase_divider(Phase phase) const {
+        switch (phase) {
+        case Phase::GROUND_IDLE: return idle_divider_;
+
+        case Phase::CRUISE: return cruise_divider_;
+
+        case Phase::AGILE: return 1;
+        }
+
+        return 1;
+    }
+
+    // Configuration
+    int base_divider_{1};
+    int idle_divider_{8};
+    int cruise_divider_{2};
+    float setpoint_threshold_{0.02f};
+    float disturbance_threshold_{0.3f};
+    float stability_margin_{0.5f};
+    float agile_hold_time_{0.5f};    // Time to stay at full rate after a trigger (s)
+    float max_dt_{0.1f};
+
+    // State
+    Phase phase_{Phase::AGILE};
+    int divider_{1};
+    int skipped_{0};
+    uint64_t last_timestamp_us_{0};
+    uint64_t agile_until_us_{0};
+    float message_interval_{0.f};    // Filtered attitude message interval (s)
+    float rate_loop_gain_{0.f};
+    bool last_disturbed_{false};
+    bool last_saturated_{false};
+    uint32_t over_budget_messages_{0};
+};
+
+} // namespace attitude_controller_aic
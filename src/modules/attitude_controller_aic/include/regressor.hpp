@@ -3,15 +3,27 @@
  * @brief Linear-in-parameters rigid-body torque regressor
  * 
  * Implements the regressor matrix Y(Omega, alpha) such that:
- * tau_rb = J*alpha - Omega x (J*Omega) = Y(Omega, alpha) * theta
+ * tau_rb = J*alpha + Omega x (J*Omega) = Y(Omega, alpha) * theta
  * 
- * where theta contains the inertia parameters (diagonal or full symmetric)
+ * where theta contains the inertia parameters (diagonal or full symmetric),
+ * optionally extended with center-of-mass offset, yaw drag and rotor inertia
+ * (see parameter_layout.hpp).
+ *
+ * Sign convention: this is Euler's equation J*dOmega/dt = tau - Omega x (J*Omega)
+ * solved for the torque, the same model the inertia EKF predicts with and the
+ * plant of the SIL integrates. Everything that forms a model torque follows it:
+ * the adaptive feedforward and the estimators (through Y), the disturbance
+ * observer residual, the fixed-inertia fallback law, the rotor momentum
+ * column (Omega x (0, 0, h), the gyroscopic term of the rotors) and the
+ * fixed-point controller.
  */
 
 #pragma once
 
 #include <matrix/matrix.hpp>
 #include "so3_utils.hpp"
+#include "parameter_layout.hpp"
+#include <type_traits>
 
 namespace attitude_controller_aic {
 
@@ -20,7 +32,7 @@ using Matrix3f = matrix::Matrix3f;
 
 /**
  * @class Regressor
- * @brief Rigid-body torque regressor (linear in inertia parameters)
+ * @brief Torque regressor (linear in the inertia and extended model parameters)
  */
 class Regressor {
 public:
@@ -28,9 +40,9 @@ public:
      * @brief Regressor matrix Y for diagonal inertia
      * 
      * For diagonal inertia J = diag(Jxx, Jyy, Jzz), the regressor is 3x3:
-     *   Y_d = [ alpha_x,        Omega_y*Omega_z,       -Omega_y*Omega_z       ]
-     *         [-Omega_x*Omega_z,  alpha_y,              Omega_x*Omega_z        ]
-     *         [ Omega_x*Omega_y, -Omega_x*Omega_y,      alpha_z                ]
+     *   Y_d = [ alpha_x,        -Omega_y*Omega_z,       Omega_y*Omega_z        ]
+     *         [ Omega_x*Omega_z,  alpha_y,             -Omega_x*Omega_z        ]
+     *         [-Omega_x*Omega_y,  Omega_x*Omega_y,      alpha_z                ]
      * 
      * tau_rb = Y_d * [Jxx, Jyy, Jzz]^T
      * 
@@ -39,18 +51,10 @@ public:
      * @return 3x3 regressor matrix
      */
     static matrix::Matrix<float, 3, 3> regressor_diagonal(const Vector3f &Omega, const Vector3f &alpha) {
-        float wx = Omega(0), wy = Omega(1), wz = Omega(2);
-        float ax = alpha(0), ay = alpha(1), az = alpha(2);
-        
-        matrix::Matrix<float, 3, 3> Y;
-        // Row 1: torque about x-axis
-        Y(0, 0) = ax;              Y(0, 1) = wy * wz;        Y(0, 2) = -wy * wz;
-        // Row 2: torque about y-axis
-        Y(1, 0) = -wx * wz;        Y(1, 1) = ay;             Y(1, 2) = wx * wz;
-        // Row 3: torque about z-axis
-        Y(2, 0) = wx * wy;         Y(2, 1) = -wx * wy;       Y(2, 2) = az;
-        
-        return Y;
+        RegressorInput x;
+        x.Omega = Omega;
+        x.alpha = alpha;
+        return evaluate<DiagonalInertiaLayout>(x);
     }
 
     /**
@@ -58,7 +62,7 @@ public:
      * 
      * For full symmetric inertia with theta = [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz]^T
      * 
-     * tau_rb = J*alpha - Omega x (J*Omega)
+     * tau_rb = J*alpha + Omega x (J*Omega)
      * where both J*alpha and Omega x (J*Omega) are linear in theta
      * 
      * @param Omega angular velocity
@@ -66,36 +70,39 @@ public:
      * @return 3x6 regressor matrix
      */
     static matrix::Matrix<float, 3, 6> regressor_full(const Vector3f &Omega, const Vector3f &alpha) {
-        float wx = Omega(0), wy = Omega(1), wz = Omega(2);
-        float ax = alpha(0), ay = alpha(1), az = alpha(2);
-        
-        matrix::Matrix<float, 3, 6> Y;
-        
-        // Row 1: tau_x = Jxx*ax + Jxy*ay + Jxz*az + (Jyy*wy - Jyz*wz)*wz + (Jzz*wz - Jzz*wz)*wy - (Jyy*wy + Jyz*wz)*wz
-        // tau_x = Jxx*ax + Jxy*(ay - wy*wz) + Jxz*(az + wy*wz) + Jyy*wy*wz - Jyz*(wy^2 - wz^2)
-        Y(0, 0) = ax;                    // Jxx coefficient
-        Y(0, 1) = wy * wz;               // Jyy coefficient
-        Y(0, 2) = -wy * wz;              // Jzz coefficient
-        Y(0, 3) = ay + wx * wz;          // Jxy coefficient
-        Y(0, 4) = az - wx * wy;          // Jxz coefficient
-        Y(0, 5) = -wy * wy + wz * wz;    // Jyz coefficient
-        
-        // Row 2: tau_y = Jxy*ax + Jyy*ay + Jyz*az + ...
-        Y(1, 0) = -wx * wz;              // Jxx coefficient
-        Y(1, 1) = ay;                    // Jyy coefficient
-        Y(1, 2) = wx * wz;               // Jzz coefficient
-        Y(1, 3) = ax - wy * wz;          // Jxy coefficient
-        Y(1, 4) = wx * wx - wz * wz;     // Jxz coefficient
-        Y(1, 5) = az + wx * wy;          // Jyz coefficient
-        
-        // Row 3: tau_z = Jxz*ax + Jyz*ay + Jzz*az + ...
-        Y(2, 0) = wx * wy;               // Jxx coefficient
-        Y(2, 1) = -wx * wy;              // Jyy coefficient
-        Y(2, 2) = az;                    // Jzz coefficient
-        Y(2, 3) = wy * wy - wx * wx;     // Jxy coefficient
-        Y(2, 4) = ax + wy * wz;          // Jxz coefficient
-        Y(2, 5) = ay - wx * wz;          // Jyz coefficient
-        
+        RegressorInput x;
+        x.Omega = Omega;
+        x.alpha = alpha;
+        return evaluate<FullInertiaLayout>(x);
+    }
+
+    /**
+     * @brief Regressor of a parameter layout, all columns in one pass
+     *
+     * The gyroscopic products are formed once and shared by the inertia and
+     * rotor columns; columns of disabled groups are not generated.
+     *
+     * @tparam Layout ParameterLayout
+     * @return 3 x Layout::N regressor, tau = Y * theta
+     */
+    template<typename Layout>
+    static matrix::Matrix<float, 3, Layout::N> evaluate(const RegressorInput &x) {
+        const float wx = x.Omega(0), wy = x.Omega(1), wz = x.Omega(2);
+        const float ax = x.alpha(0), ay = x.alpha(1), az = x.alpha(2);
+        const float wxwy = wx * wy, wxwz = wx * wz, wywz = wy * wz;
+
+        matrix::Matrix<float, 3, Layout::N> Y;
+
+        // Principal inertia
+        Y(0, 0) = ax;              Y(0, 1) = -wywz;          Y(0, 2) = wywz;
+        Y(1, 0) = wxwz;            Y(1, 1) = ay;             Y(1, 2) = -wxwz;
+        Y(2, 0) = -wxwy;           Y(2, 1) = wxwy;           Y(2, 2) = az;
+
+        products_of_inertia<Layout>(x, wxwy, wxwz, wywz, Y, std::integral_constant<bool, Layout::FULL_INERTIA>());
+        com_offset<Layout>(x, Y, std::integral_constant<bool, Layout::COM_OFFSET>());
+        yaw_drag<Layout>(x, Y, std::integral_constant<bool, Layout::YAW_DRAG>());
+        rotor_inertia<Layout>(x, Y, std::integral_constant<bool, Layout::ROTOR_INERTIA>());
+
         return Y;
     }
 
@@ -121,7 +128,7 @@ public:
     /**
      * @brief Test regressor linearity (for validation)
      * 
-     * Verify that Y*theta = J*alpha - Omega x (J*Omega) for known J
+     * Verify that Y*theta = J*alpha + Omega x (J*Omega) for known J
      * 
      * @param J true inertia matrix
      * @param theta inertia parameters extracted from J
@@ -135,8 +142,8 @@ public:
                                            const Vector3f &Omega,
                                            const Vector3f &alpha,
                                            float tolerance = 1e-5f) {
-        // Compute true rigid-body torque: tau = J*alpha - Omega x (J*Omega)
-        Vector3f tau_true = J * alpha - SO3Utils::hat(Omega) * (J * Omega);
+        // Compute true rigid-body torque: tau = J*alpha + Omega x (J*Omega)
+        Vector3f tau_true = J * alpha + SO3Utils::hat(Omega) * (J * Omega);
         
         // Compute via regressor
         auto Y = regressor_diagonal(Omega, alpha);
@@ -153,7 +160,7 @@ public:
                                        const Vector3f &alpha,
                                        float tolerance = 1e-5f) {
         // Compute true rigid-body torque
-        Vector3f tau_true = J * alpha - SO3Utils::hat(Omega) * (J * Omega);
+        Vector3f tau_true = J * alpha + SO3Utils::hat(Omega) * (J * Omega);
         
         // Compute via regressor
         auto Y = regressor_full(Omega, alpha);
@@ -163,6 +170,69 @@ public:
         float error = (tau_true - tau_regressor).norm();
         return error < tolerance;
     }
+
+private:
+    // Column groups of evaluate(), selected at compile time (absent groups have no columns)
+
+    template<typename Layout, typename M>
+    static void products_of_inertia(const RegressorInput &, float, float, float, M &, std::false_type) {}
+
+    /**
+     * tau = J*alpha + Omega x (J*Omega) with theta = [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz]:
+     * tau_x = Jxx*ax + Jxy*(ay - wx*wz) + Jxz*(az + wx*wy) + (Jzz - Jyy)*wy*wz + Jyz*(wy^2 - wz^2)
+     * and cyclic
+     */
+    template<typename Layout, typename M>
+    static void products_of_inertia(const RegressorInput &x, float wxwy, float wxwz, float wywz, M &Y,
+                                    std::true_type) {
+        const float wx = x.Omega(0), wy = x.Omega(1), wz = x.Omega(2);
+        const float ax = x.alpha(0), ay = x.alpha(1), az = x.alpha(2);
+        const float wxx = wx * wx, wyy = wy * wy, wzz = wz * wz;
+
+        // Jxy, Jxz, Jyz coefficients
+        Y(0, 3) = ay - wxwz;       Y(0, 4) = az + wxwy;      Y(0, 5) = wyy - wzz;
+        Y(1, 3) = ax + wywz;       Y(1, 4) = wzz - wxx;      Y(1, 5) = az - wxwy;
+        Y(2, 3) = wxx - wyy;       Y(2, 4) = ax - wywz;      Y(2, 5) = ay + wxwz;
+    }
+
+    template<typename Layout, typename M>
+    static void com_offset(const RegressorInput &, M &, std::false_type) {}
+
+    /**
+     * Thrust moment about the displaced center of mass: T * (-r_y, r_x, 0)
+     */
+    template<typename Layout, typename M>
+    static void com_offset(const RegressorInput &x, M &Y, std::true_type) {
+        Y(0, Layout::COM) = 0.f;        Y(0, Layout::COM + 1) = -x.thrust;
+        Y(1, Layout::COM) = x.thrust;   Y(1, Layout::COM + 1) = 0.f;
+        Y(2, Layout::COM) = 0.f;        Y(2, Layout::COM + 1) = 0.f;
+    }
+
+    template<typename Layout, typename M>
+    static void yaw_drag(const RegressorInput &, M &, std::false_type) {}
+
+    /**
+     * Yaw damping of rotor drag: c_z * Omega_z
+     */
+    template<typename Layout, typename M>
+    static void yaw_drag(const RegressorInput &x, M &Y, std::true_type) {
+        Y(0, Layout::DRAG) = 0.f;
+        Y(1, Layout::DRAG) = 0.f;
+        Y(2, Layout::DRAG) = x.Omega(2);
+    }
+
+    template<typename Layout, typename M>
+    static void rotor_inertia(const RegressorInput &, M &, std::false_type) {}
+
+    /**
+     * Rotor angular momentum J_r * h along body z: Omega x (0, 0, h) + (0, 0, dh/dt)
+     */
+    template<typename Layout, typename M>
+    static void rotor_inertia(const RegressorInput &x, M &Y, std::true_type) {
+        Y(0, Layout::ROTOR) = x.Omega(1) * x.rotor_momentum;
+        Y(1, Layout::ROTOR) = -x.Omega(0) * x.rotor_momentum;
+        Y(2, Layout::ROTOR) = x.rotor_momentum_rate;
+    }
 };
 
 } // namespace attitude_controller_aic
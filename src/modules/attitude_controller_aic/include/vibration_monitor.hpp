@@ -0,0 +1,211 @@
+/**
+ * @file vibration_monitor.hpp
+ * @brief Sliding-DFT vibration monitor gating the inertia adaptation per axis
+ *
+ * Airframe vibration leaks into Omega and alpha and biases the adaptation
+ * through Y^T * s. This monitor watches the upper band of the angular rate
+ * spectrum and scales (down to freezing) the adaptation of each axis while
+ * vibration is present, so corrupted updates are never applied.
+ *
+ * A sliding DFT over a WINDOW-sample ring buffer of rate samples tracks the
+ * contiguous bins k = FIRST_BIN ... FIRST_BIN + BINS - 1 (just below Nyquist):
+ *
+ *   S_k <- r * e^{j*2*pi*k/N} * (S_k + x_new - r^N * x_old)
+ *
+ * (damping r < 1 keeps float round-off from accumulating). Per sample this
+ * is one complex multiply-add per bin and axis, computed four bins at a
+ * time with GCC/Clang vector extensions (SSE/NEON on hosts and companion
+ * computers, plain scalar code on Cortex-M). A line halfway between two
+ * bins reads at 64% of its amplitude (rectangular window scalloping).
+ *
+ * Per axis and sample:
+ * - peak level: largest bin amplitude 2 * |S_k| / N (rad/s, a sinusoid's amplitude)
+ * - broadband level: sqrt(mean_k |S_k|^2 / N) (rad/s, white noise standard deviation)
+ * - vibration ratio q = max(peak / peak_threshold, broadband / broadband_threshold)
+ * - adaptation scale 1 for q <= 1, falling linearly to 0 (frozen) at q >= 2
+ *
+ * The scale drops immediately and recovers at most 1/WINDOW per sample, so
+ * it only returns to 1 after the corrupted samples have left the window.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace attitude_controller_aic {
+
+/**
+ * @class VibrationMonitor
+ * @brief Per-axis upper-band spectral levels and adaptation scale
+ */
+class VibrationMonitor {
+public:
+    static constexpr int WINDOW = 64;
+    static constexpr int BINS = 28;
+    static constexpr int FIRST_BIN = 4;      // fs/16: above the attitude control bandwidth
+
+    /**
+     * @brief Initialize with default thresholds
+     */
+    void init() {
+        const float r = DAMPING;
+        r_N_ = std::pow(r, static_cast<float>(WINDOW));
+
+        for (int i = 0; i < BINS; ++i) {
+            const float w = 2.f * static_cast<float>(M_PI) * (FIRST_BIN + i) / WINDOW;
+            rcos_[i / 4][i % 4] = r * cosf(w);
+            rsin_[i / 4][i % 4] = r * sinf(w);
+        }
+
+        set_thresholds(0.2f, 0.3f);
+        reset();
+    }
+
+    /**
+     * @param peak_threshold sinusoid amplitude at which the scale starts dropping (rad/s)
+     * @param broadband_threshold noise standard deviation at which the scale starts dropping (rad/s)
+     */
+    void set_thresholds(float peak_threshold, float broadband_threshold) {
+        inv_peak_threshold_ = (peak_threshold > 0.f) ? 1.f / peak_threshold : 0.f;
+        inv_broadband_threshold_ = (broadband_threshold > 0.f) ? 1.f / broadband_threshold : 0.f;
+    }
+
+    /**
+     * @brief Clear the window and release the gating
+     */
+    void reset() {
+        for (int a = 0; a < 3; ++a) {
+            for (int v = 0; v < VECS; ++v) {
+                re_[a][v] = float4{0.f, 0.f, 0.f, 0.f};
+                im_[a][v] = float4{0.f, 0.f, 0.f, 0.f};
+            }
+
+            for (int n = 0; n < WINDOW; ++n) {
+                ring_[n][a] = 0.f;
+            }
+
+            peak_[a] = 0.f;
+            broadband_[a] = 0.f;
+            peak_bin_[a] = 0;
+            scale_[a] = 1.f;
+        }
+
+        head_ = 0;
+        samples_ = 0;
+    }
+
+    /**
+     * @brief Add one angular rate sample (rad/s) and update levels and scales
+     */
+    void update(float x, float y, float z) {
+        const float sample[3] = {x, y, z};
+        constexpr float amplitude_scale = 2.f / WINDOW;
+        constexpr float power_scale = 1.f / (BINS * WINDOW);
+
+        for (int a = 0; a < 3; ++a) {
+            // Non-finite samples would poison the window until reset
+            const float x_new = std::isfinite(sample[a]) ? sample[a] : 0.f;
+            const float delta = x_new - r_N_ * ring_[head_][a];
+            ring_[head_][a] = x_new;
+
+            float4 power_sum{0.f, 0.f, 0.f, 0.f};
+            float4 power[VECS];
+
+            for (int v = 0; v < VECS; ++v) {
+                const float4 re = re_[a][v] + delta;
+                const float4 im = im_[a][v];
+                re_[a][v] = rcos_[v] * re - rsin_[v] * im;
+                im_[a][v] = rsin_[v] * re + rcos_[v] * im;
+
+                power[v] = re_[a][v] * re_[a][v] + im_[a][v] * im_[a][v];
+                power_sum += power[v];
+            }
+
+            float peak_power = 0.f;
+            int peak_bin = 0;
+
+            for (int i = 0; i < BINS; ++i) {
+                if (power[i / 4][i % 4] > peak_power) {
+                    peak_power = power[i / 4][i % 4];
+                    peak_bin = i;
+                }
+            }
+
+            peak_[a] = amplitude_scale * std::sqrt(peak_power);
+            broadband_[a] = std::sqrt(power_scale * (power_sum[0] + power_sum[1] + power_sum[2] + power_sum[3]));
+            peak_bin_[a] = peak_bin;
+        }
+
+        head_ = (head_ + 1) % WINDOW;
+
+        if (samples_ < WINDOW) {
+            // Levels are meaningless until the window is full
+            ++samples_;
+            return;
+        }
+
+        for (int a = 0; a < 3; ++a) {
+            const float q = std::fmax(peak_[a] * inv_peak_threshold_, broadband_[a] * inv_broadband_threshold_);
+            const float target = std::fmin(std::fmax(2.f - q, 0.f), 1.f);
+            scale_[a] = (target < scale_[a]) ? target : std::fmin(target, scale_[a] + 1.f / WINDOW);
+        }
+    }
+
+    /**
+     * @brief Adaptation scale of an axis (1: normal, 0: frozen)
+     */
+    float get_scale(int axis) const { return scale_[axis]; }
+
+    bool is_frozen(int axis) const { return scale_[axis] <= 0.f; }
+
+    /** @brief Largest upper-band sinusoid amplitude of an axis (rad/s) */
+    float get_peak_level(int axis) const { return peak_[axis]; }
+
+    /** @brief Upper-band noise level of an axis (rad/s) */
+    float get_broadband_level(int axis) const { return broadband_[axis]; }
+
+    /**
+     * @brief Frequency of the strongest bin of an axis
+     * @param sample_rate_hz rate at which update() is called
+     */
+    float get_peak_frequency(int axis, float sample_rate_hz) const {
+        return bin_frequency(peak_bin_[axis], sample_rate_hz);
+    }
+
+    static float bin_frequency(int bin, float sample_rate_hz) {
+        return static_cast<float>(FIRST_BIN + bin) * sample_rate_hz / WINDOW;
+    }
+
+private:
+    typedef float float4 __attribute__((vector_size(16)));
+
+    static constexpr int VECS = BINS / 4;
+    static constexpr float DAMPING = 0.9999f;
+
+    static_assert(BINS % 4 == 0, "bins are processed four at a time");
+    static_assert(FIRST_BIN + BINS <= WINDOW / 2, "bins must stay below Nyquist");
+
+    // Sliding DFT state per axis, four bins per vector
+    float4 re_[3][VECS];
+    float4 im_[3][VECS];
+    float4 rcos_[VECS];
+    float4 rsin_[VECS];
+    float r_N_{1.f};
+
+    // Rate samples of the window (oldest at head_)
+    float ring_[WINDOW][3];
+    int head_{0};
+    int samples_{0};
+
+    float inv_peak_threshold_{0.f};
+    float inv_broadband_threshold_{0.f};
+
+    // Levels and gating
+    float peak_[3];
+    float broadband_[3];
+    int peak_bin_[3];
+    float scale_[3];
+};
+
+} // namespace attitude_controller_aic
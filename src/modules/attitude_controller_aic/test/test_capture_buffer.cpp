@@ -0,0 +1,354 @@
+/**
+ * @file test_capture_buffer.cpp
+ * @brief Pre-trigger capture: window contents, extension, drops and trigger edges
+ *
+ * - the window holds the pre-trigger records, the trigger tick and the
+ *   post-trigger records, in order, read while the post part comes in
+ * - a trigger in the post part extends the window, later ones are counted
+ * - a writer that falls behind makes the producer drop ticks and flag the gap
+ *   instead of overwriting unread records
+ * - a concurrent writer thread sees every record of every window exactly once
+ * - each detector condition triggers once on its edge
+ */
+
+#include "capture_buffer.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace attitude_controller_aic;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+namespace {
+
+constexpr float DT = 0.004f;
+
+CaptureRecord make_record(uint32_t tick, uint16_t triggers = 0) {
+    CaptureRecord record{};
+    record.timestamp_us = 1000000ull + tick * 4000ull;
+    record.dt = DT;
+    record.q[0] = 1.f;
+
+    for (int i = 0; i < 3; ++i) {
+        record.J_diag[i] = 0.01f;
+    }
+
+    record.triggers = triggers;
+    return record;
+}
+
+uint32_t tick_of(const CaptureRecord &record) {
+    return static_cast<uint32_t>((record.timestamp_us - 1000000ull) / 4000ull);
+}
+
+// Writer side: read the open window to the end
+std::vector<CaptureRecord> drain(CaptureBuffer<64> &buffer) {
+    std::vector<CaptureRecord> records;
+    CaptureRecord chunk[5];
+
+    while (!buffer.complete()) {
+        const uint32_t count = buffer.read(chunk, 5);
+
+        if (count == 0) {
+            break;
+        }
+
+        records.insert(records.end(), chunk, chunk + count);
+    }
+
+    return records;
+}
+
+} // namespace
+
+int main() {
+    // Window around a trigger, partly read before the post-trigger records are in
+    {
+        static CaptureBuffer<64> buffer;
+        buffer.configure(10, 5);
+        CaptureWindow window;
+
+        for (uint32_t t = 0; t < 100; ++t) {
+            CHECK(buffer.push(make_record(t)));
+        }
+
+        CHECK(!buffer.window(window) && buffer.windows() == 0);
+        CHECK(buffer.push(make_record(100, CAPTURE_TRIGGER_MANUAL)));
+        CHECK(buffer.window(window));
+        CHECK(window.trigger_us == make_record(100).timestamp_us);
+        CHECK(window.trigger - window.start == 10 && window.end - window.trigger == 6);
+
+        std::vector<CaptureRecord> records = drain(buffer);
+        CHECK(records.size() == 11 && !buffer.complete());
+
+        for (uint32_t t = 101; t < 110; ++t) {
+            CHECK(buffer.push(make_record(t)));
+        }
+
+        const std::vector<CaptureRecord> rest = drain(buffer);
+        records.insert(records.end(), rest.begin(), rest.end());
+        CHECK(buffer.complete() && records.size() == 16);
+
+        for (size_t i = 0; i < records.size(); ++i) {
+            CHECK(tick_of(records[i]) == 90 + i);
+            CHECK(!(records[i].flags & CAPTURE_GAP));
+        }
+
+        CHECK(records[10].triggers == CAPTURE_TRIGGER_MANUAL);
+        buffer.release();
+        CHECK(!buffer.is_open());
+
+        // The next trigger opens a new window
+        CHECK(buffer.push(make_record(110, CAPTURE_TRIGGER_OVERRUN)));
+        CHECK(buffer.window(window) && buffer.windows() == 2);
+        CHECK(window.triggers == CAPTURE_TRIGGER_OVERRUN);
+    }
+
+    // Extension by a trigger in the post part; suppression after the window
+    {
+        static CaptureBuffer<64> buffer;
+        buffer.configure(4, 8);
+        CaptureWindow window;
+
+        for (uint32_t t = 0; t < 2; ++t) {
+            buffer.push(make_record(t));
+        }
+
+        // Fewer pre-trigger records than configured exist: starts at the first
+        buffer.push(make_record(2, CAPTURE_TRIGGER_SATURATION));
+        CHECK(buffer.window(window) && window.start == 0 && window.trigger == 2 && window.end == 11);
+
+        for (uint32_t t = 3; t < 6; ++t) {
+            buffer.push(make_record(t));
+        }
+
+        buffer.push(make_record(6, CAPTURE_TRIGGER_PAYLOAD));
+        CHECK(buffer.window(window) && window.end == 15);
+        CHECK(window.triggers == (CAPTURE_TRIGGER_SATURATION | CAPTURE_TRIGGER_PAYLOAD));
+
+        for (uint32_t t = 7; t < 20; ++t) {
+            buffer.push(make_record(t));
+        }
+
+        // After the window: counted, not captured
+        buffer.push(make_record(20, CAPTURE_TRIGGER_PE_LOSS));
+        CHECK(buffer.suppressed() == 1 && buffer.windows() == 1);
+
+        const std::vector<CaptureRecord> records = drain(buffer);
+        CHECK(buffer.complete() && records.size() == 15);
+        CHECK(tick_of(records.front()) == 0 && tick_of(records.back()) == 14);
+        buffer.release();
+    }
+
+    // Slow writer: ticks dropped rather than unread records overwritten, the gap flagged
+    {
+        static CaptureBuffer<64> buffer;
+        buffer.configure(20, 60);   // Clamped: pre + post must fit in the buffer
+        CHECK(buffer.post_records() == 60 && buffer.pre_records() == 3);
+
+        buffer.configure(40, 40);
+        CHECK(buffer.post_records() == 40 && buffer.pre_records() == 23);
+
+        for (uint32_t t = 0; t < 50; ++t) {
+            buffer.push(make_record(t));
+        }
+
+        buffer.push(make_record(50, CAPTURE_TRIGGER_MANUAL));
+        CaptureWindow window;
+        CHECK(buffer.window(window) && window.end - window.start == 64);
+
+        // Writer stalls: the window fills the buffer, the ticks after it are dropped
+        uint32_t dropped = 0;
+
+        for (uint32_t t = 51; t < 100; ++t) {
+            dropped += buffer.push(make_record(t)) ? 0 : 1;
+        }
+
+        CHECK(dropped == 9 && buffer.dropped() == dropped);
+
+        std::vector<CaptureRecord> records = drain(buffer);
+        CHECK(buffer.complete() && records.size() == 64);
+        CHECK(tick_of(records.front()) == 27 && tick_of(records.back()) == 90);
+        CHECK(buffer.window(window) && window.dropped == 9);
+
+        for (const CaptureRecord &record : records) {
+            CHECK(!(record.flags & CAPTURE_GAP));
+        }
+
+        buffer.release();
+
+        // The next window reaches back over the gap
+        for (uint32_t t = 100; t < 110; ++t) {
+            CHECK(buffer.push(make_record(t)));
+        }
+
+        buffer.push(make_record(110, CAPTURE_TRIGGER_MANUAL));
+
+        for (uint32_t t = 111; t < 200; ++t) {
+            CHECK(buffer.push(make_record(t)) || buffer.complete());
+            const std::vector<CaptureRecord> part = drain(buffer);
+            records.insert(records.end(), part.begin(), part.end());
+        }
+
+        CHECK(buffer.complete() && records.size() == 64 + 64);
+        CHECK(tick_of(records[64]) == 78 && tick_of(records.back()) == 150);
+
+        for (size_t i = 65; i < records.size(); ++i) {
+            const bool gap = tick_of(records[i]) != tick_of(records[i - 1]) + 1;
+            CHECK(gap == ((records[i].flags & CAPTURE_GAP) != 0));
+            CHECK(!gap || tick_of(records[i]) == 100);
+        }
+
+        buffer.release();
+
+        // Released: the ring runs on without drops
+        for (uint32_t t = 200; t < 400; ++t) {
+            CHECK(buffer.push(make_record(t)));
+        }
+    }
+
+    // Concurrent writer thread
+    {
+        static CaptureBuffer<64> buffer;
+        buffer.configure(16, 16);
+        std::atomic<bool> done{false};
+        std::vector<std::vector<uint32_t>> windows;
+
+        std::thread writer([&]() {
+            CaptureRecord chunk[4];
+
+            while (!done.load() || buffer.is_open()) {
+                CaptureWindow window;
+
+                if (!buffer.window(window)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::vector<uint32_t> ticks;
+
+                while (!buffer.complete()) {
+                    const uint32_t count = buffer.read(chunk, 4);
+
+                    for (uint32_t i = 0; i < count; ++i) {
+                        ticks.push_back(tick_of(chunk[i]));
+                    }
+
+                    if (count == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                windows.push_back(ticks);
+                buffer.release();
+            }
+        });
+
+        uint32_t stored = 0;
+
+        for (uint32_t t = 0; t < 20000; ++t) {
+            stored += buffer.push(make_record(t, (t % 500 == 250) ? CAPTURE_TRIGGER_MANUAL : 0)) ? 1 : 0;
+
+            if (t % 64 == 0) {
+                std::this_thread::yield();   // Single-core hosts
+            }
+        }
+
+        // Post part of the last window
+        done.store(true);
+        writer.join();
+
+        CHECK(buffer.windows() == windows.size() && !buffer.is_open());
+        CHECK(buffer.windows() + buffer.suppressed() == 40 && windows.size() >= 35);
+        CHECK(stored + buffer.dropped() == 20000);
+
+        for (const std::vector<uint32_t> &ticks : windows) {
+            CHECK(ticks.size() + buffer.dropped() >= 33 && !ticks.empty());
+
+            for (size_t i = 1; i < ticks.size(); ++i) {
+                CHECK(ticks[i] > ticks[i - 1]);
+            }
+        }
+    }
+
+    // Trigger edges of the detector
+    {
+        CaptureSettings settings;
+        settings.compute_budget_us = 500;
+        CaptureTriggerDetector detector;
+        uint32_t counts[6] = {};
+
+        auto run = [&](uint32_t ticks, uint16_t flags, float J, uint32_t compute_us, float omega) {
+            for (uint32_t t = 0; t < ticks; ++t) {
+                CaptureRecord record = make_record(t);
+                record.flags = flags;
+                record.compute_us = compute_us;
+                record.omega[0] = omega;
+
+                for (int i = 0; i < 3; ++i) {
+                    record.J_diag[i] = J;
+                }
+
+                const uint16_t triggers = detector.update(record, settings);
+
+                for (int b = 0; b < 6; ++b) {
+                    counts[b] += (triggers >> b) & 1;
+                }
+            }
+        };
+
+        // Steady, excited flight: nothing
+        run(2000, CAPTURE_EXCITED, 0.01f, 100, 0.f);
+
+        for (int b = 0; b < 6; ++b) {
+            CHECK(counts[b] == 0);
+        }
+
+        // Saturation burst, once however long
+        run(100, CAPTURE_EXCITED | CAPTURE_SATURATED, 0.01f, 100, 0.f);
+        CHECK(counts[0] == 1);
+        run(100, CAPTURE_EXCITED, 0.01f, 100, 0.f);
+        run(100, CAPTURE_EXCITED | CAPTURE_SATURATED, 0.01f, 100, 0.f);
+        CHECK(counts[0] == 2);
+        run(100, CAPTURE_EXCITED, 0.01f, 100, 0.f);
+
+        // Payload: inertia estimate jumps by 50 %
+        run(100, CAPTURE_EXCITED, 0.015f, 100, 0.f);
+        CHECK(counts[1] == 1);
+
+        // Excitation lost
+        run(10, 0, 0.015f, 100, 0.f);
+        CHECK(counts[2] == 1);
+
+        // Overrun: over budget, then a clamped dt
+        run(5, 0, 0.015f, 900, 0.f);
+        run(5, 0, 0.015f, 100, 0.f);
+        run(5, CAPTURE_DT_CLAMPED, 0.015f, 100, 0.f);
+        CHECK(counts[3] == 2);
+
+        // Non-finite rates
+        run(5, 0, 0.015f, 100, NAN);
+        run(5, 0, 0.015f, 100, 0.f);
+        CHECK(counts[4] == 1);
+
+        // Masked out
+        settings.trigger_mask = CAPTURE_TRIGGER_ALL & ~CAPTURE_TRIGGER_NON_FINITE;
+        run(5, 0, 0.015f, 100, INFINITY);
+        CHECK(counts[4] == 1);
+        CHECK(counts[1] == 1 && counts[2] == 1 && counts[5] == 0);
+    }
+
+    printf("capture buffer test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,319 @@
+/**
+ * @file test_fixed_point_controller.cpp
+ * @brief Fixed-point AIC controller against a float reference of the same law
+ *
+ * - saturating Q-format arithmetic
+ * - per-tick torque and inertia estimate error of the fixed-point controller
+ *   shadowing a float reference that flies the plant
+ * - closed-loop attitude of the fixed-point controller against the float
+ *   controller on the same scenarios
+ */
+
+#include "attitude_controller_aic_fixed.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace attitude_controller_aic;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+namespace {
+
+struct Mat3 {
+    double m[3][3];
+};
+
+Mat3 identity() {
+    return Mat3{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+}
+
+Mat3 mul(const Mat3 &a, const Mat3 &b) {
+    Mat3 r{};
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            for (int k = 0; k < 3; ++k) {
+                r.m[i][j] += a.m[i][k] * b.m[k][j];
+            }
+        }
+    }
+
+    return r;
+}
+
+// Rotation by angle about a unit axis (Rodrigues)
+Mat3 rotation(const double axis[3], double angle) {
+    const double c = cos(angle), s = sin(angle), v = 1 - c;
+    const double x = axis[0], y = axis[1], z = axis[2];
+    return Mat3{{{c + x * x * v, x * y * v - z * s, x * z * v + y * s},
+                 {y * x * v + z * s, c + y * y * v, y * z * v - x * s},
+                 {z * x * v - y * s, z * y * v + x * s, c + z * z * v}}};
+}
+
+/**
+ * @brief Float implementation of the law in attitude_controller_aic_fixed.hpp
+ */
+struct ReferenceController {
+    float K_R[3] = {5.0f, 5.0f, 3.0f};
+    float K_Omega[3] = {0.3f, 0.3f, 0.2f};
+    float K[3] = {0.1f, 0.1f, 0.1f};
+    float c = 2.0f, tau_max = 0.05f, gamma = 1.5f, sigma = 1e-4f, J_min = 0.01f, J_max = 1.0f, alpha_f = 0.1f;
+    float theta[3];
+    float s_f[3] = {0, 0, 0};
+
+    void compute(const float R[3][3], const float W[3], const float Rd[3][3], const float Wd[3],
+                 const float dWd[3], float dt, float tau[3]) {
+        float E[3][3];
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                E[i][j] = R[0][i] * Rd[0][j] + R[1][i] * Rd[1][j] + R[2][i] * Rd[2][j];
+            }
+        }
+
+        const float e_R[3] = {0.5f * (E[1][2] - E[2][1]), 0.5f * (E[2][0] - E[0][2]), 0.5f * (E[0][1] - E[1][0])};
+        float EWd[3], alpha[3], e_W[3];
+
+        for (int i = 0; i < 3; ++i) {
+            EWd[i] = E[i][0] * Wd[0] + E[i][1] * Wd[1] + E[i][2] * Wd[2];
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            const int j = (i + 1) % 3, k = (i + 2) % 3;
+            alpha[i] = E[i][0] * dWd[0] + E[i][1] * dWd[1] + E[i][2] * dWd[2] - (W[j] * EWd[k] - W[k] * EWd[j]);
+            e_W[i] = W[i] - EWd[i];
+            s_f[i] += alpha_f * (e_W[i] + c * e_R[i] - s_f[i]);
+        }
+
+        const float Y[3][3] = {{alpha[0], -W[1] * W[2], W[1] * W[2]},
+                               {W[0] * W[2], alpha[1], -W[0] * W[2]},
+                               {-W[0] * W[1], W[0] * W[1], alpha[2]}};
+
+        for (int i = 0; i < 3; ++i) {
+            const float Yts = Y[0][i] * s_f[0] + Y[1][i] * s_f[1] + Y[2][i] * s_f[2];
+            theta[i] = std::max(J_min, std::min(theta[i] - gamma * dt * (Yts + sigma * theta[i]), J_max));
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            const float t = Y[i][0] * theta[0] + Y[i][1] * theta[1] + Y[i][2] * theta[2]
+                            - K_R[i] * e_R[i] - K_Omega[i] * e_W[i] - K[i] * s_f[i];
+            tau[i] = std::max(-tau_max, std::min(t, tau_max));
+        }
+    }
+};
+
+struct Scenario {
+    const char *name;
+    double tilt_axis[3];
+    double tilt;             // Initial attitude error (rad)
+    double J_scale;          // True inertia / initial estimate
+    double disturbance[3];   // Constant external torque (Nm)
+    int setpoint;            // 0: level, 1: roll step 0.5 rad, 2: roll sine, 3: yaw spin
+};
+
+void setpoint(const Scenario &sc, double t, float Rd[3][3], float Wd[3], float dWd[3]) {
+    static const double x_axis[3] = {1, 0, 0};
+    static const double z_axis[3] = {0, 0, 1};
+    Mat3 R = identity();
+    double w[3] = {0, 0, 0}, dw[3] = {0, 0, 0};
+
+    if (sc.setpoint == 1) {
+        R = rotation(x_axis, 0.5);
+
+    } else if (sc.setpoint == 2) {
+        R = rotation(x_axis, 0.15 * sin(t));
+        w[0] = 0.15 * cos(t);
+        dw[0] = -0.15 * sin(t);
+
+    } else if (sc.setpoint == 3) {
+        // Constant yaw rate at a fixed roll: body rate R_x(0.2)^T * [0, 0, 0.8]
+        R = mul(rotation(z_axis, 0.8 * t), rotation(x_axis, 0.2));
+        w[1] = 0.8 * sin(0.2);
+        w[2] = 0.8 * cos(0.2);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            Rd[i][j] = static_cast<float>(R.m[i][j]);
+        }
+
+        Wd[i] = static_cast<float>(w[i]);
+        dWd[i] = static_cast<float>(dw[i]);
+    }
+}
+
+struct Plant {
+    Mat3 R;
+    double W[3];
+    double J[3];
+
+    void step(const float tau[3], const double d[3], double dt) {
+        double dW[3];
+
+        for (int i = 0; i < 3; ++i) {
+            const int j = (i + 1) % 3, k = (i + 2) % 3;
+            // J * dW = tau + d - W x (J * W)
+            dW[i] = (tau[i] + d[i] - (W[j] * J[k] * W[k] - W[k] * J[j] * W[j])) / J[i];
+        }
+
+        const double n = sqrt(W[0] * W[0] + W[1] * W[1] + W[2] * W[2]);
+
+        if (n > 1e-12) {
+            const double axis[3] = {W[0] / n, W[1] / n, W[2] / n};
+            R = mul(R, rotation(axis, n * dt));
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            W[i] += dW[i] * dt;
+        }
+    }
+
+    void sample(float Rf[3][3], float Wf[3]) const {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                Rf[i][j] = static_cast<float>(R.m[i][j]);
+            }
+
+            Wf[i] = static_cast<float>(W[i]);
+        }
+    }
+};
+
+double attitude_distance(const Mat3 &a, const Mat3 &b) {
+    double tr = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            tr += a.m[k][i] * b.m[k][i];
+        }
+    }
+
+    return acos(std::max(-1.0, std::min((tr - 1) / 2, 1.0)));
+}
+
+Plant make_plant(const Scenario &sc, const float J0[3]) {
+    Plant p{rotation(sc.tilt_axis, sc.tilt), {0, 0, 0}, {}};
+
+    for (int i = 0; i < 3; ++i) {
+        p.J[i] = J0[i] * sc.J_scale;
+    }
+
+    return p;
+}
+
+} // namespace
+
+int main() {
+    // Saturating arithmetic
+    const q16 big = q16::from_int(30000);
+    CHECK((big + big).raw() == INT32_MAX);
+    CHECK((-big - big).raw() == INT32_MIN);
+    CHECK((big * big).raw() == INT32_MAX);
+    CHECK((big * -big).raw() == INT32_MIN);
+    CHECK((q16::from_float(1.5f) * q16::from_float(-2.25f)).to_float() == -3.375f);
+    CHECK(q16::from_float(1e9f).raw() == INT32_MAX);
+    CHECK(q24::from_float(200.f).raw() == INT32_MAX);
+    CHECK(fixed::mul<24>(q16::from_float(1.5f), q16::from_float(0.004f)).to_float() - 0.006f < 1e-4f);
+    CHECK(q16::from_float(0.25f).convert<24>().to_float() == 0.25f);
+
+    const float J0[3] = {0.040f, 0.040f, 0.025f};
+    const float dt = 0.004f;
+    const int steps = 2500;  // 10 s at 250 Hz
+
+    const Scenario scenarios[] = {
+        {"recover", {0.70710678, 0.70710678, 0}, 0.4, 1.0, {0, 0, 0}, 0},
+        {"roll step", {1, 0, 0}, 0.0, 1.0, {0, 0, 0}, 1},
+        {"roll sine", {1, 0, 0}, 0.0, 1.0, {0, 0, 0}, 2},
+        {"yaw spin", {1, 0, 0}, 0.1, 1.0, {0, 0, 0}, 3},
+        {"mismatch + gust", {0, 1, 0}, 0.2, 1.5, {0.005, -0.003, 0.002}, 0},
+    };
+
+    for (const Scenario &sc : scenarios) {
+        // 1. Shadow: the reference flies, the fixed-point controller sees the same (quantized) inputs
+        ReferenceController reference;
+        std::copy(J0, J0 + 3, reference.theta);
+        FixedPointAttitudeControllerAIC shadow;
+        shadow.init(J0);
+        Plant plant = make_plant(sc, J0);
+
+        float max_tau_error = 0.f, max_theta_error = 0.f;
+
+        for (int k = 0; k < steps; ++k) {
+            float R[3][3], W[3], Rd[3][3], Wd[3], dWd[3], tau[3];
+            plant.sample(R, W);
+            setpoint(sc, k * dt, Rd, Wd, dWd);
+
+            reference.compute(R, W, Rd, Wd, dWd, dt, tau);
+            const FixedVector3 tau_q = shadow.compute_torque(FixedMatrix3::from_float(R), FixedVector3::from_float(W),
+                                       FixedMatrix3::from_float(Rd), FixedVector3::from_float(Wd),
+                                       FixedVector3::from_float(dWd), q16::from_float(dt));
+
+            for (int i = 0; i < 3; ++i) {
+                max_tau_error = std::max(max_tau_error, fabsf(tau_q(i).to_float() - tau[i]));
+                max_theta_error = std::max(max_theta_error,
+                                           fabsf(shadow.get_inertia_estimate(i).to_float() - reference.theta[i]));
+            }
+
+            plant.step(tau, sc.disturbance, dt);
+        }
+
+        // 2. Closed loop: both controllers fly their own plant
+        ReferenceController float_ctrl;
+        std::copy(J0, J0 + 3, float_ctrl.theta);
+        FixedPointAttitudeControllerAIC fixed_ctrl;
+        fixed_ctrl.init(J0);
+        Plant float_plant = make_plant(sc, J0);
+        Plant fixed_plant = make_plant(sc, J0);
+
+        double max_attitude_gap = 0.0;
+
+        for (int k = 0; k < steps; ++k) {
+            float R[3][3], W[3], Rd[3][3], Wd[3], dWd[3], tau[3];
+            setpoint(sc, k * dt, Rd, Wd, dWd);
+
+            float_plant.sample(R, W);
+            float_ctrl.compute(R, W, Rd, Wd, dWd, dt, tau);
+            float_plant.step(tau, sc.disturbance, dt);
+
+            fixed_plant.sample(R, W);
+            const FixedVector3 tau_q = fixed_ctrl.compute_torque(FixedMatrix3::from_float(R), FixedVector3::from_float(W),
+                                       FixedMatrix3::from_float(Rd), FixedVector3::from_float(Wd),
+                                       FixedVector3::from_float(dWd), q16::from_float(dt));
+            const float tau_fixed[3] = {tau_q(0).to_float(), tau_q(1).to_float(), tau_q(2).to_float()};
+            fixed_plant.step(tau_fixed, sc.disturbance, dt);
+
+            max_attitude_gap = std::max(max_attitude_gap, attitude_distance(float_plant.R, fixed_plant.R));
+        }
+
+        float Rd_end[3][3], Wd_end[3], dWd_end[3];
+        setpoint(sc, steps * dt, Rd_end, Wd_end, dWd_end);
+        Mat3 R_d_end;
+
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                R_d_end.m[i][j] = Rd_end[i][j];
+            }
+        }
+
+        const double final_error = attitude_distance(fixed_plant.R, R_d_end);
+
+        printf("%-16s tau error %.2e Nm, theta error %.2e, attitude gap %.2e rad, final error %.3f rad\n",
+               sc.name, max_tau_error, max_theta_error, max_attitude_gap, final_error);
+
+        CHECK(max_tau_error < 5e-4f);        // 1% of the saturation limit
+        CHECK(max_theta_error < 1e-4f);
+        CHECK(max_attitude_gap < 5e-3);
+        CHECK(final_error < 0.15);
+    }
+
+    return EXIT_SUCCESS;
+}
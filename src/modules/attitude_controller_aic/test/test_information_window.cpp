@@ -0,0 +1,171 @@
+/**
+ * @file test_information_window.cpp
+ * @brief Sliding information window against direct sums over the last blocks
+ *
+ * - running sums match Y^T * Y and Y^T * tau summed directly over the window
+ * - old blocks are evicted: information of an early maneuver leaves the window
+ * - smallest eigenvalue matches a known spectrum
+ * - least squares recovers the parameters of noiseless data and keeps the
+ *   prior in directions the window does not excite
+ */
+
+#include "information_window.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace attitude_controller_aic;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+namespace {
+
+constexpr int N = 4;
+constexpr int BLOCKS = 5;
+constexpr float DT = 0.004f;
+constexpr int SAMPLES_PER_BLOCK = 24;   // 0.096 s blocks
+
+struct Sample {
+    float Y[3 * N];
+    float tau[3];
+};
+
+} // namespace
+
+int main() {
+    const float theta_true[N] = {0.045f, 0.03f, -0.02f, 0.1f};
+
+    InformationWindow<N, BLOCKS> window;
+    window.init(SAMPLES_PER_BLOCK * DT - 0.5f * DT);
+    CHECK(!window.full() && window.duration() == 0.f);
+
+    std::mt19937 rng(5);
+    std::normal_distribution<float> normal(0.f, 1.f);
+    std::vector<Sample> samples;
+    int closed = 0;
+
+    // Many laps of the ring: running add/evict and the periodic recompute
+    for (int n = 0; n < 40 * SAMPLES_PER_BLOCK; ++n) {
+        Sample sample;
+
+        for (float &y : sample.Y) {
+            y = normal(rng);
+        }
+
+        for (int r = 0; r < 3; ++r) {
+            sample.tau[r] = 0.f;
+
+            for (int j = 0; j < N; ++j) {
+                sample.tau[r] += sample.Y[r * N + j] * theta_true[j];
+            }
+        }
+
+        samples.push_back(sample);
+        closed += window.add(sample.Y, sample.tau, DT) ? 1 : 0;
+    }
+
+    CHECK(closed == 40);
+    CHECK(window.full());
+    CHECK(std::fabs(window.duration() - BLOCKS * SAMPLES_PER_BLOCK * DT) < 1e-4f);
+
+    // Direct sums over the samples of the last BLOCKS blocks
+    double YY[N][N] = {};
+    double Yt[N] = {};
+
+    for (size_t n = samples.size() - BLOCKS * SAMPLES_PER_BLOCK; n < samples.size(); ++n) {
+        const Sample &s = samples[n];
+
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                for (int r = 0; r < 3; ++r) {
+                    YY[i][j] += DT * s.Y[r * N + i] * s.Y[r * N + j];
+                }
+            }
+
+            for (int r = 0; r < 3; ++r) {
+                Yt[i] += DT * s.Y[r * N + i] * s.tau[r];
+            }
+        }
+    }
+
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            CHECK(std::fabs(window.information(i, j) - YY[i][j]) < 1e-4 * (1.0 + std::fabs(YY[i][j])));
+        }
+
+        CHECK(std::fabs(window.correlation(i) - Yt[i]) < 1e-4 * (1.0 + std::fabs(Yt[i])));
+    }
+
+    // Noiseless data: least squares is exact, the ridge only shrinks it slightly
+    const float prior[N] = {0.f, 0.f, 0.f, 0.f};
+    float theta[N];
+    CHECK(window.solve(prior, 0.f, 1e-7f, theta));
+
+    for (int i = 0; i < N; ++i) {
+        CHECK(std::fabs(theta[i] - theta_true[i]) < 1e-4f);
+    }
+
+    CHECK(window.solve(prior, 0.01f, 1e-6f, theta));
+
+    for (int i = 0; i < N; ++i) {
+        CHECK(std::fabs(theta[i] - theta_true[i]) < 0.02f * std::fabs(theta_true[i]) + 1e-4f);
+    }
+
+    // Only the first parameter excited for a full window: the early information is evicted,
+    // the other directions fall back to the prior and the smallest eigenvalue to zero
+    const float prior_other[N] = {0.f, 1.f, 2.f, 3.f};
+
+    for (int n = 0; n < BLOCKS * SAMPLES_PER_BLOCK; ++n) {
+        Sample sample = {};
+        sample.Y[0] = 1.f + 0.5f * normal(rng);
+        sample.tau[0] = sample.Y[0] * theta_true[0];
+        window.add(sample.Y, sample.tau, DT);
+    }
+
+    CHECK(window.information(1, 1) < 1e-5f && window.information(0, 3) < 1e-5f);
+    CHECK(window.min_eigenvalue(N) < 1e-5f);
+    CHECK(window.solve(prior_other, 0.01f, 1e-6f, theta));
+    CHECK(std::fabs(theta[0] - theta_true[0]) < 0.02f * theta_true[0]);
+
+    for (int i = 1; i < N; ++i) {
+        CHECK(std::fabs(theta[i] - prior_other[i]) < 1e-5f);
+    }
+
+    // Known spectrum: one sample per eigenvector, W_YY = R * diag(1, 2, 3, 4) * R^T
+    // with R a rotation by 0.3 rad in the (0, 1) plane
+    window.reset();
+    CHECK(window.duration() == 0.f && window.information(0, 0) == 0.f);
+    const float c = std::cos(0.3f), s = std::sin(0.3f);
+    const float eigenvectors[N][N] = {{c, -s, 0.f, 0.f}, {s, c, 0.f, 0.f}, {0.f, 0.f, 1.f, 0.f}, {0.f, 0.f, 0.f, 1.f}};
+    const int cycles = BLOCKS * SAMPLES_PER_BLOCK / N;
+
+    for (int n = 0; n < cycles; ++n) {
+        for (int k = 0; k < N; ++k) {
+            Sample sample = {};
+            const float scale = std::sqrt((k + 1.f) / (cycles * DT));
+
+            for (int j = 0; j < N; ++j) {
+                sample.Y[j] = scale * eigenvectors[k][j];
+            }
+
+            window.add(sample.Y, sample.tau, DT);
+        }
+    }
+
+    CHECK(window.full());
+    CHECK(std::fabs(window.min_eigenvalue(N) - 1.f) < 1e-3f);
+    CHECK(std::fabs(window.min_eigenvalue(2) - 1.f) < 1e-3f);
+    CHECK(std::fabs(window.information(0, 1)) > 0.1f);
+
+    printf("information window: %d blocks of %d samples, %zu bytes\n", BLOCKS, SAMPLES_PER_BLOCK, sizeof(window));
+    return EXIT_SUCCESS;
+}
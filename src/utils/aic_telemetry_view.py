@@ -0,0 +1,208 @@
+"""
+NumPy view of the AIC telemetry rings written by the C++ aggregator.
+
+The ground-side aggregator (tools/aic_telemetry) receives AIC status and
+timing messages from many vehicles and stores them in per-vehicle ring
+buffers in POSIX shared memory. This module maps the same memory read-only
+and exposes the rings as NumPy structured arrays without copying.
+"""
+
+import mmap
+import os
+from typing import Dict, List, Optional
+
+import numpy as np
+
+
+SHM_MAGIC = 0x4D484341  # "ACHM"
+SHM_VERSION = 1
+
+# Layouts must match tools/aic_telemetry/telemetry_shm.hpp (packed, little-endian)
+HEADER_DTYPE = np.dtype([
+    ('magic', '<u4'),
+    ('version', '<u4'),
+    ('max_vehicles', '<u4'),
+    ('capacity', '<u4'),
+    ('slot_size', '<u4'),
+    ('status_record_size', '<u4'),
+    ('timing_record_size', '<u4'),
+    ('vehicle_count', '<u4'),
+    ('reserved', 'u1', 32),
+])
+
+SLOT_HEADER_DTYPE = np.dtype([
+    ('vehicle_id', '<u4'),
+    ('reserved0', '<u4'),
+    ('status_count', '<u8'),
+    ('timing_count', '<u8'),
+    ('lost', '<u8'),
+    ('last_receive_us', '<u8'),
+    ('reserved', 'u1', 24),
+])
+
+STATUS_DTYPE = np.dtype([
+    ('timestamp_us', '<u8'),
+    ('receive_us', '<u8'),
+    ('sequence', '<u4'),
+    ('theta', '<f4', 6),
+    ('d_hat', '<f4', 3),
+    ('s', '<f4', 3),
+    ('tau', '<f4', 3),
+    ('information', '<f4'),
+    ('persistently_excited', 'u1'),
+    ('saturated', 'u1'),
+    ('governor_phase', 'u1'),
+    ('flags', 'u1'),
+])
+
+TIMING_DTYPE = np.dtype([
+    ('timestamp_us', '<u8'),
+    ('receive_us', '<u8'),
+    ('sequence', '<u4'),
+    ('compute_us', '<f4'),
+    ('interval_us', '<f4'),
+    ('divider', '<u2'),
+    ('reserved', '<u2'),
+    ('skipped', '<u4'),
+])
+
+
+class AICTelemetryView:
+    """Read-only, zero-copy access to the aggregator's per-vehicle rings."""
+
+    # Oldest records of a full ring may be overwritten while being read
+    WRAP_MARGIN = 8
+
+    def __init__(self, shm_name: str = '/aic_telemetry', path: Optional[str] = None):
+        """
+        Map the aggregator shared memory.
+
+        Args:
+            shm_name: POSIX shm name used by the aggregator (-s option)
+            path: Explicit file path (overrides shm_name, e.g. for tests)
+        """
+        self.path = path or os.path.join('/dev/shm', shm_name.lstrip('/'))
+
+        with open(self.path, 'rb') as f:
+            self._mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        self.header = np.ndarray((), dtype=HEADER_DTYPE, buffer=self._mm, offset=0)
+
+        if int(self.header['magic']) != SHM_MAGIC or int(self.header['version']) != SHM_VERSION:
+            raise ValueError(f"{self.path} is not an AIC telemetry ring buffer")
+
+        if (int(self.header['status_record_size']) != STATUS_DTYPE.itemsize or
+                int(self.header['timing_record_size']) != TIMING_DTYPE.itemsize):
+            raise ValueError("AIC telemetry record layout mismatch")
+
+        self.capacity = int(self.header['capacity'])
+        self.max_vehicles = int(self.header['max_vehicles'])
+        self.slot_size = int(self.header['slot_size'])
+
+    def close(self) -> None:
+        """Release the mapping (views obtained before become invalid)."""
+        self.header = None
+        self._mm.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _slot_offset(self, slot: int) -> int:
+        return HEADER_DTYPE.itemsize + slot * self.slot_size
+
+    def slot_header(self, slot: int) -> np.ndarray:
+        """Live view of a slot header (counts update in place)."""
+        return np.ndarray((), dtype=SLOT_HEADER_DTYPE, buffer=self._mm, offset=self._slot_offset(slot))
+
+    def vehicles(self) -> Dict[int, int]:
+        """
+        Get the vehicles seen so far.
+
+        Returns:
+            Mapping vehicle_id -> slot index
+        """
+        count = int(self.header['vehicle_count'])
+        return {int(self.slot_header(i)['vehicle_id']): i for i in range(count)}
+
+    def status_ring(self, slot: int) -> np.ndarray:
+        """Zero-copy view of the raw status ring of a slot (capacity records, unordered)."""
+        offset = self._slot_offset(slot) + SLOT_HEADER_DTYPE.itemsize
+        return np.ndarray((self.capacity,), dtype=STATUS_DTYPE, buffer=self._mm, offset=offset)
+
+    def timing_ring(self, slot: int) -> np.ndarray:
+        """Zero-copy view of the raw timing ring of a slot (capacity records, unordered)."""
+        offset = (self._slot_offset(slot) + SLOT_HEADER_DTYPE.itemsize +
+                  self.capacity * STATUS_DTYPE.itemsize)
+        return np.ndarray((self.capacity,), dtype=TIMING_DTYPE, buffer=self._mm, offset=offset)
+
+    def _latest(self, ring: np.ndarray, count: int, n: Optional[int]) -> np.ndarray:
+        available = min(count, self.capacity - self.WRAP_MARGIN) if count > self.capacity else count
+        n = available if n is None else min(n, available)
+
+        if n <= 0:
+            return ring[:0].copy()
+
+        start = (count - n) % self.capacity
+        end = start + n
+
+        if end <= self.capacity:
+            return ring[start:end].copy()
+
+        return np.concatenate((ring[start:], ring[:end - self.capacity]))
+
+    def latest_status(self, vehicle_id: int, n: Optional[int] = None) -> np.ndarray:
+        """
+        Get the most recent status records of a vehicle in time order.
+
+        Args:
+            vehicle_id: Vehicle id
+            n: Number of records (default: all safely readable records)
+
+        Returns:
+            Structured array with STATUS_DTYPE fields (a copy)
+        """
+        slot = self.vehicles()[vehicle_id]
+        count = int(self.slot_header(slot)['status_count'])
+        return self._latest(self.status_ring(slot), count, n)
+
+    def latest_timing(self, vehicle_id: int, n: Optional[int] = None) -> np.ndarray:
+        """
+        Get the most recent timing records of a vehicle in time order.
+
+        Args:
+            vehicle_id: Vehicle id
+            n: Number of records (default: all safely readable records)
+
+        Returns:
+            Structured array with TIMING_DTYPE fields (a copy)
+        """
+        slot = self.vehicles()[vehicle_id]
+        count = int(self.slot_header(slot)['timing_count'])
+        return self._latest(self.timing_ring(slot), count, n)
+
+    def fleet_summary(self) -> List[Dict]:
+        """
+        Get the latest inertia estimate and timing of every vehicle.
+
+        Returns:
+            List of per-vehicle dictionaries
+        """
+        summary = []
+
+        for vehicle_id, slot in sorted(self.vehicles().items()):
+            header = self.slot_header(slot)
+            status = self.latest_status(vehicle_id, 1)
+            timing = self.latest_timing(vehicle_id, 1)
+            summary.append({
+                'vehicle_id': vehicle_id,
+                'messages': int(header['status_count']) + int(header['timing_count']),
+                'lost': int(header['lost']),
+                'theta': status['theta'][0].tolist() if len(status) else None,
+                'persistently_excited': bool(status['persistently_excited'][0]) if len(status) else False,
+                'compute_us': float(timing['compute_us'][0]) if len(timing) else None,
+            })
+
+        return summary
@@ -0,0 +1,97 @@
+/**
+ * @file aic_fleet_prior_main.cpp
+ * @brief Fits the fleet inertia prior table from estimator record files
+ *
+ * Usage:
+ *   aic_fleet_prior [-o priors.bin] [-m min_vehicles] [-z outlier_z] [-d outlier_deviation]
+ *                   [-q noise_density] [-I max_information] [-a] [-j threads] records.csv...
+ *
+ *   -a  also use flights without persistent excitation
+ *
+ * The record files are the estimates.csv files pulled from the vehicles; the
+ * table goes to the vehicles' storage directory as priors.bin.
+ */
+
+#include "fleet_prior_fit.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace aic_fleet_prior;
+
+int main(int argc, char *argv[]) {
+    std::string output = "priors.bin";
+    FitConfig config;
+
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:m:z:d:q:I:aj:h")) != -1) {
+        switch (opt) {
+        case 'o': output = optarg; break;
+
+        case 'm': config.min_vehicles = atoi(optarg); break;
+
+        case 'z': config.outlier_z = static_cast<float>(atof(optarg)); break;
+
+        case 'd': config.outlier_deviation = static_cast<float>(atof(optarg)); break;
+
+        case 'q': config.noise_density = static_cast<float>(atof(optarg)); break;
+
+        case 'I': config.max_information = static_cast<float>(atof(optarg)); break;
+
+        case 'a': config.require_excited = false; break;
+
+        case 'j': config.threads = static_cast<unsigned>(atoi(optarg)); break;
+
+        default:
+            fprintf(stderr, "usage: %s [-o priors.bin] [-m min_vehicles] [-z outlier_z] [-d outlier_deviation] "
+                    "[-q noise_density] [-I max_information] [-a] [-j threads] records.csv...\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (optind >= argc || config.outlier_z <= 0.f || config.noise_density <= 0.f || config.max_information <= 0.f) {
+        fprintf(stderr, "no record files or invalid settings\n");
+        return 1;
+    }
+
+    const std::vector<std::string> paths(argv + optind, argv + argc);
+    std::vector<EstimatorRecord> records;
+    ReadStats stats;
+    std::string error;
+
+    if (!read_records(paths, config.threads, records, stats, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    const std::vector<PriorEntry> entries = fit_priors(records, config);
+
+    printf("%zu records from %zu files (%zu malformed lines)\n", stats.records, paths.size(), stats.malformed);
+    printf("airframe payload vehicles rejected       Jxx       Jyy       Jzz   sigma_xx   sigma_yy   sigma_zz"
+           "     P_xx     P_yy     P_zz\n");
+
+    for (const PriorEntry &entry : entries) {
+        char payload[8] = "any";
+
+        if (entry.payload_id != attitude_controller_aic::PRIOR_ANY_PAYLOAD) {
+            snprintf(payload, sizeof(payload), "%u", (unsigned)entry.payload_id);
+        }
+
+        printf("%8u %7s %8u %8u %9.3g %9.3g %9.3g %10.3g %10.3g %10.3g %8.3g %8.3g %8.3g\n",
+               (unsigned)entry.airframe_id, payload,
+               (unsigned)entry.vehicles, (unsigned)entry.rejected,
+               (double)entry.theta[0], (double)entry.theta[1], (double)entry.theta[2],
+               (double)entry.sigma[0], (double)entry.sigma[1], (double)entry.sigma[2],
+               (double)entry.information[0], (double)entry.information[1], (double)entry.information[2]);
+    }
+
+    if (!write_prior_table(output, entries)) {
+        fprintf(stderr, "failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    printf("%zu priors written to %s\n", entries.size(), output.c_str());
+    return 0;
+}
@@ -0,0 +1,384 @@
+/**
+ * @file fleet_prior_fit.cpp
+ * @brief Fleet inertia priors from the estimator records of many vehicles
+ */
+
+#include "fleet_prior_fit.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace aic_fleet_prior {
+
+using attitude_controller_aic::PRIOR_ANY_PAYLOAD;
+using attitude_controller_aic::PRIOR_PARAMETERS;
+using attitude_controller_aic::PRIOR_TABLE_MAGIC;
+using attitude_controller_aic::PRIOR_TABLE_VERSION;
+using attitude_controller_aic::PriorTableHeader;
+
+namespace {
+
+constexpr double MAD_SCALE = 1.4826;     // MAD to standard deviation of a normal sample
+constexpr double HUBER_K = 1.345;        // 95 % efficiency at the normal
+constexpr double RELATIVE_SCALE_FLOOR = 1e-3;
+
+template<typename Job>
+void parallel_for(size_t count, unsigned threads, const Job &job) {
+    const unsigned workers = (threads > 0) ? threads : std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            job(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 1; t < std::min<size_t>(workers, count); ++t) {
+        pool.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    const size_t k = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    const double upper = values[k];
+
+    if (values.size() % 2 == 1) {
+        return upper;
+    }
+
+    return 0.5 * (upper + *std::max_element(values.begin(), values.begin() + k));
+}
+
+/**
+ * @brief One vehicle (and payload) of a group: medians over its flights
+ */
+struct Unit {
+    double theta[PRIOR_PARAMETERS];
+    double information[PRIOR_PARAMETERS];
+    double flight_variance[PRIOR_PARAMETERS];   // Flight-to-flight variance, < 0 without repeat flights
+    bool estimated[PRIOR_PARAMETERS];           // Any flight with information on the parameter
+};
+
+Unit reduce_unit(const std::vector<const EstimatorRecord *> &flights) {
+    Unit unit{};
+
+    for (int i = 0; i < PRIOR_PARAMETERS; ++i) {
+        std::vector<double> theta;
+        std::vector<double> information;
+
+        for (const EstimatorRecord *record : flights) {
+            if (record->information[i] > 0.f) {
+                theta.push_back(record->theta[i]);
+                information.push_back(record->information[i]);
+            }
+        }
+
+        unit.estimated[i] = !theta.empty();
+        unit.theta[i] = median(theta);
+        unit.information[i] = median(information);
+        unit.flight_variance[i] = -1.0;
+
+        // Sample variance: a MAD of a handful of flights is too noisy, the median over vehicles is robust anyway
+        if (theta.size() >= 2) {
+            double mean = 0.0;
+            double variance = 0.0;
+
+            for (double value : theta) {
+                mean += value / theta.size();
+            }
+
+            for (double value : theta) {
+                variance += (value - mean) * (value - mean) / (theta.size() - 1);
+            }
+
+            unit.flight_variance[i] = variance;
+        }
+    }
+
+    return unit;
+}
+
+struct Group {
+    uint16_t airframe_id;
+    uint16_t payload_id;
+    std::map<std::pair<uint16_t, uint16_t>, std::vector<const EstimatorRecord *>> units;   // (vehicle, payload)
+};
+
+PriorEntry fit_group(const Group &group, const FitConfig &config, bool &valid) {
+    PriorEntry entry{};
+    entry.airframe_id = group.airframe_id;
+    entry.payload_id = group.payload_id;
+    valid = false;
+
+    std::vector<Unit> units;
+    std::vector<uint16_t> payloads;
+
+    for (const auto &unit : group.units) {
+        units.push_back(reduce_unit(unit.second));
+        payloads.push_back(unit.first.second);
+    }
+
+    // Reject vehicles whose principal inertia is off the vehicles with the same payload in any axis; the
+    // airframe-wide group is spread over payloads by design
+    std::vector<bool> inlier(units.size(), true);
+
+    for (uint16_t payload : std::set<uint16_t>(payloads.begin(), payloads.end())) {
+        for (int i = 0; i < 3; ++i) {
+            std::vector<double> values;
+
+            for (size_t u = 0; u < units.size(); ++u) {
+                if (payloads[u] == payload && units[u].estimated[i]) {
+                    values.push_back(units[u].theta[i]);
+                }
+            }
+
+            const RobustEstimate fleet = robust_estimate(values);
+
+            for (size_t u = 0; u < units.size(); ++u) {
+                if (payloads[u] == payload) {
+                    const double deviation = std::fabs(units[u].theta[i] - fleet.median);
+                    const bool outlier = deviation > config.outlier_z * fleet.scale
+                                         && deviation > config.outlier_deviation * std::fabs(fleet.median);
+                    inlier[u] = inlier[u] && units[u].estimated[i] && !outlier;
+                }
+            }
+        }
+    }
+
+    const size_t vehicles = static_cast<size_t>(std::count(inlier.begin(), inlier.end(), true));
+
+    if (vehicles < static_cast<size_t>(std::max(config.min_vehicles, 1))) {
+        return entry;
+    }
+
+    entry.vehicles = static_cast<uint16_t>(std::min<size_t>(vehicles, UINT16_MAX));
+    entry.rejected = static_cast<uint16_t>(std::min<size_t>(units.size() - vehicles, UINT16_MAX));
+
+    for (int i = 0; i < PRIOR_PARAMETERS; ++i) {
+        std::vector<double> theta;
+        std::vector<double> noise;
+
+        for (size_t u = 0; u < units.size(); ++u) {
+            if (!inlier[u] || !units[u].estimated[i]) {
+                continue;
+            }
+
+            theta.push_back(units[u].theta[i]);
+
+            if (units[u].flight_variance[i] > 0.0) {
+                noise.push_back(units[u].flight_variance[i] * units[u].information[i]);
+            }
+        }
+
+        // Products of inertia only from vehicles running the full model
+        if (theta.size() < static_cast<size_t>(std::max(config.min_vehicles, 1))) {
+            continue;
+        }
+
+        // Outliers are gone: the plain spread around the location, which also covers the payload modes of the
+        // airframe-wide group (a MAD would see only the most common payload)
+        const RobustEstimate fleet = robust_estimate(theta);
+        double spread = 0.0;
+
+        for (double value : theta) {
+            spread += (value - fleet.location) * (value - fleet.location);
+        }
+
+        spread = std::max(spread / std::max<size_t>(theta.size() - 1, 1),
+                          RELATIVE_SCALE_FLOOR * RELATIVE_SCALE_FLOOR * fleet.location * fleet.location);
+        const double variance = spread * (1.0 + 1.0 / theta.size());
+        const double q = noise.empty() ? config.noise_density : median(noise);
+
+        entry.theta[i] = static_cast<float>(fleet.location);
+        entry.sigma[i] = static_cast<float>(std::sqrt(variance));
+        entry.information[i] = static_cast<float>(std::min(q / variance, static_cast<double>(config.max_information)));
+    }
+
+    valid = attitude_controller_aic::is_valid_prior(entry);
+    return entry;
+}
+
+bool read_file(const std::string &path, std::vector<EstimatorRecord> &records, ReadStats &stats) {
+    std::ifstream file(path);
+
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    bool first = true;
+
+    while (std::getline(file, line)) {
+        EstimatorRecord record;
+
+        if (parse_estimator_record(line.c_str(), record)) {
+            records.push_back(record);
+            ++stats.records;
+
+        } else if (!line.empty() && !(first && line.compare(0, 10, "vehicle_id") == 0)) {
+            ++stats.malformed;
+        }
+
+        first = false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+RobustEstimate robust_estimate(const std::vector<double> &values) {
+    RobustEstimate estimate;
+
+    if (values.empty()) {
+        return estimate;
+    }
+
+    estimate.median = median(values);
+    std::vector<double> deviations;
+
+    for (double value : values) {
+        deviations.push_back(std::fabs(value - estimate.median));
+    }
+
+    // A floor keeps identical values (and a single vehicle) from giving zero spread
+    estimate.scale = std::max(MAD_SCALE * median(deviations), RELATIVE_SCALE_FLOOR * std::fabs(estimate.median));
+    estimate.scale = std::max(estimate.scale, 1e-12);
+
+    // Huber M-estimate of location from the median, scale held
+    estimate.location = estimate.median;
+
+    for (int iteration = 0; iteration < 20; ++iteration) {
+        double weighted = 0.0;
+        double weights = 0.0;
+
+        for (double value : values) {
+            const double r = std::fabs(value - estimate.location) / estimate.scale;
+            const double w = (r <= HUBER_K) ? 1.0 : HUBER_K / r;
+            weighted += w * value;
+            weights += w;
+        }
+
+        const double location = weighted / weights;
+        const bool converged = std::fabs(location - estimate.location) < 1e-9 * estimate.scale;
+        estimate.location = location;
+
+        if (converged) {
+            break;
+        }
+    }
+
+    return estimate;
+}
+
+bool read_records(const std::vector<std::string> &paths, unsigned threads, std::vector<EstimatorRecord> &records,
+                  ReadStats &stats, std::string &error) {
+    std::vector<std::vector<EstimatorRecord>> files(paths.size());
+    std::vector<ReadStats> file_stats(paths.size());
+    std::vector<char> opened(paths.size(), 0);
+
+    parallel_for(paths.size(), threads, [&](size_t i) {
+        opened[i] = read_file(paths[i], files[i], file_stats[i]) ? 1 : 0;
+    });
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!opened[i]) {
+            error = "cannot read " + paths[i];
+            return false;
+        }
+
+        records.insert(records.end(), files[i].begin(), files[i].end());
+        stats.records += file_stats[i].records;
+        stats.malformed += file_stats[i].malformed;
+    }
+
+    return true;
+}
+
+std::vector<PriorEntry> fit_priors(const std::vector<EstimatorRecord> &records, const FitConfig &config) {
+    // Exact groups and the airframe-wide group of every airframe, ordered by (airframe, payload)
+    std::map<std::pair<uint16_t, uint16_t>, Group> groups;
+
+    for (const EstimatorRecord &record : records) {
+        if ((config.require_excited && !record.excited) || record.flight_time < config.min_flight_time
+            || record.payload_id == PRIOR_ANY_PAYLOAD) {
+            continue;
+        }
+
+        for (uint16_t payload : {record.payload_id, PRIOR_ANY_PAYLOAD}) {
+            Group &group = groups[std::make_pair(record.airframe_id, payload)];
+            group.airframe_id = record.airframe_id;
+            group.payload_id = payload;
+            group.units[std::make_pair(record.vehicle_id, record.payload_id)].push_back(&record);
+        }
+    }
+
+    std::vector<const Group *> work;
+
+    for (const auto &group : groups) {
+        work.push_back(&group.second);
+    }
+
+    std::vector<PriorEntry> fitted(work.size());
+    std::vector<char> valid(work.size(), 0);
+
+    parallel_for(work.size(), config.threads, [&](size_t i) {
+        bool ok = false;
+        fitted[i] = fit_group(*work[i], config, ok);
+        valid[i] = ok ? 1 : 0;
+    });
+
+    std::vector<PriorEntry> entries;
+
+    for (size_t i = 0; i < fitted.size(); ++i) {
+        if (valid[i]) {
+            entries.push_back(fitted[i]);
+        }
+    }
+
+    return entries;
+}
+
+bool write_prior_table(const std::string &path, const std::vector<PriorEntry> &entries) {
+    FILE *file = fopen(path.c_str(), "wb");
+
+    if (!file) {
+        return false;
+    }
+
+    PriorTableHeader header{};
+    header.magic = PRIOR_TABLE_MAGIC;
+    header.version = PRIOR_TABLE_VERSION;
+    header.entry_size = sizeof(PriorEntry);
+    header.entries = static_cast<uint32_t>(entries.size());
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    if (!entries.empty()) {
+        ok = ok && fwrite(entries.data(), sizeof(PriorEntry), entries.size(), file) == entries.size();
+    }
+
+    return (fclose(file) == 0) && ok;
+}
+
+} // namespace aic_fleet_prior
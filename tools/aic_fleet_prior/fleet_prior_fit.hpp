@@ -0,0 +1,83 @@
+/**
+ * @file fleet_prior_fit.hpp
+ * @brief Fleet inertia priors from the estimator records of many vehicles
+ *
+ * Records are grouped by airframe and payload, plus one airframe-wide group
+ * pooling all payloads. In each group:
+ *
+ * - every vehicle (a vehicle and payload in the pooled group) is reduced to
+ *   the median of its flights, so a vehicle that flies a lot does not
+ *   outweigh the others
+ * - vehicles whose principal inertia is a robust outlier (median/MAD
+ *   z-score over the vehicles with the same payload) are rejected as a
+ *   whole, e.g. a misconfigured airframe ID or a damaged frame; a relative
+ *   deviation gate keeps the MAD of a few tightly built vehicles from
+ *   rejecting sound ones
+ * - the prior is the Huber mean of the remaining vehicles, its standard
+ *   deviation their spread around it widened by the uncertainty of the mean
+ * - the initial information follows from the torque noise level q of the
+ *   estimators: a vehicle's estimate scatters over its flights with variance
+ *   q / P, so q is the median of (flight-to-flight variance * information)
+ *   over vehicles with repeat flights, and the prior information is
+ *   q / sigma^2, in the units of the estimator's information matrix
+ *
+ * Groups are fitted in parallel; each is a pure function of its records, so
+ * the table does not depend on the number of threads.
+ */
+
+#pragma once
+
+#include "fleet_prior.hpp"
+
+#include <string>
+#include <vector>
+
+namespace aic_fleet_prior {
+
+using attitude_controller_aic::EstimatorRecord;
+using attitude_controller_aic::PriorEntry;
+
+struct FitConfig {
+    unsigned threads{0};                // 0: hardware concurrency
+    int min_vehicles{3};                // Vehicles a group needs for a prior
+    bool require_excited{true};         // Skip flights that never reached persistent excitation
+    float min_flight_time{10.f};        // s
+    float outlier_z{3.5f};              // Robust z-score beyond which a vehicle is rejected...
+    float outlier_deviation{0.1f};      // ...if it is also this far off relative to the median
+    float noise_density{1e-6f};         // q (Nm^2*s) if no vehicle has repeat flights
+    float max_information{1e4f};        // Cap of the prior information
+};
+
+/**
+ * @brief Location and scale of a sample, robust to outliers
+ */
+struct RobustEstimate {
+    double location{0.0};    // Huber mean
+    double median{0.0};
+    double scale{0.0};       // 1.4826 * median absolute deviation
+};
+
+RobustEstimate robust_estimate(const std::vector<double> &values);
+
+struct ReadStats {
+    size_t records{0};
+    size_t malformed{0};     // Lines that are neither a record nor the header
+};
+
+/**
+ * @brief Read estimator record CSV files (one per vehicle or concatenated), files in parallel
+ */
+bool read_records(const std::vector<std::string> &paths, unsigned threads, std::vector<EstimatorRecord> &records,
+                  ReadStats &stats, std::string &error);
+
+/**
+ * @brief Fit the priors of all groups with enough vehicles, sorted by airframe and payload
+ */
+std::vector<PriorEntry> fit_priors(const std::vector<EstimatorRecord> &records, const FitConfig &config);
+
+/**
+ * @brief Write the binary prior table loaded by the module
+ */
+bool write_prior_table(const std::string &path, const std::vector<PriorEntry> &entries);
+
+} // namespace aic_fleet_prior
@@ -0,0 +1,200 @@
+/**
+ * @file test_fleet_prior.cpp
+ * @brief Fleet prior fit on a synthetic fleet, prior table round trip
+ *
+ * Airframe 1 flies 12 vehicles without payload (3 % spread, one with twice
+ * the inertia) and 6 with payload 5 (30 % heavier); airframe 2 has only two
+ * vehicles. Each flight's estimate scatters around the vehicle's inertia
+ * with variance q / P.
+ */
+
+#include "fleet_prior_fit.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+using namespace aic_fleet_prior;
+using attitude_controller_aic::PRIOR_ANY_PAYLOAD;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+namespace {
+
+constexpr float J_NOMINAL[3] = {0.010f, 0.012f, 0.020f};
+constexpr double Q = 1e-6;          // Torque noise level of the estimators
+constexpr float INFORMATION = 100.f;
+
+void add_vehicle(std::vector<EstimatorRecord> &records, std::mt19937 &rng, uint16_t vehicle, uint16_t airframe,
+                 uint16_t payload, float scale, int flights) {
+    std::normal_distribution<float> spread(0.f, 0.03f);
+    std::normal_distribution<float> noise(0.f, static_cast<float>(std::sqrt(Q / INFORMATION)));
+    float J[3];
+
+    for (int i = 0; i < 3; ++i) {
+        J[i] = J_NOMINAL[i] * scale * (1.f + spread(rng));
+    }
+
+    for (int f = 0; f < flights; ++f) {
+        EstimatorRecord record{};
+        record.vehicle_id = vehicle;
+        record.airframe_id = airframe;
+        record.payload_id = payload;
+        record.flight_time = 300.f;
+        record.excited = true;
+
+        for (int i = 0; i < 3; ++i) {
+            record.theta[i] = J[i] + noise(rng);
+            record.information[i] = INFORMATION;
+        }
+
+        records.push_back(record);
+    }
+}
+
+const PriorEntry *find(const std::vector<PriorEntry> &entries, uint16_t airframe, uint16_t payload) {
+    for (const PriorEntry &entry : entries) {
+        if (entry.airframe_id == airframe && entry.payload_id == payload) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(7);
+    std::vector<EstimatorRecord> records;
+
+    for (uint16_t v = 0; v < 12; ++v) {
+        add_vehicle(records, rng, v, 1, 0, 1.f, 4);
+    }
+
+    add_vehicle(records, rng, 12, 1, 0, 2.f, 4);
+
+    for (uint16_t v = 20; v < 26; ++v) {
+        add_vehicle(records, rng, v, 1, 5, 1.3f, 4);
+    }
+
+    add_vehicle(records, rng, 30, 2, 0, 1.f, 4);
+    add_vehicle(records, rng, 31, 2, 0, 1.f, 4);
+
+    // Flights that do not count: too short, not excited
+    EstimatorRecord bad = records.front();
+    bad.flight_time = 2.f;
+    bad.theta[0] = 1.f;
+    records.push_back(bad);
+    bad.flight_time = 300.f;
+    bad.excited = false;
+    records.push_back(bad);
+
+    FitConfig config;
+    config.threads = 1;
+    const std::vector<PriorEntry> entries = fit_priors(records, config);
+
+    // Entry set: exact and airframe-wide for airframe 1, nothing for airframe 2
+    CHECK(entries.size() == 3);
+    const PriorEntry *bare = find(entries, 1, 0);
+    const PriorEntry *loaded = find(entries, 1, 5);
+    const PriorEntry *pooled = find(entries, 1, PRIOR_ANY_PAYLOAD);
+    CHECK(bare && loaded && pooled);
+    CHECK(entries[0].payload_id == 0 && entries[1].payload_id == 5 && entries[2].payload_id == PRIOR_ANY_PAYLOAD);
+
+    // The outlier is rejected, the rest recovered
+    CHECK(bare->vehicles == 12 && bare->rejected == 1);
+    CHECK(loaded->vehicles == 6 && loaded->rejected == 0);
+    CHECK(pooled->vehicles == 18 && pooled->rejected == 1);
+
+    for (int i = 0; i < 3; ++i) {
+        CHECK(std::fabs(bare->theta[i] / J_NOMINAL[i] - 1.f) < 0.03f);
+        CHECK(std::fabs(loaded->theta[i] / (1.3f * J_NOMINAL[i]) - 1.f) < 0.05f);
+        CHECK(bare->sigma[i] > 0.01f * J_NOMINAL[i] && bare->sigma[i] < 0.06f * J_NOMINAL[i]);
+
+        // Pooling over payloads widens the prior
+        CHECK(pooled->sigma[i] > 2.f * bare->sigma[i]);
+        CHECK(pooled->information[i] < bare->information[i]);
+
+        // q / sigma^2 with q recovered from the flight-to-flight scatter
+        const double expected = Q / (bare->sigma[i] * bare->sigma[i]);
+        CHECK(bare->information[i] > 0.4 * expected && bare->information[i] < 2.5 * expected);
+    }
+
+    // Products of inertia were not estimated
+    for (int i = 3; i < 6; ++i) {
+        CHECK(bare->theta[i] == 0.f && bare->information[i] == 0.f);
+    }
+
+    // Same table for any number of threads
+    config.threads = 4;
+    const std::vector<PriorEntry> parallel = fit_priors(records, config);
+    CHECK(parallel.size() == entries.size());
+    CHECK(memcmp(parallel.data(), entries.data(), entries.size() * sizeof(PriorEntry)) == 0);
+
+    // Table round trip through the module's lookup
+    const std::string path = "test_fleet_prior.bin";
+    CHECK(write_prior_table(path, entries));
+
+    auto lookup = [&](uint16_t airframe, uint16_t payload, PriorEntry &prior) {
+        FILE *file = fopen(path.c_str(), "rb");
+        const int match = attitude_controller_aic::find_prior([file](void *buffer, size_t n) {
+            return file && fread(buffer, 1, n, file) == n;
+        }, airframe, payload, prior);
+
+        if (file) {
+            fclose(file);
+        }
+
+        return match;
+    };
+
+    PriorEntry prior{};
+    CHECK(lookup(1, 5, prior) == 2 && memcmp(&prior, loaded, sizeof(prior)) == 0);
+    CHECK(lookup(1, 9, prior) == 1 && prior.payload_id == PRIOR_ANY_PAYLOAD);
+    CHECK(lookup(2, 0, prior) == 0);
+    remove(path.c_str());
+
+    // Records through CSV and back
+    const std::string csv = "test_fleet_prior.csv";
+    FILE *file = fopen(csv.c_str(), "w");
+    CHECK(file);
+    fputs(attitude_controller_aic::ESTIMATOR_RECORD_HEADER, file);
+
+    for (const EstimatorRecord &record : records) {
+        char line[256];
+        CHECK(format_estimator_record(record, line, sizeof(line)) > 0);
+        fputs(line, file);
+    }
+
+    fputs("not a record\n", file);
+    fclose(file);
+
+    std::vector<EstimatorRecord> parsed;
+    ReadStats stats;
+    std::string error;
+    CHECK(read_records({csv, csv}, 2, parsed, stats, error));
+    CHECK(parsed.size() == 2 * records.size() && stats.malformed == 2);
+
+    for (size_t r = 0; r < records.size(); ++r) {
+        CHECK(parsed[r].vehicle_id == records[r].vehicle_id && parsed[r].payload_id == records[r].payload_id);
+        CHECK(parsed[r].excited == records[r].excited);
+
+        for (int i = 0; i < 6; ++i) {
+            CHECK(std::fabs(parsed[r].theta[i] - records[r].theta[i]) <= 1e-5f * std::fabs(records[r].theta[i]));
+        }
+    }
+
+    CHECK(!read_records({"does_not_exist.csv"}, 1, parsed, stats, error) && !error.empty());
+    remove(csv.c_str());
+
+    printf("fleet prior test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file aic_linux_io_main.cpp
+ * @brief Runs a control loop on the io_uring device I/O thread and reports its timing
+ *
+ * Usage:
+ *   aic_linux_io [-r imu_rate_hz] [-d duration_s] [-s command_spin_us] [-c control_cpu]
+ *                [-i /dev/iio:deviceN -p duty_cycle[,duty_cycle...]]
+ *
+ * Without -i the simulated device stands in for the board. The control
+ * computation is a placeholder mixing the gyro into the outputs; what is
+ * measured is the I/O path around it.
+ */
+
+#include "device_io.hpp"
+#include "iio_pwm_device.hpp"
+#include "simulated_device.hpp"
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace aic_linux_io;
+
+int main(int argc, char *argv[]) {
+    float rate_hz = 1000.f;
+    double duration_s = 5.0;
+    int control_cpu = -1;
+    IoConfig io_config;
+    IioPwmConfig board_config;
+    bool board = false;
+
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:d:s:c:i:p:h")) != -1) {
+        switch (opt) {
+        case 'r': rate_hz = static_cast<float>(atof(optarg)); break;
+
+        case 'd': duration_s = atof(optarg); break;
+
+        case 's': io_config.command_spin_us = static_cast<uint32_t>(atoi(optarg)); break;
+
+        case 'c': control_cpu = atoi(optarg); break;
+
+        case 'i':
+            board_config.iio_device = optarg;
+            board = true;
+            break;
+
+        case 'p': {
+                std::stringstream paths(optarg);
+                std::string path;
+
+                while (std::getline(paths, path, ',')) {
+                    board_config.pwm_duty_cycle.push_back(path);
+                }
+            }
+            break;
+
+        default:
+            fprintf(stderr, "usage: %s [-r imu_rate_hz] [-d duration_s] [-s command_spin_us] [-c control_cpu] "
+                    "[-i /dev/iio:deviceN -p duty_cycle[,duty_cycle...]]\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    SimulatedDevice simulated;
+    IioPwmDevice iio_pwm;
+    DeviceBackend *backend = nullptr;
+    std::string error;
+
+    if (board) {
+        if (!iio_pwm.open(board_config, error)) {
+            fprintf(stderr, "board: %s\n", error.c_str());
+            return 1;
+        }
+
+        backend = &iio_pwm;
+
+    } else {
+        SimulatedDeviceConfig sim_config;
+        sim_config.imu_rate_hz = rate_hz;
+
+        if (!simulated.start(sim_config)) {
+            fprintf(stderr, "failed to start the simulated device\n");
+            return 1;
+        }
+
+        backend = &simulated;
+    }
+
+    if (control_cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(control_cpu, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    DeviceIo io;
+
+    if (!io.start(*backend, io_config, error)) {
+        fprintf(stderr, "device I/O: %s\n", error.c_str());
+        return 1;
+    }
+
+    const int channels = board ? static_cast<int>(board_config.pwm_duty_cycle.size()) : 4;
+    const uint64_t end_us = monotonic_us() + static_cast<uint64_t>(duration_s * 1e6);
+    uint64_t ticks = 0;
+
+    rusage before;
+    getrusage(RUSAGE_THREAD, &before);
+
+    // Control loop: no syscalls between getrusage() calls
+    while (monotonic_us() < end_us) {
+        ImuSample sample;
+
+        if (!io.wait_imu(sample, 100000)) {
+            continue;
+        }
+
+        ActuatorCommand command{};
+        command.sequence = sample.sequence;
+        command.channels = static_cast<uint32_t>(channels);
+
+        for (int i = 0; i < channels; ++i) {
+            const float sign = (i & 1) ? -1.f : 1.f;
+            command.output[i] = 0.5f + 0.05f * sign * (sample.gyro[0] + sample.gyro[1] - sample.gyro[2]);
+        }
+
+        io.push_actuator(command);
+        ++ticks;
+    }
+
+    rusage after;
+    getrusage(RUSAGE_THREAD, &after);
+
+    io.stop();
+    const IoStats stats = io.stats();
+
+    printf("ticks %llu, control thread voluntary switches %ld\n", (unsigned long long)ticks,
+           after.ru_nvcsw - before.ru_nvcsw);
+    printf("io_uring_enter %llu for %llu operations, imu overruns %llu, errors %llu/%llu\n",
+           (unsigned long long)stats.submits, (unsigned long long)stats.operations,
+           (unsigned long long)stats.imu_overruns, (unsigned long long)stats.imu_errors,
+           (unsigned long long)stats.actuator_errors);
+    printf("commands %llu (superseded %llu, dropped %llu), push to write completion mean %.1f us max %llu us\n",
+           (unsigned long long)stats.actuator_commands, (unsigned long long)stats.actuator_superseded,
+           (unsigned long long)stats.actuator_dropped,
+           stats.actuator_commands > 0 ? double(stats.actuator_latency_sum_us) / stats.actuator_commands : 0.0,
+           (unsigned long long)stats.actuator_latency_max_us);
+
+    if (!board) {
+        simulated.stop();
+        const SimulatedDeviceStats device = simulated.stats();
+        printf("device: %llu samples, %llu commands, sample to command mean %.1f us max %llu us\n",
+               (unsigned long long)device.imu_emitted, (unsigned long long)device.commands,
+               device.answered > 0 ? double(device.loop_latency_sum_us) / device.answered : 0.0,
+               (unsigned long long)device.loop_latency_max_us);
+    }
+
+    return 0;
+}
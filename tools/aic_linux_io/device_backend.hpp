@@ -0,0 +1,81 @@
+/**
+ * @file device_backend.hpp
+ * @brief IMU samples, actuator commands and the device files the I/O thread drives
+ *
+ * A backend only describes its file descriptors and wire formats; all reads
+ * and writes are issued by DeviceIo through io_uring. The IMU is a character
+ * device producing fixed-size records (an IIO buffer, or a pipe in the
+ * simulator); actuators are one or more write targets (one PWM duty_cycle
+ * file per channel, or a single frame per command).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace aic_linux_io {
+
+static constexpr int MAX_CHANNELS = 8;
+static constexpr size_t MAX_ACTUATOR_WRITE = 64;   // Bytes per actuator target and command
+
+/**
+ * @brief CLOCK_MONOTONIC in microseconds (vDSO, no syscall)
+ */
+inline uint64_t monotonic_us() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000ull + static_cast<uint64_t>(ts.tv_nsec) / 1000ull;
+}
+
+struct ImuSample {
+    uint64_t timestamp_us;   // Device sample time, or receive_us if the device has no timestamp
+    uint64_t receive_us;     // Completion of the read that delivered the sample
+    uint32_t sequence;       // Samples delivered since start (device counter if it has one)
+    float gyro[3];           // rad/s
+    float accel[3];          // m/s^2
+};
+
+struct ActuatorCommand {
+    uint64_t timestamp_us;   // Set by DeviceIo::push_actuator()
+    uint32_t sequence;       // Caller-defined, e.g. the sequence of the IMU sample it answers
+    uint32_t channels;
+    float output[MAX_CHANNELS];   // Normalized [0, 1]
+};
+
+/**
+ * @class DeviceBackend
+ * @brief File descriptors and wire formats of one board's IMU and actuators
+ */
+class DeviceBackend {
+public:
+    virtual ~DeviceBackend() = default;
+
+    /**
+     * @brief Readable IMU device delivering imu_record_size() byte records
+     */
+    virtual int imu_fd() const = 0;
+    virtual size_t imu_record_size() const = 0;
+
+    /**
+     * @brief Decode one record
+     *
+     * Leaves sample.timestamp_us at 0 if the record has no timestamp and
+     * sample.sequence untouched if it has no counter.
+     *
+     * @return false to drop the record
+     */
+    virtual bool decode_imu(const uint8_t *record, ImuSample &sample) const = 0;
+
+    virtual int actuator_target_count() const = 0;
+    virtual int actuator_fd(int target) const = 0;
+
+    /**
+     * @brief Encode the part of a command written to one target
+     * @return bytes in buffer (at most size), 0 to skip the target
+     */
+    virtual size_t encode_actuator(int target, const ActuatorCommand &command, uint8_t *buffer, size_t size) const = 0;
+};
+
+} // namespace aic_linux_io
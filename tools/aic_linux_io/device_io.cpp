@@ -0,0 +1,416 @@
+/**
+ * @file device_io.cpp
+ * @brief io_uring device I/O thread with wait-free rings to the control thread
+ */
+
+#include "device_io.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace aic_linux_io {
+
+namespace {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Positional writes for files (sysfs attributes), -1 (current position) for streams
+int64_t write_offset(int fd) {
+    return (lseek(fd, 0, SEEK_CUR) < 0) ? -1 : 0;
+}
+
+void raise_max(std::atomic<uint64_t> &counter, uint64_t value) {
+    if (value > counter.load(std::memory_order_relaxed)) {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+void increment(std::atomic<uint64_t> &counter, uint64_t value = 1) {
+    // Single writer (the I/O thread): no read-modify-write needed
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+} // namespace
+
+bool DeviceIo::start(DeviceBackend &backend, const IoConfig &config, std::string &error) {
+    stop();
+
+    const size_t record_size = backend.imu_record_size();
+
+    if (record_size == 0 || record_size > sizeof(imu_buffer_) / MAX_IMU_BATCH) {
+        error = "unsupported IMU record size";
+        return false;
+    }
+
+    if (backend.actuator_target_count() < 0 || backend.actuator_target_count() > MAX_CHANNELS) {
+        error = "too many actuator targets";
+        return false;
+    }
+
+    int ring_error = 0;
+
+    if (!ring_.open(config.queue_depth, ring_error)) {
+        error = std::string("io_uring_setup: ") + strerror(ring_error);
+        return false;
+    }
+
+    backend_ = &backend;
+    config_ = config;
+
+    // One record of headroom for a partial record carried over between reads
+    unsigned batch = (config.imu_batch > 0) ? config.imu_batch : 1;
+    batch = (batch < MAX_IMU_BATCH) ? batch : MAX_IMU_BATCH - 1;
+    imu_read_size_ = batch * record_size;
+    imu_carry_ = 0;
+    imu_offset_ = -1;
+    imu_inflight_ = false;
+    imu_eof_ = false;
+    imu_sequence_ = 0;
+
+    targets_ = backend.actuator_target_count();
+
+    for (int target = 0; target < targets_; ++target) {
+        write_offset_[target] = write_offset(backend.actuator_fd(target));
+    }
+
+    writes_inflight_ = 0;
+    write_failed_ = false;
+    command_pending_ = false;
+    timeout_inflight_ = false;
+
+    submits_ = 0;
+    operations_ = 0;
+    imu_samples_ = 0;
+    imu_overruns_ = 0;
+    imu_errors_ = 0;
+    actuator_commands_ = 0;
+    actuator_superseded_ = 0;
+    actuator_dropped_ = 0;
+    actuator_errors_ = 0;
+    actuator_latency_max_us_ = 0;
+    actuator_latency_sum_us_ = 0;
+
+    stop_.store(false);
+    thread_ = std::thread(&DeviceIo::run, this);
+    return true;
+}
+
+void DeviceIo::stop() {
+    if (thread_.joinable()) {
+        stop_.store(true);
+        thread_.join();
+    }
+
+    ring_.close();
+    backend_ = nullptr;
+}
+
+bool DeviceIo::wait_imu(ImuSample &sample, uint64_t timeout_us) {
+    if (imu_ring_.pop(sample)) {
+        return true;
+    }
+
+    const uint64_t deadline = monotonic_us() + timeout_us;
+
+    do {
+        cpu_relax();
+
+        if (imu_ring_.pop(sample)) {
+            return true;
+        }
+    } while (monotonic_us() < deadline);
+
+    return false;
+}
+
+bool DeviceIo::push_actuator(const ActuatorCommand &command) {
+    ActuatorCommand stamped = command;
+    stamped.timestamp_us = monotonic_us();
+
+    if (!command_ring_.push(stamped)) {
+        actuator_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+IoStats DeviceIo::stats() const {
+    IoStats stats;
+    stats.submits = submits_.load(std::memory_order_relaxed);
+    stats.operations = operations_.load(std::memory_order_relaxed);
+    stats.imu_samples = imu_samples_.load(std::memory_order_relaxed);
+    stats.imu_overruns = imu_overruns_.load(std::memory_order_relaxed);
+    stats.imu_errors = imu_errors_.load(std::memory_order_relaxed);
+    stats.actuator_commands = actuator_commands_.load(std::memory_order_relaxed);
+    stats.actuator_superseded = actuator_superseded_.load(std::memory_order_relaxed);
+    stats.actuator_dropped = actuator_dropped_.load(std::memory_order_relaxed);
+    stats.actuator_errors = actuator_errors_.load(std::memory_order_relaxed);
+    stats.actuator_latency_max_us = actuator_latency_max_us_.load(std::memory_order_relaxed);
+    stats.actuator_latency_sum_us = actuator_latency_sum_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void DeviceIo::run() {
+    if (config_.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config_.cpu, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    if (config_.priority > 0) {
+        sched_param param{};
+        param.sched_priority = config_.priority;
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+
+    const uint64_t timeout_ns = static_cast<uint64_t>(config_.poll_interval_us) * 1000ull;
+    Completion completions[64];
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        // Everything for this round goes to the kernel in the one io_uring_enter() below
+        if (!imu_inflight_ && !imu_eof_) {
+            queue_imu_read();
+        }
+
+        queue_command();
+
+        if (!timeout_inflight_ && ring_.queue_timeout(timeout_ns, user_data(OP_TIMEOUT, 0))) {
+            timeout_inflight_ = true;
+        }
+
+        const int submitted = ring_.submit_and_wait(1);
+        increment(submits_);
+
+        if (submitted < 0 && submitted != -EBUSY && submitted != -EAGAIN) {
+            break;
+        }
+
+        const uint64_t samples_before = imu_samples_.load(std::memory_order_relaxed);
+        unsigned count;
+
+        while ((count = ring_.reap(completions, 64)) > 0) {
+            const uint64_t now_us = monotonic_us();
+
+            for (unsigned c = 0; c < count; ++c) {
+                switch (static_cast<Operation>(completions[c].user_data >> 32)) {
+                case OP_IMU_READ:
+                    handle_imu(completions[c].result, now_us);
+                    break;
+
+                case OP_ACTUATOR_WRITE:
+                    handle_write(completions[c].result, now_us);
+                    break;
+
+                case OP_TIMEOUT:
+                    timeout_inflight_ = false;
+                    break;
+
+                default:
+                    break;
+                }
+            }
+        }
+
+        // The control thread answers a sample within its computation time: wait for the
+        // command here rather than sleeping for a poll interval
+        if (config_.command_spin_us > 0 && imu_samples_.load(std::memory_order_relaxed) != samples_before) {
+            const uint64_t deadline = monotonic_us() + config_.command_spin_us;
+
+            while (command_ring_.size() == 0 && monotonic_us() < deadline && !stop_.load(std::memory_order_relaxed)) {
+                cpu_relax();
+            }
+        }
+    }
+
+    shutdown();
+}
+
+bool DeviceIo::queue_imu_read() {
+    if (!ring_.queue_read(backend_->imu_fd(), imu_buffer_ + imu_carry_, imu_read_size_, imu_offset_,
+                          user_data(OP_IMU_READ, 0))) {
+        return false;
+    }
+
+    imu_inflight_ = true;
+    return true;
+}
+
+void DeviceIo::queue_command() {
+    ActuatorCommand command;
+
+    while (command_ring_.pop(command)) {
+        if (command_pending_) {
+            increment(actuator_superseded_);
+        }
+
+        pending_ = command;
+        command_pending_ = true;
+    }
+
+    if (!command_pending_ || writes_inflight_ > 0) {
+        return;
+    }
+
+    command_pending_ = false;
+    write_stamp_us_ = pending_.timestamp_us;
+    write_failed_ = false;
+
+    for (int target = 0; target < targets_; ++target) {
+        const size_t size = backend_->encode_actuator(target, pending_, write_buffer_[target], MAX_ACTUATOR_WRITE);
+
+        if (size == 0) {
+            continue;
+        }
+
+        if (ring_.queue_write(backend_->actuator_fd(target), write_buffer_[target], size, write_offset_[target],
+                              user_data(OP_ACTUATOR_WRITE, static_cast<uint32_t>(target)))) {
+            ++writes_inflight_;
+
+        } else {
+            write_failed_ = true;
+        }
+    }
+
+    if (writes_inflight_ == 0) {
+        increment(write_failed_ ? actuator_errors_ : actuator_commands_);
+    }
+}
+
+void DeviceIo::handle_imu(int32_t result, uint64_t now_us) {
+    imu_inflight_ = false;
+
+    if (result == 0) {
+        imu_eof_ = true;   // Device closed: keep serving the actuators
+        return;
+    }
+
+    if (result < 0) {
+        if (result != -ECANCELED && result != -EAGAIN && result != -EINTR) {
+            increment(imu_errors_);
+        }
+
+        return;
+    }
+
+    increment(operations_);
+
+    const size_t record_size = backend_->imu_record_size();
+    const size_t available = imu_carry_ + static_cast<size_t>(result);
+    const size_t records = available / record_size;
+
+    for (size_t r = 0; r < records; ++r) {
+        ImuSample sample{};
+        sample.sequence = imu_sequence_++;
+
+        if (!backend_->decode_imu(imu_buffer_ + r * record_size, sample)) {
+            increment(imu_errors_);
+            continue;
+        }
+
+        sample.receive_us = now_us;
+
+        if (sample.timestamp_us == 0) {
+            sample.timestamp_us = now_us;
+        }
+
+        increment(imu_ring_.push(sample) ? imu_samples_ : imu_overruns_);
+    }
+
+    imu_carry_ = available - records * record_size;
+
+    if (imu_carry_ > 0) {
+        memmove(imu_buffer_, imu_buffer_ + records * record_size, imu_carry_);
+    }
+}
+
+void DeviceIo::handle_write(int32_t result, uint64_t now_us) {
+    --writes_inflight_;
+
+    if (result < 0) {
+        write_failed_ = true;
+
+    } else {
+        increment(operations_);
+    }
+
+    if (writes_inflight_ > 0) {
+        return;
+    }
+
+    if (write_failed_) {
+        increment(actuator_errors_);
+        return;
+    }
+
+    const uint64_t latency_us = (now_us > write_stamp_us_) ? now_us - write_stamp_us_ : 0;
+    increment(actuator_commands_);
+    increment(actuator_latency_sum_us_, latency_us);
+    raise_max(actuator_latency_max_us_, latency_us);
+}
+
+void DeviceIo::shutdown() {
+    // The newest queued command still goes out (a starved I/O thread may not have seen it yet)
+    queue_command();
+
+    // The kernel may still write into imu_buffer_: cancel and drain before the ring goes away
+    if (imu_inflight_) {
+        ring_.queue_cancel(user_data(OP_IMU_READ, 0), user_data(OP_CANCEL, 0));
+    }
+
+    if (timeout_inflight_) {
+        ring_.queue_cancel(user_data(OP_TIMEOUT, 0), user_data(OP_CANCEL, 1));
+    }
+
+    Completion completions[64];
+
+    for (int round = 0;
+         round < 1000 && (imu_inflight_ || writes_inflight_ > 0 || timeout_inflight_ || command_pending_); ++round) {
+        if (ring_.submit_and_wait(1) < 0) {
+            break;
+        }
+
+        const unsigned count = ring_.reap(completions, 64);
+        const uint64_t now_us = monotonic_us();
+
+        for (unsigned c = 0; c < count; ++c) {
+            switch (static_cast<Operation>(completions[c].user_data >> 32)) {
+            case OP_IMU_READ:
+                imu_inflight_ = false;
+                break;
+
+            case OP_ACTUATOR_WRITE:
+                handle_write(completions[c].result, now_us);
+                break;
+
+            case OP_TIMEOUT:
+                timeout_inflight_ = false;
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        // Pending behind the writes that just completed
+        queue_command();
+    }
+
+    if (command_pending_) {
+        command_pending_ = false;
+        actuator_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace aic_linux_io
@@ -0,0 +1,180 @@
+/**
+ * @file device_io.hpp
+ * @brief io_uring device I/O thread with wait-free rings to the control thread
+ *
+ * On Linux boards (Erle-Brain and similar) blocking SPI/I2C reads and PWM
+ * writes in the control thread put kernel latency into every tick. Here a
+ * dedicated thread owns all device I/O:
+ *
+ *   control thread                 I/O thread                      kernel
+ *   pop_imu()      <- imu ring  <- decode, timestamp  <- read completions
+ *   push_actuator() -> cmd ring -> encode             -> write submissions
+ *
+ * Each loop of the I/O thread queues the re-armed IMU read, the writes of
+ * the newest actuator command and a wake-up timeout, then makes a single
+ * io_uring_enter() that submits them all and waits for the next completion.
+ * Completions are timestamped (CLOCK_MONOTONIC) as they are reaped.
+ *
+ * The control thread only touches the two SpscRing instances and the vDSO
+ * clock: zero syscalls per tick. It waits for IMU data by spinning
+ * (wait_imu()), so it should own a core. Commands are latest-wins: a
+ * command queued while the previous one is still being written replaces
+ * any older queued command.
+ *
+ * Commands reach the devices within poll_interval_us of push_actuator(), or
+ * immediately if the I/O thread is spinning for them after an IMU sample
+ * (command_spin_us, sized to the control computation). stop() still writes
+ * the newest queued command. Every pushed command ends up in exactly one of
+ * actuator_commands, actuator_superseded, actuator_dropped or
+ * actuator_errors.
+ */
+
+#pragma once
+
+#include "device_backend.hpp"
+#include "io_uring_queue.hpp"
+#include "spsc_ring.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace aic_linux_io {
+
+struct IoConfig {
+    unsigned queue_depth{32};
+    unsigned imu_batch{8};             // IMU records per read
+    uint32_t poll_interval_us{250};    // Longest sleep of the I/O thread
+    uint32_t command_spin_us{0};       // Spin for the command after publishing IMU samples
+    int cpu{-1};                       // Pin the I/O thread (best effort, -1: no)
+    int priority{0};                   // SCHED_FIFO priority (best effort, 0: keep the policy)
+};
+
+struct IoStats {
+    uint64_t submits;                  // io_uring_enter() calls
+    uint64_t operations;               // Reads and writes completed
+    uint64_t imu_samples;              // Published to the control thread
+    uint64_t imu_overruns;             // Dropped: control thread not keeping up
+    uint64_t imu_errors;               // Failed reads and rejected records
+    uint64_t actuator_commands;        // Commands written to all targets
+    uint64_t actuator_superseded;      // Replaced by a newer command before being written
+    uint64_t actuator_dropped;         // Command ring full, or still unwritten when stop() gave up
+    uint64_t actuator_errors;          // Failed writes
+    uint64_t actuator_latency_max_us;  // push_actuator() to last write completion
+    uint64_t actuator_latency_sum_us;
+};
+
+/**
+ * @class DeviceIo
+ */
+class DeviceIo {
+public:
+    static constexpr uint32_t IMU_RING = 64;
+    static constexpr uint32_t COMMAND_RING = 8;
+
+    DeviceIo() = default;
+    ~DeviceIo() { stop(); }
+
+    DeviceIo(const DeviceIo &) = delete;
+    DeviceIo &operator=(const DeviceIo &) = delete;
+
+    /**
+     * @brief Create the ring and start the I/O thread
+     *
+     * @param backend device files, must outlive stop()
+     * @param error reason on failure (e.g. io_uring unavailable)
+     * @return true on success
+     */
+    bool start(DeviceBackend &backend, const IoConfig &config, std::string &error);
+
+    /**
+     * @brief Write the last queued command, cancel outstanding I/O and join the thread
+     */
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+    /**
+     * @brief Control thread: oldest unread IMU sample (wait-free)
+     */
+    bool pop_imu(ImuSample &sample) { return imu_ring_.pop(sample); }
+
+    /**
+     * @brief Control thread: spin until an IMU sample arrives or timeout_us elapses
+     */
+    bool wait_imu(ImuSample &sample, uint64_t timeout_us);
+
+    /**
+     * @brief Control thread: queue a command, stamping its timestamp (wait-free)
+     * @return false if the command ring is full (counted in actuator_dropped)
+     */
+    bool push_actuator(const ActuatorCommand &command);
+
+    /**
+     * @brief Counters of the I/O thread (any thread)
+     */
+    IoStats stats() const;
+
+private:
+    enum Operation : uint64_t {
+        OP_IMU_READ = 1,
+        OP_ACTUATOR_WRITE = 2,
+        OP_TIMEOUT = 3,
+        OP_CANCEL = 4,
+    };
+
+    static uint64_t user_data(Operation operation, uint32_t index) {
+        return (static_cast<uint64_t>(operation) << 32) | index;
+    }
+
+    void run();
+    bool queue_imu_read();
+    void queue_command();
+    void handle_imu(int32_t result, uint64_t now_us);
+    void handle_write(int32_t result, uint64_t now_us);
+    void shutdown();
+
+    DeviceBackend *backend_{nullptr};
+    IoConfig config_;
+    IoUringQueue ring_;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+
+    SpscRing<ImuSample, IMU_RING> imu_ring_;
+    SpscRing<ActuatorCommand, COMMAND_RING> command_ring_;
+
+    // I/O thread state
+    static constexpr unsigned MAX_IMU_BATCH = 32;
+    uint8_t imu_buffer_[MAX_IMU_BATCH * 256];
+    size_t imu_read_size_{0};
+    size_t imu_carry_{0};              // Bytes of a partial record kept at the buffer start
+    int64_t imu_offset_{-1};
+    bool imu_inflight_{false};
+    bool imu_eof_{false};
+    uint32_t imu_sequence_{0};
+
+    uint8_t write_buffer_[MAX_CHANNELS][MAX_ACTUATOR_WRITE];
+    int64_t write_offset_[MAX_CHANNELS];
+    int targets_{0};
+    int writes_inflight_{0};
+    bool write_failed_{false};
+    uint64_t write_stamp_us_{0};
+    bool command_pending_{false};
+    ActuatorCommand pending_{};
+
+    bool timeout_inflight_{false};
+
+    std::atomic<uint64_t> submits_{0};
+    std::atomic<uint64_t> operations_{0};
+    std::atomic<uint64_t> imu_samples_{0};
+    std::atomic<uint64_t> imu_overruns_{0};
+    std::atomic<uint64_t> imu_errors_{0};
+    std::atomic<uint64_t> actuator_commands_{0};
+    std::atomic<uint64_t> actuator_superseded_{0};
+    std::atomic<uint64_t> actuator_dropped_{0};       // Both threads write it (fetch_add)
+    std::atomic<uint64_t> actuator_errors_{0};
+    std::atomic<uint64_t> actuator_latency_max_us_{0};
+    std::atomic<uint64_t> actuator_latency_sum_us_{0};
+};
+
+} // namespace aic_linux_io
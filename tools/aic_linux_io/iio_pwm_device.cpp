@@ -0,0 +1,135 @@
+/**
+ * @file iio_pwm_device.cpp
+ * @brief Board backend: IIO buffered IMU and sysfs PWM outputs
+ */
+
+#include "iio_pwm_device.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace aic_linux_io {
+
+namespace {
+
+bool valid_offset(int offset, size_t bytes, size_t record_size) {
+    return offset >= 0 && static_cast<size_t>(offset) + bytes <= record_size;
+}
+
+} // namespace
+
+bool IioPwmDevice::open(const IioPwmConfig &config, std::string &error) {
+    close();
+    config_ = config;
+
+    if (config.record_size == 0 || config.pwm_duty_cycle.size() > static_cast<size_t>(MAX_CHANNELS)
+        || config.pulse_max_ns <= config.pulse_min_ns) {
+        error = "invalid configuration";
+        return false;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        if (!valid_offset(config.gyro_offset[i], 2, config.record_size)
+            || !valid_offset(config.accel_offset[i], 2, config.record_size)) {
+            error = "channel outside the scan";
+            return false;
+        }
+    }
+
+    if (config.timestamp_offset >= 0 && !valid_offset(config.timestamp_offset, 8, config.record_size)) {
+        error = "timestamp outside the scan";
+        return false;
+    }
+
+    // /dev/iio:deviceN -> /sys/bus/iio/devices/iio:deviceN/current_timestamp_clock (best effort)
+    const size_t slash = config.iio_device.rfind('/');
+    const std::string clock_path = "/sys/bus/iio/devices/" + config.iio_device.substr(slash + 1)
+                                   + "/current_timestamp_clock";
+    const int clock_fd = ::open(clock_path.c_str(), O_WRONLY | O_CLOEXEC);
+
+    if (clock_fd >= 0) {
+        if (write(clock_fd, "monotonic\n", 10) != 10) {
+            config_.timestamp_offset = -1;   // Realtime stamps: use the completion time instead
+        }
+
+        ::close(clock_fd);
+    }
+
+    imu_fd_ = ::open(config.iio_device.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (imu_fd_ < 0) {
+        error = config.iio_device + ": " + strerror(errno);
+        return false;
+    }
+
+    for (const std::string &path : config.pwm_duty_cycle) {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+
+        if (fd < 0) {
+            error = path + ": " + strerror(errno);
+            close();
+            return false;
+        }
+
+        pwm_fds_.push_back(fd);
+    }
+
+    return true;
+}
+
+void IioPwmDevice::close() {
+    if (imu_fd_ >= 0) {
+        ::close(imu_fd_);
+        imu_fd_ = -1;
+    }
+
+    for (int fd : pwm_fds_) {
+        ::close(fd);
+    }
+
+    pwm_fds_.clear();
+}
+
+int16_t IioPwmDevice::read_s16(const uint8_t *record, int offset) const {
+    const uint8_t *p = record + offset;
+    const uint16_t raw = config_.big_endian ? static_cast<uint16_t>((p[0] << 8) | p[1])
+                         : static_cast<uint16_t>((p[1] << 8) | p[0]);
+    return static_cast<int16_t>(raw);
+}
+
+bool IioPwmDevice::decode_imu(const uint8_t *record, ImuSample &sample) const {
+    for (int i = 0; i < 3; ++i) {
+        sample.gyro[i] = config_.gyro_scale * read_s16(record, config_.gyro_offset[i]);
+        sample.accel[i] = config_.accel_scale * read_s16(record, config_.accel_offset[i]);
+    }
+
+    if (config_.timestamp_offset >= 0) {
+        // IIO timestamps are host-endian
+        int64_t timestamp_ns;
+        memcpy(&timestamp_ns, record + config_.timestamp_offset, sizeof(timestamp_ns));
+        sample.timestamp_us = (timestamp_ns > 0) ? static_cast<uint64_t>(timestamp_ns) / 1000ull : 0;
+    }
+
+    return true;
+}
+
+size_t IioPwmDevice::encode_actuator(int target, const ActuatorCommand &command, uint8_t *buffer,
+                                     size_t size) const {
+    if (static_cast<uint32_t>(target) >= command.channels) {
+        return 0;
+    }
+
+    float output = command.output[target];
+    output = (output > 0.f) ? ((output < 1.f) ? output : 1.f) : 0.f;   // Also maps NaN to 0
+
+    const uint32_t pulse_ns = config_.pulse_min_ns
+                              + static_cast<uint32_t>(output * static_cast<float>(config_.pulse_max_ns - config_.pulse_min_ns));
+    const int length = snprintf(reinterpret_cast<char *>(buffer), size, "%u\n", pulse_ns);
+    return (length > 0 && static_cast<size_t>(length) < size) ? static_cast<size_t>(length) : 0;
+}
+
+} // namespace aic_linux_io
@@ -0,0 +1,79 @@
+/**
+ * @file iio_pwm_device.hpp
+ * @brief Board backend: IIO buffered IMU and sysfs PWM outputs
+ *
+ * The kernel drivers of the Erle-Brain class boards expose the IMU
+ * (inv_mpu6050 on SPI) as an IIO device and the PWM expander (pwm-pca9685
+ * on I2C) as sysfs PWM channels. Reading the IIO buffer character device
+ * returns whole scans, so SPI transfers happen in the driver's interrupt
+ * thread and never in ours; each PWM channel is one duty_cycle write.
+ *
+ * The IIO buffer (scan_elements/in_*_en, buffer/length, buffer/enable) and the
+ * PWM channels (export, period, enable) are set up by the board start
+ * script; this backend only opens the data files. The scan layout is given
+ * by the in_*_index and in_*_type files under scan_elements.
+ */
+
+#pragma once
+
+#include "device_backend.hpp"
+
+#include <string>
+#include <vector>
+
+namespace aic_linux_io {
+
+struct IioPwmConfig {
+    std::string iio_device{"/dev/iio:device0"};
+    size_t record_size{24};                    // Bytes per scan, including padding
+    int gyro_offset[3] {8, 10, 12};            // Byte offsets of the 16-bit channels in a scan
+    int accel_offset[3] {0, 2, 4};
+    bool big_endian{true};                     // "be:s16/16>>0" in scan_elements/in_*_type
+    float gyro_scale{0.001064724f};            // in_anglvel_scale (rad/s per LSB)
+    float accel_scale{0.000598f};              // in_accel_scale (m/s^2 per LSB)
+    int timestamp_offset{16};                  // s64 nanoseconds, -1 without a timestamp channel
+
+    std::vector<std::string> pwm_duty_cycle;   // /sys/class/pwm/pwmchipN/pwmM/duty_cycle per channel
+    uint32_t pulse_min_ns{1000000};
+    uint32_t pulse_max_ns{2000000};
+};
+
+/**
+ * @class IioPwmDevice
+ */
+class IioPwmDevice : public DeviceBackend {
+public:
+    IioPwmDevice() = default;
+    ~IioPwmDevice() override { close(); }
+
+    IioPwmDevice(const IioPwmDevice &) = delete;
+    IioPwmDevice &operator=(const IioPwmDevice &) = delete;
+
+    /**
+     * @brief Open the IIO buffer and the PWM duty_cycle files
+     *
+     * Switches the IIO timestamp clock to CLOCK_MONOTONIC so that sample
+     * timestamps compare with monotonic_us().
+     *
+     * @param error reason on failure
+     */
+    bool open(const IioPwmConfig &config, std::string &error);
+    void close();
+
+    int imu_fd() const override { return imu_fd_; }
+    size_t imu_record_size() const override { return config_.record_size; }
+    bool decode_imu(const uint8_t *record, ImuSample &sample) const override;
+
+    int actuator_target_count() const override { return static_cast<int>(pwm_fds_.size()); }
+    int actuator_fd(int target) const override { return pwm_fds_[target]; }
+    size_t encode_actuator(int target, const ActuatorCommand &command, uint8_t *buffer, size_t size) const override;
+
+private:
+    int16_t read_s16(const uint8_t *record, int offset) const;
+
+    IioPwmConfig config_;
+    int imu_fd_{-1};
+    std::vector<int> pwm_fds_;
+};
+
+} // namespace aic_linux_io
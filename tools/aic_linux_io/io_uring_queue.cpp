@@ -0,0 +1,266 @@
+/**
+ * @file io_uring_queue.cpp
+ * @brief Minimal io_uring submission/completion queue on the raw syscalls
+ */
+
+#include "io_uring_queue.hpp"
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace aic_linux_io {
+
+namespace {
+
+// Ring indices are shared with the kernel
+inline unsigned load_acquire(const unsigned *index) {
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+inline void store_release(unsigned *index, unsigned value) {
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+template<typename T>
+T *at(void *base, uint32_t offset) {
+    return reinterpret_cast<T *>(static_cast<uint8_t *>(base) + offset);
+}
+
+} // namespace
+
+bool IoUringQueue::open(unsigned entries, int &error) {
+    static_assert(sizeof(Timespec) == sizeof(__kernel_timespec), "timespec layout");
+
+    close();
+    error = 0;
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    const long fd = syscall(__NR_io_uring_setup, entries, &params);
+
+    if (fd < 0) {
+        error = errno;
+        return false;
+    }
+
+    fd_ = static_cast<int>(fd);
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+    if (single_mmap) {
+        sq_ring_size_ = (cq_ring_size_ > sq_ring_size_) ? cq_ring_size_ : sq_ring_size_;
+    }
+
+    void *sq_ring = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                         IORING_OFF_SQ_RING);
+
+    if (sq_ring == MAP_FAILED) {
+        error = errno;
+        close();
+        return false;
+    }
+
+    sq_ring_ = sq_ring;
+
+    if (single_mmap) {
+        cq_ring_ = sq_ring_;
+
+    } else {
+        void *cq_ring = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                             IORING_OFF_CQ_RING);
+
+        if (cq_ring == MAP_FAILED) {
+            error = errno;
+            close();
+            return false;
+        }
+
+        cq_ring_ = cq_ring;
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+
+    if (sqes == MAP_FAILED) {
+        error = errno;
+        close();
+        return false;
+    }
+
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    sq_head_ = at<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_mask_ = at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_array_ = at<unsigned>(sq_ring_, params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+
+    cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+    sq_tail_local_ = *sq_tail_;
+    queued_ = 0;
+    return true;
+}
+
+void IoUringQueue::close() {
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+    }
+
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+        munmap(cq_ring_, cq_ring_size_);
+    }
+
+    if (sq_ring_) {
+        munmap(sq_ring_, sq_ring_size_);
+    }
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+
+    fd_ = -1;
+    sq_ring_ = nullptr;
+    cq_ring_ = nullptr;
+    sqes_ = nullptr;
+    queued_ = 0;
+}
+
+io_uring_sqe *IoUringQueue::next_sqe() {
+    if (fd_ < 0 || sq_tail_local_ - load_acquire(sq_head_) >= sq_entries_) {
+        return nullptr;
+    }
+
+    const unsigned index = sq_tail_local_ & *sq_mask_;
+    io_uring_sqe *sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sq_tail_local_;
+    ++queued_;
+    return sqe;
+}
+
+bool IoUringQueue::queue_read(int fd, void *buffer, size_t size, int64_t offset, uint64_t user_data) {
+    io_uring_sqe *sqe = next_sqe();
+
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(size);
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUringQueue::queue_write(int fd, const void *buffer, size_t size, int64_t offset, uint64_t user_data) {
+    io_uring_sqe *sqe = next_sqe();
+
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(size);
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUringQueue::queue_timeout(uint64_t timeout_ns, uint64_t user_data) {
+    io_uring_sqe *sqe = next_sqe();
+
+    if (!sqe) {
+        return false;
+    }
+
+    // The kernel copies the timespec while consuming the entry
+    Timespec &spec = timespecs_[timespec_next_++ % TIMESPEC_SLOTS];
+    spec.tv_sec = static_cast<int64_t>(timeout_ns / 1000000000ull);
+    spec.tv_nsec = static_cast<int64_t>(timeout_ns % 1000000000ull);
+
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uint64_t>(&spec);
+    sqe->len = 1;
+    sqe->off = 0;   // Pure timeout: not satisfied by other completions
+    sqe->user_data = user_data;
+    return true;
+}
+
+bool IoUringQueue::queue_cancel(uint64_t target_user_data, uint64_t user_data) {
+    io_uring_sqe *sqe = next_sqe();
+
+    if (!sqe) {
+        return false;
+    }
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target_user_data;
+    sqe->user_data = user_data;
+    return true;
+}
+
+int IoUringQueue::submit_and_wait(unsigned wait_count) {
+    if (fd_ < 0) {
+        return -EBADF;
+    }
+
+    store_release(sq_tail_, sq_tail_local_);
+
+    const unsigned flags = (wait_count > 0) ? IORING_ENTER_GETEVENTS : 0;
+
+    for (;;) {
+        const long consumed = syscall(__NR_io_uring_enter, fd_, queued_, wait_count, flags, nullptr, 0);
+
+        if (consumed >= 0) {
+            queued_ -= static_cast<unsigned>(consumed);
+            return static_cast<int>(consumed);
+        }
+
+        if (errno != EINTR) {
+            return -errno;
+        }
+    }
+}
+
+unsigned IoUringQueue::reap(Completion *completions, unsigned max) {
+    if (fd_ < 0) {
+        return 0;
+    }
+
+    unsigned head = *cq_head_;
+    const unsigned tail = load_acquire(cq_tail_);
+    unsigned count = 0;
+
+    while (head != tail && count < max) {
+        const io_uring_cqe &cqe = cqes_[head & *cq_mask_];
+        completions[count].user_data = cqe.user_data;
+        completions[count].result = cqe.res;
+        ++count;
+        ++head;
+    }
+
+    store_release(cq_head_, head);
+    return count;
+}
+
+} // namespace aic_linux_io
@@ -0,0 +1,130 @@
+/**
+ * @file io_uring_queue.hpp
+ * @brief Minimal io_uring submission/completion queue on the raw syscalls
+ *
+ * Only what the device I/O thread needs: reads, writes and relative
+ * timeouts, queued into the shared submission ring and handed to the kernel
+ * in one io_uring_enter() per batch. No liburing dependency, so the tool
+ * builds against the kernel headers of any board image (Linux >= 5.6 at run
+ * time; open() fails cleanly on older kernels or where io_uring is disabled).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace aic_linux_io {
+
+struct Completion {
+    uint64_t user_data;
+    int32_t result;     // Bytes transferred or -errno
+};
+
+/**
+ * @class IoUringQueue
+ * @brief One ring, used from a single thread
+ */
+class IoUringQueue {
+public:
+    IoUringQueue() = default;
+    ~IoUringQueue() { close(); }
+
+    IoUringQueue(const IoUringQueue &) = delete;
+    IoUringQueue &operator=(const IoUringQueue &) = delete;
+
+    /**
+     * @brief Create the ring and map its queues
+     *
+     * @param entries submission queue depth (rounded up to a power of two by the kernel)
+     * @param error errno of the failing call, 0 on success
+     * @return true on success
+     */
+    bool open(unsigned entries, int &error);
+
+    void close();
+
+    bool is_open() const { return fd_ >= 0; }
+
+    /**
+     * @brief Queue a read of size bytes at offset (-1: current file position)
+     * @return false if the submission queue is full
+     */
+    bool queue_read(int fd, void *buffer, size_t size, int64_t offset, uint64_t user_data);
+
+    /**
+     * @brief Queue a write of size bytes at offset (-1: current file position)
+     */
+    bool queue_write(int fd, const void *buffer, size_t size, int64_t offset, uint64_t user_data);
+
+    /**
+     * @brief Queue a timeout completing with -ETIME after timeout_ns
+     */
+    bool queue_timeout(uint64_t timeout_ns, uint64_t user_data);
+
+    /**
+     * @brief Queue the cancellation of the request tagged target_user_data
+     *
+     * The cancelled request completes with -ECANCELED (or its own result if
+     * it was already finishing), then this entry with 0 or -ENOENT.
+     */
+    bool queue_cancel(uint64_t target_user_data, uint64_t user_data);
+
+    /**
+     * @brief Submit the queued entries and wait for at least wait_count completions
+     *
+     * One io_uring_enter() whatever the number of queued entries.
+     *
+     * @return entries consumed by the kernel, or -errno
+     */
+    int submit_and_wait(unsigned wait_count);
+
+    /**
+     * @brief Copy up to max completions out of the completion queue
+     * @return completions copied
+     */
+    unsigned reap(Completion *completions, unsigned max);
+
+    unsigned queued() const { return queued_; }
+
+private:
+    io_uring_sqe *next_sqe();
+
+    int fd_{-1};
+
+    void *sq_ring_{nullptr};
+    size_t sq_ring_size_{0};
+    void *cq_ring_{nullptr};     // Same mapping as sq_ring_ with IORING_FEAT_SINGLE_MMAP
+    size_t cq_ring_size_{0};
+    io_uring_sqe *sqes_{nullptr};
+    size_t sqes_size_{0};
+
+    unsigned *sq_head_{nullptr};
+    unsigned *sq_tail_{nullptr};
+    unsigned *sq_mask_{nullptr};
+    unsigned *sq_array_{nullptr};
+    unsigned sq_entries_{0};
+
+    unsigned *cq_head_{nullptr};
+    unsigned *cq_tail_{nullptr};
+    unsigned *cq_mask_{nullptr};
+    io_uring_cqe *cqes_{nullptr};
+
+    unsigned sq_tail_local_{0};  // Entries queued but not yet published to the kernel
+    unsigned queued_{0};
+
+    // Timeout specs must stay valid until submitted (layout of __kernel_timespec)
+    struct Timespec {
+        int64_t tv_sec;
+        int64_t tv_nsec;
+    };
+
+    static constexpr unsigned TIMESPEC_SLOTS = 8;
+    Timespec timespecs_[TIMESPEC_SLOTS] {};
+    unsigned timespec_next_{0};
+};
+
+} // namespace aic_linux_io
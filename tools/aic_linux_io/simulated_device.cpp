@@ -0,0 +1,180 @@
+/**
+ * @file simulated_device.cpp
+ * @brief Local stand-in for the IMU and actuators of a board
+ */
+
+#include "simulated_device.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+namespace aic_linux_io {
+
+namespace {
+
+void slow_rotation(double t, float gyro[3], float accel[3]) {
+    gyro[0] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 0.5 * t));
+    gyro[1] = static_cast<float>(0.3 * std::cos(2.0 * M_PI * 0.7 * t));
+    gyro[2] = 0.1f;
+    accel[0] = 0.f;
+    accel[1] = 0.f;
+    accel[2] = -9.81f;
+}
+
+void close_pair(int fds[2]) {
+    for (int i = 0; i < 2; ++i) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+            fds[i] = -1;
+        }
+    }
+}
+
+} // namespace
+
+bool SimulatedDevice::start(const SimulatedDeviceConfig &config) {
+    stop();
+
+    if (!(config.imu_rate_hz > 0.f) || config.channels < 1 || config.channels > MAX_CHANNELS) {
+        return false;
+    }
+
+    config_ = config;
+
+    if (!config_.imu_model) {
+        config_.imu_model = slow_rotation;
+    }
+
+    // Device-side ends are non-blocking: the device never stalls on the reader
+    if (pipe2(imu_pipe_, O_CLOEXEC) != 0 || pipe2(actuator_pipe_, O_CLOEXEC) != 0) {
+        close_pair(imu_pipe_);
+        close_pair(actuator_pipe_);
+        return false;
+    }
+
+    fcntl(imu_pipe_[1], F_SETFL, O_NONBLOCK);
+    fcntl(actuator_pipe_[0], F_SETFL, O_NONBLOCK);
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_ = SimulatedDeviceStats{};
+    }
+
+    stop_.store(false);
+    thread_ = std::thread(&SimulatedDevice::run, this);
+    return true;
+}
+
+void SimulatedDevice::stop() {
+    if (thread_.joinable()) {
+        stop_.store(true);
+        thread_.join();
+    }
+
+    // Commands already written still count
+    if (actuator_pipe_[0] >= 0) {
+        receive_commands();
+    }
+
+    close_pair(imu_pipe_);
+    close_pair(actuator_pipe_);
+}
+
+SimulatedDeviceStats SimulatedDevice::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+bool SimulatedDevice::decode_imu(const uint8_t *record, ImuSample &sample) const {
+    Record r;
+    memcpy(&r, record, sizeof(r));
+
+    if (!std::isfinite(r.gyro[0]) || !std::isfinite(r.gyro[1]) || !std::isfinite(r.gyro[2])) {
+        return false;
+    }
+
+    sample.timestamp_us = r.timestamp_us;
+    sample.sequence = r.sequence;
+
+    for (int i = 0; i < 3; ++i) {
+        sample.gyro[i] = r.gyro[i];
+        sample.accel[i] = r.accel[i];
+    }
+
+    return true;
+}
+
+size_t SimulatedDevice::encode_actuator(int /* target */, const ActuatorCommand &command, uint8_t *buffer,
+                                        size_t size) const {
+    if (size < sizeof(command)) {
+        return 0;
+    }
+
+    memcpy(buffer, &command, sizeof(command));
+    return sizeof(command);
+}
+
+void SimulatedDevice::run() {
+    const uint64_t period_ns = static_cast<uint64_t>(1e9 / config_.imu_rate_hz);
+    const uint64_t start_us = monotonic_us();
+    uint64_t next_ns = 0;
+    uint32_t sequence = 0;
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        const uint64_t now_ns = (monotonic_us() - start_us) * 1000ull;
+
+        if (now_ns >= next_ns) {
+            Record record;
+            record.sequence = sequence;
+            config_.imu_model(next_ns * 1e-9, record.gyro, record.accel);
+            record.timestamp_us = start_us + next_ns / 1000ull;   // Sample clock, as a device timestamp
+            emitted_us_[sequence % HISTORY] = monotonic_us();
+
+            // Sample lost if the reader has let the pipe fill up, as with a device FIFO
+            if (write(imu_pipe_[1], &record, sizeof(record)) == static_cast<ssize_t>(sizeof(record))) {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                ++stats_.imu_emitted;
+            }
+
+            ++sequence;
+            next_ns += period_ns;
+            continue;
+        }
+
+        pollfd fd{actuator_pipe_[0], POLLIN, 0};
+        const uint64_t wait_ns = next_ns - now_ns;
+        const timespec timeout{static_cast<time_t>(wait_ns / 1000000000ull), static_cast<long>(wait_ns % 1000000000ull)};
+
+        if (ppoll(&fd, 1, &timeout, nullptr) > 0) {
+            receive_commands();
+        }
+    }
+}
+
+void SimulatedDevice::receive_commands() {
+    ActuatorCommand command;
+
+    while (read(actuator_pipe_[0], &command, sizeof(command)) == static_cast<ssize_t>(sizeof(command))) {
+        const uint64_t now_us = monotonic_us();
+        const uint64_t emitted_us = emitted_us_[command.sequence % HISTORY];
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        ++stats_.commands;
+        stats_.last_command = command;
+
+        if (emitted_us > 0 && now_us >= emitted_us && now_us - emitted_us < 1000000ull) {
+            const uint64_t latency_us = now_us - emitted_us;
+            ++stats_.answered;
+            stats_.loop_latency_sum_us += latency_us;
+            stats_.loop_latency_max_us = (latency_us > stats_.loop_latency_max_us) ? latency_us
+                                         : stats_.loop_latency_max_us;
+        }
+    }
+}
+
+} // namespace aic_linux_io
@@ -0,0 +1,101 @@
+/**
+ * @file simulated_device.hpp
+ * @brief Local stand-in for the IMU and actuators of a board
+ *
+ * A device thread plays the hardware: it writes IMU records into a pipe at
+ * the configured rate and reads actuator frames from a second pipe. DeviceIo
+ * drives the other ends through io_uring exactly as it drives the IIO and
+ * PWM files of a real board, so tests and desktop runs exercise the same
+ * I/O path without hardware.
+ *
+ * The device remembers when it emitted each sample; a command whose
+ * sequence is that of an IMU sample gives the sample-to-actuator latency
+ * of the whole loop (device -> I/O thread -> control thread -> device).
+ */
+
+#pragma once
+
+#include "device_backend.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace aic_linux_io {
+
+struct SimulatedDeviceConfig {
+    float imu_rate_hz{1000.f};
+    int channels{4};
+
+    // Signal of the simulated IMU at time t (s); a slow rotation if empty
+    std::function<void(double t, float gyro[3], float accel[3])> imu_model;
+};
+
+struct SimulatedDeviceStats {
+    uint64_t imu_emitted;
+    uint64_t commands;                 // Actuator frames received
+    uint64_t answered;                 // Frames whose sequence matched an emitted sample
+    uint64_t loop_latency_max_us;      // Sample emitted to its command received
+    uint64_t loop_latency_sum_us;
+    ActuatorCommand last_command;
+};
+
+/**
+ * @class SimulatedDevice
+ */
+class SimulatedDevice : public DeviceBackend {
+public:
+    SimulatedDevice() = default;
+    ~SimulatedDevice() override { stop(); }
+
+    SimulatedDevice(const SimulatedDevice &) = delete;
+    SimulatedDevice &operator=(const SimulatedDevice &) = delete;
+
+    /**
+     * @brief Create the pipes and start emitting samples
+     */
+    bool start(const SimulatedDeviceConfig &config);
+
+    /**
+     * @brief Stop the device thread, take the commands already written and close the pipes (DeviceIo reads end of file)
+     */
+    void stop();
+
+    SimulatedDeviceStats stats() const;
+
+    int imu_fd() const override { return imu_pipe_[0]; }
+    size_t imu_record_size() const override { return sizeof(Record); }
+    bool decode_imu(const uint8_t *record, ImuSample &sample) const override;
+
+    int actuator_target_count() const override { return 1; }
+    int actuator_fd(int /* target */) const override { return actuator_pipe_[1]; }
+    size_t encode_actuator(int target, const ActuatorCommand &command, uint8_t *buffer, size_t size) const override;
+
+private:
+#pragma pack(push, 1)
+    struct Record {
+        uint64_t timestamp_us;
+        uint32_t sequence;
+        float gyro[3];
+        float accel[3];
+    };
+#pragma pack(pop)
+
+    void run();
+    void receive_commands();
+
+    SimulatedDeviceConfig config_;
+    int imu_pipe_[2] {-1, -1};
+    int actuator_pipe_[2] {-1, -1};
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+
+    static constexpr uint32_t HISTORY = 1024;
+    uint64_t emitted_us_[HISTORY] {};   // Emit time by sequence % HISTORY
+
+    mutable std::mutex stats_mutex_;
+    SimulatedDeviceStats stats_{};
+};
+
+} // namespace aic_linux_io
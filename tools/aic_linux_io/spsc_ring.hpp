@@ -0,0 +1,92 @@
+/**
+ * @file spsc_ring.hpp
+ * @brief Wait-free single-producer single-consumer ring
+ *
+ * Carries IMU samples from the I/O thread to the control thread and
+ * actuator commands back. push() and pop() finish in a bounded number of
+ * steps whatever the other side does: no locks, no retries, no syscalls.
+ *
+ * head_ is written by the consumer only, tail_ by the producer only; each
+ * side keeps a cached copy of the other index and reloads it only when the
+ * ring looks full (producer) or empty (consumer), so the common case touches
+ * no cache line owned by the other thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace aic_linux_io {
+
+/**
+ * @class SpscRing
+ * @tparam T trivially copyable element
+ * @tparam CAPACITY slots, a power of two
+ */
+template<typename T, uint32_t CAPACITY>
+class SpscRing {
+public:
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    /**
+     * @brief Producer: append an element
+     * @return false if the ring is full (the element is not stored)
+     */
+    bool push(const T &value) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - head_cached_ == CAPACITY) {
+            head_cached_ = head_.load(std::memory_order_acquire);
+
+            if (tail - head_cached_ == CAPACITY) {
+                return false;
+            }
+        }
+
+        buffer_[tail & (CAPACITY - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer: take the oldest element
+     * @return false if the ring is empty
+     */
+    bool pop(T &value) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+
+        if (head == tail_cached_) {
+            tail_cached_ = tail_.load(std::memory_order_acquire);
+
+            if (head == tail_cached_) {
+                return false;
+            }
+        }
+
+        value = buffer_[head & (CAPACITY - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Elements in the ring (exact on either side, approximate elsewhere)
+     */
+    uint32_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr uint32_t capacity() { return CAPACITY; }
+
+private:
+    // Producer and consumer state on separate cache lines
+    alignas(64) std::atomic<uint32_t> tail_{0};
+    uint32_t head_cached_{0};
+
+    alignas(64) std::atomic<uint32_t> head_{0};
+    uint32_t tail_cached_{0};
+
+    alignas(64) T buffer_[CAPACITY];
+};
+
+} // namespace aic_linux_io
@@ -0,0 +1,182 @@
+/**
+ * @file aic_bench_main.cpp
+ * @brief Head-to-head benchmark of the AIC against the stock PX4 attitude and rate controllers
+ *
+ * Usage:
+ *   aic_bench [-d duration_s] [-S seed] [-n passes] [-L log.csv]... [-T ticks.csv] [-o report]
+ *
+ * Flies every built-in scenario in the SIL with the AIC module and with the
+ * PX4 cascade (same timing, noise and seed), then replays controller inputs
+ * through the AIC module tick, the AIC controller alone and the PX4 cascade
+ * to time them per tick: the inputs the AIC saw in the first scenario and
+ * every -L flight log (tick_log.hpp format). Writes report.json and
+ * report.md and prints the key numbers.
+ *
+ * -T writes the recorded first-scenario inputs as a tick log (a reference
+ * for converting flight logs, or to replay on another host).
+ */
+
+#include "bench_report.hpp"
+#include "controller_bench.hpp"
+#include "sil_simulator.hpp"
+#include "tick_log.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace aic_sil;
+
+namespace {
+
+struct Scenario {
+    const char *name;
+    const char *description;
+    void (*apply)(SilConfig &config);
+};
+
+const Scenario SCENARIOS[] = {
+    {"steps", "0.2 rad roll/pitch steps (torque-limited slews), module inertia 10% low",
+     [](SilConfig &) {}},
+    {"small_steps", "0.05 rad roll/pitch steps, mostly unsaturated",
+     [](SilConfig &config) { config.step_amplitude = 0.05f; }},
+    {"payload", "0.05 rad steps, plant inertia 1.5x (module starts from the unloaded inertia)",
+     [](SilConfig &config) { config.step_amplitude = 0.05f; config.J_true = config.J_true * 1.5f; }},
+    {"disturbance", "hover with a constant 0.01 Nm roll and pitch torque (CG offset)",
+     [](SilConfig &config) { config.step_amplitude = 0.f; config.disturbance = Vector3f(0.01f, -0.01f, 0.f); }},
+    {"dropout", "0.05 rad steps, 30% estimator and 10% setpoint message dropout",
+     [](SilConfig &config) {
+         config.step_amplitude = 0.05f;
+         config.estimator.dropout = 0.3f;
+         config.setpoint.dropout = 0.1f;
+     }},
+    {"vibration", "0.05 rad steps, 0.5 rad/s motor vibration line at 180 Hz on roll/pitch",
+     [](SilConfig &config) { config.step_amplitude = 0.05f; config.vibration_amplitude = 0.5f; }},
+};
+
+double log_span(const std::vector<TickRecord> &ticks) {
+    return ticks.empty() ? 0.0 : static_cast<double>(ticks.back().time_us - ticks.front().time_us) * 1e-6;
+}
+
+CostComparison compare_cost(const std::string &source, const std::vector<TickRecord> &ticks,
+                            const SilConfig &config, int passes) {
+    CostComparison comparison;
+    comparison.source = source;
+    comparison.duration_s = log_span(ticks);
+    comparison.cost[0] = replay_ticks(ticks, BenchController::AIC_MODULE, config, passes);
+    comparison.cost[1] = replay_ticks(ticks, BenchController::AIC_CONTROLLER, config, passes);
+    comparison.cost[2] = replay_ticks(ticks, BenchController::PX4_CASCADE, config, passes);
+    return comparison;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    SilConfig base;
+    base.duration_s = 20.f;
+    int passes = 5;
+    std::string report_path = "aic_bench_report";
+    std::string ticks_path;
+    std::vector<std::string> logs;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:S:n:L:T:o:h")) != -1) {
+        switch (opt) {
+        case 'd': base.duration_s = atof(optarg); break;
+
+        case 'S': base.seed = static_cast<uint32_t>(atoi(optarg)); break;
+
+        case 'n': passes = atoi(optarg); break;
+
+        case 'L': logs.push_back(optarg); break;
+
+        case 'T': ticks_path = optarg; break;
+
+        case 'o': report_path = optarg; break;
+
+        default:
+            fprintf(stderr, "usage: %s [-d duration_s] [-S seed] [-n passes] [-L log.csv]... [-T ticks.csv] "
+                    "[-o report]\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (base.duration_s <= 0.f || passes < 1) {
+        fprintf(stderr, "duration and passes must be positive\n");
+        return 1;
+    }
+
+    BenchReport report;
+    report.passes = passes;
+    std::vector<TickRecord> sil_ticks;
+
+    for (const Scenario &scenario : SCENARIOS) {
+        SilConfig config = base;
+        scenario.apply(config);
+
+        ScenarioComparison comparison;
+        comparison.name = scenario.name;
+        comparison.description = scenario.description;
+        comparison.duration_s = config.duration_s;
+
+        config.controller = SilController::AIC;
+        config.record_ticks = (&scenario == &SCENARIOS[0]);
+        SilSimulator aic(config);
+        comparison.aic = aic.run();
+
+        if (config.record_ticks) {
+            sil_ticks = aic.ticks();
+        }
+
+        config.controller = SilController::PX4_CASCADE;
+        config.record_ticks = false;
+        SilSimulator px4(config);
+        comparison.px4 = px4.run();
+
+        report.scenarios.push_back(comparison);
+
+        const float rad2deg = 180.f / static_cast<float>(M_PI);
+        printf("%-12s attitude rms: aic %.2f deg, px4 %.2f deg; max: aic %.2f deg, px4 %.2f deg\n", scenario.name,
+               (double)(comparison.aic.attitude_rms * rad2deg), (double)(comparison.px4.attitude_rms * rad2deg),
+               (double)(comparison.aic.attitude_max * rad2deg), (double)(comparison.px4.attitude_max * rad2deg));
+    }
+
+    if (!ticks_path.empty() && !write_tick_log(ticks_path, sil_ticks)) {
+        fprintf(stderr, "cannot write %s\n", ticks_path.c_str());
+        return 1;
+    }
+
+    report.costs.push_back(compare_cost(std::string("sil ") + SCENARIOS[0].name, sil_ticks, base, passes));
+
+    for (const std::string &path : logs) {
+        std::vector<TickRecord> ticks;
+        std::string error;
+
+        if (!read_tick_log(path, ticks, error)) {
+            fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+            return 1;
+        }
+
+        report.costs.push_back(compare_cost(path, ticks, base, passes));
+    }
+
+    for (const CostComparison &c : report.costs) {
+        printf("%s (%zu ticks): aic module %.0f ns, aic controller %.0f ns, px4 cascade %.0f ns per tick (mean)\n",
+               c.source.c_str(), c.cost[2].ticks / passes, c.cost[0].ns_mean, c.cost[1].ns_mean, c.cost[2].ns_mean);
+    }
+
+    printf("state: aic module %zu bytes, aic controller %zu bytes, px4 cascade %zu bytes\n",
+           bench_state_bytes(BenchController::AIC_MODULE), bench_state_bytes(BenchController::AIC_CONTROLLER),
+           bench_state_bytes(BenchController::PX4_CASCADE));
+
+    if (!write_json_report(report_path + ".json", report) || !write_markdown_report(report_path + ".md", report)) {
+        fprintf(stderr, "cannot write %s.json/.md\n", report_path.c_str());
+        return 1;
+    }
+
+    printf("report: %s.json, %s.md\n", report_path.c_str(), report_path.c_str());
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file aic_fault_main.cpp
+ * @brief Fault-injection campaign of the AIC module in the multi-rate SIL
+ *
+ * Usage:
+ *   aic_fault [-N runs] [-j threads] [-d duration_s] [-F fork_time_s] [-w fault_window_s] [-s settle_s]
+ *             [-m max_faults] [-k kind,...] [-S seed] [-M quad|hex] [-o runs.csv] [-a]
+ *
+ *   -k  fault kinds: sensor_dropout, dt_spike, stale_setpoint, nan_burst, bit_flip, actuator_loss (default all)
+ *   -o  writes the degraded and lost runs (all runs with -a), one line per fault, for replay by index
+ *
+ * Prints the outcome counts per fault kind and in total. The exit status is
+ * 0 whatever the outcomes; the campaign is a measurement, not a test.
+ */
+
+#include "fault_campaign.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace aic_sil;
+
+static bool parse_kinds(const char *arg, unsigned &kinds) {
+    kinds = 0;
+    std::string list(arg);
+    size_t begin = 0;
+
+    while (begin <= list.size()) {
+        const size_t end = std::min(list.find(',', begin), list.size());
+        const std::string name = list.substr(begin, end - begin);
+        int kind = 0;
+
+        while (kind < FAULT_KINDS && name != fault_kind_name(static_cast<FaultKind>(kind))) {
+            ++kind;
+        }
+
+        if (kind == FAULT_KINDS) {
+            fprintf(stderr, "unknown fault kind '%s'\n", name.c_str());
+            return false;
+        }
+
+        kinds |= 1u << kind;
+        begin = end + 1;
+    }
+
+    return true;
+}
+
+static bool write_runs(const char *path, const std::vector<FaultRun> &runs) {
+    FILE *file = fopen(path, "w");
+
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "run,outcome,evaluation_rms,tilt_max,fallback,diverged,kind,start_s,duration_s,magnitude,target\n");
+
+    for (const FaultRun &run : runs) {
+        for (int f = 0; f < run.fault_count; ++f) {
+            const FaultSpec &fault = run.faults[f];
+            fprintf(file, "%zu,%s,%.5f,%.5f,%d,%d,%s,%.4f,%.4f,%.4f,%u\n", run.index, fault_outcome_name(run.outcome),
+                    (double)run.evaluation_rms, (double)run.tilt_max, run.fallback_active ? 1 : 0,
+                    run.diverged ? 1 : 0, fault_kind_name(fault.kind), (double)fault.start_s,
+                    (double)fault.duration_s, (double)fault.magnitude, (unsigned)fault.target);
+        }
+    }
+
+    return fclose(file) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    FaultCampaignConfig config;
+    config.campaign.runs = 1000;
+    const char *output = nullptr;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "N:j:d:F:w:s:m:k:S:M:o:ah")) != -1) {
+        switch (opt) {
+        case 'N': config.campaign.runs = static_cast<size_t>(atol(optarg)); break;
+
+        case 'j': config.campaign.threads = static_cast<unsigned>(atoi(optarg)); break;
+
+        case 'd': config.campaign.base.duration_s = atof(optarg); break;
+
+        case 'F': config.campaign.fork_time_s = atof(optarg); break;
+
+        case 'w': config.fault_window_s = atof(optarg); break;
+
+        case 's': config.settle_s = atof(optarg); break;
+
+        case 'm': config.max_faults = atoi(optarg); break;
+
+        case 'k':
+            if (!parse_kinds(optarg, config.kinds)) {
+                return 1;
+            }
+
+            break;
+
+        case 'S': config.campaign.base.seed = static_cast<uint32_t>(atoi(optarg)); break;
+
+        case 'M':
+            if (strcmp(optarg, "quad") == 0) {
+                config.campaign.base.module.motor_frame = attitude_controller_aic::MotorFrame::QUAD_X;
+
+            } else if (strcmp(optarg, "hex") == 0) {
+                config.campaign.base.module.motor_frame = attitude_controller_aic::MotorFrame::HEX_X;
+
+            } else {
+                fprintf(stderr, "unknown frame '%s' (quad, hex)\n", optarg);
+                return 1;
+            }
+
+            break;
+
+        case 'o': output = optarg; break;
+
+        case 'a': config.keep_recovered = true; break;
+
+        default:
+            fprintf(stderr, "usage: %s [-N runs] [-j threads] [-d duration_s] [-F fork_time_s] [-w fault_window_s]\n"
+                    "          [-s settle_s] [-m max_faults] [-k kind,...] [-S seed] [-M quad|hex]\n"
+                    "          [-o runs.csv] [-a]\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (config.campaign.runs == 0 || config.campaign.fork_time_s <= 0.f || config.fault_window_s <= 0.f
+        || config.settle_s < 0.f || evaluation_start(config) >= config.campaign.base.duration_s) {
+        fprintf(stderr, "runs must be positive and the scoring must start before the end "
+                "(fork + window + settle < duration)\n");
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const FaultCampaignResult result = run_fault_campaign(config);
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const float rad2deg = 180.f / static_cast<float>(M_PI);
+    printf("%zu runs of %.1f s forked at %.1f s in %.1f s (%.0f runs/s)\n", config.campaign.runs,
+           (double)config.campaign.base.duration_s, (double)config.campaign.fork_time_s, wall_s,
+           config.campaign.runs / wall_s);
+    printf("reference: attitude rms %.2f deg from %.1f s\n", (double)(result.reference.evaluation_rms * rad2deg),
+           (double)evaluation_start(config));
+    printf("%-16s %10s %10s %10s\n", "fault", "recovered", "degraded", "lost");
+
+    for (int kind = 0; kind < FAULT_KINDS; ++kind) {
+        if (config.kinds & (1u << kind)) {
+            const uint64_t *counts = result.outcomes[kind];
+            printf("%-16s %10llu %10llu %10llu\n", fault_kind_name(static_cast<FaultKind>(kind)),
+                   (unsigned long long)counts[0], (unsigned long long)counts[1], (unsigned long long)counts[2]);
+        }
+    }
+
+    printf("%-16s %10llu %10llu %10llu\n", "total", (unsigned long long)result.totals[0],
+           (unsigned long long)result.totals[1], (unsigned long long)result.totals[2]);
+
+    if (output) {
+        if (!write_runs(output, result.runs)) {
+            fprintf(stderr, "failed to write %s\n", output);
+            return 1;
+        }
+
+        printf("%zu runs written to %s\n", result.runs.size(), output);
+    }
+
+    return 0;
+}
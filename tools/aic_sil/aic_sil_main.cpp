@@ -0,0 +1,252 @@
+/**
+ * @file aic_sil_main.cpp
+ * @brief Runs the AIC module tick pipeline against the multi-rate SIL timing model
+ *
+ * Usage:
+ *   aic_sil [-d duration_s] [-g gyro_hz] [-e estimator_hz] [-p setpoint_hz]
+ *           [-l estimator_latency_us,jitter_us] [-a actuator_latency_us,jitter_us]
+ *           [-k spike_prob,spike_us] [-x estimator_dropout] [-y setpoint_dropout]
+ *           [-J Ixx,Iyy,Izz] [-G (governor off)] [-S seed]
+ *           [-V vibration_rad_s,vibration_hz] [-W (vibration gating off)]
+ *           [-M quad|hex] [-K motor,failure_time_s] [-D (failure detection off)]
+ *           [-F fork_time_s -N runs [-j threads]]
+ *
+ * With -F, runs a payload-change campaign: each run forks from the state at
+ * fork_time_s, scales the plant inertia by a factor in [0.8, 1.5] and
+ * reseeds the noise. The campaign is run forked and from scratch and both
+ * wall times are reported.
+ *
+ * With -M, the module allocates to the motors of the frame; -K stops a motor
+ * (0-based) and the detection and reconfiguration latencies are reported.
+ */
+
+#include "sil_campaign.hpp"
+#include "sil_simulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+using namespace aic_sil;
+
+static bool parse_pair(const char *arg, float &a, float &b) {
+    if (sscanf(arg, "%f,%f", &a, &b) != 2) {
+        fprintf(stderr, "invalid pair '%s'\n", arg);
+        return false;
+    }
+
+    return true;
+}
+
+static int run_campaign(const CampaignConfig &campaign) {
+    const Variation payload_change = [&campaign](SilSimulator &sim, size_t i) {
+        // Same inertia factor whichever way the campaign is run
+        std::mt19937 rng(campaign.base.seed * 104729u + static_cast<uint32_t>(i));
+        const float scale = std::uniform_real_distribution<float>(0.8f, 1.5f)(rng);
+        sim.set_plant_inertia(campaign.base.J_true * scale);
+        sim.reseed(campaign.base.seed + 1 + static_cast<uint32_t>(i));
+    };
+
+    auto timed = [&](std::vector<SilResult> (*runner)(const CampaignConfig &, const Variation &),
+                     std::vector<SilResult> &results) {
+        const auto start = std::chrono::steady_clock::now();
+        results = runner(campaign, payload_change);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    std::vector<SilResult> forked, scratch;
+    const double forked_s = timed(run_forked, forked);
+    const double scratch_s = timed(run_from_scratch, scratch);
+
+    float worst_rms = 0.f;
+    uint64_t fallbacks = 0;
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < forked.size(); ++i) {
+        worst_rms = std::max(worst_rms, forked[i].attitude_rms);
+        fallbacks += forked[i].fallback_engaged;
+        mismatches += (forked[i].attitude_rms != scratch[i].attitude_rms) ? 1 : 0;
+    }
+
+    printf("campaign: %zu runs of %.1f s forked at %.1f s\n", campaign.runs, (double)campaign.base.duration_s,
+           (double)campaign.fork_time_s);
+    printf("forked %.3f s, from scratch %.3f s (%.2fx), %zu mismatching runs\n", forked_s, scratch_s,
+           scratch_s / forked_s, mismatches);
+    printf("worst attitude rms %.2f deg, envelope fallbacks %llu\n", (double)(worst_rms * 180.f / (float)M_PI),
+           (unsigned long long)fallbacks);
+    return (mismatches == 0) ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    SilConfig config;
+    CampaignConfig campaign;
+    campaign.fork_time_s = -1.f;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:g:e:p:l:a:k:x:y:J:GS:V:WM:K:DF:N:j:h")) != -1) {
+        switch (opt) {
+        case 'd': config.duration_s = atof(optarg); break;
+
+        case 'g': config.gyro.rate_hz = atof(optarg); break;
+
+        case 'e': config.estimator.rate_hz = atof(optarg); break;
+
+        case 'p': config.setpoint.rate_hz = atof(optarg); break;
+
+        case 'l':
+            if (!parse_pair(optarg, config.estimator.latency.mean_us, config.estimator.latency.jitter_us)) {
+                return 1;
+            }
+
+            break;
+
+        case 'a':
+            if (!parse_pair(optarg, config.actuator.mean_us, config.actuator.jitter_us)) {
+                return 1;
+            }
+
+            break;
+
+        case 'k':
+            if (!parse_pair(optarg, config.scheduling.spike_prob, config.scheduling.spike_us)) {
+                return 1;
+            }
+
+            break;
+
+        case 'x': config.estimator.dropout = atof(optarg); break;
+
+        case 'y': config.setpoint.dropout = atof(optarg); break;
+
+        case 'J': {
+                float Ixx, Iyy, Izz;
+
+                if (sscanf(optarg, "%f,%f,%f", &Ixx, &Iyy, &Izz) != 3) {
+                    fprintf(stderr, "invalid inertia '%s'\n", optarg);
+                    return 1;
+                }
+
+                config.J_true = Vector3f(Ixx, Iyy, Izz);
+                break;
+            }
+
+        case 'G': config.module.governor_enabled = false; break;
+
+        case 'V':
+            if (!parse_pair(optarg, config.vibration_amplitude, config.vibration_hz)) {
+                return 1;
+            }
+
+            break;
+
+        case 'W': config.module.vibration_gating = false; break;
+
+        case 'M':
+            if (strcmp(optarg, "quad") == 0) {
+                config.module.motor_frame = attitude_controller_aic::MotorFrame::QUAD_X;
+
+            } else if (strcmp(optarg, "hex") == 0) {
+                config.module.motor_frame = attitude_controller_aic::MotorFrame::HEX_X;
+
+            } else {
+                fprintf(stderr, "unknown frame '%s' (quad, hex)\n", optarg);
+                return 1;
+            }
+
+            break;
+
+        case 'K': {
+                float motor;
+
+                if (!parse_pair(optarg, motor, config.motor_failure_s)) {
+                    return 1;
+                }
+
+                config.motor_failure = static_cast<int>(motor);
+                break;
+            }
+
+        case 'D': config.module.failure_detection = false; break;
+
+        case 'S': config.seed = static_cast<uint32_t>(atoi(optarg)); break;
+
+        case 'F': campaign.fork_time_s = atof(optarg); break;
+
+        case 'N': campaign.runs = static_cast<size_t>(atoi(optarg)); break;
+
+        case 'j': campaign.threads = static_cast<unsigned>(atoi(optarg)); break;
+
+        default:
+            fprintf(stderr, "usage: %s [-d duration_s] [-g gyro_hz] [-e estimator_hz] [-p setpoint_hz]\n"
+                    "          [-l est_latency_us,jitter_us] [-a act_latency_us,jitter_us]\n"
+                    "          [-k spike_prob,spike_us] [-x est_dropout] [-y sp_dropout]\n"
+                    "          [-J Ixx,Iyy,Izz] [-G] [-S seed] [-V amplitude,hz] [-W]\n"
+                    "          [-M quad|hex] [-K motor,time_s] [-D]\n"
+                    "          [-F fork_time_s -N runs [-j threads]]\n",
+                    argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (config.duration_s <= 0.f || config.gyro.rate_hz <= 0.f || config.estimator.rate_hz <= 0.f
+        || config.setpoint.rate_hz <= 0.f) {
+        fprintf(stderr, "duration and rates must be positive\n");
+        return 1;
+    }
+
+    if (campaign.fork_time_s >= 0.f) {
+        if (campaign.fork_time_s >= config.duration_s || campaign.runs == 0) {
+            fprintf(stderr, "fork time must be before the end and runs positive\n");
+            return 1;
+        }
+
+        campaign.base = config;
+        return run_campaign(campaign);
+    }
+
+    SilSimulator sil(config);
+    const SilResult r = sil.run();
+
+    const float rad2deg = 180.f / static_cast<float>(M_PI);
+    printf("simulated %.1f s in %.3f s (%.0fx real time, %llu events)\n", (double)config.duration_s,
+           r.wall_time_s, r.realtime_factor, (unsigned long long)r.events);
+    printf("attitude error: rms %.2f deg, max %.2f deg (tilt max %.2f deg)\n", (double)(r.attitude_rms * rad2deg),
+           (double)(r.attitude_max * rad2deg), (double)(r.tilt_max * rad2deg));
+    printf("module: %llu wakeups (%llu coalesced), %llu controlled, %llu governor skips\n",
+           (unsigned long long)r.wakeups, (unsigned long long)r.coalesced, (unsigned long long)r.controlled,
+           (unsigned long long)r.skipped);
+    printf("dt: min %.2f ms, mean %.2f ms, max %.2f ms, %llu clamped\n", (double)(r.dt_min * 1e3f),
+           (double)(r.dt_mean * 1e3f), (double)(r.dt_max * 1e3f), (unsigned long long)r.dt_clamped);
+    printf("dropped: gyro %llu, estimator %llu, setpoint %llu; envelope fallbacks %llu\n",
+           (unsigned long long)r.gyro_dropped, (unsigned long long)r.estimator_dropped,
+           (unsigned long long)r.setpoint_dropped, (unsigned long long)r.fallback_engaged);
+    printf("vibration gating: %llu controlled ticks with scaled-down adaptation\n",
+           (unsigned long long)r.adaptation_gated);
+
+    if (r.failure_detected_motor >= 0 && r.detection_latency < 0.f) {
+        printf("false motor failure detection: motor %d\n", r.failure_detected_motor);
+
+    } else if (config.motor_failure >= 0) {
+        printf("motor %d stopped at %.2f s: ", config.motor_failure, (double)config.motor_failure_s);
+
+        if (r.failure_detected_motor >= 0) {
+            printf("detected motor %d after %.1f ms, reduced allocation at the motors %.1f ms later\n",
+                   r.failure_detected_motor, (double)(r.detection_latency * 1e3f),
+                   (double)(r.reconfiguration_latency * 1e3f));
+
+        } else {
+            printf("not detected\n");
+        }
+
+    }
+
+    const Matrix3f J_hat = sil.core().controller().get_inertia_estimate();
+    printf("inertia estimate: [%.4f, %.4f, %.4f] (true [%.4f, %.4f, %.4f])\n", (double)J_hat(0, 0),
+           (double)J_hat(1, 1), (double)J_hat(2, 2), (double)config.J_true(0), (double)config.J_true(1),
+           (double)config.J_true(2));
+    return 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file bench_report.cpp
+ * @brief Side-by-side AIC vs PX4 baseline report (JSON and markdown)
+ */
+
+#include "bench_report.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace aic_sil {
+
+namespace {
+
+const BenchController CONTROLLERS[BENCH_CONTROLLER_COUNT] = {
+    BenchController::AIC_MODULE, BenchController::AIC_CONTROLLER, BenchController::PX4_CASCADE
+};
+
+std::string json_string(const std::string &text) {
+    std::string escaped;
+
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+
+        escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+
+    return escaped;
+}
+
+inline double deg(float rad) {
+    return rad * 180.0 / M_PI;
+}
+
+void write_tracking_json(FILE *f, const char *name, const SilResult &r, bool last) {
+    fprintf(f, "      \"%s\": {\"attitude_rms_deg\": %.4f, \"attitude_max_deg\": %.4f, \"tilt_max_deg\": %.4f, "
+            "\"controlled\": %llu, \"dt_mean_ms\": %.4f, \"envelope_fallbacks\": %llu}%s\n",
+            name, deg(r.attitude_rms), deg(r.attitude_max), deg(r.tilt_max), (unsigned long long)r.controlled,
+            r.dt_mean * 1e3, (unsigned long long)r.fallback_engaged, last ? "" : ",");
+}
+
+void write_cost_json(FILE *f, const char *name, const TickCost &c, bool cycles, bool last) {
+    fprintf(f, "      \"%s\": {\"ticks\": %zu, \"ns_mean\": %.1f, \"ns_p50\": %.1f, \"ns_p99\": %.1f, "
+            "\"ns_max\": %.1f, ", name, c.ticks, c.ns_mean, c.ns_p50, c.ns_p99, c.ns_max);
+
+    if (cycles) {
+        fprintf(f, "\"cycles_mean\": %.1f, \"cycles_p99\": %.1f, ", c.cycles_mean, c.cycles_p99);
+
+    } else {
+        fprintf(f, "\"cycles_mean\": null, \"cycles_p99\": null, ");
+    }
+
+    fprintf(f, "\"torque_rms_nm\": %.6f, \"saturated_fraction\": %.4f}%s\n", (double)c.torque_rms,
+            (double)c.saturated, last ? "" : ",");
+}
+
+double ratio(double a, double b) {
+    return (b > 0.0) ? a / b : 0.0;
+}
+
+} // namespace
+
+bool write_json_report(const std::string &path, const BenchReport &report) {
+    FILE *f = fopen(path.c_str(), "w");
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    const bool cycles = bench_has_cycle_counter();
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"host\": {\"cycle_counter\": %s, \"passes\": %d},\n", cycles ? "\"tsc\"" : "null", report.passes);
+
+    fprintf(f, "  \"memory_bytes\": {");
+
+    for (int i = 0; i < BENCH_CONTROLLER_COUNT; ++i) {
+        fprintf(f, "\"%s\": %zu%s", bench_controller_name(CONTROLLERS[i]), bench_state_bytes(CONTROLLERS[i]),
+                (i + 1 < BENCH_CONTROLLER_COUNT) ? ", " : "");
+    }
+
+    fprintf(f, "},\n");
+
+    fprintf(f, "  \"scenarios\": [\n");
+
+    for (size_t k = 0; k < report.scenarios.size(); ++k) {
+        const ScenarioComparison &s = report.scenarios[k];
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"name\": \"%s\",\n", json_string(s.name).c_str());
+        fprintf(f, "      \"description\": \"%s\",\n", json_string(s.description).c_str());
+        fprintf(f, "      \"duration_s\": %.1f,\n", (double)s.duration_s);
+        write_tracking_json(f, "aic", s.aic, false);
+        write_tracking_json(f, "px4_cascade", s.px4, true);
+        fprintf(f, "    }%s\n", (k + 1 < report.scenarios.size()) ? "," : "");
+    }
+
+    fprintf(f, "  ],\n");
+
+    fprintf(f, "  \"cost\": [\n");
+
+    for (size_t k = 0; k < report.costs.size(); ++k) {
+        const CostComparison &c = report.costs[k];
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"source\": \"%s\",\n", json_string(c.source).c_str());
+        fprintf(f, "      \"duration_s\": %.2f,\n", c.duration_s);
+
+        for (int i = 0; i < BENCH_CONTROLLER_COUNT; ++i) {
+            write_cost_json(f, bench_controller_name(CONTROLLERS[i]), c.cost[i], cycles,
+                            i + 1 == BENCH_CONTROLLER_COUNT);
+        }
+
+        fprintf(f, "    }%s\n", (k + 1 < report.costs.size()) ? "," : "");
+    }
+
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+
+    const bool ok = (ferror(f) == 0);
+    return (fclose(f) == 0) && ok;
+}
+
+bool write_markdown_report(const std::string &path, const BenchReport &report) {
+    FILE *f = fopen(path.c_str(), "w");
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    const bool cycles = bench_has_cycle_counter();
+
+    fprintf(f, "# AIC vs PX4 attitude/rate control\n\n");
+    fprintf(f, "Generated by aic_bench. Tracking is closed loop in the SIL (same timing, noise and seed for "
+            "both controllers); cost is per attitude message on replayed inputs, %d timed passes, on this "
+            "host.\n\n", report.passes);
+
+    fprintf(f, "## Tracking\n\n");
+    fprintf(f, "| Scenario | AIC rms (deg) | PX4 rms (deg) | AIC max (deg) | PX4 max (deg) "
+            "| AIC tilt max (deg) | PX4 tilt max (deg) |\n");
+    fprintf(f, "|---|---:|---:|---:|---:|---:|---:|\n");
+
+    for (const ScenarioComparison &s : report.scenarios) {
+        fprintf(f, "| %s | %.2f | %.2f | %.2f | %.2f | %.2f | %.2f |\n", s.name.c_str(), deg(s.aic.attitude_rms),
+                deg(s.px4.attitude_rms), deg(s.aic.attitude_max), deg(s.px4.attitude_max), deg(s.aic.tilt_max),
+                deg(s.px4.tilt_max));
+    }
+
+    fprintf(f, "\n");
+
+    for (const ScenarioComparison &s : report.scenarios) {
+        fprintf(f, "- **%s**: %s\n", s.name.c_str(), s.description.c_str());
+    }
+
+    fprintf(f, "\n## CPU per tick\n\n");
+    fprintf(f, "| Source | Controller | mean (ns) | p50 (ns) | p99 (ns) | max (ns) | mean (cycles) | p99 (cycles) "
+            "| torque rms (Nm) | saturated |\n");
+    fprintf(f, "|---|---|---:|---:|---:|---:|---:|---:|---:|---:|\n");
+
+    for (const CostComparison &c : report.costs) {
+        for (int i = 0; i < BENCH_CONTROLLER_COUNT; ++i) {
+            const TickCost &t = c.cost[i];
+            fprintf(f, "| %s | %s | %.0f | %.0f | %.0f | %.0f | ", c.source.c_str(),
+                    bench_controller_name(CONTROLLERS[i]), t.ns_mean, t.ns_p50, t.ns_p99, t.ns_max);
+
+            if (cycles) {
+                fprintf(f, "%.0f | %.0f | ", t.cycles_mean, t.cycles_p99);
+
+            } else {
+                fprintf(f, "- | - | ");
+            }
+
+            fprintf(f, "%.4f | %.1f%% |\n", (double)t.torque_rms, (double)(t.saturated * 100.f));
+        }
+    }
+
+    if (!report.costs.empty()) {
+        const CostComparison &c = report.costs.front();
+        fprintf(f, "\nOn %s the AIC module tick costs %.1fx the PX4 cascade (mean), the controller alone %.1fx.\n",
+                c.source.c_str(), ratio(c.cost[0].ns_mean, c.cost[2].ns_mean),
+                ratio(c.cost[1].ns_mean, c.cost[2].ns_mean));
+    }
+
+    fprintf(f, "\n## Memory\n\n");
+    fprintf(f, "| Controller | state (bytes) |\n");
+    fprintf(f, "|---|---:|\n");
+
+    for (int i = 0; i < BENCH_CONTROLLER_COUNT; ++i) {
+        fprintf(f, "| %s | %zu |\n", bench_controller_name(CONTROLLERS[i]), bench_state_bytes(CONTROLLERS[i]));
+    }
+
+    const bool ok = (ferror(f) == 0);
+    return (fclose(f) == 0) && ok;
+}
+
+} // namespace aic_sil
@@ -0,0 +1,56 @@
+/**
+ * @file bench_report.hpp
+ * @brief Side-by-side AIC vs PX4 baseline report (JSON and markdown)
+ *
+ * Closed-loop tracking of both controllers on the same SIL scenarios,
+ * per-tick cost on replayed inputs (SIL recordings and flight logs) and
+ * controller state sizes, written by aic_bench.
+ */
+
+#pragma once
+
+#include "controller_bench.hpp"
+#include "sil_simulator.hpp"
+
+#include <string>
+#include <vector>
+
+namespace aic_sil {
+
+/**
+ * @brief One SIL scenario flown by both controllers
+ */
+struct ScenarioComparison {
+    std::string name;
+    std::string description;
+    float duration_s{0.f};
+    SilResult aic;
+    SilResult px4;
+};
+
+/**
+ * @brief Cost of all controllers on one replayed input sequence
+ */
+struct CostComparison {
+    std::string source;         // Scenario name or log path
+    double duration_s{0.0};     // Span of the replayed log
+    TickCost cost[BENCH_CONTROLLER_COUNT];
+};
+
+struct BenchReport {
+    std::vector<ScenarioComparison> scenarios;
+    std::vector<CostComparison> costs;
+    int passes{0};
+};
+
+/**
+ * @return true on success
+ */
+bool write_json_report(const std::string &path, const BenchReport &report);
+
+/**
+ * @return true on success
+ */
+bool write_markdown_report(const std::string &path, const BenchReport &report);
+
+} // namespace aic_sil
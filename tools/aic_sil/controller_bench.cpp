@@ -0,0 +1,268 @@
+/**
+ * @file controller_bench.cpp
+ * @brief Per-tick CPU cost of the AIC and the PX4 baseline on replayed controller inputs
+ */
+
+#include "controller_bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define AIC_BENCH_TSC 1
+#endif
+
+namespace aic_sil {
+
+using attitude_controller_aic::AICModuleInput;
+
+namespace {
+
+uint64_t read_counter() {
+#ifdef AIC_BENCH_TSC
+    // Keep the read from moving across the timed code
+    _mm_lfence();
+    const uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+uint64_t counter_overhead() {
+    uint64_t best = UINT64_MAX;
+
+    for (int i = 0; i < 1000; ++i) {
+        const uint64_t t0 = read_counter();
+        const uint64_t t1 = read_counter();
+        best = std::min(best, t1 - t0);
+    }
+
+    return best;
+}
+
+double percentile(std::vector<uint64_t> &samples, double p) {
+    const size_t k = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return static_cast<double>(samples[k]);
+}
+
+// Replayed logs carry no message counter: a setpoint differing from the previous one is a new message
+struct SetpointCounter {
+    Quaternionf q_d;
+    uint32_t sequence{0};
+
+    bool update(const Quaternionf &q) {
+        const bool changed = (sequence == 0) || q(0) != q_d(0) || q(1) != q_d(1) || q(2) != q_d(2) || q(3) != q_d(3);
+
+        if (changed) {
+            q_d = q;
+            ++sequence;
+        }
+
+        return changed;
+    }
+};
+
+struct ModuleStep {
+    std::unique_ptr<ModuleCore> core{new ModuleCore()};
+    AICModuleInput input;
+    SetpointCounter setpoint;
+
+    explicit ModuleStep(const SilConfig &config) {
+        SilSimulator::setup_module(*core, config);
+        input.omega_d = Vector3f(0.f, 0.f, 0.f);
+        input.thrust = config.hover_thrust;
+    }
+
+    bool operator()(const TickRecord &tick, Vector3f &tau) {
+        input.q = tick.q;
+        input.omega = tick.omega;
+        input.q_d = tick.q_d;
+        setpoint.update(tick.q_d);
+        input.setpoint_sequence = setpoint.sequence;
+        return core->update(tick.time_us, input, tau).controlled;
+    }
+};
+
+struct ControllerStep {
+    std::unique_ptr<ModuleCore> core{new ModuleCore()};
+    uint64_t last_us{0};
+    SetpointCounter setpoint;
+    Matrix3f R_d;
+
+    explicit ControllerStep(const SilConfig &config) {
+        SilSimulator::setup_module(*core, config);
+    }
+
+    bool operator()(const TickRecord &tick, Vector3f &tau) {
+        // Module dt clamp
+        float dt = (last_us > 0) ? static_cast<float>(tick.time_us - last_us) * 1e-6f : 0.004f;
+        dt = (dt < ModuleCore::MIN_DT) ? ModuleCore::MIN_DT : ((dt > ModuleCore::MAX_DT) ? ModuleCore::MAX_DT : dt);
+        last_us = tick.time_us;
+
+        if (setpoint.update(tick.q_d)) {
+            R_d = tick.q_d.to_dcm();
+        }
+
+        tau = core->controller().compute_torque(tick.q.to_dcm(), tick.omega, R_d, Vector3f::Zero(), Vector3f::Zero(), dt,
+                                                setpoint.sequence);
+        return true;
+    }
+};
+
+struct CascadeStep {
+    Px4CascadeController controller;
+    uint64_t last_us{0};
+
+    explicit CascadeStep(const SilConfig &config) {
+        controller.set_params(config.baseline);
+    }
+
+    bool operator()(const TickRecord &tick, Vector3f &tau) {
+        const float dt = (last_us > 0) ? static_cast<float>(tick.time_us - last_us) * 1e-6f : 0.004f;
+        last_us = tick.time_us;
+        tau = controller.update(tick.q, tick.omega, tick.q_d, dt, false);
+        return true;
+    }
+};
+
+template<typename Step>
+TickCost time_ticks(const std::vector<TickRecord> &ticks, const SilConfig &config, int passes, float tau_max) {
+    TickCost cost;
+
+    if (ticks.empty() || passes < 1) {
+        return cost;
+    }
+
+    const uint64_t overhead = counter_overhead();
+    std::vector<uint64_t> samples;
+    samples.reserve(ticks.size() * passes);
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    const uint64_t counter_start = read_counter();
+    double tau_sq_sum = 0.0;
+    size_t controlled = 0;
+    size_t saturated = 0;
+
+    // Pass 0 warms up and is not timed
+    for (int pass = 0; pass <= passes; ++pass) {
+        Step step(config);
+        const bool last = (pass == passes);
+
+        for (const TickRecord &tick : ticks) {
+            Vector3f tau(0.f, 0.f, 0.f);
+            const uint64_t t0 = read_counter();
+            const bool output = step(tick, tau);
+            const uint64_t t1 = read_counter();
+
+            if (pass > 0) {
+                samples.push_back((t1 - t0 > overhead) ? t1 - t0 - overhead : 0);
+            }
+
+            // Also keeps the torque observable, so the timed call is not optimized away
+            if (last && output) {
+                tau_sq_sum += tau.dot(tau);
+                ++controlled;
+                saturated += (std::fabs(tau(0)) >= tau_max || std::fabs(tau(1)) >= tau_max
+                              || std::fabs(tau(2)) >= tau_max) ? 1 : 0;
+            }
+        }
+    }
+
+    const double wall_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now()
+                           - wall_start).count();
+    const double counter_span = static_cast<double>(read_counter() - counter_start);
+
+#ifdef AIC_BENCH_TSC
+    const double ns_per_count = (counter_span > 0.0) ? wall_ns / counter_span : 0.0;
+#else
+    (void)wall_ns;
+    (void)counter_span;
+    const double ns_per_count = 1.0;
+#endif
+
+    double sum = 0.0;
+
+    for (uint64_t sample : samples) {
+        sum += static_cast<double>(sample);
+    }
+
+    cost.ticks = samples.size();
+    const double mean = sum / samples.size();
+    const double p50 = percentile(samples, 0.5);
+    const double p99 = percentile(samples, 0.99);
+    const double max = static_cast<double>(*std::max_element(samples.begin(), samples.end()));
+
+    cost.ns_mean = mean * ns_per_count;
+    cost.ns_p50 = p50 * ns_per_count;
+    cost.ns_p99 = p99 * ns_per_count;
+    cost.ns_max = max * ns_per_count;
+
+#ifdef AIC_BENCH_TSC
+    cost.cycles_mean = mean;
+    cost.cycles_p99 = p99;
+#endif
+
+    cost.torque_rms = (controlled > 0) ? static_cast<float>(std::sqrt(tau_sq_sum / controlled)) : 0.f;
+    cost.saturated = (controlled > 0) ? static_cast<float>(saturated) / controlled : 0.f;
+    return cost;
+}
+
+} // namespace
+
+const char *bench_controller_name(BenchController controller) {
+    switch (controller) {
+    case BenchController::AIC_MODULE: return "aic_module";
+
+    case BenchController::AIC_CONTROLLER: return "aic_controller";
+
+    case BenchController::PX4_CASCADE: return "px4_cascade";
+    }
+
+    return "unknown";
+}
+
+size_t bench_state_bytes(BenchController controller) {
+    switch (controller) {
+    case BenchController::AIC_MODULE: return sizeof(ModuleCore);
+
+    case BenchController::AIC_CONTROLLER: return sizeof(attitude_controller_aic::AttitudeControllerAIC);
+
+    case BenchController::PX4_CASCADE: return sizeof(Px4CascadeController);
+    }
+
+    return 0;
+}
+
+bool bench_has_cycle_counter() {
+#ifdef AIC_BENCH_TSC
+    return true;
+#else
+    return false;
+#endif
+}
+
+TickCost replay_ticks(const std::vector<TickRecord> &ticks, BenchController controller, const SilConfig &config,
+                      int passes) {
+    switch (controller) {
+    case BenchController::AIC_MODULE:
+        return time_ticks<ModuleStep>(ticks, config, passes, 0.05f);
+
+    case BenchController::AIC_CONTROLLER:
+        return time_ticks<ControllerStep>(ticks, config, passes, 0.05f);
+
+    case BenchController::PX4_CASCADE:
+        return time_ticks<CascadeStep>(ticks, config, passes, config.baseline.torque_max);
+    }
+
+    return TickCost();
+}
+
+} // namespace aic_sil
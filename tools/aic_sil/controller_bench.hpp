@@ -0,0 +1,70 @@
+/**
+ * @file controller_bench.hpp
+ * @brief Per-tick CPU cost of the AIC and the PX4 baseline on replayed controller inputs
+ *
+ * A tick log (recorded from the SIL or read from a flight log) is replayed
+ * open loop through a fresh controller; every tick is timed individually so
+ * the report has the distribution, not just the mean. One untimed pass
+ * warms caches and branch predictors, then the log is replayed `passes`
+ * times. Timer overhead (back-to-back reads) is subtracted.
+ *
+ * On x86 the time stamp counter gives cycles (reference cycles at the
+ * nominal clock, unaffected by frequency scaling); elsewhere only
+ * nanoseconds are reported. These are host numbers: on a flight controller
+ * use the module's "aic: control" perf counter.
+ */
+
+#pragma once
+
+#include "sil_simulator.hpp"
+#include "tick_log.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace aic_sil {
+
+enum class BenchController {
+    AIC_MODULE,         // AICModuleCore::update: governor, controller, monitors (per attitude message)
+    AIC_CONTROLLER,     // compute_torque only
+    PX4_CASCADE,        // Attitude P + rate PID
+};
+
+static constexpr int BENCH_CONTROLLER_COUNT = 3;
+
+struct TickCost {
+    size_t ticks{0};            // Timed ticks (all passes)
+    double ns_mean{0.0};
+    double ns_p50{0.0};
+    double ns_p99{0.0};
+    double ns_max{0.0};
+    double cycles_mean{0.0};    // 0 without a cycle counter
+    double cycles_p99{0.0};
+
+    // Commands over the last pass
+    float torque_rms{0.f};      // Nm
+    float saturated{0.f};       // Fraction of ticks with an axis at the torque limit
+};
+
+const char *bench_controller_name(BenchController controller);
+
+/**
+ * @brief Controller state size (bytes) as instantiated by the module or the flight stack
+ */
+size_t bench_state_bytes(BenchController controller);
+
+/**
+ * @brief True if cycles are measured (x86 time stamp counter)
+ */
+bool bench_has_cycle_counter();
+
+/**
+ * @brief Replay ticks through a fresh controller set up as in the SIL
+ *
+ * @param config controller setup (module settings, initial inertia, baseline gains)
+ * @param passes timed replays of the whole log
+ */
+TickCost replay_ticks(const std::vector<TickRecord> &ticks, BenchController controller, const SilConfig &config,
+                      int passes);
+
+} // namespace aic_sil
@@ -0,0 +1,44 @@
+/**
+ * @file cow_block.hpp
+ * @brief Copy-on-write state block for forkable simulations
+ *
+ * Copying a CowBlock shares the value; the first write() through a copy
+ * that is not the sole owner clones it. A snapshot of a simulation is then
+ * a handful of reference count increments, and each fork only pays for
+ * the blocks it actually modifies.
+ *
+ * Forks of one snapshot may run on different threads: a block is only
+ * modified in place when its owner holds the last reference. A single
+ * CowBlock object must not be copied and written concurrently.
+ */
+
+#pragma once
+
+#include <memory>
+
+namespace aic_sil {
+
+template<typename T>
+class CowBlock {
+public:
+    CowBlock() : value_(std::make_shared<T>()) {}
+    explicit CowBlock(const T &value) : value_(std::make_shared<T>(value)) {}
+
+    const T &read() const { return *value_; }
+    const T *operator->() const { return value_.get(); }
+
+    T &write() {
+        if (value_.use_count() > 1) {
+            value_ = std::make_shared<T>(*value_);
+        }
+
+        return *value_;
+    }
+
+    bool shares_with(const CowBlock &other) const { return value_ == other.value_; }
+
+private:
+    std::shared_ptr<T> value_;
+};
+
+} // namespace aic_sil
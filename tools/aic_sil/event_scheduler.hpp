@@ -0,0 +1,83 @@
+/**
+ * @file event_scheduler.hpp
+ * @brief Discrete-event scheduler on a microsecond time base
+ *
+ * Events run in time order; events due at the same time run in the order
+ * they were scheduled, so a simulation is reproducible for a given seed.
+ *
+ * Events are plain values dispatched to a handler rather than closures, so
+ * a scheduler (and with it a whole simulation) can be copied and forked.
+ *
+ * @tparam Event copyable event payload
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace aic_sil {
+
+template<typename Event>
+class EventScheduler {
+public:
+    /**
+     * @brief Schedule an event at an absolute time (clamped to now)
+     */
+    void schedule(uint64_t time_us, const Event &event) {
+        queue_.push(Entry{std::max(time_us, now_us_), seq_++, event});
+    }
+
+    /**
+     * @brief Run all events due up to and including end_us
+     *
+     * @param handler called as handler(event) with now() at the event time;
+     *                it may schedule further events
+     * @return number of events run
+     */
+    template<typename Handler>
+    uint64_t run_until(uint64_t end_us, Handler &&handler) {
+        uint64_t count = 0;
+
+        while (!queue_.empty() && queue_.top().time_us <= end_us) {
+            const Entry entry = queue_.top();
+            queue_.pop();
+
+            now_us_ = entry.time_us;
+            handler(entry.event);
+            ++count;
+        }
+
+        now_us_ = std::max(now_us_, end_us);
+        processed_ += count;
+        return count;
+    }
+
+    uint64_t now() const { return now_us_; }
+    uint64_t processed() const { return processed_; }
+    size_t pending() const { return queue_.size(); }
+
+private:
+    struct Entry {
+        uint64_t time_us;
+        uint64_t seq;
+        Event event;
+    };
+
+    struct Later {
+        bool operator()(const Entry &a, const Entry &b) const {
+            return (a.time_us != b.time_us) ? a.time_us > b.time_us : a.seq > b.seq;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, Later> queue_;
+    uint64_t now_us_{0};
+    uint64_t seq_{0};
+    uint64_t processed_{0};
+};
+
+} // namespace aic_sil
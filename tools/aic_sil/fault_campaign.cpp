@@ -0,0 +1,149 @@
+/**
+ * @file fault_campaign.cpp
+ * @brief Fault-injection campaigns: many forked runs with random faults, outcomes classified
+ */
+
+#include "fault_campaign.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace aic_sil {
+
+namespace {
+
+/**
+ * @brief Duration and magnitude ranges a fault of each kind is drawn from
+ */
+struct FaultRange {
+    float min_duration_s;
+    float max_duration_s;
+    float min_magnitude;
+    float max_magnitude;
+    bool signed_magnitude;
+};
+
+constexpr FaultRange FAULT_RANGES[FAULT_KINDS] = {
+    {0.05f, 0.5f, 0.f, 0.f, false},     // SENSOR_DROPOUT
+    {0.05f, 0.5f, 0.1f, 1.f, true},     // DT_SPIKE: clock offset (s), past MAX_DT
+    {0.1f, 1.f, 0.f, 0.f, false},       // STALE_SETPOINT
+    {0.004f, 0.1f, 0.f, 0.f, false},    // NAN_BURST
+    {0.f, 0.f, 0.f, 0.f, false},        // STATE_BIT_FLIP
+    {0.05f, 0.5f, 0.2f, 1.f, false},    // ACTUATOR_LOSS: lost share
+};
+
+} // namespace
+
+int draw_faults(const FaultCampaignConfig &config, size_t index, FaultSpec faults[MAX_RUN_FAULTS]) {
+    FaultKind kinds[FAULT_KINDS];
+    int kind_count = 0;
+
+    for (int k = 0; k < FAULT_KINDS; ++k) {
+        if (config.kinds & (1u << k)) {
+            kinds[kind_count++] = static_cast<FaultKind>(k);
+        }
+    }
+
+    if (kind_count == 0) {
+        return 0;
+    }
+
+    // Own generator per run: the same scenario however the runs are spread over the threads
+    std::mt19937 rng(config.campaign.base.seed * 15485863u + static_cast<uint32_t>(index));
+    auto uniform = [&rng](float a, float b) { return std::uniform_real_distribution<float>(a, b)(rng); };
+
+    const int max_faults = std::max(1, std::min(config.max_faults, MAX_RUN_FAULTS));
+    const int count = std::uniform_int_distribution<int>(1, max_faults)(rng);
+
+    for (int f = 0; f < count; ++f) {
+        FaultSpec &fault = faults[f];
+        fault.kind = kinds[std::uniform_int_distribution<int>(0, kind_count - 1)(rng)];
+
+        const FaultRange &range = FAULT_RANGES[static_cast<int>(fault.kind)];
+        fault.duration_s = std::min(uniform(range.min_duration_s, range.max_duration_s), config.fault_window_s);
+        fault.start_s = config.campaign.fork_time_s + uniform(0.f, config.fault_window_s - fault.duration_s);
+        fault.magnitude = uniform(range.min_magnitude, range.max_magnitude);
+
+        if (range.signed_magnitude && rng() % 2 == 0) {
+            fault.magnitude = -fault.magnitude;
+        }
+
+        fault.target = static_cast<uint32_t>(rng());
+    }
+
+    return count;
+}
+
+FaultOutcome classify(const SilResult &result, const SilResult &reference, const OutcomeThresholds &thresholds) {
+    if (result.diverged || !std::isfinite(result.evaluation_rms) || result.tilt_max > thresholds.lost_tilt
+        || result.evaluation_rms > thresholds.lost_rms) {
+        return FaultOutcome::LOST;
+    }
+
+    if (result.fallback_active
+        || result.evaluation_rms > thresholds.degraded_ratio * reference.evaluation_rms + thresholds.degraded_margin) {
+        return FaultOutcome::DEGRADED;
+    }
+
+    return FaultOutcome::RECOVERED;
+}
+
+FaultCampaignResult run_fault_campaign(const FaultCampaignConfig &config) {
+    FaultCampaignResult result;
+
+    CampaignConfig chunk = config.campaign;
+    chunk.base.evaluation_start_s = evaluation_start(config);
+
+    // Reference: the prefix every run forks from, run on to the end without faults
+    SilSimulator prefix(chunk.base);
+    prefix.run_until(chunk.fork_time_s);
+    result.reference = prefix.run();
+
+    // Chunks bound the per-run results held at once (campaigns of millions of runs)
+    for (size_t first = 0; first < config.campaign.runs; first += FAULT_CHUNK_RUNS) {
+        chunk.runs = std::min(FAULT_CHUNK_RUNS, config.campaign.runs - first);
+        std::vector<FaultRun> runs(chunk.runs);
+
+        const std::vector<SilResult> results = run_forked(chunk, [&](SilSimulator &sim, size_t i) {
+            FaultRun &run = runs[i];
+            run.index = first + i;
+            run.fault_count = draw_faults(config, run.index, run.faults);
+
+            for (int f = 0; f < run.fault_count; ++f) {
+                sim.inject_fault(run.faults[f]);
+            }
+        });
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            FaultRun &run = runs[i];
+            const SilResult &r = results[i];
+            run.outcome = classify(r, result.reference, config.thresholds);
+            run.evaluation_rms = r.evaluation_rms;
+            run.tilt_max = r.tilt_max;
+            run.fallback_active = r.fallback_active;
+            run.diverged = r.diverged;
+
+            const int outcome = static_cast<int>(run.outcome);
+            ++result.totals[outcome];
+            bool counted[FAULT_KINDS] {};
+
+            for (int f = 0; f < run.fault_count; ++f) {
+                const int kind = static_cast<int>(run.faults[f].kind);
+
+                if (!counted[kind]) {
+                    counted[kind] = true;
+                    ++result.outcomes[kind][outcome];
+                }
+            }
+
+            if (config.keep_recovered || run.outcome != FaultOutcome::RECOVERED) {
+                result.runs.push_back(run);
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace aic_sil
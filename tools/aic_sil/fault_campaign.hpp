@@ -0,0 +1,103 @@
+/**
+ * @file fault_campaign.hpp
+ * @brief Fault-injection campaigns: many forked runs with random faults, outcomes classified
+ *
+ * Every run forks from the fault-free prefix at fork_time_s and gets 1 to
+ * max_faults faults drawn from the enabled kinds (fault_model.hpp), all
+ * starting and ending within the fault window after the fork. A scenario is
+ * a function of the campaign seed and the run index only, so any run can be
+ * replayed by index, and the random streams of the simulation are left
+ * alone: a run differs from the fault-free reference continuation by its
+ * faults only.
+ *
+ * Tracking is scored from settle_s after the fault window to the end and
+ * compared with the reference:
+ *
+ *   LOST       the plant state went non-finite, the tilt exceeded lost_tilt at any time,
+ *              or the scored attitude error rms exceeds lost_rms
+ *   DEGRADED   the envelope fallback is still latched, or the scored rms exceeds
+ *              degraded_ratio * reference + degraded_margin
+ *   RECOVERED  otherwise
+ */
+
+#pragma once
+
+#include "sil_campaign.hpp"
+
+#include <vector>
+
+namespace aic_sil {
+
+static constexpr int MAX_RUN_FAULTS = 4;
+static constexpr size_t FAULT_CHUNK_RUNS = 4096;    // Runs forked and held at once
+
+enum class FaultOutcome : uint8_t { RECOVERED, DEGRADED, LOST };
+
+static constexpr int FAULT_OUTCOMES = 3;
+
+inline const char *fault_outcome_name(FaultOutcome outcome) {
+    switch (outcome) {
+    case FaultOutcome::RECOVERED: return "recovered";
+
+    case FaultOutcome::DEGRADED: return "degraded";
+
+    case FaultOutcome::LOST: return "lost";
+    }
+
+    return "unknown";
+}
+
+struct OutcomeThresholds {
+    float lost_tilt{1.2f};          // rad
+    float lost_rms{0.3f};           // rad
+    float degraded_ratio{1.5f};
+    float degraded_margin{0.005f};  // rad
+};
+
+struct FaultCampaignConfig {
+    CampaignConfig campaign;        // base.duration_s must leave time after the settling
+    unsigned kinds{(1u << FAULT_KINDS) - 1};   // Bit per FaultKind
+    int max_faults{1};              // Faults per run: 1..max_faults (at most MAX_RUN_FAULTS)
+    float fault_window_s{3.f};      // Faults within [fork_time_s, fork_time_s + fault_window_s]
+    float settle_s{3.f};            // Scoring starts this long after the fault window
+    OutcomeThresholds thresholds;
+    bool keep_recovered{false};     // Keep every run in the result, not only the degraded and lost ones
+};
+
+struct FaultRun {
+    size_t index{0};                // Run number (draw_faults())
+    FaultSpec faults[MAX_RUN_FAULTS];
+    int fault_count{0};
+    FaultOutcome outcome{FaultOutcome::RECOVERED};
+    float evaluation_rms{0.f};      // rad
+    float tilt_max{0.f};            // rad
+    bool fallback_active{false};
+    bool diverged{false};
+};
+
+struct FaultCampaignResult {
+    SilResult reference;            // Fault-free continuation
+    std::vector<FaultRun> runs;     // By index; recovered runs only with keep_recovered
+    uint64_t outcomes[FAULT_KINDS][FAULT_OUTCOMES]{};   // Runs with a fault of the kind, by outcome
+    uint64_t totals[FAULT_OUTCOMES]{};
+};
+
+/**
+ * @brief Start of the scoring of every run (fork + fault window + settling)
+ */
+inline float evaluation_start(const FaultCampaignConfig &config) {
+    return config.campaign.fork_time_s + config.fault_window_s + config.settle_s;
+}
+
+/**
+ * @brief Faults of run index (deterministic in the campaign seed and the index)
+ *
+ * @return number of faults written (0 if no kind is enabled)
+ */
+int draw_faults(const FaultCampaignConfig &config, size_t index, FaultSpec faults[MAX_RUN_FAULTS]);
+
+FaultOutcome classify(const SilResult &result, const SilResult &reference, const OutcomeThresholds &thresholds);
+
+FaultCampaignResult run_fault_campaign(const FaultCampaignConfig &config);
+
+} // namespace aic_sil
@@ -0,0 +1,67 @@
+/**
+ * @file fault_model.hpp
+ * @brief Faults injected into the SIL: the module's inputs, its clock, the estimator state and the actuators
+ *
+ * A fault is active over [start_s, start_s + duration_s):
+ *
+ *   SENSOR_DROPOUT  no attitude message reaches the module (dt beyond MAX_DT on the next tick)
+ *   DT_SPIKE        the module clock is offset by magnitude seconds (a timestamp glitch: dt jumps by the
+ *                   offset when the fault starts and back when it ends, past the clamp either way)
+ *   STALE_SETPOINT  no setpoint message is delivered, the module keeps the last one
+ *   NAN_BURST       the attitude messages carry NaN attitude and rates
+ *   STATE_BIT_FLIP  one bit of the estimator state (theta, then P) flips at start_s; target = word * 32 + bit
+ *   ACTUATOR_LOSS   the torque reaching the plant is scaled by 1 - magnitude; with a motor frame only the
+ *                   thrust of motor target (modulo the motor count) is
+ *
+ * The clock fault only applies to AICModuleCore; the PX4 baseline keeps the
+ * simulation clock.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace aic_sil {
+
+enum class FaultKind : uint8_t {
+    SENSOR_DROPOUT,
+    DT_SPIKE,
+    STALE_SETPOINT,
+    NAN_BURST,
+    STATE_BIT_FLIP,
+    ACTUATOR_LOSS,
+};
+
+static constexpr int FAULT_KINDS = 6;
+
+struct FaultSpec {
+    FaultKind kind{FaultKind::SENSOR_DROPOUT};
+    float start_s{0.f};
+    float duration_s{0.f};
+    float magnitude{0.f};       // Clock offset (s) or lost torque share [0, 1]
+    uint32_t target{0};         // Estimator state bit or motor
+
+    uint64_t start_us() const { return static_cast<uint64_t>(static_cast<double>(start_s) * 1e6); }
+    uint64_t end_us() const { return static_cast<uint64_t>((static_cast<double>(start_s) + duration_s) * 1e6); }
+    bool active(uint64_t now) const { return now >= start_us() && now < end_us(); }
+};
+
+inline const char *fault_kind_name(FaultKind kind) {
+    switch (kind) {
+    case FaultKind::SENSOR_DROPOUT: return "sensor_dropout";
+
+    case FaultKind::DT_SPIKE: return "dt_spike";
+
+    case FaultKind::STALE_SETPOINT: return "stale_setpoint";
+
+    case FaultKind::NAN_BURST: return "nan_burst";
+
+    case FaultKind::STATE_BIT_FLIP: return "bit_flip";
+
+    case FaultKind::ACTUATOR_LOSS: return "actuator_loss";
+    }
+
+    return "unknown";
+}
+
+} // namespace aic_sil
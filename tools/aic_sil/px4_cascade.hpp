@@ -0,0 +1,256 @@
+/**
+ * @file px4_cascade.hpp
+ * @brief Stock PX4 multicopter attitude and rate controller math as a SIL baseline
+ *
+ * Same control laws as PX4's AttitudeControl (mc_att_control) and
+ * RateControl (mc_rate_control), so the AIC can be compared against what
+ * the flight stack would fly on identical scenarios:
+ *
+ *   attitude: reduced (tilt-first) attitude error with yaw weight,
+ *             rate_sp = P .* 2 * imag(q^-1 * q_d), clamped to the rate limits
+ *   rate:     u = P .* e + I_int - D .* d(Omega)/dt + FF .* rate_sp,
+ *             integral scaled by (1 - (e / 400 deg/s)^2), frozen towards
+ *             saturation and clamped to the integrator limit
+ *
+ * The PX4 sources are not compiled in because RateControl depends on the
+ * generated uORB headers; only the math is reproduced. Differences:
+ * - angular acceleration is the message-to-message rate difference through
+ *   a one-pole low-pass (PX4 differentiates the gyro at sensor rate through
+ *   a second-order filter at IMU_DGYRO_CUTOFF),
+ * - saturation flags come from the normalized output leaving [-1, 1] (PX4
+ *   gets them from the control allocator),
+ * - the normalized output is scaled by torque_max, the same mapping the AIC
+ *   module uses for actuator controls.
+ *
+ * The default gains are not PX4's (those are tuned for normalized outputs of
+ * a typical airframe): they give the cascade the same stiffness and damping
+ * as the AIC's PD and composite terms (K_R + K*c, K_Omega + K) at
+ * torque_max, so the comparison isolates what the adaptive feedforward,
+ * robust term and observer add.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace aic_sil {
+
+using Vector3f = matrix::Vector3f;
+using Quaternionf = matrix::Quaternionf;
+
+/**
+ * @brief MC_*_P, MC_YAW_WEIGHT, MC_*RATE_MAX and MC_*RATE_* equivalents
+ */
+struct Px4CascadeParams {
+    Vector3f attitude_p{13.f, 13.f, 10.7f};    // MC_ROLL_P, MC_PITCH_P, MC_YAW_P (1/s)
+    float yaw_weight{0.4f};                    // MC_YAW_WEIGHT
+    Vector3f rate_limit{3.84f, 3.84f, 3.49f};  // MC_ROLLRATE_MAX ... (220, 220, 200 deg/s)
+    Vector3f rate_p{8.f, 8.f, 6.f};            // Normalized output per rad/s
+    Vector3f rate_i{10.f, 10.f, 8.f};
+    Vector3f rate_d{0.1f, 0.1f, 0.f};
+    Vector3f rate_ff{0.f, 0.f, 0.f};
+    Vector3f integrator_limit{0.3f, 0.3f, 0.3f}; // MC_RR_INT_LIM ...
+    float dgyro_cutoff_hz{30.f};               // IMU_DGYRO_CUTOFF
+    float torque_max{0.05f};                   // Torque at normalized output 1 (Nm)
+};
+
+/**
+ * @class Px4CascadeController
+ * @brief Attitude P -> rate PID cascade, one update per attitude message
+ */
+class Px4CascadeController {
+public:
+    static constexpr float MIN_DT = 0.000125f;    // mc_rate_control dt bounds
+    static constexpr float MAX_DT = 0.02f;
+
+    Px4CascadeController() {
+        set_params(Px4CascadeParams());
+        reset();
+    }
+
+    void set_params(const Px4CascadeParams &params) {
+        params_ = params;
+        yaw_w_ = std::min(std::max(params.yaw_weight, 0.f), 1.f);
+        attitude_p_ = params.attitude_p;
+
+        // Compensate for the yaw weight rescaling the output (AttitudeControl::setProportionalGain)
+        if (yaw_w_ > 1e-4f) {
+            attitude_p_(2) /= yaw_w_;
+        }
+    }
+
+    void reset() {
+        rate_int_ = Vector3f(0.f, 0.f, 0.f);
+        rate_prev_ = Vector3f(0.f, 0.f, 0.f);
+        angular_accel_ = Vector3f(0.f, 0.f, 0.f);
+        rate_sp_ = Vector3f(0.f, 0.f, 0.f);
+        has_prev_ = false;
+
+        for (int i = 0; i < 3; ++i) {
+            saturation_positive_[i] = false;
+            saturation_negative_[i] = false;
+        }
+    }
+
+    /**
+     * @brief One attitude message
+     *
+     * @param q attitude
+     * @param omega body rates (rad/s)
+     * @param q_d attitude setpoint
+     * @param dt time since the previous update (s), clamped to [MIN_DT, MAX_DT]
+     * @param landed integrator frozen
+     * @return torque (Nm)
+     */
+    Vector3f update(const Quaternionf &q, const Vector3f &omega, const Quaternionf &q_d, float dt, bool landed) {
+        dt = (dt < MIN_DT) ? MIN_DT : ((dt > MAX_DT) ? MAX_DT : dt);
+        rate_sp_ = attitude_update(q, q_d);
+
+        if (has_prev_) {
+            const float k = dt / (dt + 1.f / (2.f * static_cast<float>(M_PI) * params_.dgyro_cutoff_hz));
+            angular_accel_ += ((omega - rate_prev_) / dt - angular_accel_) * k;
+        }
+
+        rate_prev_ = omega;
+        has_prev_ = true;
+
+        Vector3f rate_error = rate_sp_ - omega;
+        Vector3f tau;
+
+        for (int i = 0; i < 3; ++i) {
+            const float u = params_.rate_p(i) * rate_error(i) + rate_int_(i) - params_.rate_d(i) * angular_accel_(i)
+                            + params_.rate_ff(i) * rate_sp_(i);
+            saturation_positive_[i] = u >= 1.f;
+            saturation_negative_[i] = u <= -1.f;
+            tau(i) = std::min(std::max(u, -1.f), 1.f) * params_.torque_max;
+        }
+
+        if (!landed) {
+            update_integral(rate_error, dt);
+        }
+
+        return tau;
+    }
+
+    const Vector3f &get_rate_setpoint() const { return rate_sp_; }
+    const Vector3f &get_integrator() const { return rate_int_; }
+
+private:
+    Vector3f attitude_update(const Quaternionf &q, const Quaternionf &q_d_full) const {
+        // Reduced desired attitude neglecting yaw, to prioritize roll and pitch
+        const Vector3f e_z = dcm_z(q);
+        const Vector3f e_z_d = dcm_z(q_d_full);
+        Quaternionf qd_red = shortest_rotation(e_z, e_z_d);
+
+        if (std::fabs(qd_red(1)) > (1.f - 1e-5f) || std::fabs(qd_red(2)) > (1.f - 1e-5f)) {
+            qd_red = q_d_full;
+
+        } else {
+            qd_red = product(qd_red, q);
+        }
+
+        // Mix full and reduced desired attitude
+        Quaternionf q_mix = canonical(product(conjugate(qd_red), q_d_full));
+        q_mix(0) = std::min(std::max(q_mix(0), -1.f), 1.f);
+        q_mix(3) = std::min(std::max(q_mix(3), -1.f), 1.f);
+        const Quaternionf qd = product(qd_red, Quaternionf(std::cos(yaw_w_ * std::acos(q_mix(0))), 0.f, 0.f,
+                                                           std::sin(yaw_w_ * std::asin(q_mix(3)))));
+
+        // sin(alpha/2)-scaled rotation axis from q to qd as the attitude error
+        const Quaternionf qe = canonical(product(conjugate(q), qd));
+        Vector3f rate_sp;
+
+        for (int i = 0; i < 3; ++i) {
+            rate_sp(i) = 2.f * qe(i + 1) * attitude_p_(i);
+            rate_sp(i) = std::min(std::max(rate_sp(i), -params_.rate_limit(i)), params_.rate_limit(i));
+        }
+
+        return rate_sp;
+    }
+
+    void update_integral(Vector3f &rate_error, float dt) {
+        for (int i = 0; i < 3; ++i) {
+            // Prevent further saturation
+            if (saturation_positive_[i]) {
+                rate_error(i) = std::min(rate_error(i), 0.f);
+            }
+
+            if (saturation_negative_[i]) {
+                rate_error(i) = std::max(rate_error(i), 0.f);
+            }
+
+            // Reduce the I gain with increasing rate error (bounce-back after large setpoint changes)
+            float i_factor = rate_error(i) / (400.f * static_cast<float>(M_PI) / 180.f);
+            i_factor = std::max(0.f, 1.f - i_factor * i_factor);
+
+            const float rate_i = rate_int_(i) + i_factor * params_.rate_i(i) * rate_error(i) * dt;
+
+            if (std::isfinite(rate_i)) {
+                rate_int_(i) = std::min(std::max(rate_i, -params_.integrator_limit(i)), params_.integrator_limit(i));
+            }
+        }
+    }
+
+    static Quaternionf product(const Quaternionf &a, const Quaternionf &b) {
+        return Quaternionf(a(0) * b(0) - a(1) * b(1) - a(2) * b(2) - a(3) * b(3),
+                           a(0) * b(1) + a(1) * b(0) + a(2) * b(3) - a(3) * b(2),
+                           a(0) * b(2) - a(1) * b(3) + a(2) * b(0) + a(3) * b(1),
+                           a(0) * b(3) + a(1) * b(2) - a(2) * b(1) + a(3) * b(0));
+    }
+
+    static Quaternionf conjugate(const Quaternionf &q) {
+        return Quaternionf(q(0), -q(1), -q(2), -q(3));
+    }
+
+    static Quaternionf canonical(const Quaternionf &q) {
+        return (q(0) < 0.f) ? Quaternionf(-q(0), -q(1), -q(2), -q(3)) : q;
+    }
+
+    static Vector3f dcm_z(const Quaternionf &q) {
+        return Vector3f(2.f * (q(0) * q(2) + q(1) * q(3)), 2.f * (q(2) * q(3) - q(0) * q(1)),
+                        q(0) * q(0) - q(1) * q(1) - q(2) * q(2) + q(3) * q(3));
+    }
+
+    /**
+     * @brief Shortest rotation from src to dst (matrix::Quaternion(src, dst))
+     */
+    static Quaternionf shortest_rotation(const Vector3f &src, const Vector3f &dst) {
+        Vector3f cr = src.cross(dst);
+        const float dt = src.dot(dst);
+        float w;
+
+        if (cr.norm() < 1e-5f && dt < 0.f) {
+            // Opposite vectors: rotate half a turn about the axis least aligned with src
+            const float ax = std::fabs(src(0));
+            const float ay = std::fabs(src(1));
+            const float az = std::fabs(src(2));
+            Vector3f axis = (ax < ay) ? ((ax < az) ? Vector3f(1.f, 0.f, 0.f) : Vector3f(0.f, 0.f, 1.f))
+                            : ((ay < az) ? Vector3f(0.f, 1.f, 0.f) : Vector3f(0.f, 0.f, 1.f));
+            cr = src.cross(axis);
+            w = 0.f;
+
+        } else {
+            w = dt + std::sqrt(src.dot(src) * dst.dot(dst));
+        }
+
+        const float norm = std::sqrt(w * w + cr.dot(cr));
+        return Quaternionf(w / norm, cr(0) / norm, cr(1) / norm, cr(2) / norm);
+    }
+
+    Px4CascadeParams params_;
+    Vector3f attitude_p_;       // Yaw compensated for the yaw weight
+    float yaw_w_{0.4f};
+
+    Vector3f rate_int_;
+    Vector3f rate_prev_;
+    Vector3f angular_accel_;    // Filtered rate derivative (rad/s^2)
+    Vector3f rate_sp_;
+    bool has_prev_{false};
+    bool saturation_positive_[3];
+    bool saturation_negative_[3];
+};
+
+} // namespace aic_sil
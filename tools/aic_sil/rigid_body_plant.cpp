@@ -0,0 +1,107 @@
+/**
+ * @file rigid_body_plant.cpp
+ * @brief Rigid-body rotational dynamics, advanced lazily to event times
+ */
+
+#include "rigid_body_plant.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aic_sil {
+
+RigidBodyPlant::RigidBodyPlant(const Vector3f &J_diag, uint64_t step_us) :
+    J_(J_diag), step_us_(std::max<uint64_t>(step_us, 1)) {
+    q_ = Quaternionf(1.f, 0.f, 0.f, 0.f);
+    Omega_ = Vector3f(0.f, 0.f, 0.f);
+    tau_ = Vector3f(0.f, 0.f, 0.f);
+    disturbance_ = Vector3f(0.f, 0.f, 0.f);
+}
+
+void RigidBodyPlant::set_state(const Quaternionf &q, const Vector3f &Omega) {
+    q_ = q;
+    Omega_ = Omega;
+}
+
+void RigidBodyPlant::advance_to(uint64_t time_us) {
+    while (time_us_ < time_us) {
+        const uint64_t h = std::min(step_us_, time_us - time_us_);
+        integrate(static_cast<float>(h) * 1e-6f);
+        time_us_ += h;
+    }
+}
+
+RigidBodyPlant::State RigidBodyPlant::derivative(const State &x) const {
+    State dx;
+    const float *w = x.w;
+    const float *q = x.q;
+
+    // Euler's equations, principal axes
+    const float Jw[3] = {J_(0) * w[0], J_(1) * w[1], J_(2) * w[2]};
+    const float gyro[3] = {
+        w[1] * Jw[2] - w[2] * Jw[1],
+        w[2] * Jw[0] - w[0] * Jw[2],
+        w[0] * Jw[1] - w[1] * Jw[0],
+    };
+
+    for (int i = 0; i < 3; ++i) {
+        dx.w[i] = (tau_(i) + disturbance_(i) - gyro[i]) / J_(i);
+    }
+
+    // Quaternion kinematics with body rates (Hamilton, scalar first)
+    dx.q[0] = 0.5f * (-q[1] * w[0] - q[2] * w[1] - q[3] * w[2]);
+    dx.q[1] = 0.5f * (q[0] * w[0] + q[2] * w[2] - q[3] * w[1]);
+    dx.q[2] = 0.5f * (q[0] * w[1] + q[3] * w[0] - q[1] * w[2]);
+    dx.q[3] = 0.5f * (q[0] * w[2] + q[1] * w[1] - q[2] * w[0]);
+    return dx;
+}
+
+void RigidBodyPlant::integrate(float dt) {
+    State x;
+
+    for (int i = 0; i < 4; ++i) {
+        x.q[i] = q_(i);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        x.w[i] = Omega_(i);
+    }
+
+    auto axpy = [](const State &a, float s, const State &b) {
+        State r;
+
+        for (int i = 0; i < 4; ++i) {
+            r.q[i] = a.q[i] + s * b.q[i];
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            r.w[i] = a.w[i] + s * b.w[i];
+        }
+
+        return r;
+    };
+
+    const State k1 = derivative(x);
+    const State k2 = derivative(axpy(x, 0.5f * dt, k1));
+    const State k3 = derivative(axpy(x, 0.5f * dt, k2));
+    const State k4 = derivative(axpy(x, dt, k3));
+
+    float norm = 0.f;
+
+    for (int i = 0; i < 4; ++i) {
+        x.q[i] += dt / 6.f * (k1.q[i] + 2.f * k2.q[i] + 2.f * k3.q[i] + k4.q[i]);
+        norm += x.q[i] * x.q[i];
+    }
+
+    norm = std::sqrt(norm);
+
+    for (int i = 0; i < 4; ++i) {
+        q_(i) = x.q[i] / norm;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        Omega_(i) = x.w[i] + dt / 6.f * (k1.w[i] + 2.f * k2.w[i] + 2.f * k3.w[i] + k4.w[i]);
+    }
+}
+
+} // namespace aic_sil
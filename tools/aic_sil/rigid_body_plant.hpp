@@ -0,0 +1,67 @@
+/**
+ * @file rigid_body_plant.hpp
+ * @brief Rigid-body rotational dynamics, advanced lazily to event times
+ *
+ *   J * dot_Omega = tau + d - Omega x (J * Omega)
+ *   dot_q = 0.5 * q * [0, Omega]
+ *
+ * integrated with RK4 at a fixed internal step between events. The torque
+ * is piecewise constant: it changes only when an actuator command lands.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+
+#include <cstdint>
+
+namespace aic_sil {
+
+using Vector3f = matrix::Vector3f;
+using Matrix3f = matrix::Matrix3f;
+using Quaternionf = matrix::Quaternionf;
+
+class RigidBodyPlant {
+public:
+    /**
+     * @param J_diag principal inertia (kg*m^2)
+     * @param step_us internal integration step
+     */
+    RigidBodyPlant(const Vector3f &J_diag, uint64_t step_us = 100);
+
+    /**
+     * @brief Integrate up to time_us (no-op if already there)
+     */
+    void advance_to(uint64_t time_us);
+
+    void set_inertia(const Vector3f &J_diag) { J_ = J_diag; }
+    void set_torque(const Vector3f &tau) { tau_ = tau; }
+    void set_disturbance(const Vector3f &d) { disturbance_ = d; }
+    void set_state(const Quaternionf &q, const Vector3f &Omega);
+
+    uint64_t time() const { return time_us_; }
+    const Vector3f &inertia() const { return J_; }
+    const Quaternionf &attitude() const { return q_; }
+    const Vector3f &angular_velocity() const { return Omega_; }
+    const Vector3f &torque() const { return tau_; }
+
+private:
+    struct State {
+        float q[4];
+        float w[3];
+    };
+
+    State derivative(const State &x) const;
+    void integrate(float dt);
+
+    Vector3f J_;
+    uint64_t step_us_;
+    uint64_t time_us_{0};
+
+    Quaternionf q_;
+    Vector3f Omega_;
+    Vector3f tau_;
+    Vector3f disturbance_;
+};
+
+} // namespace aic_sil
@@ -0,0 +1,70 @@
+/**
+ * @file sil_campaign.cpp
+ * @brief Monte Carlo campaigns of SIL continuations sharing a warm-up prefix
+ */
+
+#include "sil_campaign.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace aic_sil {
+
+namespace {
+
+template<typename Job>
+void parallel_for(size_t count, unsigned threads, const Job &job) {
+    const unsigned workers = (threads > 0) ? threads : std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            job(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 1; t < std::min<size_t>(workers, count); ++t) {
+        pool.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+std::vector<SilResult> run_forked(const CampaignConfig &config, const Variation &variation) {
+    SilSimulator prefix(config.base);
+    prefix.run_until(config.fork_time_s);
+
+    std::vector<SilResult> results(config.runs);
+
+    parallel_for(config.runs, config.threads, [&](size_t i) {
+        SilSimulator sim = prefix.fork();
+        variation(sim, i);
+        results[i] = sim.run();
+    });
+
+    return results;
+}
+
+std::vector<SilResult> run_from_scratch(const CampaignConfig &config, const Variation &variation) {
+    std::vector<SilResult> results(config.runs);
+
+    parallel_for(config.runs, config.threads, [&](size_t i) {
+        SilSimulator sim(config.base);
+        sim.run_until(config.fork_time_s);
+        variation(sim, i);
+        results[i] = sim.run();
+    });
+
+    return results;
+}
+
+} // namespace aic_sil
@@ -0,0 +1,38 @@
+/**
+ * @file sil_campaign.hpp
+ * @brief Monte Carlo campaigns of SIL continuations sharing a warm-up prefix
+ *
+ * Every run of a campaign is the same simulation up to fork_time_s
+ * (takeoff, controller convergence) followed by a run-specific variation
+ * (payload change, gust, new noise seed). run_forked() simulates the
+ * prefix once and forks each continuation from it; run_from_scratch()
+ * simulates every run in full and is kept as the reference. Both give
+ * identical results.
+ */
+
+#pragma once
+
+#include "sil_simulator.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace aic_sil {
+
+/**
+ * @brief Applied to each continuation at the fork time (index = run number)
+ */
+using Variation = std::function<void(SilSimulator &sim, size_t index)>;
+
+struct CampaignConfig {
+    SilConfig base;
+    float fork_time_s{5.f};
+    size_t runs{16};
+    unsigned threads{0};    // 0: hardware concurrency
+};
+
+std::vector<SilResult> run_forked(const CampaignConfig &config, const Variation &variation);
+
+std::vector<SilResult> run_from_scratch(const CampaignConfig &config, const Variation &variation);
+
+} // namespace aic_sil
@@ -0,0 +1,559 @@
+/**
+ * @file sil_simulator.cpp
+ * @brief Software-in-the-loop simulation of the AIC module under multi-rate message timing
+ */
+
+#include "sil_simulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace aic_sil {
+
+using attitude_controller_aic::AICModuleInput;
+using attitude_controller_aic::AICTickStatus;
+
+namespace {
+
+/**
+ * @brief Moment of the hover thrust about a displaced center of mass, r x (0, 0, T)
+ *
+ * Thrust in N with a motor frame, normalized otherwise (as the module sees it).
+ */
+Vector3f thrust_moment(const SilConfig &config, const attitude_controller_aic::MotorAllocation &effectiveness) {
+    const float T = config.hover_thrust * (effectiveness.is_enabled() ? effectiveness.max_thrust() : 1.f);
+    return Vector3f(config.com_offset(1) * T, -config.com_offset(0) * T, 0.f);
+}
+
+} // namespace
+
+SilSimulator::SilSimulator(const SilConfig &config) :
+    config_(config), plant_(RigidBodyPlant(config.J_true, config.plant_step_us)) {
+
+    StreamState &streams = streams_.write();
+    streams.gyro_sum = Vector3f(0.f, 0.f, 0.f);
+    streams.gyro_last = Vector3f(0.f, 0.f, 0.f);
+    reseed(config.seed);
+
+    ModuleState &module = module_.write();
+    setup_module(module.core, config);
+    module.baseline.set_params(config.baseline);
+
+    actuators_.write().effectiveness.configure(config.module.motor_frame, config.module.motor_geometry);
+    plant_.write().set_disturbance(config.disturbance + thrust_moment(config, actuators_->effectiveness));
+
+    module.attitude_q = Quaternionf(1.f, 0.f, 0.f, 0.f);
+    module.attitude_omega = Vector3f(0.f, 0.f, 0.f);
+    module.setpoint_q = Quaternionf(1.f, 0.f, 0.f, 0.f);
+    module.setpoint_omega = config.rate_setpoint + Vector3f(0.f, 0.f, config.spin_rate);
+
+    EventScheduler<Event> &scheduler = scheduler_.write();
+    scheduler.schedule(0, Event{Event::GYRO_SAMPLE, Quaternionf(), Vector3f()});
+    scheduler.schedule(0, Event{Event::ESTIMATOR_SAMPLE, Quaternionf(), Vector3f()});
+    scheduler.schedule(0, Event{Event::SETPOINT_SAMPLE, Quaternionf(), Vector3f()});
+
+    if (config.motor_failure >= 0) {
+        inject_motor_failure(config.motor_failure, config.motor_failure_s);
+    }
+
+    for (const FaultSpec &fault : config.faults) {
+        schedule_fault(fault);
+    }
+}
+
+void SilSimulator::setup_module(ModuleCore &core, const SilConfig &config) {
+    // Same controller setup as AttitudeControllerAICModule (runtime gains)
+    Matrix3f J_init;
+    J_init.setZero();
+
+    for (int i = 0; i < 3; ++i) {
+        J_init(i, i) = config.J_init(i);
+    }
+
+    auto &controller = core.controller();
+    controller.init(J_init, true, true);
+    controller.set_control_gains(Vector3f(5.0f, 5.0f, 3.0f), Vector3f(0.3f, 0.3f, 0.2f),
+                                 Vector3f(0.1f, 0.1f, 0.1f), 2.0f);
+    controller.set_saturation_limit(0.05f);
+    controller.set_adaptation_params(1.5f, 1e-4f, 0.01f, 0.001f);
+    controller.set_disturbance_observer(config.disturbance_observer, 0.05f);
+    controller.set_extended_model(config.extended_model);
+    controller.set_information_window(config.information_window, config.estimator_mode, config.pe_threshold);
+    controller.set_ekf_noise(config.ekf_gyro_noise, config.ekf_acceleration_noise);
+
+    core.init();
+    core.configure(config.module);
+}
+
+void SilSimulator::reseed(uint32_t seed) {
+    config_.seed = seed;
+    StreamState &streams = streams_.write();
+
+    // Independent generator per stream: changing one stream leaves the others' draws unchanged
+    for (int i = 0; i < STREAM_COUNT; ++i) {
+        streams.rng[i].seed(seed * 7919u + static_cast<uint32_t>(i));
+    }
+}
+
+void SilSimulator::set_plant_inertia(const Vector3f &J_true) {
+    config_.J_true = J_true;
+    plant_.write().set_inertia(J_true);
+}
+
+void SilSimulator::set_disturbance(const Vector3f &disturbance) {
+    config_.disturbance = disturbance;
+    plant_.write().set_disturbance(disturbance + thrust_moment(config_, actuators_->effectiveness));
+}
+
+void SilSimulator::set_setpoint_steps(float amplitude, float period_s) {
+    config_.step_amplitude = amplitude;
+    config_.step_period_s = period_s;
+}
+
+void SilSimulator::set_rate_setpoint(const Vector3f &omega_d) {
+    config_.rate_setpoint = omega_d;
+    scheduler_.write().schedule(scheduler_->now(), Event{Event::RATES_SETPOINT_DELIVERY, Quaternionf(),
+                                                         omega_d + Vector3f(0.f, 0.f, config_.spin_rate)});
+}
+
+void SilSimulator::inject_motor_failure(int motor, float time_s) {
+    const uint64_t time_us = static_cast<uint64_t>(static_cast<double>(time_s) * 1e6);
+
+    if (!actuators_->effectiveness.is_enabled() || motor < 0 || motor >= actuators_->effectiveness.motor_count()
+        || time_us < scheduler_->now()) {
+        return;
+    }
+
+    Event event{Event::MOTOR_FAILURE, Quaternionf(), Vector3f()};
+    event.motor = static_cast<int8_t>(motor);
+    scheduler_.write().schedule(time_us, event);
+}
+
+void SilSimulator::inject_fault(const FaultSpec &fault) {
+    if (fault.start_us() < scheduler_->now()) {
+        return;
+    }
+
+    config_.faults.push_back(fault);
+    schedule_fault(fault);
+}
+
+void SilSimulator::schedule_fault(const FaultSpec &fault) {
+    // The other faults are looked up by the stream they act on (active_fault())
+    if (fault.kind == FaultKind::STATE_BIT_FLIP) {
+        Event event{Event::STATE_BIT_FLIP, Quaternionf(), Vector3f()};
+        event.target = fault.target;
+        scheduler_.write().schedule(fault.start_us(), event);
+    }
+}
+
+const FaultSpec *SilSimulator::active_fault(FaultKind kind, uint64_t now) const {
+    for (const FaultSpec &fault : config_.faults) {
+        if (fault.kind == kind && fault.active(now)) {
+            return &fault;
+        }
+    }
+
+    return nullptr;
+}
+
+SilResult SilSimulator::run() {
+    run_until(config_.duration_s);
+    return result();
+}
+
+void SilSimulator::run_until(float time_s) {
+    const uint64_t end_us = static_cast<uint64_t>(static_cast<double>(time_s) * 1e6);
+    const auto start = std::chrono::steady_clock::now();
+
+    scheduler_.write().run_until(end_us, [this](const Event &event) { handle(event); });
+
+    stats_.write().result.wall_time_s +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+SilResult SilSimulator::result() const {
+    const Statistics &stats = stats_.read();
+    SilResult r = stats.result;
+
+    r.attitude_rms = (stats.error_samples > 0) ?
+                     static_cast<float>(std::sqrt(stats.error_sq_sum / stats.error_samples)) : 0.f;
+    r.evaluation_rms = (stats.evaluation_samples > 0) ?
+                       static_cast<float>(std::sqrt(stats.evaluation_sq_sum / stats.evaluation_samples)) : 0.f;
+    r.fallback_active = module_->core.controller().is_fallback_active();
+    r.dt_mean = (stats.dt_count > 0) ? static_cast<float>(stats.dt_sum / stats.dt_count) : 0.f;
+    r.events = scheduler_->processed();
+    r.realtime_factor = (r.wall_time_s > 0.0) ? time() / r.wall_time_s : 0.0;
+    return r;
+}
+
+int SilSimulator::shared_blocks(const SilSimulator &other) const {
+    return scheduler_.shares_with(other.scheduler_) + plant_.shares_with(other.plant_)
+           + module_.shares_with(other.module_) + streams_.shares_with(other.streams_)
+           + actuators_.shares_with(other.actuators_) + stats_.shares_with(other.stats_);
+}
+
+void SilSimulator::handle(const Event &event) {
+    const uint64_t now = scheduler_->now();
+
+    switch (event.type) {
+    case Event::GYRO_SAMPLE:
+        on_gyro_sample(now);
+        break;
+
+    case Event::ESTIMATOR_SAMPLE:
+        on_estimator_sample(now);
+        break;
+
+    case Event::SETPOINT_SAMPLE:
+        on_setpoint_sample(now);
+        break;
+
+    case Event::ATTITUDE_DELIVERY: {
+            ModuleState &module = module_.write();
+            module.attitude_q = event.q;
+            module.attitude_omega = event.v;
+            module.attitude_updated = true;
+
+            // poll() returns, the module task runs after the scheduler gets to it
+            const uint64_t wakeup = now + config_.scheduling.sample(streams_.write().rng[SCHEDULING]);
+            scheduler_.write().schedule(wakeup, Event{Event::WAKEUP, Quaternionf(), Vector3f()});
+            break;
+        }
+
+    case Event::SETPOINT_DELIVERY: {
+            ModuleState &module = module_.write();
+            module.setpoint_q = event.q;
+            ++module.setpoint_sequence;
+            break;
+        }
+
+    case Event::RATES_SETPOINT_DELIVERY: {
+            // Either setpoint message invalidates the cached setpoint terms (as in the module)
+            ModuleState &module = module_.write();
+            module.setpoint_omega = event.v;
+            ++module.setpoint_sequence;
+            break;
+        }
+
+    case Event::WAKEUP:
+        on_wakeup(now);
+        break;
+
+    case Event::ACTUATOR_COMMAND:
+        on_actuator_command(now, event);
+        break;
+
+    case Event::MOTOR_FAILURE:
+        actuators_.write().failed_motor = event.motor;
+        stats_.write().failure_us = now;
+        apply_motor_torque(now);
+        break;
+
+    case Event::STATE_BIT_FLIP: {
+            auto &controller = module_.write().core.controller();
+            const uint32_t words = static_cast<uint32_t>(controller.get_estimator_state_words());
+            controller.flip_estimator_bit(static_cast<int>(event.target / 32u % words),
+                                          static_cast<int>(event.target % 32u));
+            break;
+        }
+    }
+}
+
+void SilSimulator::on_gyro_sample(uint64_t now) {
+    scheduler_.write().schedule(now + config_.gyro.period_us(), Event{Event::GYRO_SAMPLE, Quaternionf(), Vector3f()});
+
+    StreamState &streams = streams_.write();
+    std::mt19937 &rng = streams.rng[GYRO];
+
+    if (config_.gyro.drop(rng)) {
+        ++stats_.write().result.gyro_dropped;
+        return;
+    }
+
+    RigidBodyPlant &plant = plant_.write();
+    plant.advance_to(now);
+
+    std::normal_distribution<float> noise(0.f, config_.gyro_noise);
+    const float vibration = config_.vibration_amplitude
+                            * std::sin(2.f * static_cast<float>(M_PI) * config_.vibration_hz * (now % 1000000) * 1e-6f);
+    const Vector3f &Omega = plant.angular_velocity();
+    streams.gyro_last = Vector3f(Omega(0) + vibration + noise(rng), Omega(1) + vibration + noise(rng),
+                                 Omega(2) + noise(rng));
+    streams.gyro_sum += streams.gyro_last;
+    ++streams.gyro_count;
+}
+
+void SilSimulator::on_estimator_sample(uint64_t now) {
+    EventScheduler<Event> &scheduler = scheduler_.write();
+    scheduler.schedule(now + config_.estimator.period_us(), Event{Event::ESTIMATOR_SAMPLE, Quaternionf(), Vector3f()});
+
+    RigidBodyPlant &plant = plant_.write();
+    plant.advance_to(now);
+
+    // Tracking error against the setpoint the generator is commanding right now
+    Statistics &stats = stats_.write();
+    const float error = rotation_angle(plant.attitude(), profile_setpoint(now));
+    stats.error_sq_sum += static_cast<double>(error) * error;
+    ++stats.error_samples;
+    stats.result.attitude_max = std::max(stats.result.attitude_max, error);
+    stats.result.tilt_max = std::max(stats.result.tilt_max, tilt_angle(plant.attitude(), profile_setpoint(now)));
+
+    // NaN compares false everywhere, the angles above would read zero
+    if (!std::isfinite(plant.attitude()(0)) || !std::isfinite(plant.angular_velocity().norm())) {
+        stats.result.diverged = true;
+    }
+
+    if (config_.evaluation_start_s >= 0.f && now * 1e-6f >= config_.evaluation_start_s) {
+        stats.evaluation_sq_sum += static_cast<double>(error) * error;
+        ++stats.evaluation_samples;
+        stats.result.evaluation_max = std::max(stats.result.evaluation_max, error);
+    }
+
+    // Rates are the mean of the gyro samples since the last estimator update
+    StreamState &streams = streams_.write();
+    const Vector3f omega = (streams.gyro_count > 0) ?
+                           Vector3f(streams.gyro_sum / static_cast<float>(streams.gyro_count)) : streams.gyro_last;
+    streams.gyro_sum = Vector3f(0.f, 0.f, 0.f);
+    streams.gyro_count = 0;
+
+    if (config_.estimator.drop(streams.rng[ESTIMATOR])) {
+        ++stats.result.estimator_dropped;
+        return;
+    }
+
+    // Latency drawn first: a faulted run keeps the random streams of the run without the fault
+    const uint64_t delivery = now + config_.estimator.latency.sample(streams.rng[ESTIMATOR]);
+
+    if (active_fault(FaultKind::SENSOR_DROPOUT, now)) {
+        ++stats.result.faulted_messages;
+        return;
+    }
+
+    if (active_fault(FaultKind::NAN_BURST, now)) {
+        ++stats.result.faulted_messages;
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        scheduler.schedule(delivery, Event{Event::ATTITUDE_DELIVERY, Quaternionf(nan, nan, nan, nan),
+                                           Vector3f(nan, nan, nan)});
+        return;
+    }
+
+    scheduler.schedule(delivery, Event{Event::ATTITUDE_DELIVERY, plant.attitude(), omega});
+}
+
+void SilSimulator::on_setpoint_sample(uint64_t now) {
+    EventScheduler<Event> &scheduler = scheduler_.write();
+    scheduler.schedule(now + config_.setpoint.period_us(), Event{Event::SETPOINT_SAMPLE, Quaternionf(), Vector3f()});
+
+    std::mt19937 &rng = streams_.write().rng[SETPOINT];
+
+    if (config_.setpoint.drop(rng)) {
+        ++stats_.write().result.setpoint_dropped;
+        return;
+    }
+
+    const uint64_t delivery = now + config_.setpoint.latency.sample(rng);
+
+    if (active_fault(FaultKind::STALE_SETPOINT, now)) {
+        ++stats_.write().result.faulted_messages;
+        return;
+    }
+
+    scheduler.schedule(delivery, Event{Event::SETPOINT_DELIVERY, profile_setpoint(now), Vector3f()});
+}
+
+void SilSimulator::on_wakeup(uint64_t now) {
+    ModuleState &module = module_.write();
+    Statistics &stats = stats_.write();
+    SilResult &result = stats.result;
+    ++result.wakeups;
+
+    if (!module.attitude_updated) {
+        ++result.coalesced;
+        return;
+    }
+
+    module.attitude_updated = false;
+
+    AICModuleInput input;
+    input.q = module.attitude_q;
+    input.omega = module.attitude_omega;
+    input.q_d = module.setpoint_q;
+    input.setpoint_sequence = module.setpoint_sequence;
+    input.omega_d = module.setpoint_omega;
+    input.thrust = config_.hover_thrust;
+    input.landed = false;
+
+    // Clock glitch: the module sees shifted timestamps
+    uint64_t stamp = now;
+
+    if (const FaultSpec *spike = active_fault(FaultKind::DT_SPIKE, now)) {
+        ++result.faulted_messages;
+        stamp = static_cast<uint64_t>(std::max(0.0, static_cast<double>(now) + spike->magnitude * 1e6));
+    }
+
+    Vector3f tau;
+    const AICTickStatus status = (config_.controller == SilController::PX4_CASCADE) ?
+                                 baseline_update(now, input, tau) : module.core.update(stamp, input, tau);
+
+    result.skipped += status.skipped ? 1 : 0;
+    result.dt_clamped += status.dt_clamped ? 1 : 0;
+    result.fallback_engaged += status.fallback_engaged ? 1 : 0;
+
+    const attitude_controller_aic::VibrationMonitor &vibration = module.core.vibration_monitor();
+    const bool gated = vibration.get_scale(0) < 1.f || vibration.get_scale(1) < 1.f || vibration.get_scale(2) < 1.f;
+    result.adaptation_gated += (status.controlled && gated && config_.module.vibration_gating) ? 1 : 0;
+
+    if (!status.controlled) {
+        if (!status.skipped) {
+            module.last_control_us = now;   // First message initializes the time base
+        }
+
+        return;
+    }
+
+    ++result.controlled;
+    result.excited += module.core.controller().is_persistently_excited() ? 1 : 0;
+
+    if (config_.record_ticks) {
+        stats.ticks.push_back(TickRecord{now, input.q, input.omega, input.q_d});
+    }
+
+    const float dt = static_cast<float>(now - module.last_control_us) * 1e-6f;
+    module.last_control_us = now;
+    result.dt_min = (stats.dt_count > 0) ? std::min(result.dt_min, dt) : dt;
+    result.dt_max = std::max(result.dt_max, dt);
+    stats.dt_sum += dt;
+    ++stats.dt_count;
+
+    if (status.motor_failure_detected) {
+        result.failure_detected_motor = module.core.allocation().failed_motor();
+        stats.detection_us = now;
+        result.detection_latency = (stats.failure_us > 0) ? static_cast<float>(now - stats.failure_us) * 1e-6f : -1.f;
+    }
+
+    Event command{Event::ACTUATOR_COMMAND, Quaternionf(), tau};
+
+    if (module.core.allocation().is_enabled()) {
+        command.motor = static_cast<int8_t>(module.core.allocation().failed_motor());
+
+        if (config_.controller == SilController::PX4_CASCADE) {
+            // Nominal allocation of the baseline torque (no failure handling)
+            module.core.allocation().allocate(tau, input.thrust, command.motors);
+
+        } else {
+            for (int i = 0; i < module.core.allocation().motor_count(); ++i) {
+                command.motors[i] = module.core.motor_outputs()[i];
+            }
+        }
+    }
+
+    const uint64_t applied = now + config_.actuator.sample(streams_.write().rng[ACTUATOR]);
+    scheduler_.write().schedule(applied, command);
+}
+
+AICTickStatus SilSimulator::baseline_update(uint64_t now, const AICModuleInput &input, Vector3f &tau) {
+    ModuleState &module = module_.write();
+    AICTickStatus status;
+
+    // Like the module, the first message only initializes the time base
+    if (!module.baseline_started) {
+        module.baseline_started = true;
+        return status;
+    }
+
+    const float dt = static_cast<float>(now - module.last_control_us) * 1e-6f;
+    status.dt_clamped = dt < Px4CascadeController::MIN_DT || dt > Px4CascadeController::MAX_DT;
+    tau = module.baseline.update(input.q, input.omega, input.q_d, dt, input.landed);
+    status.controlled = true;
+    return status;
+}
+
+void SilSimulator::on_actuator_command(uint64_t now, const Event &event) {
+    if (!actuators_->effectiveness.is_enabled()) {
+        const FaultSpec *loss = active_fault(FaultKind::ACTUATOR_LOSS, now);
+        const float share = loss ? 1.f - std::max(0.f, std::min(loss->magnitude, 1.f)) : 1.f;
+        RigidBodyPlant &plant = plant_.write();
+        plant.advance_to(now);
+        plant.set_torque(event.v * share);
+        return;
+    }
+
+    ActuatorState &actuators = actuators_.write();
+
+    for (int i = 0; i < actuators.effectiveness.motor_count(); ++i) {
+        actuators.commands[i] = event.motors[i];
+    }
+
+    Statistics &stats = stats_.write();
+
+    if (event.motor >= 0 && stats.result.reconfiguration_latency < 0.f) {
+        stats.result.reconfiguration_latency = static_cast<float>(now - stats.detection_us) * 1e-6f;
+    }
+
+    apply_motor_torque(now);
+}
+
+void SilSimulator::apply_motor_torque(uint64_t now) {
+    const ActuatorState &actuators = actuators_.read();
+    float thrust[MAX_MOTORS];
+
+    for (int i = 0; i < actuators.effectiveness.motor_count(); ++i) {
+        thrust[i] = (i == actuators.failed_motor) ? 0.f : actuators.commands[i];
+    }
+
+    if (const FaultSpec *loss = active_fault(FaultKind::ACTUATOR_LOSS, now)) {
+        const int motor = static_cast<int>(loss->target % static_cast<uint32_t>(actuators.effectiveness.motor_count()));
+        thrust[motor] *= 1.f - std::max(0.f, std::min(loss->magnitude, 1.f));
+    }
+
+    RigidBodyPlant &plant = plant_.write();
+    plant.advance_to(now);
+    plant.set_torque(actuators.effectiveness.torque(thrust));
+}
+
+Quaternionf SilSimulator::profile_setpoint(uint64_t time_us) const {
+    // Heading (yaw about z) then the step tilt in the body frame
+    const float yaw = config_.spin_rate * time_us * 1e-6f;
+    const float c_h = std::cos(0.5f * yaw);
+    const float s_h = std::sin(0.5f * yaw);
+    const Quaternionf heading(c_h, 0.f, 0.f, s_h);
+
+    if (config_.step_period_s <= 0.f || config_.step_amplitude == 0.f) {
+        return heading;
+    }
+
+    // Hold level for the first period, then roll+, pitch+, roll-, pitch-, ...
+    const int step = static_cast<int>(time_us * 1e-6f / config_.step_period_s);
+
+    if (step == 0) {
+        return heading;
+    }
+
+    const int phase = (step - 1) % 4;
+    const float angle = (phase < 2) ? config_.step_amplitude : -config_.step_amplitude;
+    const float c = std::cos(0.5f * angle);
+    const float s = std::sin(0.5f * angle);
+    return (phase % 2 == 0) ? Quaternionf(c_h * c, c_h * s, s_h * s, s_h * c)
+                            : Quaternionf(c_h * c, -s_h * s, c_h * s, s_h * c);
+}
+
+float SilSimulator::rotation_angle(const Quaternionf &a, const Quaternionf &b) {
+    float dot = 0.f;
+
+    for (int i = 0; i < 4; ++i) {
+        dot += a(i) * b(i);
+    }
+
+    return 2.f * std::acos(std::min(1.f, std::fabs(dot)));
+}
+
+float SilSimulator::tilt_angle(const Quaternionf &a, const Quaternionf &b) {
+    const Vector3f za = a.to_dcm() * Vector3f(0.f, 0.f, 1.f);
+    const Vector3f zb = b.to_dcm() * Vector3f(0.f, 0.f, 1.f);
+    return std::acos(std::max(-1.f, std::min(za.dot(zb), 1.f)));
+}
+
+} // namespace aic_sil
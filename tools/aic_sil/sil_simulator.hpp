@@ -0,0 +1,322 @@
+/**
+ * @file sil_simulator.hpp
+ * @brief Software-in-the-loop simulation of the AIC module under multi-rate message timing
+ *
+ * The module tick pipeline (AICModuleCore, the same code the PX4 module
+ * runs) is driven by a discrete-event model of the flight stack:
+ *
+ *   gyro (1-8 kHz) -> estimator (250 Hz) --latency/dropout--> module wakeup
+ *   setpoint generator (50 Hz) --latency/dropout--> latest setpoint
+ *   module wakeup (+ scheduling jitter) -> AICModuleCore::update
+ *   torque or motor commands --actuator latency--> rigid-body plant
+ *
+ * The same scenarios can be flown by the stock PX4 attitude and rate
+ * controller math instead (config.controller, px4_cascade.hpp) for a
+ * baseline; it runs on every attitude message like mc_att_control.
+ * With record_ticks, the inputs of every controlled tick are kept so they
+ * can be replayed through any controller (tick_log.hpp).
+ *
+ * With a motor frame configured (config.module.motor_frame), the module
+ * allocates and the plant torque is the effectiveness matrix times the
+ * commands of the motors still running, so motor failures can be injected
+ * and the detection and reconfiguration latencies measured.
+ *
+ * As with uORB, the module reads the latest delivered messages when it
+ * wakes up; wakeups that find no new attitude message are coalesced. The
+ * plant is only integrated up to the time of the event that observes or
+ * changes it, so simulation cost scales with the message rates.
+ *
+ * Faults (fault_model.hpp) drop, hold or corrupt the module's messages,
+ * offset its clock, flip estimator state bits and take torque away; with
+ * evaluation_start_s the tracking after the faults is scored separately.
+ *
+ * Snapshot and fork: the complete state (plant, module core with the
+ * controller, RNG streams, pending events, statistics) lives in
+ * copy-on-write blocks, so copying a simulator is O(1). Run a shared
+ * warm-up prefix once, then fork() continuations, change post-fork
+ * parameters (inertia, disturbance, setpoints, seed) and run each to the
+ * end. A fork with unchanged parameters reproduces the uninterrupted run
+ * exactly.
+ */
+
+#pragma once
+
+#include "cow_block.hpp"
+#include "event_scheduler.hpp"
+#include "fault_model.hpp"
+#include "px4_cascade.hpp"
+#include "rigid_body_plant.hpp"
+#include "tick_log.hpp"
+#include "timing_model.hpp"
+
+#include <attitude_controller_aic.hpp>
+#include <aic_module_core.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace aic_sil {
+
+using ModuleCore = attitude_controller_aic::AICModuleCore<attitude_controller_aic::AttitudeControllerAIC>;
+
+/**
+ * @brief Controller flying the scenario
+ */
+enum class SilController : uint8_t {
+    AIC,            // AICModuleCore, as the module runs it
+    PX4_CASCADE,    // Stock PX4 attitude + rate control math (baseline)
+};
+
+struct SilConfig {
+    float duration_s{20.f};
+    uint32_t seed{1};
+
+    // Message streams
+    StreamTiming gyro{2000.f, LatencyModel{}, 0.f};
+    StreamTiming estimator{250.f, LatencyModel{500.f, 100.f, 0.f, 0.f}, 0.f};
+    StreamTiming setpoint{50.f, LatencyModel{1000.f, 300.f, 0.f, 0.f}, 0.f};
+    LatencyModel scheduling{50.f, 30.f, 0.001f, 3000.f};   // Module wakeup after delivery
+    LatencyModel actuator{2000.f, 200.f, 0.f, 0.f};         // Command to torque (ESC + motor)
+
+    // Plant
+    Vector3f J_true{0.045f, 0.045f, 0.028f};   // kg*m^2
+    Vector3f disturbance{0.f, 0.f, 0.f};       // Constant torque (Nm)
+    Vector3f com_offset{0.f, 0.f, 0.f};        // CoM from the rotor centroid (m; Nm at full thrust without motors)
+    float gyro_noise{0.005f};                  // rad/s (1 sigma)
+    float vibration_amplitude{0.f};            // Motor vibration line on the roll/pitch gyro (rad/s)
+    float vibration_hz{180.f};
+    uint64_t plant_step_us{100};
+
+    // Setpoint profile: alternating roll/pitch steps
+    float step_amplitude{0.2f};                // rad
+    float step_period_s{2.f};
+    Vector3f rate_setpoint{0.f, 0.f, 0.f};     // Body rate setpoint (rad/s), its own message
+    float spin_rate{0.f};                      // Heading turns at this yaw rate (rad/s, fed forward in the rates)
+
+    // Motors (config.module.motor_frame != NONE)
+    float hover_thrust{0.5f};                  // Collective thrust command [0, 1]
+    int motor_failure{-1};                     // Motor that stops at motor_failure_s (-1: none)
+    float motor_failure_s{5.f};
+
+    // Module
+    Vector3f J_init{0.040f, 0.040f, 0.025f};   // Module default inertia
+    attitude_controller_aic::AICModuleConfig module;
+    bool disturbance_observer{true};
+    bool extended_model{false};                // Adapt CoM offset, yaw drag and rotor inertia
+    float information_window{2.f};             // Information window length (s), 0: off
+    attitude_controller_aic::EstimatorMode estimator_mode{attitude_controller_aic::EstimatorMode::IWG};
+    float pe_threshold{0.05f};                 // Window excitation threshold ((rad/s^2)^2)
+    float ekf_gyro_noise{0.005f};              // EstimatorMode::EKF noise model (AIC_EKF_GYR_N, AIC_EKF_ACC_N)
+    float ekf_acceleration_noise{0.03f};
+
+    // Controller under test
+    SilController controller{SilController::AIC};
+    Px4CascadeParams baseline;
+    bool record_ticks{false};                  // Keep the inputs of every controlled tick
+
+    // Fault injection
+    std::vector<FaultSpec> faults;
+    float evaluation_start_s{-1.f};            // Tracking also scored from here to the end (< 0: off)
+};
+
+struct SilResult {
+    // Tracking (true attitude vs generated setpoint, sampled at the estimator rate)
+    float attitude_rms{0.f};          // rad
+    float attitude_max{0.f};          // rad
+    float tilt_max{0.f};              // Thrust axis error only, ignores yaw (rad)
+
+    // Module ticks
+    uint64_t wakeups{0};
+    uint64_t coalesced{0};            // Wakeups without a new attitude message
+    uint64_t controlled{0};
+    uint64_t skipped{0};              // Rate governor decimation
+    uint64_t dt_clamped{0};
+    float dt_min{0.f};                // Unclamped controller interval (s)
+    float dt_max{0.f};
+    float dt_mean{0.f};
+    uint64_t fallback_engaged{0};
+    uint64_t adaptation_gated{0};     // Controlled ticks with any axis adaptation scaled down
+    uint64_t excited{0};              // Controlled ticks with the persistent excitation flag set
+
+    // Motor failure
+    int failure_detected_motor{-1};   // Motor the module declared failed
+    float detection_latency{-1.f};    // Motor stop to detection (s), -1 if none or before the stop
+    float reconfiguration_latency{-1.f}; // Detection to the first reduced-allocation command at the motors (s)
+
+    // Streams
+    uint64_t gyro_dropped{0};
+    uint64_t estimator_dropped{0};
+    uint64_t setpoint_dropped{0};
+
+    // Faults
+    uint64_t faulted_messages{0};     // Messages lost, held, corrupted or time-shifted by a fault
+    float evaluation_rms{0.f};        // Attitude error from config.evaluation_start_s on (rad)
+    float evaluation_max{0.f};
+    bool diverged{false};             // Non-finite plant state
+    bool fallback_active{false};      // Envelope fallback latched at the end
+
+    // Cost (a fork includes the prefix it was forked from)
+    uint64_t events{0};
+    double wall_time_s{0.0};
+    double realtime_factor{0.0};
+};
+
+/**
+ * @class SilSimulator
+ * @brief One simulation; copies are cheap forks sharing state until written
+ */
+class SilSimulator {
+public:
+    explicit SilSimulator(const SilConfig &config);
+
+    /**
+     * @brief Run to the configured duration and return the statistics
+     */
+    SilResult run();
+
+    /**
+     * @brief Run up to time_s (e.g. the end of a shared warm-up prefix)
+     */
+    void run_until(float time_s);
+
+    /**
+     * @brief Continuation sharing all state with this simulator until either writes it
+     */
+    SilSimulator fork() const { return *this; }
+
+    // Post-fork parameters
+    void set_duration(float duration_s) { config_.duration_s = duration_s; }
+    void set_plant_inertia(const Vector3f &J_true);
+    void set_disturbance(const Vector3f &disturbance);
+    void set_setpoint_steps(float amplitude, float period_s);
+
+    /**
+     * @brief Deliver a rate setpoint message now, without a new attitude setpoint
+     */
+    void set_rate_setpoint(const Vector3f &omega_d);
+
+    /**
+     * @brief Stop a motor at time_s (no-op without a motor frame or if time_s has passed)
+     */
+    void inject_motor_failure(int motor, float time_s);
+
+    /**
+     * @brief Add a fault (no-op if it starts before the current time)
+     */
+    void inject_fault(const FaultSpec &fault);
+
+    void set_evaluation_start(float time_s) { config_.evaluation_start_s = time_s; }
+
+    /**
+     * @brief Restart all random streams from a new seed (Monte Carlo continuations)
+     */
+    void reseed(uint32_t seed);
+
+    SilResult result() const;
+
+    /**
+     * @brief Inputs of the controlled ticks so far (config.record_ticks)
+     */
+    const std::vector<TickRecord> &ticks() const { return stats_->ticks; }
+
+    /**
+     * @brief Controller and module setup of the SIL (same as AttitudeControllerAICModule, runtime gains)
+     */
+    static void setup_module(ModuleCore &core, const SilConfig &config);
+
+    float time() const { return static_cast<float>(scheduler_->now()) * 1e-6f; }
+    const SilConfig &config() const { return config_; }
+    const ModuleCore &core() const { return module_->core; }
+    const RigidBodyPlant &plant() const { return plant_.read(); }
+
+    /**
+     * @brief Number of state blocks still shared with another simulator (0..6)
+     */
+    int shared_blocks(const SilSimulator &other) const;
+
+private:
+    enum Stream { GYRO, ESTIMATOR, SETPOINT, SCHEDULING, ACTUATOR, STREAM_COUNT };
+
+    static constexpr int MAX_MOTORS = attitude_controller_aic::MotorAllocation::MAX_MOTORS;
+
+    struct Event {
+        enum Type : uint8_t {
+            GYRO_SAMPLE, ESTIMATOR_SAMPLE, SETPOINT_SAMPLE,
+            ATTITUDE_DELIVERY, SETPOINT_DELIVERY, RATES_SETPOINT_DELIVERY, WAKEUP, ACTUATOR_COMMAND, MOTOR_FAILURE,
+            STATE_BIT_FLIP
+        } type;
+
+        Quaternionf q;    // Attitude (delivery) or setpoint
+        Vector3f v;       // Rates (delivery, rate setpoint) or torque (actuator)
+        int8_t motor{-1}; // Failed motor (failure) or of the allocation the commands came from (actuator)
+        float motors[MAX_MOTORS] {}; // Motor commands (actuator, motor frame only)
+        uint32_t target{0};          // Estimator state word * 32 + bit (bit flip)
+    };
+
+    // Copy-on-write state blocks
+    struct ModuleState {
+        ModuleCore core;
+        Quaternionf attitude_q;       // Latest delivered messages (uORB semantics)
+        Vector3f attitude_omega;
+        bool attitude_updated{false};
+        Quaternionf setpoint_q;
+        Vector3f setpoint_omega;
+        uint32_t setpoint_sequence{1};  // Attitude and rate setpoint messages delivered (initial setpoints: 1)
+        uint64_t last_control_us{0};
+        Px4CascadeController baseline;
+        bool baseline_started{false};
+    };
+
+    struct StreamState {
+        std::mt19937 rng[STREAM_COUNT];
+        Vector3f gyro_sum;            // Estimator gyro averaging
+        int gyro_count{0};
+        Vector3f gyro_last;
+    };
+
+    struct ActuatorState {
+        attitude_controller_aic::MotorAllocation effectiveness;   // True motor geometry
+        float commands[MAX_MOTORS]{};
+        int failed_motor{-1};
+    };
+
+    struct Statistics {
+        SilResult result;
+        uint64_t failure_us{0};
+        uint64_t detection_us{0};
+        double error_sq_sum{0.0};
+        uint64_t error_samples{0};
+        double evaluation_sq_sum{0.0};
+        uint64_t evaluation_samples{0};
+        double dt_sum{0.0};
+        uint64_t dt_count{0};
+        std::vector<TickRecord> ticks;
+    };
+
+    void handle(const Event &event);
+    void on_gyro_sample(uint64_t now);
+    void on_estimator_sample(uint64_t now);
+    void on_setpoint_sample(uint64_t now);
+    void on_wakeup(uint64_t now);
+    attitude_controller_aic::AICTickStatus baseline_update(uint64_t now, const attitude_controller_aic::AICModuleInput &input,
+                                                           Vector3f &tau);
+    void on_actuator_command(uint64_t now, const Event &event);
+    void apply_motor_torque(uint64_t now);
+    void schedule_fault(const FaultSpec &fault);
+    const FaultSpec *active_fault(FaultKind kind, uint64_t now) const;
+
+    Quaternionf profile_setpoint(uint64_t time_us) const;
+    static float rotation_angle(const Quaternionf &a, const Quaternionf &b);
+    static float tilt_angle(const Quaternionf &a, const Quaternionf &b);
+
+    SilConfig config_;
+    CowBlock<EventScheduler<Event>> scheduler_;
+    CowBlock<RigidBodyPlant> plant_;
+    CowBlock<ModuleState> module_;
+    CowBlock<StreamState> streams_;
+    CowBlock<ActuatorState> actuators_;
+    CowBlock<Statistics> stats_;
+};
+
+} // namespace aic_sil
@@ -0,0 +1,206 @@
+/**
+ * @file so3_batch.cpp
+ * @brief Batched SO(3) exponential/log map and quaternion kernels over structure-of-arrays data
+ */
+
+#include "so3_batch.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace aic_sil {
+
+namespace {
+
+// pi/2 split for Cody-Waite reduction (leading parts exact in a float product with small integers)
+constexpr float PIO2_1 = 1.5703125f;
+constexpr float PIO2_2 = 4.837512969970703125e-4f;
+constexpr float PIO2_3 = 7.54978995489188216e-8f;
+constexpr float TWO_OVER_PI = 0.636619772367581343f;
+constexpr float PI_OVER_2 = 1.57079632679489662f;
+constexpr float PI_OVER_4 = 0.785398163397448310f;
+constexpr float TAN_PI_OVER_8 = 0.414213562373095049f;
+
+/**
+ * @brief sin(h), cos(h) and sin(h)/h for h >= 0
+ *
+ * |h| <= pi/4 (quadrant 0) evaluates sin(h)/h as a polynomial in h^2, so it
+ * is exact to rounding at h = 0.
+ */
+inline void sincos_sinc(float h, float &s, float &c, float &sinc) {
+    const int32_t j = static_cast<int32_t>(h * TWO_OVER_PI + 0.5f);
+    const float jf = static_cast<float>(j);
+    const float r = ((h - jf * PIO2_1) - jf * PIO2_2) - jf * PIO2_3;
+    const float z = r * r;
+
+    // Minimax on [-pi/4, pi/4]: sin(r) = r + r * z * Ps(z), cos(r) = 1 - z / 2 + z^2 * Pc(z)
+    const float ps = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+    const float sin_r = r + r * z * ps;
+    const float cos_r = 1.f - 0.5f * z + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z
+                        + 4.166664568298827e-2f);
+
+    // Quadrant j: (sin, cos) = (s_r, c_r), (c_r, -s_r), (-s_r, -c_r), (-c_r, s_r)
+    const bool swap = (j & 1) != 0;
+    const float s_abs = swap ? cos_r : sin_r;
+    const float c_abs = swap ? sin_r : cos_r;
+    s = (j & 2) ? -s_abs : s_abs;
+    c = ((j + 1) & 2) ? -c_abs : c_abs;
+
+    // Both candidates are evaluated and selected (a conditional division is a branch to the vectorizer)
+    const float sinc_poly = 1.f + z * ps;
+    const float sinc_div = s / ((h > PI_OVER_4) ? h : PI_OVER_4);
+    sinc = (j == 0) ? sinc_poly : sinc_div;
+}
+
+/**
+ * @brief atan(y / x) / y for y, x >= 0 (x > 0 or y > 0)
+ *
+ * For y / x <= tan(pi/8) (no inversion, no shift) the quotient is the
+ * polynomial atan(t) / t divided by x, so it stays exact as y -> 0.
+ */
+inline float atan_over_y(float y, float x) {
+    const bool invert = y > x;
+    const float t = (invert ? x : y) / (invert ? y : x);
+    const bool shift = t > TAN_PI_OVER_8;
+    const float t_shifted = (t - 1.f) / (t + 1.f);
+    const float u = shift ? t_shifted : t;
+    const float z = u * u;
+
+    // Minimax on [-tan(pi/8), tan(pi/8)]: atan(u) = u + u * z * Pa(z)
+    const float pa = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z
+                      - 3.33329491539e-1f);
+    const float atan_u = u + u * z * pa;
+    const float atan_t = shift ? PI_OVER_4 + atan_u : atan_u;
+    const float angle = invert ? PI_OVER_2 - atan_t : atan_t;
+
+    // Float selects only: a bool combining both conditions becomes a byte mask the vectorizer rejects
+    const float small = (1.f + z * pa) / x;
+    const float large = angle / ((y > 1e-30f) ? y : 1e-30f);
+    const float unshifted = shift ? large : small;
+    return invert ? large : unshifted;
+}
+
+// The kernels take every array as a restrict parameter and are not inlined:
+// restrict locals initialized from std::vector::data() are not trusted by
+// the alias analysis, and inlining a kernel into its wrapper drops the
+// no-alias guarantee. Either way the loop stays scalar.
+__attribute__((noinline))
+void exp_kernel(size_t n, const float *__restrict px, const float *__restrict py, const float *__restrict pz,
+                float *__restrict qw, float *__restrict qx, float *__restrict qy, float *__restrict qz) {
+    for (size_t i = 0; i < n; ++i) {
+        const float theta = std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+        float s, c, sinc;
+        sincos_sinc(0.5f * theta, s, c, sinc);
+
+        // sin(theta / 2) / theta = sinc(theta / 2) / 2
+        const float k = 0.5f * sinc;
+        qw[i] = c;
+        qx[i] = k * px[i];
+        qy[i] = k * py[i];
+        qz[i] = k * pz[i];
+    }
+}
+
+__attribute__((noinline))
+void log_kernel(size_t n, const float *__restrict qw, const float *__restrict qx, const float *__restrict qy,
+                const float *__restrict qz, float *__restrict px, float *__restrict py, float *__restrict pz) {
+    for (size_t i = 0; i < n; ++i) {
+        // q and -q are the same rotation: take the one with w >= 0 (|phi| <= pi)
+        const float sign = (qw[i] < 0.f) ? -1.f : 1.f;
+        const float w = sign * qw[i];
+        const float v = std::sqrt(qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]);
+
+        // Half angle atan2(|v|, w); phi = v * 2 * half / |v|
+        const float k = sign * 2.f * atan_over_y(v, w);
+
+        px[i] = k * qx[i];
+        py[i] = k * qy[i];
+        pz[i] = k * qz[i];
+    }
+}
+
+__attribute__((noinline))
+void compose_kernel(size_t n, const float *__restrict aw, const float *__restrict ax, const float *__restrict ay,
+                    const float *__restrict az, const float *__restrict bw, const float *__restrict bx,
+                    const float *__restrict by, const float *__restrict bz, float *__restrict cw, float *__restrict cx,
+                    float *__restrict cy, float *__restrict cz) {
+    for (size_t i = 0; i < n; ++i) {
+        cw[i] = aw[i] * bw[i] - ax[i] * bx[i] - ay[i] * by[i] - az[i] * bz[i];
+        cx[i] = aw[i] * bx[i] + ax[i] * bw[i] + ay[i] * bz[i] - az[i] * by[i];
+        cy[i] = aw[i] * by[i] - ax[i] * bz[i] + ay[i] * bw[i] + az[i] * bx[i];
+        cz[i] = aw[i] * bz[i] + ax[i] * by[i] - ay[i] * bx[i] + az[i] * bw[i];
+    }
+}
+
+__attribute__((noinline))
+void rotate_kernel(size_t n, const float *__restrict qw, const float *__restrict qx, const float *__restrict qy,
+                   const float *__restrict qz, const float *__restrict vx, const float *__restrict vy,
+                   const float *__restrict vz, float *__restrict ox, float *__restrict oy, float *__restrict oz) {
+    for (size_t i = 0; i < n; ++i) {
+        // t = 2 * q_v x v, v' = v + w * t + q_v x t
+        const float tx = 2.f * (qy[i] * vz[i] - qz[i] * vy[i]);
+        const float ty = 2.f * (qz[i] * vx[i] - qx[i] * vz[i]);
+        const float tz = 2.f * (qx[i] * vy[i] - qy[i] * vx[i]);
+        ox[i] = vx[i] + qw[i] * tx + (qy[i] * tz - qz[i] * ty);
+        oy[i] = vy[i] + qw[i] * ty + (qz[i] * tx - qx[i] * tz);
+        oz[i] = vz[i] + qw[i] * tz + (qx[i] * ty - qy[i] * tx);
+    }
+}
+
+__attribute__((noinline))
+void integrate_kernel(size_t n, float dt, float *__restrict qw, float *__restrict qx, float *__restrict qy,
+                      float *__restrict qz, const float *__restrict wx, const float *__restrict wy,
+                      const float *__restrict wz) {
+    for (size_t i = 0; i < n; ++i) {
+        // Increment exp(omega * dt), fused with the product
+        const float px = wx[i] * dt, py = wy[i] * dt, pz = wz[i] * dt;
+        const float theta = std::sqrt(px * px + py * py + pz * pz);
+        float s, c, sinc;
+        sincos_sinc(0.5f * theta, s, c, sinc);
+        const float k = 0.5f * sinc;
+        const float dw = c, dx = k * px, dy = k * py, dz = k * pz;
+
+        const float w = qw[i] * dw - qx[i] * dx - qy[i] * dy - qz[i] * dz;
+        const float x = qw[i] * dx + qx[i] * dw + qy[i] * dz - qz[i] * dy;
+        const float y = qw[i] * dy - qx[i] * dz + qy[i] * dw + qz[i] * dx;
+        const float z = qw[i] * dz + qx[i] * dy - qy[i] * dx + qz[i] * dw;
+
+        const float norm_inv = 1.f / std::sqrt(w * w + x * x + y * y + z * z);
+        qw[i] = w * norm_inv;
+        qx[i] = x * norm_inv;
+        qy[i] = y * norm_inv;
+        qz[i] = z * norm_inv;
+    }
+}
+
+} // namespace
+
+void so3_exp(const Vector3Array &phi, QuaternionArray &q) {
+    q.resize(phi.size());
+    exp_kernel(phi.size(), phi.x.data(), phi.y.data(), phi.z.data(), q.w.data(), q.x.data(), q.y.data(),
+               q.z.data());
+}
+
+void so3_log(const QuaternionArray &q, Vector3Array &phi) {
+    phi.resize(q.size());
+    log_kernel(q.size(), q.w.data(), q.x.data(), q.y.data(), q.z.data(), phi.x.data(), phi.y.data(), phi.z.data());
+}
+
+void quat_compose(const QuaternionArray &a, const QuaternionArray &b, QuaternionArray &c) {
+    c.resize(a.size());
+    compose_kernel(a.size(), a.w.data(), a.x.data(), a.y.data(), a.z.data(), b.w.data(), b.x.data(), b.y.data(),
+                   b.z.data(), c.w.data(), c.x.data(), c.y.data(), c.z.data());
+}
+
+void quat_rotate(const QuaternionArray &q, const Vector3Array &v, Vector3Array &out) {
+    out.resize(q.size());
+    rotate_kernel(q.size(), q.w.data(), q.x.data(), q.y.data(), q.z.data(), v.x.data(), v.y.data(), v.z.data(),
+                  out.x.data(), out.y.data(), out.z.data());
+}
+
+void so3_integrate(QuaternionArray &q, const Vector3Array &omega, float dt) {
+    integrate_kernel(q.size(), dt, q.w.data(), q.x.data(), q.y.data(), q.z.data(), omega.x.data(), omega.y.data(),
+                     omega.z.data());
+}
+
+} // namespace aic_sil
@@ -0,0 +1,101 @@
+/**
+ * @file so3_batch.hpp
+ * @brief Batched SO(3) exponential/log map and quaternion kernels over structure-of-arrays data
+ *
+ * Simulation, replay and reference differentiation evaluate the same few
+ * Lie-group operations over thousands of samples (campaign members, log
+ * rows, integration steps). These kernels process one component array at a
+ * time: every loop body is straight-line code (no data-dependent branches,
+ * no libm calls), so the compiler vectorizes it at -O2/-O3.
+ *
+ * - so3_exp: rotation vector -> unit quaternion
+ * - so3_log: unit quaternion -> rotation vector (shortest, |phi| <= pi)
+ * - quat_compose: Hamilton product a * b
+ * - quat_rotate: q * v * q^-1
+ * - so3_integrate: q <- q * exp(omega * dt), renormalized (body rates)
+ *
+ * sin/cos and atan are evaluated with Cody-Waite range reduction and
+ * minimax polynomials (single precision, a few ulp). The small-angle cases
+ * use the same polynomials: sin(h)/h and atan(t)/t are evaluated directly
+ * as polynomials in h^2 and t^2, so exp and log keep full relative accuracy
+ * down to zero angle without a separate branch or a division by the angle.
+ *
+ * Outputs must not share storage with inputs (the arrays are accessed
+ * through restrict pointers); so3_integrate updates q in place. The
+ * kernels need -fno-math-errno and -fno-trapping-math (set in
+ * CMakeLists.txt): otherwise sqrt keeps an errno branch, and the selects
+ * between two evaluated candidates (small vs large angle, octant
+ * reduction) are sunk back into branches.
+ *
+ * Quaternions are Hamilton, scalar first, as matrix::Quaternionf.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace aic_sil {
+
+/**
+ * @brief Batch of 3-vectors, one array per component
+ */
+struct Vector3Array {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    void resize(size_t n) {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+
+    size_t size() const { return x.size(); }
+};
+
+/**
+ * @brief Batch of quaternions, one array per component
+ */
+struct QuaternionArray {
+    std::vector<float> w;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    void resize(size_t n) {
+        w.resize(n);
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+
+    size_t size() const { return w.size(); }
+};
+
+/**
+ * @brief q = exp(phi): rotation by |phi| about phi / |phi| (q is resized)
+ */
+void so3_exp(const Vector3Array &phi, QuaternionArray &q);
+
+/**
+ * @brief phi = log(q) for unit quaternions, the rotation with |phi| <= pi (phi is resized)
+ */
+void so3_log(const QuaternionArray &q, Vector3Array &phi);
+
+/**
+ * @brief c = a * b (sizes of a and b must match, c is resized, distinct from a and b)
+ */
+void quat_compose(const QuaternionArray &a, const QuaternionArray &b, QuaternionArray &c);
+
+/**
+ * @brief out = q * v * q^-1 for unit quaternions (out is resized, distinct from v)
+ */
+void quat_rotate(const QuaternionArray &q, const Vector3Array &v, Vector3Array &out);
+
+/**
+ * @brief q <- q * exp(omega * dt), renormalized (body-frame rates, sizes must match)
+ */
+void so3_integrate(QuaternionArray &q, const Vector3Array &omega, float dt);
+
+} // namespace aic_sil
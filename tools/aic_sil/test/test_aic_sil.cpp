@@ -0,0 +1,1142 @@
+/**
+ * @file test_aic_sil.cpp
+ * @brief Event ordering, bounded tracking under realistic timing, dropout effects on dt, speed,
+ *        exact and cheap snapshot/fork continuations,
+ *        vibration gating of the adaptation, motor failure allocation, detection and latency,
+ *        PX4 baseline, tick log round trip and benchmark report,
+ *        extended regressor columns and CoM offset learning,
+ *        windowed excitation and windowed least-squares relearning of a payload,
+ *        inertia EKF against a dense reference, on the payload and through a torque impulse,
+ *        batched SO(3) kernels against a double-precision reference,
+ *        fleet prior warm start, boot-time configuration benchmark and base divider,
+ *        fault injection and fault campaign classification, module setpoint path under the governor,
+ *        rate setpoint messages between attitude setpoints,
+ *        notch redesign on a bandwidth change
+ */
+
+#include "../bench_report.hpp"
+#include "../controller_bench.hpp"
+#include "../fault_campaign.hpp"
+#include "../sil_campaign.hpp"
+#include "../sil_simulator.hpp"
+#include "../so3_batch.hpp"
+#include "../tick_log.hpp"
+
+#include "config_benchmark.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace aic_sil;
+using attitude_controller_aic::ExtendedFullLayout;
+using attitude_controller_aic::InertiaEKF;
+using attitude_controller_aic::InertiaEKFSettings;
+using attitude_controller_aic::Regressor;
+using attitude_controller_aic::RegressorInput;
+
+namespace {
+
+// Double-precision references (scalar first, Hamilton)
+void reference_exp(double x, double y, double z, double q[4]) {
+    const double theta = std::sqrt(x * x + y * y + z * z);
+    const double k = (theta > 0.0) ? std::sin(0.5 * theta) / theta : 0.5;
+    q[0] = std::cos(0.5 * theta);
+    q[1] = k * x;
+    q[2] = k * y;
+    q[3] = k * z;
+}
+
+void reference_product(const double a[4], const double b[4], double c[4]) {
+    c[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    c[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    c[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    c[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+}
+
+double component_error(const QuaternionArray &q, size_t i, const double r[4]) {
+    return std::fmax(std::fmax(std::fabs(q.w[i] - r[0]), std::fabs(q.x[i] - r[1])),
+                     std::fmax(std::fabs(q.y[i] - r[2]), std::fabs(q.z[i] - r[3])));
+}
+
+using EKFVector = Eigen::Matrix<double, InertiaEKF::N, 1>;
+using EKFMatrix = Eigen::Matrix<double, InertiaEKF::N, InertiaEKF::N>;
+
+// Euler step of [Omega, theta]: J * dOmega/dt = tau - Omega x (J * Omega), theta constant
+EKFVector reference_transition(const EKFVector &x, const Eigen::Vector3d &tau, double dt) {
+    Eigen::Matrix3d J;
+    J << x(3), x(6), x(7),
+         x(6), x(4), x(8),
+         x(7), x(8), x(5);
+    const Eigen::Vector3d w = x.head<3>();
+    EKFVector next = x;
+    next.head<3>() += dt * J.inverse() * (tau - w.cross(J * w));
+    return next;
+}
+
+} // namespace
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+int main() {
+    // Time order, ties in scheduling order, events scheduled from callbacks
+    EventScheduler<int> scheduler;
+    std::vector<int> order;
+    scheduler.schedule(20, 3);
+    scheduler.schedule(10, 1);
+    scheduler.schedule(30, 4);
+    const uint64_t run = scheduler.run_until(25, [&](int event) {
+        order.push_back(event);
+
+        if (event == 1) {
+            scheduler.schedule(10, 2);
+        }
+    });
+    CHECK(run == 3);
+    CHECK(scheduler.now() == 25);
+    CHECK((order == std::vector<int> {1, 2, 3}));
+    CHECK(scheduler.pending() == 1);
+
+    // Nominal multi-rate timing, governor off: dt follows the estimator rate
+    SilConfig config;
+    config.duration_s = 10.f;
+    config.module.governor_enabled = false;
+
+    SilSimulator nominal_sil(config);
+    const SilResult nominal = nominal_sil.run();
+    // Steps of 0.2 rad slew at the 0.05 Nm torque limit, so the RMS includes the transients
+    CHECK(nominal.attitude_rms < 0.15f);
+    CHECK(nominal.attitude_max < 0.35f);
+    CHECK(nominal.fallback_engaged == 0);
+    CHECK(nominal.controlled > 2000);
+    CHECK(nominal.dt_mean > 0.0039f && nominal.dt_mean < 0.0041f);
+    CHECK(nominal.dt_max < 0.01f);       // 3 ms scheduling spikes
+
+    // Same seed, same run
+    SilSimulator repeat_sil(config);
+    const SilResult repeat = repeat_sil.run();
+    CHECK(repeat.attitude_rms == nominal.attitude_rms);
+    CHECK(repeat.events == nominal.events);
+
+    // A fork shares all state blocks until written and reproduces the uninterrupted run
+    SilSimulator prefix(config);
+    prefix.run_until(4.f);
+    SilSimulator fork = prefix.fork();
+    CHECK(fork.shared_blocks(prefix) == 6);
+    const SilResult forked = fork.run();
+    CHECK(fork.shared_blocks(prefix) == 1);   // Motor commands are only written with a motor frame
+    CHECK(prefix.time() == 4.f);
+    CHECK(forked.attitude_rms == nominal.attitude_rms);
+    CHECK(forked.controlled == nominal.controlled);
+    CHECK(forked.events == nominal.events);
+
+    // Campaign varying payload inertia and noise after the prefix: same results, fewer events
+    CampaignConfig campaign;
+    campaign.base = config;
+    campaign.fork_time_s = 5.f;
+    campaign.runs = 6;
+    campaign.threads = 2;
+
+    const Variation payload_change = [&](SilSimulator &sim, size_t i) {
+        sim.set_plant_inertia(config.J_true * (1.f + 0.1f * i));
+        sim.reseed(100 + static_cast<uint32_t>(i));
+    };
+
+    const std::vector<SilResult> fast_runs = run_forked(campaign, payload_change);
+    const std::vector<SilResult> full_runs = run_from_scratch(campaign, payload_change);
+
+    SilSimulator campaign_prefix(config);
+    campaign_prefix.run_until(campaign.fork_time_s);
+    uint64_t forked_events = campaign_prefix.result().events;
+    uint64_t full_events = 0;
+
+    for (size_t i = 0; i < campaign.runs; ++i) {
+        CHECK(fast_runs[i].attitude_rms == full_runs[i].attitude_rms);
+        CHECK(fast_runs[i].events == full_runs[i].events);
+        CHECK(fast_runs[i].attitude_rms < 0.2f);
+        forked_events += fast_runs[i].events - campaign_prefix.result().events;
+        full_events += full_runs[i].events;
+    }
+
+    CHECK(fast_runs[1].attitude_rms != fast_runs[2].attitude_rms);
+    CHECK(forked_events < 0.7 * full_events);
+
+    // Estimator dropouts: longer controller intervals, still bounded tracking
+    config.estimator.dropout = 0.3f;
+    SilSimulator dropout_sil(config);
+    const SilResult dropout = dropout_sil.run();
+    CHECK(dropout.estimator_dropped > 500);
+    CHECK(dropout.dt_mean > 1.3f * nominal.dt_mean);
+    CHECK(dropout.dt_max >= 3.f * 0.004f);
+    CHECK(dropout.attitude_rms < 0.2f);
+    CHECK(dropout.fallback_engaged == 0);
+
+    // Motor vibration line on roll/pitch: gating freezes the inertia of those axes and the products,
+    // which otherwise drift off (30 s so the ungated drift is well developed)
+    SilConfig vibration = config;
+    vibration.estimator.dropout = 0.f;
+    vibration.duration_s = 30.f;
+    vibration.vibration_amplitude = 1.5f;
+    SilSimulator gated_sil(vibration);
+    const SilResult gated = gated_sil.run();
+    vibration.module.vibration_gating = false;
+    SilSimulator ungated_sil(vibration);
+    ungated_sil.run();
+    CHECK(nominal.adaptation_gated == 0);
+    CHECK(gated.adaptation_gated > gated.controlled / 2);
+    float gated_error = 0.f;
+    float ungated_error = 0.f;
+
+    for (int i = 0; i < 3; ++i) {
+        const float J_true = vibration.J_true(i);
+        gated_error = std::fmax(gated_error, std::fabs(gated_sil.core().controller().get_inertia_estimate()(i, i) - J_true));
+        ungated_error = std::fmax(ungated_error,
+                                  std::fabs(ungated_sil.core().controller().get_inertia_estimate()(i, i) - J_true));
+    }
+
+    CHECK(gated_error < 0.5f * ungated_error);
+
+    // Reduced allocations: the failed motor gets nothing, the others still hover torque-free;
+    // a quadrotor gives up yaw
+    using attitude_controller_aic::MotorAllocation;
+    using attitude_controller_aic::MotorFrame;
+    MotorAllocation allocation;
+    CHECK(allocation.configure(MotorFrame::HEX_X, attitude_controller_aic::MotorGeometry()));
+    float u[MotorAllocation::MAX_MOTORS];
+
+    for (int failed = -1; failed < allocation.motor_count(); ++failed) {
+        allocation.set_failed_motor(failed);
+        allocation.allocate(Vector3f(0.f, 0.f, 0.f), 0.5f, u);
+        CHECK(allocation.is_yaw_controllable());
+        CHECK(allocation.torque(u).norm() < 1e-4f);
+
+        float thrust = 0.f;
+
+        for (int i = 0; i < allocation.motor_count(); ++i) {
+            thrust += u[i];
+        }
+
+        CHECK(std::fabs(thrust - 3.f) < 1e-4f);
+        CHECK(failed < 0 || u[failed] == 0.f);
+    }
+
+    CHECK(allocation.configure(MotorFrame::QUAD_X, attitude_controller_aic::MotorGeometry()));
+    CHECK(allocation.is_yaw_controllable());
+    allocation.set_failed_motor(1);
+    CHECK(!allocation.is_yaw_controllable());
+    allocation.allocate(Vector3f(-0.01f, 0.02f, 0.f), 0.3f, u);
+    CHECK(u[1] == 0.f);
+    CHECK(std::fabs(allocation.torque(u)(0) + 0.01f) < 1e-4f && std::fabs(allocation.torque(u)(1) - 0.02f) < 1e-4f);
+
+    // Hexarotor motor failure: detected and reconfigured within a few ticks, the tilt stays bounded;
+    // without detection the vehicle flips. No false detection in nominal flight.
+    SilConfig hex = config;
+    hex.estimator.dropout = 0.f;
+    hex.module.motor_frame = MotorFrame::HEX_X;
+    SilSimulator hex_nominal_sil(hex);
+    const SilResult hex_nominal = hex_nominal_sil.run();
+    CHECK(hex_nominal.failure_detected_motor == -1);
+    CHECK(hex_nominal.tilt_max < 0.35f);
+
+    hex.motor_failure = 2;
+    hex.motor_failure_s = 5.f;
+    SilSimulator failure_sil(hex);
+    const SilResult failure = failure_sil.run();
+    CHECK(failure.failure_detected_motor == 2);
+    CHECK(failure.detection_latency > 0.f && failure.detection_latency < 0.03f);
+    CHECK(failure.reconfiguration_latency > 0.f && failure.reconfiguration_latency < 0.01f);
+    CHECK(failure.tilt_max < 0.4f);
+
+    hex.module.failure_detection = false;
+    SilSimulator undetected_sil(hex);
+    const SilResult undetected = undetected_sil.run();
+    CHECK(undetected.failure_detected_motor == -1);
+    CHECK(undetected.tilt_max > 1.5f);
+
+    // PX4 cascade baseline on the same scenario: bounded tracking, every message controlled
+    SilConfig baseline = config;
+    baseline.estimator.dropout = 0.f;
+    baseline.controller = SilController::PX4_CASCADE;
+    SilSimulator baseline_sil(baseline);
+    const SilResult px4 = baseline_sil.run();
+    CHECK(px4.attitude_rms < 0.15f);
+    CHECK(px4.attitude_max < 0.35f);
+    CHECK(px4.skipped == 0 && px4.controlled == nominal.controlled);   // Same message timing
+
+    // Constant disturbance in hover: the observer rejects it faster than the rate integrator
+    baseline.step_amplitude = 0.f;
+    baseline.disturbance = Vector3f(0.01f, -0.01f, 0.f);
+    SilSimulator px4_hover_sil(baseline);
+    const SilResult px4_hover = px4_hover_sil.run();
+    baseline.controller = SilController::AIC;
+    SilSimulator aic_hover_sil(baseline);
+    const SilResult aic_hover = aic_hover_sil.run();
+    CHECK(aic_hover.attitude_max < px4_hover.attitude_max);
+    CHECK(px4_hover.attitude_max < 0.01f);
+
+    // Extended regressor: inertia columns as the inertia-only kernel, extra columns as the torques they model
+    {
+        RegressorInput x;
+        x.Omega = Vector3f(0.3f, -0.7f, 1.1f);
+        x.alpha = Vector3f(2.f, -1.f, 0.5f);
+        x.thrust = 12.f;
+        x.rotor_momentum = 150.f;
+        x.rotor_momentum_rate = -40.f;
+        const auto Y = Regressor::evaluate<ExtendedFullLayout>(x);
+        const auto Y_full = Regressor::regressor_full(x.Omega, x.alpha);
+
+        const float r_x = 0.01f, r_y = -0.02f, c_z = 0.003f, J_r = 2e-5f;
+        const Vector3f h(0.f, 0.f, x.rotor_momentum);
+        const Vector3f expected = -Vector3f(r_x, r_y, 0.f).cross(Vector3f(0.f, 0.f, x.thrust))
+                                  + Vector3f(0.f, 0.f, c_z * x.Omega(2))
+                                  + J_r * (x.Omega.cross(h) + Vector3f(0.f, 0.f, x.rotor_momentum_rate));
+
+        // Sign convention: Euler's equations solved for the torque, as the plant and the EKF integrate them
+        Matrix3f J;
+        J(0, 0) = 0.045f;
+        J(1, 1) = 0.05f;
+        J(2, 2) = 0.028f;
+        J(0, 1) = J(1, 0) = 0.002f;
+        J(0, 2) = J(2, 0) = -0.001f;
+        J(1, 2) = J(2, 1) = 0.003f;
+        const float theta[6] = {J(0, 0), J(1, 1), J(2, 2), J(0, 1), J(0, 2), J(1, 2)};
+        const Vector3f tau_rb = J * x.alpha + x.Omega.cross(J * x.Omega);
+
+        for (int i = 0; i < 3; ++i) {
+            float tau_inertia = 0.f;
+
+            for (int j = 0; j < 6; ++j) {
+                CHECK(Y(i, j) == Y_full(i, j));
+                tau_inertia += Y_full(i, j) * theta[j];
+            }
+
+            CHECK(std::fabs(tau_inertia - tau_rb(i)) < 1e-6f);
+
+            const float tau = Y(i, ExtendedFullLayout::COM) * r_x + Y(i, ExtendedFullLayout::COM + 1) * r_y
+                              + Y(i, ExtendedFullLayout::DRAG) * c_z + Y(i, ExtendedFullLayout::ROTOR) * J_r;
+            CHECK(std::fabs(tau - expected(i)) < 1e-6f);
+        }
+    }
+
+    // Off-center payload in hover (0.01 Nm at hover thrust), no observer: the inertia-only model leaves
+    // the bias to the feedback, the extended model learns the CoM offset (leakage keeps it somewhat short)
+    SilConfig payload = baseline;
+    payload.disturbance = Vector3f(0.f, 0.f, 0.f);
+    payload.com_offset = Vector3f(0.02f, 0.02f, 0.f);
+    payload.disturbance_observer = false;
+    payload.duration_s = 30.f;
+    SilSimulator inertia_only_sil(payload);
+    const SilResult inertia_only = inertia_only_sil.run();
+    payload.extended_model = true;
+    SilSimulator extended_sil(payload);
+    const SilResult extended = extended_sil.run();
+    const Vector3f r_hat = extended_sil.core().controller().get_com_offset_estimate();
+    CHECK(r_hat(0) > 0.01f && r_hat(0) < 0.025f && r_hat(1) > 0.01f && r_hat(1) < 0.025f);
+    CHECK(extended.attitude_rms < 0.6f * inertia_only.attitude_rms);
+
+    // Spinning plant (heading turning at 1 rad/s under the roll/pitch steps): the windowed fit of the
+    // regressor and the EKF model are the same equations, so both land on the plant inertia together
+    {
+        SilConfig spin;
+        spin.duration_s = 10.f;
+        spin.spin_rate = 1.f;
+        spin.estimator_mode = attitude_controller_aic::EstimatorMode::WINDOWED_LS;
+        SilSimulator spin_ls_sil(spin);
+        const SilResult spin_ls = spin_ls_sil.run();
+        spin.estimator_mode = attitude_controller_aic::EstimatorMode::EKF;
+        SilSimulator spin_ekf_sil(spin);
+        const SilResult spin_ekf = spin_ekf_sil.run();
+        const Matrix3f J_ls = spin_ls_sil.core().controller().get_inertia_estimate();
+        const Matrix3f J_ekf = spin_ekf_sil.core().controller().get_inertia_estimate();
+        CHECK(spin_ls.fallback_engaged == 0 && spin_ekf.fallback_engaged == 0);
+        CHECK(std::fabs(spin_ekf_sil.plant().angular_velocity()(2) - spin.spin_rate) < 0.2f);
+
+        for (int i = 0; i < 3; ++i) {
+            CHECK(std::fabs(J_ls(i, i) - J_ekf(i, i)) / J_ekf(i, i) < 0.15f);
+            CHECK(std::fabs(J_ls(i, i) - spin.J_true(i)) / spin.J_true(i) < 0.15f);
+            CHECK(std::fabs(J_ekf(i, i) - spin.J_true(i)) / spin.J_true(i) < 0.15f);
+        }
+    }
+
+    // Windowed excitation follows the recent flight: set after steps, cleared after a
+    // window of hover, while the information accumulated since boot only grows
+    SilConfig window_config;
+    window_config.duration_s = 6.f;
+    SilSimulator maneuvering(window_config);
+    maneuvering.run();
+    CHECK(maneuvering.core().controller().is_persistently_excited());
+    const float accumulated = maneuvering.core().controller().get_information_quality();
+    SilSimulator hovering = maneuvering.fork();
+    hovering.set_setpoint_steps(0.f, 2.f);
+    hovering.set_duration(10.f);
+    hovering.run();
+    CHECK(!hovering.core().controller().is_persistently_excited());
+    CHECK(hovering.core().controller().get_window_excitation() < 0.2f * window_config.pe_threshold);
+    CHECK(hovering.core().controller().get_information_quality() >= accumulated);
+
+    // Payload 1.5x from the start: the windowed fit reaches the loaded inertia, the gradient does not
+    window_config.duration_s = 8.f;
+    window_config.J_true = window_config.J_true * 1.5f;
+    SilSimulator payload_iwg_sil(window_config);
+    const SilResult payload_iwg = payload_iwg_sil.run();
+    window_config.estimator_mode = attitude_controller_aic::EstimatorMode::WINDOWED_LS;
+    SilSimulator payload_ls_sil(window_config);
+    const SilResult payload_ls = payload_ls_sil.run();
+    const Matrix3f J_iwg = payload_iwg_sil.core().controller().get_inertia_estimate();
+    const Matrix3f J_ls = payload_ls_sil.core().controller().get_inertia_estimate();
+    CHECK(payload_ls.fallback_engaged == 0 && payload_ls.excited > 0);
+
+    float error_iwg = 0.f;
+    float error_ls = 0.f;
+
+    for (int i = 0; i < 3; ++i) {
+        const float error = std::fabs(J_ls(i, i) - window_config.J_true(i)) / window_config.J_true(i);
+        CHECK(error < 0.15f);
+        error_ls += error;
+        error_iwg += std::fabs(J_iwg(i, i) - window_config.J_true(i)) / window_config.J_true(i);
+    }
+
+    CHECK(error_ls < 0.5f * error_iwg);
+
+    CHECK(payload_ls.attitude_rms <= payload_iwg.attitude_rms);
+
+    // Same payload, rate and inertia EKF: roll learned at the first step (before the window fills),
+    // all principal moments within 10 %, the inertia variance shrunk from the initial uncertainty
+    {
+        window_config.estimator_mode = attitude_controller_aic::EstimatorMode::EKF;
+        SilSimulator payload_ekf_sil(window_config);
+        float variance_initial[6];
+        CHECK(payload_ekf_sil.core().controller().get_inertia_variance(variance_initial));
+        payload_ekf_sil.run_until(3.f);
+        const float error_ekf_early = std::fabs(payload_ekf_sil.core().controller().get_inertia_estimate()(0, 0)
+                                                - window_config.J_true(0)) / window_config.J_true(0);
+        CHECK(error_ekf_early < 0.1f);
+
+        const SilResult payload_ekf = payload_ekf_sil.run();
+        const Matrix3f J_ekf = payload_ekf_sil.core().controller().get_inertia_estimate();
+        float variance[6];
+        CHECK(payload_ekf_sil.core().controller().get_inertia_variance(variance));
+        CHECK(payload_ekf.fallback_engaged == 0 && payload_ekf_sil.core().controller().get_ekf_rejections() == 0);
+
+        for (int i = 0; i < 3; ++i) {
+            CHECK(std::fabs(J_ekf(i, i) - window_config.J_true(i)) / window_config.J_true(i) < 0.1f);
+            CHECK(std::isfinite(variance[i]) && variance[i] < 0.1f * variance_initial[i]);
+        }
+
+        CHECK(payload_ekf.attitude_rms <= payload_ls.attitude_rms);
+        CHECK(!payload_iwg_sil.core().controller().get_inertia_variance(variance));
+
+        // Roll torque impulse the EKF model does not know about (0.2 Nm for 0.1 s): the innovations leave
+        // the gate, the rates restart after a run of rejections instead of locking the filter out, and
+        // the inertia learning carries on to all principal moments within 10 %
+        SilSimulator impulse_sil(window_config);
+        impulse_sil.run_until(3.f);
+        impulse_sil.set_disturbance(Vector3f(0.2f, 0.f, 0.f));
+        impulse_sil.run_until(3.1f);
+        impulse_sil.set_disturbance(Vector3f(0.f, 0.f, 0.f));
+        impulse_sil.run_until(4.f);
+        const uint32_t impulse_rejections = impulse_sil.core().controller().get_ekf_rejections();
+        impulse_sil.run();
+        const Matrix3f J_impulse = impulse_sil.core().controller().get_inertia_estimate();
+        CHECK(impulse_rejections > 0 && impulse_sil.core().controller().get_ekf_resyncs() >= 1);
+        CHECK(impulse_sil.core().controller().get_ekf_rejections() == impulse_rejections);
+
+        for (int i = 0; i < 3; ++i) {
+            CHECK(std::fabs(J_impulse(i, i) - window_config.J_true(i)) / window_config.J_true(i) < 0.1f);
+        }
+    }
+
+    // EKF steps against a dense 9x9 reference in double: F by central differences of the transition,
+    // P' = F * P * F^T + Q, then the full-covariance gyro update
+    {
+        InertiaEKFSettings settings;
+        settings.inertia_drift = 0.f;
+        InertiaEKF ekf;
+        Matrix3f J_init;
+        J_init(0, 0) = 0.04f;
+        J_init(1, 1) = 0.05f;
+        J_init(2, 2) = 0.03f;
+        J_init(0, 1) = J_init(1, 0) = 0.004f;
+        J_init(0, 2) = J_init(2, 0) = -0.002f;
+        J_init(1, 2) = J_init(2, 1) = 0.003f;
+        ekf.init(J_init, settings);
+        ekf.restart_rate(Vector3f(0.5f, -0.3f, 0.8f));
+
+        EKFVector x;
+        EKFMatrix P;
+
+        for (int i = 0; i < InertiaEKF::N; ++i) {
+            x(i) = (i < 3) ? ekf.rate()(i) : ekf.parameter(i - 3);
+
+            for (int j = 0; j < InertiaEKF::N; ++j) {
+                P(i, j) = ekf.covariance(i, j);
+            }
+        }
+
+        const double dt = 0.004;
+        const float weights[3] = {1.f, 1.f, 1.f};
+        const double R = settings.gyro_noise * settings.gyro_noise;
+        double state_error = 0.0;
+        double covariance_error = 0.0;
+
+        for (int k = 0; k < 50; ++k) {
+            const Eigen::Vector3d tau(0.02 * std::sin(0.3 * k), -0.015 * std::cos(0.2 * k), 0.01);
+            EKFMatrix F;
+
+            for (int j = 0; j < InertiaEKF::N; ++j) {
+                const double h = 1e-6 * std::fmax(1.0, std::fabs(x(j)));
+                EKFVector plus = x;
+                EKFVector minus = x;
+                plus(j) += h;
+                minus(j) -= h;
+                F.col(j) = (reference_transition(plus, tau, dt) - reference_transition(minus, tau, dt)) / (2.0 * h);
+            }
+
+            x = reference_transition(x, tau, dt);
+            P = F * P * F.transpose();
+            P.topLeftCorner<3, 3>() += Eigen::Matrix3d::Identity() * settings.acceleration_noise
+                                       * settings.acceleration_noise * dt;
+            ekf.predict(Vector3f(tau(0), tau(1), tau(2)), static_cast<float>(dt));
+
+            const Eigen::Vector3d z = x.head<3>() + Eigen::Vector3d(0.004 * std::sin(1.7 * k), 0.003, -0.002);
+            const Eigen::Matrix3d S = P.topLeftCorner<3, 3>() + R * Eigen::Matrix3d::Identity();
+            const Eigen::Matrix<double, InertiaEKF::N, 3> K = P.leftCols<3>() * S.inverse();
+            x += K * (z - x.head<3>());
+            P -= K * P.topRows<3>();
+            CHECK(ekf.update(Vector3f(z(0), z(1), z(2)), weights));
+
+            for (int i = 0; i < InertiaEKF::N; ++i) {
+                const double value = (i < 3) ? ekf.rate()(i) : ekf.parameter(i - 3);
+                state_error = std::fmax(state_error, std::fabs(value - x(i)) / std::sqrt(P(i, i)));
+
+                for (int j = 0; j < InertiaEKF::N; ++j) {
+                    covariance_error = std::fmax(covariance_error, std::fabs(ekf.covariance(i, j) - P(i, j))
+                                                 / std::sqrt(P(i, i) * P(j, j)));
+                }
+            }
+        }
+
+        CHECK(state_error < 1e-2);
+        CHECK(covariance_error < 1e-3);
+        CHECK(ekf.rejected() == 0);
+    }
+
+    // Setpoint terms cached across ticks of one setpoint message: same torque as recomputing them,
+    // and a gain change takes effect without a new setpoint
+    {
+        std::unique_ptr<ModuleCore> cached(new ModuleCore());
+        std::unique_ptr<ModuleCore> direct(new ModuleCore());
+        SilSimulator::setup_module(*cached, baseline);
+        SilSimulator::setup_module(*direct, baseline);
+        float max_error = 0.f;
+        Matrix3f R_d;
+
+        auto rotation = [](const Vector3f &axis, float angle) {
+            const Vector3f v = axis.normalized() * std::sin(0.5f * angle);
+            return Quaternionf(std::cos(0.5f * angle), v(0), v(1), v(2));
+        };
+
+        for (int k = 0; k < 400; ++k) {
+            const float t = 0.004f * k;
+            const Quaternionf q = rotation(Vector3f(0.3f, -0.2f, 0.9f), 0.2f * std::sin(3.f * t));
+            const Vector3f omega(0.4f * std::cos(3.f * t), -0.3f * std::sin(2.f * t), 0.1f);
+            const uint32_t sequence = 1 + k / 4;   // 250 Hz loop, 62.5 Hz setpoint
+            const Vector3f Omega_d(0.1f * sequence, 0.f, -0.05f);
+            const Vector3f dot_Omega_d(0.f, 0.02f * sequence, 0.f);
+
+            if (k % 4 == 0) {
+                R_d = rotation(Vector3f(0.f, 0.f, 1.f), 0.01f * sequence).to_dcm();
+            }
+
+            if (k == 200) {
+                const Vector3f K_R(6.f, 6.f, 3.5f);
+                const Vector3f K_Omega(0.4f, 0.4f, 0.25f);
+                const Vector3f K(0.15f, 0.15f, 0.1f);
+                cached->controller().set_control_gains(K_R, K_Omega, K, 2.f);
+                direct->controller().set_control_gains(K_R, K_Omega, K, 2.f);
+                CHECK(std::fabs(cached->controller().get_rate_loop_gain() - direct->controller().get_rate_loop_gain())
+                      < 1e-6f * direct->controller().get_rate_loop_gain());
+            }
+
+            const Vector3f tau_cached = cached->controller().compute_torque(q.to_dcm(), omega, R_d, Omega_d, dot_Omega_d,
+                                        0.004f, sequence);
+            const Vector3f tau_direct = direct->controller().compute_torque(q.to_dcm(), omega, R_d, Omega_d, dot_Omega_d,
+                                        0.004f);
+            max_error = std::max(max_error, (tau_cached - tau_direct).norm());
+        }
+
+        CHECK(max_error < 1e-6f);
+
+        // Same sequence: the terms of the first call are kept, as if the first setpoint were passed again
+        SilSimulator::setup_module(*cached, baseline);
+        SilSimulator::setup_module(*direct, baseline);
+        const Vector3f Omega_d_first(1.f, 0.f, 0.f);
+        Vector3f tau_stale;
+        Vector3f tau_repeated;
+
+        for (int k = 0; k < 2; ++k) {
+            tau_stale = cached->controller().compute_torque(Matrix3f::Identity(), Vector3f(), Matrix3f::Identity(),
+                        (k == 0) ? Omega_d_first : Vector3f(), Vector3f(), 0.004f, 1000);
+            tau_repeated = direct->controller().compute_torque(Matrix3f::Identity(), Vector3f(), Matrix3f::Identity(),
+                           Omega_d_first, Vector3f(), 0.004f);
+        }
+
+        CHECK(tau_repeated.norm() > 0.f && (tau_stale - tau_repeated).norm() < 1e-7f);
+    }
+
+    // Warm start from a fleet prior: the informative prior holds the estimate near the prior inertia on
+    // the same inputs, and the information gathered in flight excludes the prior
+    {
+        std::unique_ptr<ModuleCore> cold(new ModuleCore());
+        std::unique_ptr<ModuleCore> warm(new ModuleCore());
+        SilSimulator::setup_module(*cold, baseline);
+        SilSimulator::setup_module(*warm, baseline);
+        const Matrix3f J_prior = cold->controller().get_inertia_estimate();
+        const float prior_information[6] = {1e3f, 1e3f, 1e3f, 0.f, 0.f, 0.f};
+        warm->controller().set_inertia_prior(J_prior, prior_information);
+
+        for (int k = 0; k < 1000; ++k) {
+            const float t = 0.004f * k;
+            const Vector3f omega(1.5f * std::sin(4.f * t), -1.2f * std::cos(3.f * t), 0.8f * std::sin(2.f * t));
+
+            for (ModuleCore *core : {cold.get(), warm.get()}) {
+                core->controller().compute_torque(Matrix3f::Identity(), omega, Matrix3f::Identity(), Vector3f(),
+                                                  Vector3f(), 0.004f);
+            }
+        }
+
+        float information_cold[6];
+        float information_warm[6];
+        cold->controller().get_gathered_information(information_cold);
+        warm->controller().get_gathered_information(information_warm);
+        const Matrix3f J_cold = cold->controller().get_inertia_estimate();
+        const Matrix3f J_warm = warm->controller().get_inertia_estimate();
+
+        for (int i = 0; i < 3; ++i) {
+            CHECK(information_cold[i] > 0.f);
+            CHECK(std::fabs(information_warm[i] - information_cold[i]) < 0.05f * information_cold[i]);
+            CHECK(std::fabs(J_warm(i, i) - J_prior(i, i)) < 0.5f * std::fabs(J_cold(i, i) - J_prior(i, i)));
+        }
+    }
+
+    // Boot-time benchmark: every model timed, the richest configuration within the budget chosen,
+    // the base divider honored with and without the rate governor
+    {
+        using attitude_controller_aic::BENCH_MODELS;
+        using attitude_controller_aic::ConfigurationChoice;
+        using attitude_controller_aic::EstimatorMode;
+        using attitude_controller_aic::select_configuration;
+
+        std::unique_ptr<ModuleCore> scratch(new ModuleCore());
+        SilSimulator::setup_module(*scratch, baseline);
+        float compute_us[BENCH_MODELS];
+        const auto now_us = []() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                             std::chrono::steady_clock::now().time_since_epoch()).count());
+        };
+        attitude_controller_aic::benchmark_models(scratch->controller(), scratch->controller().get_inertia_estimate(),
+                now_us, attitude_controller_aic::BenchmarkSettings(), compute_us);
+
+        for (int model = 0; model < BENCH_MODELS; ++model) {
+            CHECK(std::isfinite(compute_us[model]) && compute_us[model] >= 0.f && compute_us[model] < 1000.f);
+        }
+
+        // Full-rate, full model with windowed LS costs 20 us: ample budget, then tighter and tighter
+        const float costs[BENCH_MODELS] = {20.f, 16.f, 6.f, 5.f};
+        ConfigurationChoice choice = select_configuration(costs, 0xf, 0.004f, 4, 0.2f, 1.5f);
+        CHECK(choice.valid && choice.within_budget && choice.config.full_inertia);
+        CHECK(choice.config.estimator == EstimatorMode::WINDOWED_LS && choice.config.divider == 1);
+
+        choice = select_configuration(costs, 0xf, 0.001f, 4, 0.2f, 1.5f);   // 1 kHz messages: 200 us budget
+        CHECK(choice.config.full_inertia && choice.config.divider == 1);
+        choice = select_configuration(costs, 0xf, 0.0001f, 4, 0.2f, 1.5f);  // 20 us budget: diagonal model
+        CHECK(!choice.config.full_inertia && choice.config.estimator == EstimatorMode::WINDOWED_LS);
+        CHECK(choice.config.divider == 1 && std::fabs(choice.load - 0.09f) < 1e-4f);
+        const float slow_window[BENCH_MODELS] = {20.f, 16.f, 14.f, 5.f};
+        choice = select_configuration(slow_window, 0xf, 0.0001f, 4, 0.2f, 1.5f);
+        CHECK(!choice.config.full_inertia && choice.config.estimator == EstimatorMode::IWG);
+        CHECK(choice.config.divider == 1 && std::fabs(choice.load - 0.075f) < 1e-4f);
+        choice = select_configuration(costs, 0x3, 0.0001f, 4, 0.2f, 1.5f);  // Full model only: lower rate
+        CHECK(choice.within_budget && choice.config.full_inertia && choice.config.divider == 2);
+        choice = select_configuration(costs, 0xf, 0.00001f, 2, 0.2f, 1.5f); // Nothing fits
+        CHECK(choice.valid && !choice.within_budget && choice.config.divider == 2 && !choice.config.full_inertia);
+        CHECK(!select_configuration(costs, 0, 0.004f, 4, 0.2f, 1.5f).valid);
+
+        // Base divider 2 without the governor: every second message exactly; base 3 with it
+        for (bool governor : {false, true}) {
+            std::unique_ptr<ModuleCore> core(new ModuleCore());
+            SilConfig config = baseline;
+            config.module.governor_enabled = governor;
+            SilSimulator::setup_module(*core, config);
+            const int divider = governor ? 3 : 2;
+            core->rate_governor().set_base_divider(divider);
+            attitude_controller_aic::AICModuleInput input;
+            input.setpoint_sequence = 1;
+            int controlled = 0;
+            int last = -100;
+            int shortest = 100;
+
+            for (int k = 0; k < 600; ++k) {
+                Vector3f tau;
+
+                if (core->update(1000000ull + 4000ull * k, input, tau).controlled) {
+                    shortest = std::min(shortest, k - last);
+                    last = k;
+                    ++controlled;
+                }
+            }
+
+            CHECK(shortest >= divider);
+            CHECK(governor ? (controlled <= 600 / divider) : (controlled == 599 / divider));
+            CHECK(core->rate_governor().get_over_budget_messages() == 0);
+        }
+
+        // Base divider 4 against a margin that only admits every message: the stability bound wins and
+        // the messages over the CPU budget are counted
+        for (bool governor : {false, true}) {
+            std::unique_ptr<ModuleCore> core(new ModuleCore());
+            SilConfig config = baseline;
+            config.module.governor_enabled = governor;
+            SilSimulator::setup_module(*core, config);
+            core->rate_governor().set_base_divider(4);
+            core->rate_governor().set_parameters(8, 2, 0.02f, 0.3f, 0.01f);
+            attitude_controller_aic::AICModuleInput input;
+            input.setpoint_sequence = 1;
+            int controlled = 0;
+
+            for (int k = 0; k < 600; ++k) {
+                Vector3f tau;
+                controlled += core->update(1000000ull + 4000ull * k, input, tau).controlled ? 1 : 0;
+            }
+
+            CHECK(core->rate_governor().max_stable_divider() == 1);
+            CHECK(controlled > 550);
+            CHECK(core->rate_governor().get_over_budget_messages() > 500);
+        }
+    }
+
+    // Notch redesign on a bandwidth change alone (same center and rate): a wider notch takes more of a
+    // tone 10 Hz off the center
+    {
+        attitude_controller_aic::FilterBank bank;
+        float amplitude[2];
+
+        for (int pass = 0; pass < 2; ++pass) {
+            bank.set_notch(0, 100.f, (pass == 0) ? 10.f : 60.f, 1000.f);
+            amplitude[pass] = 0.f;
+
+            for (int k = 0; k < 2000; ++k) {
+                const float x = std::sin(2.f * static_cast<float>(M_PI) * 90.f * 0.001f * k);
+                const float y = bank.apply(Vector3f(x, 0.f, 0.f))(0);
+                amplitude[pass] = (k >= 1000) ? std::fmax(amplitude[pass], std::fabs(y)) : 0.f;
+            }
+        }
+
+        CHECK(amplitude[0] > 0.6f && amplitude[1] < 0.5f * amplitude[0]);
+    }
+
+    // Module setpoint path: a held heading of 1 rad with a zero rate setpoint lets the governor leave
+    // AGILE (the Euler angles of the attitude setpoint must not be taken for rates)
+    {
+        struct AttitudeSetpointMessage {
+            float q_d[4];
+            float roll_body, pitch_body, yaw_body;
+            float thrust_body[3];
+        };
+
+        struct RatesSetpointMessage {
+            float roll, pitch, yaw;
+        };
+
+        const float yaw = 1.f;
+        const AttitudeSetpointMessage attitude{{std::cos(0.5f * yaw), 0.f, 0.f, std::sin(0.5f * yaw)},
+            0.f, 0.f, yaw, {0.f, 0.f, -0.5f}};
+        const RatesSetpointMessage rates{0.f, 0.f, 0.f};
+
+        std::unique_ptr<ModuleCore> core(new ModuleCore());
+        SilConfig governed = baseline;
+        governed.module.governor_enabled = true;
+        SilSimulator::setup_module(*core, governed);
+        attitude_controller_aic::AICModuleInput input;
+        attitude_controller_aic::set_setpoint_input(input, attitude, rates);
+        input.q = input.q_d;
+        input.setpoint_sequence = 1;
+        CHECK(input.omega_d.norm() == 0.f && input.thrust == 0.5f);
+        int controlled = 0;
+
+        for (int k = 0; k < 500; ++k) {
+            input.omega = Vector3f(0.002f * std::sin(0.7f * k), -0.002f, 0.001f);
+            Vector3f tau;
+            controlled += core->update(1000000ull + 4000ull * k, input, tau).controlled ? 1 : 0;
+        }
+
+        CHECK(core->rate_governor().get_phase() == attitude_controller_aic::RateGovernor::Phase::CRUISE);
+        CHECK(controlled < 400);
+    }
+
+    // Rate setpoint messages without a new attitude setpoint (that stream is lost after the initial one):
+    // a yaw rate setpoint reaches the control law right away, and the level attitude setpoint then holds
+    // the heading at an offset, instead of the cached setpoint terms keeping a zero rate setpoint
+    {
+        SilConfig rates;
+        rates.duration_s = 4.f;
+        rates.module.governor_enabled = false;
+        rates.step_amplitude = 0.f;
+        rates.setpoint.dropout = 1.f;
+        SilSimulator rates_sil(rates);
+        rates_sil.run_until(2.f);
+        rates_sil.set_rate_setpoint(Vector3f(0.f, 0.f, 0.5f));
+        rates_sil.run_until(2.1f);
+        CHECK(rates_sil.plant().angular_velocity()(2) > 0.1f);
+        rates_sil.run();
+        const Quaternionf q = rates_sil.plant().attitude();
+        CHECK(2.f * std::atan2(q(3), q(0)) > 0.03f);
+    }
+
+    // Faults act on their streams only: a fault-free run with scoring is the nominal run, dropouts and
+    // clock glitches push dt past the clamp, NaN attitude latches the fallback, bit flips are reversible
+    {
+        SilConfig clean;
+        clean.duration_s = 10.f;
+        clean.module.governor_enabled = false;
+        clean.evaluation_start_s = 8.f;
+        SilSimulator clean_sil(clean);
+        const SilResult reference = clean_sil.run();
+        CHECK(reference.attitude_rms == nominal.attitude_rms && reference.faulted_messages == 0);
+        CHECK(reference.evaluation_rms > 0.f && !reference.diverged && !reference.fallback_active);
+
+        auto faulted = [&clean](FaultKind kind, float start_s, float duration_s, float magnitude) {
+            SilSimulator sim(clean);
+            sim.run_until(5.f);
+            FaultSpec fault;
+            fault.kind = kind;
+            fault.start_s = start_s;
+            fault.duration_s = duration_s;
+            fault.magnitude = magnitude;
+            sim.inject_fault(fault);
+            return sim.run();
+        };
+
+        const SilResult late = faulted(FaultKind::NAN_BURST, 4.f, 1.f, 0.f);   // Before the current time
+        CHECK(late.attitude_rms == reference.attitude_rms && late.faulted_messages == 0);
+
+        const SilResult sensor = faulted(FaultKind::SENSOR_DROPOUT, 6.f, 0.3f, 0.f);
+        CHECK(sensor.faulted_messages >= 74 && sensor.faulted_messages <= 76);
+        CHECK(sensor.dt_max > 0.3f && sensor.dt_clamped >= 1);
+
+        for (float offset : {0.5f, -0.5f}) {
+            // Clamped on the jump and on the jump back
+            const SilResult clock = faulted(FaultKind::DT_SPIKE, 6.f, 0.2f, offset);
+            CHECK(clock.faulted_messages >= 45 && clock.dt_clamped >= 2);
+            CHECK(clock.dt_max < 0.01f);    // The simulation clock is unaffected
+        }
+
+        const SilResult stale = faulted(FaultKind::STALE_SETPOINT, 5.9f, 0.5f, 0.f);
+        CHECK(stale.faulted_messages >= 24 && stale.faulted_messages <= 26);
+        CHECK(stale.attitude_rms > reference.attitude_rms);    // Misses the step at 6 s for 0.4 s
+
+        const SilResult nan = faulted(FaultKind::NAN_BURST, 6.f, 0.02f, 0.f);
+        CHECK(nan.fallback_engaged >= 1 && nan.fallback_active && !nan.diverged);
+        CHECK(classify(nan, reference, OutcomeThresholds()) == FaultOutcome::DEGRADED);
+
+        const SilResult loss = faulted(FaultKind::ACTUATOR_LOSS, 5.9f, 0.3f, 1.f);
+        CHECK(loss.attitude_rms > reference.attitude_rms && !loss.fallback_active);
+        CHECK(classify(loss, reference, OutcomeThresholds()) == FaultOutcome::RECOVERED);
+
+        SilResult diverged = reference;
+        diverged.diverged = true;
+        CHECK(classify(diverged, reference, OutcomeThresholds()) == FaultOutcome::LOST);
+
+        attitude_controller_aic::AttitudeControllerAIC flipped;
+        Matrix3f J_init;
+        J_init.setZero();
+        J_init(0, 0) = J_init(1, 1) = 0.04f;
+        J_init(2, 2) = 0.025f;
+        flipped.init(J_init, true, true);
+        CHECK(flipped.get_estimator_state_words() == 3 + 3 * 3);
+        flipped.flip_estimator_bit(0, 30);
+        CHECK(flipped.get_inertia_estimate()(0, 0) != 0.04f);
+        flipped.flip_estimator_bit(0, 30);
+        CHECK(flipped.get_inertia_estimate()(0, 0) == 0.04f);
+        flipped.flip_estimator_bit(flipped.get_estimator_state_words(), 30);   // Out of range: ignored
+        CHECK(flipped.get_inertia_estimate()(0, 0) == 0.04f);
+
+        // Campaign: faults within the window, reference = the fault-free run, same outcomes on any
+        // number of threads, every kind drawn
+        FaultCampaignConfig faults;
+        faults.campaign.base = clean;
+        faults.campaign.fork_time_s = 4.f;
+        faults.campaign.runs = 24;
+        faults.campaign.threads = 1;
+        faults.fault_window_s = 2.f;
+        faults.settle_s = 2.f;
+        faults.max_faults = 2;
+        faults.keep_recovered = true;
+        const FaultCampaignResult serial = run_fault_campaign(faults);
+        faults.campaign.threads = 3;
+        const FaultCampaignResult parallel = run_fault_campaign(faults);
+
+        CHECK(serial.reference.evaluation_rms == reference.evaluation_rms);
+        CHECK(serial.runs.size() == 24 && parallel.runs.size() == 24);
+        CHECK(serial.totals[0] + serial.totals[1] + serial.totals[2] == 24);
+        bool drawn[FAULT_KINDS] {};
+
+        for (size_t i = 0; i < serial.runs.size(); ++i) {
+            const FaultRun &run = serial.runs[i];
+            CHECK(run.index == i && run.fault_count >= 1 && run.fault_count <= 2);
+            CHECK(parallel.runs[i].outcome == run.outcome && parallel.runs[i].evaluation_rms == run.evaluation_rms);
+
+            for (int f = 0; f < run.fault_count; ++f) {
+                const FaultSpec &fault = run.faults[f];
+                CHECK(fault.start_s >= 4.f && fault.start_s + fault.duration_s <= 6.f + 1e-4f);
+                drawn[static_cast<int>(fault.kind)] = true;
+
+                // The envelope latches on NaN attitude until landing
+                CHECK(fault.kind != FaultKind::NAN_BURST || run.outcome != FaultOutcome::RECOVERED);
+            }
+        }
+
+        for (int kind = 0; kind < FAULT_KINDS; ++kind) {
+            CHECK(drawn[kind]);
+        }
+
+        // Only the kinds asked for, only the runs that did not recover
+        faults.kinds = 1u << static_cast<int>(FaultKind::NAN_BURST);
+        faults.keep_recovered = false;
+        faults.campaign.runs = 4;
+        const FaultCampaignResult nan_only = run_fault_campaign(faults);
+        CHECK(nan_only.outcomes[static_cast<int>(FaultKind::NAN_BURST)][0] == nan_only.totals[0]);
+        CHECK(nan_only.runs.size() == 4 - nan_only.totals[0]);
+
+        for (int kind = 0; kind < FAULT_KINDS; ++kind) {
+            CHECK(kind == static_cast<int>(FaultKind::NAN_BURST)
+                  || nan_only.outcomes[kind][0] + nan_only.outcomes[kind][1] + nan_only.outcomes[kind][2] == 0);
+        }
+
+        printf("aic sil: fault campaign of %zu runs: %llu recovered, %llu degraded, %llu lost\n", serial.runs.size(),
+               (unsigned long long)serial.totals[0], (unsigned long long)serial.totals[1],
+               (unsigned long long)serial.totals[2]);
+    }
+
+    // Recorded inputs survive the CSV round trip and replay through every controller
+    SilConfig recorded = baseline;
+    recorded.duration_s = 2.f;
+    recorded.record_ticks = true;
+    SilSimulator recorded_sil(recorded);
+    const SilResult recorded_result = recorded_sil.run();
+    CHECK(recorded_sil.ticks().size() == recorded_result.controlled);
+
+    const std::string log_path = "test_aic_sil_ticks.csv";
+    CHECK(write_tick_log(log_path, recorded_sil.ticks()));
+    std::vector<TickRecord> ticks;
+    std::string error;
+    CHECK(read_tick_log(log_path, ticks, error));
+    CHECK(ticks.size() == recorded_sil.ticks().size());
+    CHECK(ticks.back().time_us == recorded_sil.ticks().back().time_us);
+    CHECK(std::fabs(ticks.back().q(1) - recorded_sil.ticks().back().q(1)) < 1e-6f);
+    CHECK(std::fabs(ticks.back().omega(0) - recorded_sil.ticks().back().omega(0)) < 1e-6f);
+
+    // ulog2csv column names in another order; the setpoint is optional
+    {
+        std::ofstream log(log_path);
+        log << "timestamp,xyz[0],xyz[1],xyz[2],q[0],q[1],q[2],q[3]\n"
+            << "1000,0.1,0.2,0.3,1,0,0,0\n"
+            << "500,0,0,0,1,0,0,0\n"          // Out of order: skipped
+            << "2000,0.1,nan,0.3,1,0,0,0\n"   // Non-finite: skipped
+            << "3000,0.1,0.2,0.3,0.7071068,0.7071068,0,0\r\n";
+    }
+
+    CHECK(read_tick_log(log_path, ticks, error));
+    CHECK(ticks.size() == 2);
+    CHECK(ticks[0].omega(1) == 0.2f && ticks[1].time_us == 3000 && ticks[1].q_d(0) == 1.f);
+    std::remove(log_path.c_str());
+    CHECK(!read_tick_log(log_path, ticks, error));
+
+    BenchReport report;
+    report.passes = 2;
+    CostComparison cost;
+    cost.source = "test \"log\"";
+
+    for (int i = 0; i < BENCH_CONTROLLER_COUNT; ++i) {
+        cost.cost[i] = replay_ticks(recorded_sil.ticks(), static_cast<BenchController>(i), config, report.passes);
+        CHECK(cost.cost[i].ticks == 2 * recorded_sil.ticks().size());
+        CHECK(cost.cost[i].ns_mean > 0.0 && cost.cost[i].ns_p50 <= cost.cost[i].ns_p99);
+        CHECK(cost.cost[i].torque_rms > 0.f);
+    }
+
+    CHECK(bench_state_bytes(BenchController::PX4_CASCADE) < bench_state_bytes(BenchController::AIC_CONTROLLER));
+    report.costs.push_back(cost);
+    ScenarioComparison scenario;
+    scenario.name = "nominal";
+    scenario.aic = nominal;
+    scenario.px4 = px4;
+    report.scenarios.push_back(scenario);
+    CHECK(write_json_report("test_aic_sil_report.json", report));
+    CHECK(write_markdown_report("test_aic_sil_report.md", report));
+    {
+        std::ifstream json("test_aic_sil_report.json");
+        const std::string text((std::istreambuf_iterator<char>(json)), std::istreambuf_iterator<char>());
+        CHECK(text.find("\"source\": \"test \\\"log\\\"\"") != std::string::npos);
+        CHECK(text.find("\"px4_cascade\": {\"attitude_rms_deg\"") != std::string::npos);
+    }
+    std::remove("test_aic_sil_report.json");
+    std::remove("test_aic_sil_report.md");
+
+    // Batched SO(3) kernels: angles log-uniform over 1e-9..10 rad plus zero, pi and 3 pi
+    const size_t batch = 20000;
+    std::mt19937 so3_rng(7);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::uniform_real_distribution<double> decade(-9.0, 1.0);
+    Vector3Array phi;
+    Vector3Array omega;
+    phi.resize(batch);
+    omega.resize(batch);
+
+    for (size_t i = 0; i < batch; ++i) {
+        const double special[] = {0.0, M_PI, 3.0 * M_PI};
+        const double angle = (i < 3) ? special[i] : std::pow(10.0, decade(so3_rng));
+        double axis[3] = {unit(so3_rng), unit(so3_rng), unit(so3_rng)};
+        const double norm = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        phi.x[i] = static_cast<float>(angle * axis[0] / norm);
+        phi.y[i] = static_cast<float>(angle * axis[1] / norm);
+        phi.z[i] = static_cast<float>(angle * axis[2] / norm);
+        omega.x[i] = static_cast<float>(10.0 * unit(so3_rng));
+        omega.y[i] = static_cast<float>(10.0 * unit(so3_rng));
+        omega.z[i] = static_cast<float>(10.0 * unit(so3_rng));
+    }
+
+    QuaternionArray q_batch;
+    so3_exp(phi, q_batch);
+    CHECK(q_batch.size() == batch && q_batch.w[0] == 1.f && q_batch.x[0] == 0.f);
+    double exp_error = 0.0;
+
+    for (size_t i = 0; i < batch; ++i) {
+        double r[4];
+        reference_exp(phi.x[i], phi.y[i], phi.z[i], r);
+        exp_error = std::fmax(exp_error, component_error(q_batch, i, r));
+    }
+
+    CHECK(exp_error < 2e-6);
+
+    // Log of the float quaternions: relative accuracy down to 1e-9 rad, shortest rotation
+    Vector3Array phi_log;
+    so3_log(q_batch, phi_log);
+    double log_relative = 0.0;
+    double log_absolute = 0.0;
+
+    for (size_t i = 0; i < batch; ++i) {
+        const double w = q_batch.w[i], x = q_batch.x[i], y = q_batch.y[i], z = q_batch.z[i];
+        const double sign = (w < 0.0) ? -1.0 : 1.0;
+        const double v = std::sqrt(x * x + y * y + z * z);
+        const double k = (v > 0.0) ? sign * 2.0 * std::atan2(v, sign * w) / v : 2.0;
+        const double dx = phi_log.x[i] - k * x, dy = phi_log.y[i] - k * y, dz = phi_log.z[i] - k * z;
+        const double error = std::sqrt(dx * dx + dy * dy + dz * dz);
+        const double magnitude = std::fabs(k) * v;
+        CHECK(std::isfinite(error) && magnitude <= M_PI + 1e-6);
+
+        if (magnitude < 0.1) {
+            log_relative = std::fmax(log_relative, (magnitude > 0.0) ? error / magnitude : error);
+
+        } else {
+            log_absolute = std::fmax(log_absolute, error);
+        }
+    }
+
+    CHECK(log_relative < 1e-6 && log_absolute < 2e-6);
+    CHECK(phi_log.x[0] == 0.f && phi_log.y[0] == 0.f && phi_log.z[0] == 0.f);
+
+    // Composition and rotation against the double product
+    QuaternionArray q_other;
+    QuaternionArray q_composed;
+    Vector3Array rotated;
+    so3_exp(omega, q_other);
+    quat_compose(q_batch, q_other, q_composed);
+    quat_rotate(q_batch, omega, rotated);
+    double compose_error = 0.0;
+    double rotate_error = 0.0;
+
+    for (size_t i = 0; i < batch; ++i) {
+        const double a[4] = {q_batch.w[i], q_batch.x[i], q_batch.y[i], q_batch.z[i]};
+        const double b[4] = {q_other.w[i], q_other.x[i], q_other.y[i], q_other.z[i]};
+        const double a_inv[4] = {a[0], -a[1], -a[2], -a[3]};
+        const double v[4] = {0.0, omega.x[i], omega.y[i], omega.z[i]};
+        double c[4], av[4], r[4];
+        reference_product(a, b, c);
+        compose_error = std::fmax(compose_error, component_error(q_composed, i, c));
+        reference_product(a, v, av);
+        reference_product(av, a_inv, r);
+        rotate_error = std::fmax(rotate_error, std::fmax(std::fabs(rotated.x[i] - r[1]),
+                                 std::fmax(std::fabs(rotated.y[i] - r[2]), std::fabs(rotated.z[i] - r[3]))));
+    }
+
+    CHECK(compose_error < 1e-6 && rotate_error < 1e-5);
+
+    // Integration: q * exp(omega * dt), renormalized
+    QuaternionArray q_integrated = q_batch;
+    const float dt_step = 0.004f;
+    so3_integrate(q_integrated, omega, dt_step);
+    double integrate_error = 0.0;
+
+    for (size_t i = 0; i < batch; ++i) {
+        const double a[4] = {q_batch.w[i], q_batch.x[i], q_batch.y[i], q_batch.z[i]};
+        double d[4], c[4];
+        reference_exp(omega.x[i] * (double)dt_step, omega.y[i] * (double)dt_step, omega.z[i] * (double)dt_step, d);
+        reference_product(a, d, c);
+        const double norm = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+
+        for (double &component : c) {
+            component /= norm;
+        }
+
+        integrate_error = std::fmax(integrate_error, component_error(q_integrated, i, c));
+    }
+
+    CHECK(integrate_error < 1e-6);
+
+    const auto so3_start = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < 10; ++pass) {
+        so3_exp(phi, q_batch);
+        so3_log(q_batch, phi_log);
+    }
+
+    const double so3_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - so3_start)
+                          .count() / (10.0 * batch);
+
+    // Far below the controller's minimum interval: dt clamp engages
+    config.estimator.dropout = 0.f;
+    config.estimator.rate_hz = 1000.f;
+    SilSimulator fast_sil(config);
+    const SilResult fast = fast_sil.run();
+    CHECK(fast.dt_clamped > fast.controlled / 2);
+
+    // Hundreds of times faster than real time
+    CHECK(nominal.realtime_factor > 100.0);
+
+    printf("aic sil: rms %.4f rad (dropout %.4f), dt mean %.2f ms (dropout %.2f ms), %.0fx real time\n",
+           (double)nominal.attitude_rms, (double)dropout.attitude_rms, (double)(nominal.dt_mean * 1e3f),
+           (double)(dropout.dt_mean * 1e3f), nominal.realtime_factor);
+    printf("aic sil: px4 cascade rms %.4f rad; replay per tick: aic module %.0f ns, px4 cascade %.0f ns\n",
+           (double)px4.attitude_rms, cost.cost[0].ns_mean, cost.cost[2].ns_mean);
+    printf("aic sil: CoM offset estimate [%.4f, %.4f] (true 0.02), hover rms %.5f rad (inertia only %.5f)\n",
+           (double)r_hat(0), (double)r_hat(1), (double)extended.attitude_rms, (double)inertia_only.attitude_rms);
+    printf("aic sil: payload Jxx estimate %.4f windowed LS, %.4f IWG (true %.4f)\n", (double)J_ls(0, 0),
+           (double)J_iwg(0, 0), (double)window_config.J_true(0));
+    printf("aic sil: so3 batch max error exp %.1e, log %.1e rel / %.1e abs, %.1f ns per exp + log\n", exp_error,
+           log_relative, log_absolute, so3_ns);
+    printf("aic sil: motor failure detected after %.1f ms, reduced allocation at the motors %.1f ms later\n",
+           (double)(failure.detection_latency * 1e3f), (double)(failure.reconfiguration_latency * 1e3f));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file tick_log.cpp
+ * @brief Per-message controller inputs recorded from the SIL or read from flight logs
+ */
+
+#include "tick_log.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace aic_sil {
+
+namespace {
+
+enum Column { TIME, Q0, Q1, Q2, Q3, WX, WY, WZ, QD0, QD1, QD2, QD3, COLUMN_COUNT };
+
+int column_of(const std::string &name) {
+    static const char *const names[] = {
+        "timestamp", "q[0]", "q[1]", "q[2]", "q[3]", "rollspeed", "pitchspeed", "yawspeed",
+        "q_d[0]", "q_d[1]", "q_d[2]", "q_d[3]"
+    };
+
+    for (int i = 0; i < COLUMN_COUNT; ++i) {
+        if (name == names[i]) {
+            return i;
+        }
+    }
+
+    // vehicle_angular_velocity
+    if (name.size() == 6 && name.compare(0, 4, "xyz[") == 0 && name[5] == ']' && name[4] >= '0' && name[4] <= '2') {
+        return WX + (name[4] - '0');
+    }
+
+    return -1;
+}
+
+std::vector<std::string> split(const std::string &line) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+
+    while (std::getline(stream, field, ',')) {
+        // Tolerate CRLF and padding
+        const size_t begin = field.find_first_not_of(" \t\r");
+        const size_t end = field.find_last_not_of(" \t\r");
+        fields.push_back((begin == std::string::npos) ? std::string() : field.substr(begin, end - begin + 1));
+    }
+
+    return fields;
+}
+
+} // namespace
+
+bool write_tick_log(const std::string &path, const std::vector<TickRecord> &ticks) {
+    FILE *f = fopen(path.c_str(), "w");
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    fprintf(f, "timestamp,q[0],q[1],q[2],q[3],rollspeed,pitchspeed,yawspeed,q_d[0],q_d[1],q_d[2],q_d[3]\n");
+
+    for (const TickRecord &tick : ticks) {
+        fprintf(f, "%llu,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+                (unsigned long long)tick.time_us, (double)tick.q(0), (double)tick.q(1), (double)tick.q(2),
+                (double)tick.q(3), (double)tick.omega(0), (double)tick.omega(1), (double)tick.omega(2),
+                (double)tick.q_d(0), (double)tick.q_d(1), (double)tick.q_d(2), (double)tick.q_d(3));
+    }
+
+    const bool ok = (ferror(f) == 0);
+    return (fclose(f) == 0) && ok;
+}
+
+bool read_tick_log(const std::string &path, std::vector<TickRecord> &ticks, std::string &error) {
+    std::ifstream file(path);
+
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+
+    if (!std::getline(file, line)) {
+        error = "empty file";
+        return false;
+    }
+
+    // Field index of each column (-1: absent)
+    int index[COLUMN_COUNT];
+
+    for (int i = 0; i < COLUMN_COUNT; ++i) {
+        index[i] = -1;
+    }
+
+    const std::vector<std::string> header = split(line);
+
+    for (size_t i = 0; i < header.size(); ++i) {
+        const int column = column_of(header[i]);
+
+        if (column >= 0 && index[column] < 0) {
+            index[column] = static_cast<int>(i);
+        }
+    }
+
+    for (int i = TIME; i <= WZ; ++i) {
+        if (index[i] < 0) {
+            error = "missing column for timestamp, q[0..3] or body rates";
+            return false;
+        }
+    }
+
+    const bool has_setpoint = index[QD0] >= 0 && index[QD1] >= 0 && index[QD2] >= 0 && index[QD3] >= 0;
+    ticks.clear();
+
+    while (std::getline(file, line)) {
+        const std::vector<std::string> fields = split(line);
+        double value[COLUMN_COUNT] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0};
+        bool valid = true;
+
+        for (int i = 0; i < COLUMN_COUNT && valid; ++i) {
+            if (index[i] < 0) {
+                continue;
+            }
+
+            if (static_cast<size_t>(index[i]) >= fields.size() || fields[index[i]].empty()) {
+                valid = false;
+                break;
+            }
+
+            char *end = nullptr;
+            value[i] = strtod(fields[index[i]].c_str(), &end);
+            valid = (*end == '\0') && std::isfinite(value[i]);
+        }
+
+        const uint64_t time_us = static_cast<uint64_t>(value[TIME]);
+
+        if (!valid || value[TIME] < 0.0 || (!ticks.empty() && time_us <= ticks.back().time_us)) {
+            continue;
+        }
+
+        TickRecord tick;
+        tick.time_us = time_us;
+        tick.q = matrix::Quaternionf(value[Q0], value[Q1], value[Q2], value[Q3]);
+        tick.omega = matrix::Vector3f(value[WX], value[WY], value[WZ]);
+        tick.q_d = has_setpoint ? matrix::Quaternionf(value[QD0], value[QD1], value[QD2], value[QD3]) :
+                   matrix::Quaternionf(1.f, 0.f, 0.f, 0.f);
+        ticks.push_back(tick);
+    }
+
+    if (ticks.empty()) {
+        error = "no valid rows";
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace aic_sil
@@ -0,0 +1,55 @@
+/**
+ * @file tick_log.hpp
+ * @brief Per-message controller inputs recorded from the SIL or read from flight logs
+ *
+ * One record per attitude message the module handled: time, attitude,
+ * rates and the latest attitude setpoint. Replaying a log through a
+ * controller reproduces its inputs exactly (open loop), so the cost of
+ * different controllers can be compared on the same data.
+ *
+ * CSV with a header row. Columns are found by name, in any order, with the
+ * names ulog2csv uses for vehicle_attitude and vehicle_attitude_setpoint:
+ *
+ *   timestamp                      us
+ *   q[0] .. q[3]                   attitude
+ *   rollspeed, pitchspeed, yawspeed  or  xyz[0] .. xyz[2]  (rad/s)
+ *   q_d[0] .. q_d[3]               setpoint (optional, identity if absent)
+ *
+ * so the attitude, angular velocity and setpoint CSVs of a flight log only
+ * need joining on timestamp. Other columns are ignored.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aic_sil {
+
+struct TickRecord {
+    uint64_t time_us;
+    matrix::Quaternionf q;
+    matrix::Vector3f omega;
+    matrix::Quaternionf q_d;
+};
+
+/**
+ * @brief Write records as CSV
+ * @return true on success
+ */
+bool write_tick_log(const std::string &path, const std::vector<TickRecord> &ticks);
+
+/**
+ * @brief Read a CSV log
+ *
+ * Rows with non-increasing timestamps or non-finite values are skipped.
+ *
+ * @param error reason on failure
+ * @return true if at least one record was read
+ */
+bool read_tick_log(const std::string &path, std::vector<TickRecord> &ticks, std::string &error);
+
+} // namespace aic_sil
@@ -0,0 +1,60 @@
+/**
+ * @file timing_model.hpp
+ * @brief Message stream timing: rate, latency distribution and dropouts
+ *
+ * Latency of a message is
+ *
+ *   max(0, mean + N(0, jitter^2)) + (spike with probability spike_prob)
+ *
+ * which covers transport delay, scheduler jitter and the occasional long
+ * stall (flash write, higher-priority work queue) seen on flight hardware.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace aic_sil {
+
+struct LatencyModel {
+    float mean_us{0.f};
+    float jitter_us{0.f};      // Standard deviation
+    float spike_prob{0.f};
+    float spike_us{0.f};
+
+    uint64_t sample(std::mt19937 &rng) const {
+        float latency = mean_us;
+
+        if (jitter_us > 0.f) {
+            latency += std::normal_distribution<float>(0.f, jitter_us)(rng);
+        }
+
+        latency = (latency > 0.f) ? latency : 0.f;
+
+        if (spike_prob > 0.f && std::uniform_real_distribution<float>(0.f, 1.f)(rng) < spike_prob) {
+            latency += spike_us;
+        }
+
+        return static_cast<uint64_t>(latency + 0.5f);
+    }
+};
+
+/**
+ * @brief Periodic message stream
+ */
+struct StreamTiming {
+    float rate_hz{250.f};
+    LatencyModel latency;
+    float dropout{0.f};         // Probability a message is lost
+
+    uint64_t period_us() const {
+        return static_cast<uint64_t>(1e6f / rate_hz + 0.5f);
+    }
+
+    bool drop(std::mt19937 &rng) const {
+        return dropout > 0.f && std::uniform_real_distribution<float>(0.f, 1.f)(rng) < dropout;
+    }
+};
+
+} // namespace aic_sil
@@ -0,0 +1,210 @@
+/**
+ * @file aggregator.cpp
+ * @brief Multi-vehicle AIC telemetry aggregator (UDP + epoll -> shared memory)
+ */
+
+#include "aggregator.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+namespace aic_telemetry {
+
+namespace {
+
+uint64_t monotonic_us() {
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000ull + ts.tv_nsec / 1000;
+}
+
+} // namespace
+
+bool TelemetryAggregator::open(const std::string &bind_address, uint16_t base_port, int port_count,
+                               const std::string &shm_name, uint32_t max_vehicles, uint32_t capacity) {
+    close();
+
+    if (port_count <= 0 || !shm_.create(shm_name, max_vehicles, capacity)) {
+        return false;
+    }
+
+    slot_lookup_.assign(UINT16_MAX + 1, -1);
+    next_status_sequence_.assign(max_vehicles, 0);
+    next_timing_sequence_.assign(max_vehicles, 0);
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+
+    if (epoll_fd_ < 0) {
+        close();
+        return false;
+    }
+
+    for (int i = 0; i < port_count; ++i) {
+        int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+        if (fd < 0) {
+            close();
+            return false;
+        }
+
+        sockets_.push_back(fd);
+
+        // Large receive buffer: 30+ vehicles burst at the control rate
+        int rcvbuf = 4 * 1024 * 1024;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+        struct sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(base_port + i));
+
+        if (inet_pton(AF_INET, bind_address.c_str(), &addr.sin_addr) != 1
+            || bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close();
+            return false;
+        }
+
+        struct epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close();
+            return false;
+        }
+    }
+
+    for (int i = 0; i < BATCH_SIZE; ++i) {
+        iovecs_[i].iov_base = buffers_[i];
+        iovecs_[i].iov_len = sizeof(buffers_[i]);   // One spare byte detects oversized datagrams
+        memset(&messages_[i], 0, sizeof(messages_[i]));
+        messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+        messages_[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    stats_ = Stats{};
+    return true;
+}
+
+void TelemetryAggregator::close() {
+    for (int fd : sockets_) {
+        ::close(fd);
+    }
+
+    sockets_.clear();
+
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    shm_.close();
+}
+
+int TelemetryAggregator::poll(int timeout_ms) {
+    if (epoll_fd_ < 0) {
+        return -1;
+    }
+
+    struct epoll_event events[16];
+    const int ready = epoll_wait(epoll_fd_, events, 16, timeout_ms);
+
+    if (ready < 0) {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    int stored = 0;
+
+    for (int i = 0; i < ready; ++i) {
+        stored += drain(events[i].data.fd);
+    }
+
+    return stored;
+}
+
+int TelemetryAggregator::drain(int fd) {
+    const uint64_t received_before = stats_.received;
+
+    for (;;) {
+        const int n = recvmmsg(fd, messages_, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+        if (n <= 0) {
+            break;
+        }
+
+        const uint64_t receive_us = monotonic_us();
+
+        for (int i = 0; i < n; ++i) {
+            process(buffers_[i], messages_[i].msg_len, receive_us);
+        }
+
+        if (n < BATCH_SIZE) {
+            break;
+        }
+    }
+
+    return static_cast<int>(stats_.received - received_before);
+}
+
+void TelemetryAggregator::process(const uint8_t *data, size_t size, uint64_t receive_us) {
+    PacketHeader header;
+
+    if (!parse_header(data, size, header)) {
+        ++stats_.rejected;
+        return;
+    }
+
+    int &slot = slot_lookup_[header.vehicle_id];
+
+    if (slot < 0) {
+        slot = shm_.slot_for(header.vehicle_id);
+
+        if (slot < 0) {
+            ++stats_.overflow;
+            return;
+        }
+    }
+
+    SlotHeader *sh = shm_.slot_header(slot);
+    const bool is_status = static_cast<MessageType>(header.type) == MessageType::STATUS;
+    uint32_t &expected = is_status ? next_status_sequence_[slot] : next_timing_sequence_[slot];
+
+    // Count gaps (reordered or restarted streams only resynchronize)
+    const uint64_t count = is_status ? sh->status_count : sh->timing_count;
+
+    if (count > 0 && header.sequence > expected) {
+        const uint32_t gap = header.sequence - expected;
+        sh->lost += gap;
+        stats_.lost += gap;
+    }
+
+    expected = header.sequence + 1;
+    sh->last_receive_us = receive_us;
+
+    // Payload goes straight from the receive buffer into the ring record
+    if (is_status) {
+        StatusRecord *rec = shm_.next_status(slot);
+        rec->timestamp_us = header.timestamp_us;
+        rec->receive_us = receive_us;
+        rec->sequence = header.sequence;
+        memcpy(&rec->status, payload(data), sizeof(StatusPayload));
+        shm_.commit_status(slot);
+
+    } else {
+        TimingRecord *rec = shm_.next_timing(slot);
+        rec->timestamp_us = header.timestamp_us;
+        rec->receive_us = receive_us;
+        rec->sequence = header.sequence;
+        memcpy(&rec->timing, payload(data), sizeof(TimingPayload));
+        shm_.commit_timing(slot);
+    }
+
+    ++stats_.received;
+}
+
+} // namespace aic_telemetry
@@ -0,0 +1,93 @@
+/**
+ * @file aggregator.hpp
+ * @brief Multi-vehicle AIC telemetry aggregator (UDP + epoll -> shared memory)
+ * 
+ * Listens on a range of local UDP ports, drains all ready sockets with
+ * batched recvmmsg() calls and copies each validated payload straight from
+ * the receive buffer into the vehicle's shared-memory ring.
+ */
+
+#pragma once
+
+#include "aic_telemetry_packet.hpp"
+#include "telemetry_shm.hpp"
+
+#include <sys/socket.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aic_telemetry {
+
+/**
+ * @class TelemetryAggregator
+ * @brief Receives AIC status/timing datagrams from many vehicles
+ */
+class TelemetryAggregator {
+public:
+    static constexpr int BATCH_SIZE = 64;    // Datagrams per recvmmsg() call
+
+    struct Stats {
+        uint64_t received{0};     // Valid packets stored
+        uint64_t rejected{0};     // Malformed or foreign datagrams
+        uint64_t overflow{0};     // Packets from vehicles beyond max_vehicles
+        uint64_t lost{0};         // Sequence gaps over all vehicles
+    };
+
+    TelemetryAggregator() = default;
+    ~TelemetryAggregator() { close(); }
+
+    TelemetryAggregator(const TelemetryAggregator &) = delete;
+    TelemetryAggregator &operator=(const TelemetryAggregator &) = delete;
+
+    /**
+     * @brief Bind the UDP ports and create the shared-memory rings
+     * 
+     * @param bind_address local address, e.g. "127.0.0.1" or "0.0.0.0"
+     * @param base_port first UDP port
+     * @param port_count number of consecutive ports (e.g. one per vehicle group)
+     * @param shm_name POSIX shm name of the rings
+     * @param max_vehicles number of vehicle slots
+     * @param capacity records per ring
+     * @return true on success
+     */
+    bool open(const std::string &bind_address, uint16_t base_port, int port_count,
+              const std::string &shm_name, uint32_t max_vehicles, uint32_t capacity);
+
+    /**
+     * @brief Wait for datagrams and process everything that is ready
+     * 
+     * @param timeout_ms epoll timeout (-1 blocks)
+     * @return number of valid packets stored, -1 on error
+     */
+    int poll(int timeout_ms);
+
+    void close();
+
+    const Stats &stats() const { return stats_; }
+    const TelemetryShm &shm() const { return shm_; }
+
+private:
+    int drain(int fd);
+    void process(const uint8_t *data, size_t size, uint64_t receive_us);
+
+    int epoll_fd_{-1};
+    std::vector<int> sockets_;
+    TelemetryShm shm_;
+    Stats stats_;
+
+    // Receive batch buffers (reused, no per-datagram allocation)
+    alignas(64) uint8_t buffers_[BATCH_SIZE][MAX_PACKET_SIZE + 1];
+    struct mmsghdr messages_[BATCH_SIZE];
+    struct iovec iovecs_[BATCH_SIZE];
+
+    // Vehicle id -> slot (-1: not assigned yet), avoids a slot search per packet
+    std::vector<int> slot_lookup_;
+
+    // Expected next sequence per slot and message type (loss accounting)
+    std::vector<uint32_t> next_status_sequence_;
+    std::vector<uint32_t> next_timing_sequence_;
+};
+
+} // namespace aic_telemetry
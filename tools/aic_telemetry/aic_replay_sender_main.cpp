@@ -0,0 +1,79 @@
+/**
+ * @file aic_replay_sender_main.cpp
+ * @brief Sends synthetic AIC telemetry for N vehicles to a local aggregator
+ * 
+ * Usage:
+ *   aic_replay_sender [-a address] [-p base_port] [-n port_count]
+ *                     [-v vehicles] [-r rate_hz] [-d duration_s]
+ */
+
+#include "replay_sender.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+
+using namespace aic_telemetry;
+
+int main(int argc, char *argv[]) {
+    std::string address = "127.0.0.1";
+    int base_port = 14660;
+    int port_count = 1;
+    int vehicles = 32;
+    double rate_hz = 250.0;
+    double duration_s = 10.0;
+
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:p:n:v:r:d:h")) != -1) {
+        switch (opt) {
+        case 'a': address = optarg; break;
+
+        case 'p': base_port = atoi(optarg); break;
+
+        case 'n': port_count = atoi(optarg); break;
+
+        case 'v': vehicles = atoi(optarg); break;
+
+        case 'r': rate_hz = atof(optarg); break;
+
+        case 'd': duration_s = atof(optarg); break;
+
+        default:
+            fprintf(stderr, "usage: %s [-a address] [-p base_port] [-n port_count] "
+                    "[-v vehicles] [-r rate_hz] [-d duration_s]\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    ReplaySender sender;
+
+    if (rate_hz <= 0.0 || !sender.open(address, static_cast<uint16_t>(base_port), port_count)) {
+        fprintf(stderr, "failed to open sender\n");
+        return 1;
+    }
+
+    const uint64_t period_ns = static_cast<uint64_t>(1e9 / rate_hz);
+    const uint32_t steps = static_cast<uint32_t>(duration_s * rate_hz);
+
+    struct timespec next {};
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    uint64_t sent = 0;
+
+    for (uint32_t step = 0; step < steps; ++step) {
+        sent += sender.send_step(vehicles, step, static_cast<uint64_t>(step * 1e6 / rate_hz));
+
+        next.tv_nsec += period_ns;
+
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            ++next.tv_sec;
+        }
+
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+    }
+
+    printf("sent %llu datagrams for %d vehicles\n", (unsigned long long)sent, vehicles);
+    return 0;
+}
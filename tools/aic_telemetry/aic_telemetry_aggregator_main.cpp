@@ -0,0 +1,101 @@
+/**
+ * @file aic_telemetry_aggregator_main.cpp
+ * @brief Ground-side aggregator of AIC status/timing streams from many vehicles
+ * 
+ * Usage:
+ *   aic_telemetry_aggregator [-a bind_address] [-p base_port] [-n port_count]
+ *                            [-s shm_name] [-v max_vehicles] [-c capacity]
+ * 
+ * Python clients read the rings with src/utils/aic_telemetry_view.py.
+ */
+
+#include "aggregator.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+using namespace aic_telemetry;
+
+namespace {
+
+volatile sig_atomic_t g_should_exit = 0;
+
+void handle_signal(int) {
+    g_should_exit = 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::string bind_address = "127.0.0.1";
+    std::string shm_name = "/aic_telemetry";
+    int base_port = 14660;
+    int port_count = 1;
+    int max_vehicles = 64;
+    int capacity = 4096;
+
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:p:n:s:v:c:h")) != -1) {
+        switch (opt) {
+        case 'a': bind_address = optarg; break;
+
+        case 'p': base_port = atoi(optarg); break;
+
+        case 'n': port_count = atoi(optarg); break;
+
+        case 's': shm_name = optarg; break;
+
+        case 'v': max_vehicles = atoi(optarg); break;
+
+        case 'c': capacity = atoi(optarg); break;
+
+        default:
+            fprintf(stderr, "usage: %s [-a bind_address] [-p base_port] [-n port_count] "
+                    "[-s shm_name] [-v max_vehicles] [-c capacity]\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    TelemetryAggregator aggregator;
+
+    if (max_vehicles <= 0 || capacity <= 0
+        || !aggregator.open(bind_address, static_cast<uint16_t>(base_port), port_count, shm_name,
+                            static_cast<uint32_t>(max_vehicles), static_cast<uint32_t>(capacity))) {
+        fprintf(stderr, "failed to open %s:%d (+%d ports) / %s: %s\n", bind_address.c_str(), base_port,
+                port_count, shm_name.c_str(), strerror(errno));
+        return 1;
+    }
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    printf("aggregating %s:%d-%d into %s (%d vehicles x %d records)\n", bind_address.c_str(), base_port,
+           base_port + port_count - 1, shm_name.c_str(), max_vehicles, capacity);
+
+    time_t last_report = time(nullptr);
+
+    while (!g_should_exit) {
+        if (aggregator.poll(200) < 0) {
+            perror("epoll_wait");
+            break;
+        }
+
+        const time_t now = time(nullptr);
+
+        if (now - last_report >= 5) {
+            const TelemetryAggregator::Stats &st = aggregator.stats();
+            printf("vehicles %u, received %llu, lost %llu, rejected %llu, overflow %llu\n",
+                   aggregator.shm().vehicle_count(), (unsigned long long)st.received,
+                   (unsigned long long)st.lost, (unsigned long long)st.rejected,
+                   (unsigned long long)st.overflow);
+            last_report = now;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file aic_telemetry_packet.hpp
+ * @brief Wire format of AIC status and timing messages sent to the ground
+ * 
+ * Fixed-size, packed, little-endian datagrams: a common header followed by
+ * a status or timing payload. Receivers validate the header in place and
+ * copy the payload straight from the receive buffer into its destination.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace aic_telemetry {
+
+static constexpr uint32_t PACKET_MAGIC = 0x54434941;  // "AICT"
+static constexpr uint8_t PACKET_VERSION = 1;
+
+enum class MessageType : uint8_t {
+    STATUS = 1,
+    TIMING = 2
+};
+
+#pragma pack(push, 1)
+
+struct PacketHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t type;              // MessageType
+    uint16_t vehicle_id;
+    uint32_t sequence;         // Per-vehicle, per-type message counter
+    uint64_t timestamp_us;     // Vehicle time of the control update
+};
+
+/**
+ * @brief Controller status (one per control update or decimated)
+ */
+struct StatusPayload {
+    float theta[6];            // Inertia estimate [Jxx, Jyy, Jzz, Jxy, Jxz, Jyz] (kg*m^2)
+    float d_hat[3];            // Disturbance estimate (Nm)
+    float s[3];                // Filtered composite error
+    float tau[3];              // Torque command (Nm)
+    float information;         // Information matrix determinant
+    uint8_t persistently_excited;
+    uint8_t saturated;
+    uint8_t governor_phase;
+    uint8_t flags;
+};
+
+/**
+ * @brief Controller timing instrumentation
+ */
+struct TimingPayload {
+    float compute_us;          // Control update duration
+    float interval_us;         // Time since the previous control update
+    uint16_t divider;          // Rate governor divider
+    uint16_t reserved;
+    uint32_t skipped;          // Messages skipped by the rate governor
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(PacketHeader) == 20, "unexpected header size");
+static_assert(sizeof(StatusPayload) == 68, "unexpected status payload size");
+static_assert(sizeof(TimingPayload) == 16, "unexpected timing payload size");
+
+static constexpr size_t STATUS_PACKET_SIZE = sizeof(PacketHeader) + sizeof(StatusPayload);
+static constexpr size_t TIMING_PACKET_SIZE = sizeof(PacketHeader) + sizeof(TimingPayload);
+static constexpr size_t MAX_PACKET_SIZE = STATUS_PACKET_SIZE;
+
+/**
+ * @brief Validate a datagram and read its header
+ * 
+ * @param data datagram bytes
+ * @param size datagram length
+ * @param header decoded header (valid if true is returned)
+ * @return true if the datagram is a well-formed AIC telemetry packet
+ */
+inline bool parse_header(const uint8_t *data, size_t size, PacketHeader &header) {
+    if (size < sizeof(PacketHeader)) {
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(PacketHeader));
+
+    if (header.magic != PACKET_MAGIC || header.version != PACKET_VERSION) {
+        return false;
+    }
+
+    switch (static_cast<MessageType>(header.type)) {
+    case MessageType::STATUS: return size == STATUS_PACKET_SIZE;
+
+    case MessageType::TIMING: return size == TIMING_PACKET_SIZE;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Payload location inside a validated datagram
+ */
+inline const uint8_t *payload(const uint8_t *data) {
+    return data + sizeof(PacketHeader);
+}
+
+/**
+ * @brief Serialize a packet into buf (at least MAX_PACKET_SIZE bytes)
+ * @return packet size
+ */
+template<typename Payload>
+inline size_t encode(uint8_t *buf, MessageType type, uint16_t vehicle_id, uint32_t sequence,
+                     uint64_t timestamp_us, const Payload &body) {
+    PacketHeader header{PACKET_MAGIC, PACKET_VERSION, static_cast<uint8_t>(type),
+                        vehicle_id, sequence, timestamp_us};
+    memcpy(buf, &header, sizeof(header));
+    memcpy(buf + sizeof(header), &body, sizeof(body));
+    return sizeof(header) + sizeof(body);
+}
+
+} // namespace aic_telemetry
@@ -0,0 +1,105 @@
+/**
+ * @file replay_sender.cpp
+ * @brief Local stand-in for live vehicles: sends AIC telemetry over UDP
+ */
+
+#include "replay_sender.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cmath>
+
+namespace aic_telemetry {
+
+bool ReplaySender::open(const std::string &address, uint16_t base_port, int port_count) {
+    close();
+
+    fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+    if (fd_ < 0) {
+        return false;
+    }
+
+    address_ = address;
+    base_port_ = base_port;
+    port_count_ = (port_count > 0) ? port_count : 1;
+    return true;
+}
+
+void ReplaySender::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+StatusPayload ReplaySender::make_status(uint16_t vehicle_id, uint32_t step) {
+    StatusPayload status{};
+    const float t = step * 0.004f;
+    const float converge = 1.f - expf(-t / 5.f);
+
+    // Per-vehicle true inertia, estimate converging from a common prior
+    const float J_true[3] = {0.035f + 0.001f * (vehicle_id % 10), 0.038f + 0.001f * (vehicle_id % 7), 0.022f};
+    const float J_prior[3] = {0.040f, 0.040f, 0.025f};
+
+    for (int i = 0; i < 3; ++i) {
+        status.theta[i] = J_prior[i] + converge * (J_true[i] - J_prior[i]);
+        status.s[i] = 0.2f * expf(-t) * sinf(2.f * t + i);
+        status.tau[i] = 0.01f * sinf(0.5f * t + vehicle_id + i);
+        status.d_hat[i] = 0.002f * cosf(0.1f * t + i);
+    }
+
+    status.information = 1e-6f * (1.f + t);
+    status.persistently_excited = (t > 2.f) ? 1 : 0;
+    status.saturated = (step % 500) < 5 ? 1 : 0;
+    status.governor_phase = static_cast<uint8_t>((step / 250) % 3);
+    return status;
+}
+
+TimingPayload ReplaySender::make_timing(uint16_t vehicle_id, uint32_t step) {
+    TimingPayload timing{};
+    timing.compute_us = 40.f + (vehicle_id % 5) + 3.f * sinf(step * 0.01f);
+    timing.interval_us = 4000.f;
+    timing.divider = 1;
+    timing.skipped = 0;
+    return timing;
+}
+
+int ReplaySender::send_step(int vehicle_count, uint32_t step, uint64_t timestamp_us) {
+    uint8_t buf[MAX_PACKET_SIZE];
+    int sent = 0;
+
+    for (int v = 1; v <= vehicle_count; ++v) {
+        const uint16_t id = static_cast<uint16_t>(v);
+
+        size_t size = encode(buf, MessageType::STATUS, id, step, timestamp_us, make_status(id, step));
+        sent += send_packet(id, buf, size) ? 1 : 0;
+
+        size = encode(buf, MessageType::TIMING, id, step, timestamp_us, make_timing(id, step));
+        sent += send_packet(id, buf, size) ? 1 : 0;
+    }
+
+    return sent;
+}
+
+bool ReplaySender::send_packet(uint16_t vehicle_id, const uint8_t *data, size_t size) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(base_port_ + vehicle_id % port_count_));
+
+    if (inet_pton(AF_INET, address_.c_str(), &addr.sin_addr) != 1) {
+        return false;
+    }
+
+    return sendto(fd_, data, size, 0, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr))
+           == static_cast<ssize_t>(size);
+}
+
+} // namespace aic_telemetry
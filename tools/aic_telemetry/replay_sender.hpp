@@ -0,0 +1,67 @@
+/**
+ * @file replay_sender.hpp
+ * @brief Local stand-in for live vehicles: sends AIC telemetry over UDP
+ * 
+ * Generates deterministic status and timing streams for a number of
+ * simulated vehicles (inertia estimate converging to a per-vehicle value,
+ * decaying composite error, periodic governor phases) and sends them to a
+ * local aggregator at a fixed rate.
+ */
+
+#pragma once
+
+#include "aic_telemetry_packet.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace aic_telemetry {
+
+/**
+ * @class ReplaySender
+ * @brief Synthetic multi-vehicle AIC telemetry source
+ */
+class ReplaySender {
+public:
+    ReplaySender() = default;
+    ~ReplaySender() { close(); }
+
+    ReplaySender(const ReplaySender &) = delete;
+    ReplaySender &operator=(const ReplaySender &) = delete;
+
+    /**
+     * @brief Open the UDP socket towards the aggregator
+     * 
+     * @param address aggregator address, e.g. "127.0.0.1"
+     * @param base_port first aggregator port
+     * @param port_count vehicles are spread over port_count consecutive ports
+     */
+    bool open(const std::string &address, uint16_t base_port, int port_count);
+    void close();
+
+    /**
+     * @brief Send one status and one timing message for every vehicle
+     * 
+     * @param vehicle_count number of simulated vehicles (ids 1..vehicle_count)
+     * @param step control update index (drives the synthetic signals)
+     * @param timestamp_us vehicle timestamp of the update
+     * @return number of datagrams sent
+     */
+    int send_step(int vehicle_count, uint32_t step, uint64_t timestamp_us);
+
+    /**
+     * @brief Synthetic status of a vehicle at a given step (also used by tests)
+     */
+    static StatusPayload make_status(uint16_t vehicle_id, uint32_t step);
+    static TimingPayload make_timing(uint16_t vehicle_id, uint32_t step);
+
+private:
+    bool send_packet(uint16_t vehicle_id, const uint8_t *data, size_t size);
+
+    int fd_{-1};
+    std::string address_;
+    uint16_t base_port_{0};
+    int port_count_{1};
+};
+
+} // namespace aic_telemetry
@@ -0,0 +1,207 @@
+/**
+ * @file telemetry_shm.cpp
+ * @brief Shared-memory per-vehicle ring buffers of AIC telemetry
+ */
+
+#include "telemetry_shm.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace aic_telemetry {
+
+namespace {
+
+// Counters are shared with readers in other processes: publish with release semantics
+inline void store_release(uint64_t *counter, uint64_t value) {
+    __atomic_store_n(counter, value, __ATOMIC_RELEASE);
+}
+
+inline void store_release(uint32_t *counter, uint32_t value) {
+    __atomic_store_n(counter, value, __ATOMIC_RELEASE);
+}
+
+inline uint64_t load_acquire(const uint64_t *counter) {
+    return __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+}
+
+inline uint32_t load_acquire(const uint32_t *counter) {
+    return __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+}
+
+} // namespace
+
+bool TelemetryShm::create(const std::string &name, uint32_t max_vehicles, uint32_t capacity) {
+    close();
+
+    if (max_vehicles == 0 || capacity == 0) {
+        return false;
+    }
+
+    const size_t size = sizeof(ShmHeader) + max_vehicles * slot_size(capacity);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mem == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    base_ = static_cast<uint8_t *>(mem);
+    header_ = reinterpret_cast<ShmHeader *>(base_);
+    size_ = size;
+    name_ = name;
+    owner_ = true;
+
+    memset(base_, 0, size_);
+    header_->version = SHM_VERSION;
+    header_->max_vehicles = max_vehicles;
+    header_->capacity = capacity;
+    header_->slot_size = static_cast<uint32_t>(slot_size(capacity));
+    header_->status_record_size = sizeof(StatusRecord);
+    header_->timing_record_size = sizeof(TimingRecord);
+    header_->vehicle_count = 0;
+
+    // Magic last: readers only accept a fully initialized layout
+    store_release(&header_->magic, SHM_MAGIC);
+    return true;
+}
+
+bool TelemetryShm::open_readonly(const std::string &name) {
+    close();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st {};
+
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void *mem = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+
+    base_ = static_cast<uint8_t *>(mem);
+    header_ = reinterpret_cast<ShmHeader *>(base_);
+    size_ = st.st_size;
+    name_ = name;
+    owner_ = false;
+
+    if (load_acquire(&header_->magic) != SHM_MAGIC || header_->version != SHM_VERSION) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void TelemetryShm::close() {
+    if (base_ != nullptr) {
+        munmap(base_, size_);
+
+        if (owner_) {
+            shm_unlink(name_.c_str());
+        }
+    }
+
+    base_ = nullptr;
+    header_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+}
+
+int TelemetryShm::find_slot(uint16_t vehicle_id) const {
+    const uint32_t count = vehicle_count();
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (slot_header(i)->vehicle_id == vehicle_id) {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+int TelemetryShm::slot_for(uint16_t vehicle_id) {
+    int slot = find_slot(vehicle_id);
+
+    if (slot >= 0 || header_ == nullptr) {
+        return slot;
+    }
+
+    const uint32_t count = header_->vehicle_count;
+
+    if (count >= header_->max_vehicles) {
+        return -1;
+    }
+
+    slot_header(count)->vehicle_id = vehicle_id;
+    store_release(&header_->vehicle_count, count + 1);
+    return static_cast<int>(count);
+}
+
+uint32_t TelemetryShm::vehicle_count() const {
+    return (header_ != nullptr) ? load_acquire(&header_->vehicle_count) : 0;
+}
+
+SlotHeader *TelemetryShm::slot_header(int slot) const {
+    return reinterpret_cast<SlotHeader *>(base_ + sizeof(ShmHeader) + slot * static_cast<size_t>(header_->slot_size));
+}
+
+const StatusRecord *TelemetryShm::status_ring(int slot) const {
+    return reinterpret_cast<const StatusRecord *>(reinterpret_cast<const uint8_t *>(slot_header(slot))
+            + sizeof(SlotHeader));
+}
+
+const TimingRecord *TelemetryShm::timing_ring(int slot) const {
+    return reinterpret_cast<const TimingRecord *>(reinterpret_cast<const uint8_t *>(status_ring(slot))
+            + header_->capacity * sizeof(StatusRecord));
+}
+
+StatusRecord *TelemetryShm::next_status(int slot) {
+    const uint64_t count = slot_header(slot)->status_count;
+    return const_cast<StatusRecord *>(status_ring(slot)) + (count % header_->capacity);
+}
+
+void TelemetryShm::commit_status(int slot) {
+    SlotHeader *sh = slot_header(slot);
+    store_release(&sh->status_count, sh->status_count + 1);
+}
+
+TimingRecord *TelemetryShm::next_timing(int slot) {
+    const uint64_t count = slot_header(slot)->timing_count;
+    return const_cast<TimingRecord *>(timing_ring(slot)) + (count % header_->capacity);
+}
+
+void TelemetryShm::commit_timing(int slot) {
+    SlotHeader *sh = slot_header(slot);
+    store_release(&sh->timing_count, sh->timing_count + 1);
+}
+
+} // namespace aic_telemetry
@@ -0,0 +1,151 @@
+/**
+ * @file telemetry_shm.hpp
+ * @brief Shared-memory per-vehicle ring buffers of AIC telemetry
+ *
+ * Layout (all little-endian, offsets in bytes):
+ *
+ *   ShmHeader                                         [0, 64)
+ *   slot i at 64 + i * slot_size:
+ *     SlotHeader                                      [0, 64)
+ *     StatusRecord status[capacity]                   [64, 64 + capacity * sizeof(StatusRecord))
+ *     TimingRecord timing[capacity]                   (follows)
+ *
+ * Slots are assigned to vehicle ids in arrival order. Each ring has a
+ * monotonically increasing write count; record k lives at index
+ * k % capacity and is complete once the count is greater than k.
+ * Readers (src/utils/aic_telemetry_view.py) map the same layout with
+ * NumPy structured dtypes; they must treat the oldest few records of a
+ * full ring as possibly being overwritten.
+ */
+
+#pragma once
+
+#include "aic_telemetry_packet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace aic_telemetry {
+
+static constexpr uint32_t SHM_MAGIC = 0x4D484341;  // "ACHM"
+static constexpr uint32_t SHM_VERSION = 1;
+
+#pragma pack(push, 1)
+
+struct ShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t max_vehicles;
+    uint32_t capacity;             // Records per ring
+    uint32_t slot_size;            // Bytes per vehicle slot
+    uint32_t status_record_size;
+    uint32_t timing_record_size;
+    uint32_t vehicle_count;        // Assigned slots (written last)
+    uint8_t reserved[32];
+};
+
+struct SlotHeader {
+    uint32_t vehicle_id;
+    uint32_t reserved0;
+    uint64_t status_count;         // Status records written
+    uint64_t timing_count;         // Timing records written
+    uint64_t lost;                 // Messages lost (sequence gaps)
+    uint64_t last_receive_us;      // Ground receive time of the latest message
+    uint8_t reserved[24];
+};
+
+struct StatusRecord {
+    uint64_t timestamp_us;
+    uint64_t receive_us;
+    uint32_t sequence;
+    StatusPayload status;
+};
+
+struct TimingRecord {
+    uint64_t timestamp_us;
+    uint64_t receive_us;
+    uint32_t sequence;
+    TimingPayload timing;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(ShmHeader) == 64, "unexpected shm header size");
+static_assert(sizeof(SlotHeader) == 64, "unexpected slot header size");
+
+/**
+ * @class TelemetryShm
+ * @brief Owner (writer) or reader of the shared-memory telemetry rings
+ */
+class TelemetryShm {
+public:
+    TelemetryShm() = default;
+    ~TelemetryShm() { close(); }
+
+    TelemetryShm(const TelemetryShm &) = delete;
+    TelemetryShm &operator=(const TelemetryShm &) = delete;
+
+    /**
+     * @brief Create (or truncate) the shared-memory object and initialize the layout
+     *
+     * @param name POSIX shm name, e.g. "/aic_telemetry"
+     * @param max_vehicles number of vehicle slots
+     * @param capacity records per ring
+     * @return true on success
+     */
+    bool create(const std::string &name, uint32_t max_vehicles, uint32_t capacity);
+
+    /**
+     * @brief Map an existing shared-memory object read-only
+     */
+    bool open_readonly(const std::string &name);
+
+    /**
+     * @brief Unmap (and unlink if created by this instance)
+     */
+    void close();
+
+    /**
+     * @brief Find or assign the slot of a vehicle
+     * @return slot index or -1 if all slots are taken
+     */
+    int slot_for(uint16_t vehicle_id);
+
+    /**
+     * @brief Find the slot of a vehicle without assigning one
+     */
+    int find_slot(uint16_t vehicle_id) const;
+
+    /**
+     * @brief Next status record of a slot to fill
+     *
+     * The caller fills the record in place, then calls commit_status().
+     */
+    StatusRecord *next_status(int slot);
+    void commit_status(int slot);
+
+    TimingRecord *next_timing(int slot);
+    void commit_timing(int slot);
+
+    SlotHeader *slot_header(int slot) const;
+    const StatusRecord *status_ring(int slot) const;
+    const TimingRecord *timing_ring(int slot) const;
+
+    const ShmHeader *header() const { return header_; }
+    uint32_t vehicle_count() const;
+    size_t size() const { return size_; }
+
+    static size_t slot_size(uint32_t capacity) {
+        return sizeof(SlotHeader) + capacity * (sizeof(StatusRecord) + sizeof(TimingRecord));
+    }
+
+private:
+    uint8_t *base_{nullptr};
+    ShmHeader *header_{nullptr};
+    size_t size_{0};
+    std::string name_;
+    bool owner_{false};
+};
+
+} // namespace aic_telemetry
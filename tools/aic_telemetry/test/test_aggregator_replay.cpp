@@ -0,0 +1,107 @@
+/**
+ * @file test_aggregator_replay.cpp
+ * @brief Replay sender -> aggregator -> shared memory round trip
+ */
+
+#include "../aggregator.hpp"
+#include "../replay_sender.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace aic_telemetry;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return EXIT_FAILURE; \
+        } \
+    } while (0)
+
+int main() {
+    const int vehicles = 40;
+    const uint32_t steps = 50;
+    const uint32_t capacity = 32;   // Smaller than steps: exercises ring wrap-around
+    const uint16_t port = static_cast<uint16_t>(20000 + getpid() % 20000);
+    const std::string shm_name = "/aic_telemetry_test_" + std::to_string(getpid());
+
+    TelemetryAggregator aggregator;
+    CHECK(aggregator.open("127.0.0.1", port, 2, shm_name, 64, capacity));
+
+    ReplaySender sender;
+    CHECK(sender.open("127.0.0.1", port, 2));
+
+    for (uint32_t step = 0; step < steps; ++step) {
+        CHECK(sender.send_step(vehicles, step, step * 4000ull) == 2 * vehicles);
+
+        // Drain as we go so the socket buffers never overflow
+        while (aggregator.poll(0) > 0) {}
+    }
+
+    // Wait for the tail of the stream
+    const uint64_t expected = 2ull * vehicles * steps;
+
+    for (int i = 0; i < 100 && aggregator.stats().received < expected; ++i) {
+        aggregator.poll(10);
+    }
+
+    CHECK(aggregator.stats().received == expected);
+    CHECK(aggregator.stats().rejected == 0);
+    CHECK(aggregator.stats().lost == 0);
+
+    // Read back through an independent read-only mapping
+    TelemetryShm reader;
+    CHECK(reader.open_readonly(shm_name));
+    CHECK(reader.vehicle_count() == static_cast<uint32_t>(vehicles));
+    CHECK(reader.header()->capacity == capacity);
+
+    for (uint16_t id = 1; id <= vehicles; ++id) {
+        const int slot = reader.find_slot(id);
+        CHECK(slot >= 0);
+
+        const SlotHeader *sh = reader.slot_header(slot);
+        CHECK(sh->status_count == steps);
+        CHECK(sh->timing_count == steps);
+
+        // Latest record is the last step and matches the sender's payload
+        const StatusRecord &latest = reader.status_ring(slot)[(steps - 1) % capacity];
+        CHECK(latest.sequence == steps - 1);
+        CHECK(latest.timestamp_us == (steps - 1) * 4000ull);
+
+        const StatusPayload ref = ReplaySender::make_status(id, steps - 1);
+        CHECK(memcmp(&latest.status, &ref, sizeof(ref)) == 0);
+
+        const TimingRecord &timing = reader.timing_ring(slot)[(steps - 1) % capacity];
+        CHECK(std::fabs(timing.timing.compute_us - ReplaySender::make_timing(id, steps - 1).compute_us) < 1e-6f);
+    }
+
+    // Malformed datagrams are rejected
+    uint8_t buf[MAX_PACKET_SIZE];
+    size_t size = encode(buf, MessageType::STATUS, 1, steps, 0, ReplaySender::make_status(1, steps));
+    buf[0] ^= 0xff;   // Corrupt magic
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    CHECK(sendto(sock, buf, size, 0, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == (ssize_t)size);
+    close(sock);
+
+    for (int i = 0; i < 100 && aggregator.stats().rejected == 0; ++i) {
+        aggregator.poll(10);
+    }
+
+    CHECK(aggregator.stats().rejected == 1);
+
+    printf("aggregator replay test passed (%llu packets)\n", (unsigned long long)aggregator.stats().received);
+    return EXIT_SUCCESS;
+}
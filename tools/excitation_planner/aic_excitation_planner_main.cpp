@@ -0,0 +1,122 @@
+/**
+ * @file aic_excitation_planner_main.cpp
+ * @brief Plans an inertia identification maneuver and writes it as a mission file
+ *
+ * Usage:
+ *   aic_excitation_planner [-d duration_s] [-s segments] [-t max_tilt_deg]
+ *                          [-r max_rate_dps] [-q tau_max_nm] [-J Ixx,Iyy,Izz]
+ *                          [-n candidates] [-j threads] [-S seed]
+ *                          [-p lat,lon,alt] [-o mission.json]
+ */
+
+#include "maneuver.hpp"
+#include "mission_writer.hpp"
+#include "planner.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace aic_excitation;
+
+int main(int argc, char *argv[]) {
+    float duration_s = 20.f;
+    float max_tilt_deg = 35.f;
+    float max_rate_dps = 200.f;
+    float Ixx = 0.040f, Iyy = 0.040f, Izz = 0.025f;  // Module default inertia (kg*m^2)
+    std::string output = "missions/aic_excitation.json";
+
+    Limits limits;
+    PlannerConfig config;
+    MissionInfo info;
+
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:s:t:r:q:J:n:j:S:p:o:h")) != -1) {
+        switch (opt) {
+        case 'd': duration_s = atof(optarg); break;
+
+        case 's': config.segments = atoi(optarg); break;
+
+        case 't': max_tilt_deg = atof(optarg); break;
+
+        case 'r': max_rate_dps = atof(optarg); break;
+
+        case 'q': limits.tau_max = atof(optarg); break;
+
+        case 'J':
+            if (sscanf(optarg, "%f,%f,%f", &Ixx, &Iyy, &Izz) != 3) {
+                fprintf(stderr, "invalid inertia '%s'\n", optarg);
+                return 1;
+            }
+
+            break;
+
+        case 'n': config.global_candidates = atoi(optarg); break;
+
+        case 'j': config.threads = static_cast<unsigned>(atoi(optarg)); break;
+
+        case 'S': config.seed = static_cast<uint32_t>(strtoul(optarg, nullptr, 10)); break;
+
+        case 'p':
+            if (sscanf(optarg, "%lf,%lf,%f", &info.lat, &info.lon, &info.alt) != 3) {
+                fprintf(stderr, "invalid position '%s'\n", optarg);
+                return 1;
+            }
+
+            break;
+
+        case 'o': output = optarg; break;
+
+        default:
+            fprintf(stderr, "usage: %s [-d duration_s] [-s segments] [-t max_tilt_deg] [-r max_rate_dps] "
+                    "[-q tau_max_nm] [-J Ixx,Iyy,Izz] [-n candidates] [-j threads] [-S seed] "
+                    "[-p lat,lon,alt] [-o mission.json]\n", argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (duration_s <= 0.f || config.segments < 1 || config.global_candidates < 1) {
+        fprintf(stderr, "invalid planner configuration\n");
+        return 1;
+    }
+
+    config.segment_duration = duration_s / config.segments;
+    limits.max_tilt = max_tilt_deg * static_cast<float>(M_PI) / 180.f;
+    limits.max_rate = max_rate_dps * static_cast<float>(M_PI) / 180.f;
+
+    matrix::Matrix3f J;
+    J.setZero();
+    J(0, 0) = Ixx;
+    J(1, 1) = Iyy;
+    J(2, 2) = Izz;
+
+    ManeuverModel model(J, limits);
+    ExcitationPlanner planner(model, config);
+
+    const auto start = std::chrono::steady_clock::now();
+    Evaluation evaluation;
+    const Maneuver maneuver = planner.plan(&evaluation);
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("evaluated %llu candidates in %.2f s\n", (unsigned long long)planner.evaluations(), elapsed);
+    printf("min eigenvalue %.6g, max eigenvalue %.6g (%s)\n", evaluation.min_eigenvalue,
+           evaluation.max_eigenvalue, evaluation.feasible ? "feasible" : "INFEASIBLE");
+    printf("peak tilt %.1f deg, rate %.1f deg/s, torque %.4f Nm\n", evaluation.peak_tilt * 180.0 / M_PI,
+           evaluation.peak_rate * 180.0 / M_PI, evaluation.peak_torque);
+
+    if (!evaluation.feasible) {
+        fprintf(stderr, "no feasible maneuver found, relax the limits or raise the candidate count\n");
+        return 1;
+    }
+
+    if (!write_mission(output, info, model, maneuver, evaluation)) {
+        fprintf(stderr, "failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    printf("wrote %s\n", output.c_str());
+    return 0;
+}
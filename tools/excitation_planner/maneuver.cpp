@@ -0,0 +1,164 @@
+/**
+ * @file maneuver.cpp
+ * @brief Parameterized attitude excitation maneuver and its inertia information
+ */
+
+#include "maneuver.hpp"
+
+#include "regressor.hpp"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <cmath>
+
+namespace aic_excitation {
+
+namespace {
+
+constexpr float TWO_PI = 2.f * static_cast<float>(M_PI);
+
+/**
+ * @brief Segment taper w(tau) and its first two derivatives
+ */
+void taper(float tau, float duration, float taper_s, float &w, float &dw, float &ddw) {
+    w = 1.f;
+    dw = 0.f;
+    ddw = 0.f;
+
+    if (taper_s <= 0.f) {
+        return;
+    }
+
+    taper_s = std::min(taper_s, 0.5f * duration);
+    float sign = 1.f;
+
+    if (tau > duration - taper_s) {
+        // Fade out mirrors the fade in
+        tau = duration - tau;
+        sign = -1.f;
+
+    } else if (tau >= taper_s) {
+        return;
+    }
+
+    // w = sin^2(k * tau), k = pi / (2 * taper_s)
+    const float k = static_cast<float>(M_PI) / (2.f * taper_s);
+    w = sinf(k * tau) * sinf(k * tau);
+    dw = sign * k * sinf(2.f * k * tau);
+    ddw = 2.f * k * k * cosf(2.f * k * tau);
+}
+
+} // namespace
+
+ManeuverModel::ManeuverModel(const matrix::Matrix3f &J, const Limits &limits, float sample_dt) :
+    J_(J), limits_(limits), sample_dt_(sample_dt) {}
+
+ManeuverState ManeuverModel::state(const Maneuver &maneuver, float t) const {
+    ManeuverState st{};
+    const int n = static_cast<int>(maneuver.segments.size());
+    const int index = std::min(static_cast<int>(t / maneuver.segment_duration), n - 1);
+
+    if (index < 0) {
+        return st;
+    }
+
+    const Segment &segment = maneuver.segments[index];
+    const float tau = t - index * maneuver.segment_duration;
+
+    float w, dw, ddw;
+    taper(tau, maneuver.segment_duration, limits_.taper_s, w, dw, ddw);
+
+    // Euler angles and their derivatives (product rule on w * A * sin)
+    float e[3], de[3], dde[3];
+
+    for (int i = 0; i < 3; ++i) {
+        const AxisWave &wave = segment.axis[i];
+        const float omega = TWO_PI * wave.frequency_hz;
+        const float s = wave.amplitude * sinf(omega * tau + wave.phase);
+        const float ds = wave.amplitude * omega * cosf(omega * tau + wave.phase);
+        const float dds = -omega * omega * s;
+
+        e[i] = w * s;
+        de[i] = dw * s + w * ds;
+        dde[i] = ddw * s + 2.f * dw * ds + w * dds;
+        st.euler[i] = e[i];
+    }
+
+    // ZYX Euler kinematics: body rates and their time derivative
+    const float sphi = sinf(e[0]), cphi = cosf(e[0]);
+    const float sth = sinf(e[1]), cth = cosf(e[1]);
+
+    st.Omega(0) = de[0] - de[2] * sth;
+    st.Omega(1) = de[1] * cphi + de[2] * sphi * cth;
+    st.Omega(2) = -de[1] * sphi + de[2] * cphi * cth;
+
+    st.alpha(0) = dde[0] - dde[2] * sth - de[2] * cth * de[1];
+    st.alpha(1) = dde[1] * cphi - de[1] * sphi * de[0] + dde[2] * sphi * cth
+                  + de[2] * (cphi * de[0] * cth - sphi * sth * de[1]);
+    st.alpha(2) = -dde[1] * sphi - de[1] * cphi * de[0] + dde[2] * cphi * cth
+                  - de[2] * (sphi * de[0] * cth + cphi * sth * de[1]);
+
+    return st;
+}
+
+Evaluation ManeuverModel::evaluate(const Maneuver &maneuver) const {
+    Evaluation result{};
+
+    if (maneuver.segments.empty()) {
+        return result;
+    }
+
+    Eigen::Matrix<double, 6, 6> info = Eigen::Matrix<double, 6, 6>::Zero();
+
+    const float cos_max_tilt = cosf(limits_.max_tilt);
+    const float torque_limit = limits_.torque_margin * limits_.tau_max;
+    float min_cos_tilt = 1.f;
+    const int steps = static_cast<int>(maneuver.duration() / sample_dt_);
+
+    for (int k = 0; k < steps; ++k) {
+        const ManeuverState st = state(maneuver, k * sample_dt_);
+
+        // Tilt of the body z axis: cos(tilt) = cos(roll) * cos(pitch)
+        min_cos_tilt = std::min(min_cos_tilt, cosf(st.euler[0]) * cosf(st.euler[1]));
+        result.peak_rate = std::max(result.peak_rate, st.Omega.norm());
+
+        // Rigid-body torque needed to fly the setpoint
+        const matrix::Vector3f JOmega = J_ * st.Omega;
+        const matrix::Vector3f tau = J_ * st.alpha + st.Omega.cross(JOmega);
+
+        for (int i = 0; i < 3; ++i) {
+            result.peak_torque = std::max(result.peak_torque, std::fabs(tau(i)));
+        }
+
+        // Information: Y^T * Y is symmetric, accumulate the upper triangle
+        const matrix::Matrix<float, 3, 6> Y =
+            attitude_controller_aic::Regressor::regressor_full(st.Omega, st.alpha);
+
+        for (int a = 0; a < 6; ++a) {
+            for (int b = a; b < 6; ++b) {
+                info(a, b) += static_cast<double>(Y(0, a) * Y(0, b) + Y(1, a) * Y(1, b) + Y(2, a) * Y(2, b));
+            }
+        }
+    }
+
+    result.peak_tilt = acosf(std::max(-1.f, std::min(min_cos_tilt, 1.f)));
+
+    // Largest relative excess over the limits
+    result.violation = std::max({0.0,
+                                 static_cast<double>(cos_max_tilt - min_cos_tilt),
+                                 static_cast<double>(result.peak_rate / limits_.max_rate - 1.f),
+                                 static_cast<double>(result.peak_torque / torque_limit - 1.f)});
+    result.feasible = (result.violation <= 0.0);
+
+    info *= sample_dt_;
+    info.triangularView<Eigen::StrictlyLower>() = info.transpose();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, 6, 6>> solver(info, Eigen::EigenvaluesOnly);
+    result.min_eigenvalue = solver.eigenvalues()(0);
+    result.max_eigenvalue = solver.eigenvalues()(5);
+
+    return result;
+}
+
+} // namespace aic_excitation
@@ -0,0 +1,124 @@
+/**
+ * @file maneuver.hpp
+ * @brief Parameterized attitude excitation maneuver and its inertia information
+ *
+ * A maneuver is a sequence of equal-length segments. In each segment the
+ * roll, pitch and yaw setpoints are tapered sinusoids
+ *
+ *   angle_i(t) = w(t) * A_i * sin(2*pi*f_i*t + phi_i)
+ *
+ * where the taper w(t) rises from and returns to zero at the segment
+ * boundaries, so consecutive segments join at level attitude with zero rate.
+ *
+ * Evaluation assumes ideal tracking: body rates and accelerations follow
+ * analytically from the ZYX Euler angle derivatives, and the accumulated
+ * information sum(Y^T * Y * dt) uses Regressor::regressor_full, i.e. the
+ * same regressor the onboard estimator adapts with.
+ */
+
+#pragma once
+
+#include <matrix/matrix.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace aic_excitation {
+
+/**
+ * @brief Sinusoid of one Euler angle within a segment
+ */
+struct AxisWave {
+    float amplitude{0.f};      // rad
+    float frequency_hz{0.f};   // Hz
+    float phase{0.f};          // rad
+};
+
+/**
+ * @brief One maneuver segment (roll, pitch, yaw waves)
+ */
+struct Segment {
+    AxisWave axis[3];
+};
+
+struct Maneuver {
+    std::vector<Segment> segments;
+    float segment_duration{5.f};   // s
+
+    float duration() const { return segment_duration * segments.size(); }
+};
+
+/**
+ * @brief Flight envelope the maneuver must stay within
+ */
+struct Limits {
+    float max_tilt{0.61f};        // Tilt of the body z axis from vertical (rad)
+    float max_rate{3.5f};         // Body rate magnitude (rad/s)
+    float tau_max{0.05f};         // Actuator torque limit per axis (Nm)
+    float torque_margin{0.8f};    // Fraction of tau_max the maneuver may use (rest is left to feedback)
+    float min_frequency_hz{0.1f};
+    float max_frequency_hz{2.f};
+    float taper_s{1.f};           // Segment fade in/out time
+};
+
+/**
+ * @brief Result of evaluating a maneuver
+ */
+struct Evaluation {
+    bool feasible{false};
+    double min_eigenvalue{0.0};   // Of sum(Y^T * Y * dt)
+    double max_eigenvalue{0.0};
+    double violation{0.0};        // Largest relative limit excess (0 if feasible)
+    float peak_tilt{0.f};         // rad
+    float peak_rate{0.f};         // rad/s
+    float peak_torque{0.f};       // Nm
+
+    /**
+     * @brief Search objective: feasible maneuvers rank by the minimum eigenvalue,
+     *        infeasible ones below all feasible ones by their violation
+     */
+    double score() const { return feasible ? min_eigenvalue : -violation; }
+};
+
+/**
+ * @brief Setpoint state at one instant of a maneuver
+ */
+struct ManeuverState {
+    float euler[3];       // roll, pitch, yaw (rad)
+    matrix::Vector3f Omega;
+    matrix::Vector3f alpha;
+};
+
+/**
+ * @class ManeuverModel
+ * @brief Evaluates maneuvers for a nominal vehicle
+ */
+class ManeuverModel {
+public:
+    /**
+     * @param J nominal inertia (kg*m^2), used for the torque limit
+     * @param limits flight envelope
+     * @param sample_dt evaluation step (s)
+     */
+    ManeuverModel(const matrix::Matrix3f &J, const Limits &limits, float sample_dt = 0.005f);
+
+    /**
+     * @brief Attitude, body rate and body acceleration setpoint at time t
+     */
+    ManeuverState state(const Maneuver &maneuver, float t) const;
+
+    /**
+     * @brief Accumulate the information of a maneuver and check the limits
+     */
+    Evaluation evaluate(const Maneuver &maneuver) const;
+
+    const Limits &limits() const { return limits_; }
+    float sample_dt() const { return sample_dt_; }
+
+private:
+    matrix::Matrix3f J_;
+    Limits limits_;
+    float sample_dt_;
+};
+
+} // namespace aic_excitation
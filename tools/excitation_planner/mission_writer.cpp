@@ -0,0 +1,117 @@
+/**
+ * @file mission_writer.cpp
+ * @brief Export of a planned excitation maneuver as a mission JSON file (missions/)
+ */
+
+#include "mission_writer.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace aic_excitation {
+
+namespace {
+
+inline double deg(float rad) {
+    return rad * 180.0 / M_PI;
+}
+
+void write_wave(FILE *f, const char *name, const AxisWave &wave, bool last) {
+    fprintf(f, "          \"%s\": {\"amplitude_deg\": %.3f, \"frequency_hz\": %.4f, \"phase_deg\": %.2f}%s\n",
+            name, deg(wave.amplitude), wave.frequency_hz, deg(std::fmod(wave.phase, 2.f * static_cast<float>(M_PI))),
+            last ? "" : ",");
+}
+
+} // namespace
+
+bool write_mission(const std::string &path, const MissionInfo &info, const ManeuverModel &model,
+                   const Maneuver &maneuver, const Evaluation &evaluation) {
+    FILE *f = fopen(path.c_str(), "w");
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    const Limits &limits = model.limits();
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"name\": \"%s\",\n", info.name.c_str());
+    fprintf(f, "  \"description\": \"%.0f s attitude excitation maneuver for inertia identification\",\n",
+            maneuver.duration());
+    fprintf(f, "  \"default_altitude\": %.1f,\n", info.alt);
+    fprintf(f, "  \"default_speed\": 0.0,\n");
+    fprintf(f, "  \"pattern_type\": \"excitation\",\n");
+    fprintf(f, "  \"waypoints\": [\n");
+    fprintf(f, "    {\n");
+    fprintf(f, "      \"id\": 1,\n");
+    fprintf(f, "      \"lat\": %.7f,\n", info.lat);
+    fprintf(f, "      \"lon\": %.7f,\n", info.lon);
+    fprintf(f, "      \"alt\": %.1f,\n", info.alt);
+    fprintf(f, "      \"description\": \"Excitation hover point\"\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "  ],\n");
+
+    fprintf(f, "  \"excitation\": {\n");
+    fprintf(f, "    \"duration_s\": %.2f,\n", maneuver.duration());
+    fprintf(f, "    \"segment_duration_s\": %.2f,\n", maneuver.segment_duration);
+    fprintf(f, "    \"taper_s\": %.2f,\n", limits.taper_s);
+    fprintf(f, "    \"limits\": {\"max_tilt_deg\": %.1f, \"max_rate_dps\": %.1f, \"tau_max_nm\": %.4f, "
+            "\"torque_margin\": %.2f},\n",
+            deg(limits.max_tilt), deg(limits.max_rate), limits.tau_max, limits.torque_margin);
+    fprintf(f, "    \"information\": {\"min_eigenvalue\": %.6g, \"max_eigenvalue\": %.6g, ",
+            evaluation.min_eigenvalue, evaluation.max_eigenvalue);
+
+    if (evaluation.min_eigenvalue > 0.0) {
+        fprintf(f, "\"condition_number\": %.6g},\n", evaluation.max_eigenvalue / evaluation.min_eigenvalue);
+
+    } else {
+        fprintf(f, "\"condition_number\": null},\n");
+    }
+
+    fprintf(f, "    \"peaks\": {\"tilt_deg\": %.2f, \"rate_dps\": %.1f, \"torque_nm\": %.4f},\n",
+            deg(evaluation.peak_tilt), deg(evaluation.peak_rate), evaluation.peak_torque);
+
+    fprintf(f, "    \"segments\": [\n");
+
+    for (size_t k = 0; k < maneuver.segments.size(); ++k) {
+        const Segment &segment = maneuver.segments[k];
+        fprintf(f, "      {\n");
+        fprintf(f, "        \"start_s\": %.2f,\n", k * maneuver.segment_duration);
+        fprintf(f, "        \"axes\": {\n");
+        write_wave(f, "roll", segment.axis[0], false);
+        write_wave(f, "pitch", segment.axis[1], false);
+        write_wave(f, "yaw", segment.axis[2], true);
+        fprintf(f, "        }\n");
+        fprintf(f, "      }%s\n", (k + 1 < maneuver.segments.size()) ? "," : "");
+    }
+
+    fprintf(f, "    ],\n");
+
+    // Attitude setpoints relative to the heading at the hover point
+    fprintf(f, "    \"setpoint_rate_hz\": %.1f,\n", info.setpoint_rate_hz);
+    fprintf(f, "    \"setpoints\": [\n");
+
+    const int count = static_cast<int>(maneuver.duration() * info.setpoint_rate_hz) + 1;
+
+    for (int k = 0; k < count; ++k) {
+        const float t = k / info.setpoint_rate_hz;
+        const ManeuverState st = model.state(maneuver, t);
+        fprintf(f, "      {\"t\": %.3f, \"roll_deg\": %.3f, \"pitch_deg\": %.3f, \"yaw_deg\": %.3f}%s\n",
+                t, deg(st.euler[0]), deg(st.euler[1]), deg(st.euler[2]), (k + 1 < count) ? "," : "");
+    }
+
+    fprintf(f, "    ]\n");
+    fprintf(f, "  },\n");
+
+    fprintf(f, "  \"notes\": [\n");
+    fprintf(f, "    \"Generated by aic_excitation_planner\",\n");
+    fprintf(f, "    \"Hold position at the waypoint and fly the setpoint table in an attitude mode\",\n");
+    fprintf(f, "    \"Replace coordinates with your actual location\"\n");
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+
+    const bool ok = (ferror(f) == 0);
+    return (fclose(f) == 0) && ok;
+}
+
+} // namespace aic_excitation
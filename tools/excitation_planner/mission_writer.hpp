@@ -0,0 +1,34 @@
+/**
+ * @file mission_writer.hpp
+ * @brief Export of a planned excitation maneuver as a mission JSON file (missions/)
+ *
+ * The file keeps the keys mission_planner.py reads (name, description,
+ * default_altitude, waypoints) with a single hover waypoint where the
+ * maneuver is flown, and adds an "excitation" section with the segment
+ * parameters, the limits and the attitude setpoint table.
+ */
+
+#pragma once
+
+#include "maneuver.hpp"
+
+#include <string>
+
+namespace aic_excitation {
+
+struct MissionInfo {
+    std::string name{"AIC Excitation Maneuver"};
+    double lat{37.7749};
+    double lon{-122.4194};
+    float alt{15.f};
+    float setpoint_rate_hz{50.f};
+};
+
+/**
+ * @brief Write the maneuver mission file
+ * @return true on success
+ */
+bool write_mission(const std::string &path, const MissionInfo &info, const ManeuverModel &model,
+                   const Maneuver &maneuver, const Evaluation &evaluation);
+
+} // namespace aic_excitation
@@ -0,0 +1,161 @@
+/**
+ * @file planner.cpp
+ * @brief Parallel search for the maneuver maximizing the minimum information eigenvalue
+ */
+
+#include "planner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace aic_excitation {
+
+ExcitationPlanner::ExcitationPlanner(const ManeuverModel &model, const PlannerConfig &config) :
+    model_(model), config_(config) {
+    threads_ = (config.threads > 0) ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ExcitationPlanner::evaluate_batch(const std::vector<Maneuver> &candidates,
+                                       std::vector<Evaluation> &results) const {
+    results.resize(candidates.size());
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < candidates.size(); i = next.fetch_add(1)) {
+            results[i] = model_.evaluate(candidates[i]);
+        }
+    };
+
+    const unsigned count = std::min<unsigned>(threads_, static_cast<unsigned>(candidates.size()));
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 1; t < count; ++t) {
+        pool.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+Maneuver ExcitationPlanner::random_maneuver(std::mt19937 &rng) const {
+    const Limits &limits = model_.limits();
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    // Roll and pitch together must stay below the tilt limit
+    const float max_amplitude[3] = {limits.max_tilt / sqrtf(2.f), limits.max_tilt / sqrtf(2.f),
+                                    config_.max_yaw_amplitude
+                                   };
+
+    Maneuver maneuver;
+    maneuver.segment_duration = config_.segment_duration;
+    maneuver.segments.resize(config_.segments);
+
+    for (Segment &segment : maneuver.segments) {
+        for (int i = 0; i < 3; ++i) {
+            segment.axis[i].amplitude = max_amplitude[i] * unit(rng);
+            segment.axis[i].frequency_hz = limits.min_frequency_hz
+                                           + (limits.max_frequency_hz - limits.min_frequency_hz) * unit(rng);
+            segment.axis[i].phase = 2.f * static_cast<float>(M_PI) * unit(rng);
+        }
+    }
+
+    return maneuver;
+}
+
+Maneuver ExcitationPlanner::perturb(const Maneuver &maneuver, float step, std::mt19937 &rng) const {
+    const Limits &limits = model_.limits();
+    std::normal_distribution<float> normal(0.f, step);
+
+    Maneuver candidate = maneuver;
+
+    for (Segment &segment : candidate.segments) {
+        for (int i = 0; i < 3; ++i) {
+            // Steps relative to the parameter ranges
+            segment.axis[i].amplitude += normal(rng) * limits.max_tilt;
+            segment.axis[i].frequency_hz += normal(rng) * (limits.max_frequency_hz - limits.min_frequency_hz);
+            segment.axis[i].phase += normal(rng) * 2.f * static_cast<float>(M_PI);
+        }
+    }
+
+    clamp(candidate);
+    return candidate;
+}
+
+void ExcitationPlanner::clamp(Maneuver &maneuver) const {
+    const Limits &limits = model_.limits();
+    const float max_amplitude[3] = {limits.max_tilt, limits.max_tilt, config_.max_yaw_amplitude};
+
+    for (Segment &segment : maneuver.segments) {
+        for (int i = 0; i < 3; ++i) {
+            AxisWave &wave = segment.axis[i];
+            wave.amplitude = std::max(0.f, std::min(wave.amplitude, max_amplitude[i]));
+            wave.frequency_hz = std::max(limits.min_frequency_hz, std::min(wave.frequency_hz, limits.max_frequency_hz));
+        }
+    }
+}
+
+Maneuver ExcitationPlanner::plan(Evaluation *best_evaluation) {
+    std::mt19937 rng(config_.seed);
+    std::vector<Maneuver> candidates;
+    std::vector<Evaluation> results;
+
+    // 1. Global random search
+    candidates.reserve(std::max(config_.global_candidates, config_.refine_batch));
+
+    for (int i = 0; i < config_.global_candidates; ++i) {
+        candidates.push_back(random_maneuver(rng));
+    }
+
+    evaluate_batch(candidates, results);
+    evaluations_ += candidates.size();
+
+    size_t best_index = 0;
+
+    for (size_t i = 1; i < results.size(); ++i) {
+        if (results[i].score() > results[best_index].score()) {
+            best_index = i;
+        }
+    }
+
+    Maneuver best = candidates[best_index];
+    Evaluation best_eval = results[best_index];
+
+    // 2. Refinement around the incumbent
+    float step = 0.1f;
+
+    for (int round = 0; round < config_.refine_rounds; ++round) {
+        candidates.clear();
+
+        for (int i = 0; i < config_.refine_batch; ++i) {
+            candidates.push_back(perturb(best, step, rng));
+        }
+
+        evaluate_batch(candidates, results);
+        evaluations_ += candidates.size();
+
+        bool improved = false;
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i].score() > best_eval.score()) {
+                best = candidates[i];
+                best_eval = results[i];
+                improved = true;
+            }
+        }
+
+        step = improved ? std::min(step * 1.5f, 0.2f) : std::max(step * 0.6f, 1e-3f);
+    }
+
+    if (best_evaluation != nullptr) {
+        *best_evaluation = best_eval;
+    }
+
+    return best;
+}
+
+} // namespace aic_excitation
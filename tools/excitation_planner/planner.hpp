@@ -0,0 +1,69 @@
+/**
+ * @file planner.hpp
+ * @brief Parallel search for the maneuver maximizing the minimum information eigenvalue
+ *
+ * Two phases, both evaluating candidate batches on all cores:
+ * 1. global: random maneuvers drawn uniformly from the parameter box
+ * 2. refinement: Gaussian perturbations of the incumbent with a step size
+ *    that grows on success and shrinks on failure
+ *
+ * Candidates are drawn serially from a seeded generator and evaluation is
+ * pure, so the result does not depend on the number of threads.
+ */
+
+#pragma once
+
+#include "maneuver.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace aic_excitation {
+
+struct PlannerConfig {
+    int segments{4};
+    float segment_duration{5.f};   // s
+    float max_yaw_amplitude{0.8f}; // rad
+    int global_candidates{2048};
+    int refine_rounds{60};
+    int refine_batch{128};
+    unsigned threads{0};           // 0: hardware concurrency
+    uint32_t seed{1};
+};
+
+/**
+ * @class ExcitationPlanner
+ * @brief Optimizes an excitation maneuver for a ManeuverModel
+ */
+class ExcitationPlanner {
+public:
+    ExcitationPlanner(const ManeuverModel &model, const PlannerConfig &config);
+
+    /**
+     * @brief Run the search
+     *
+     * @param best_evaluation evaluation of the returned maneuver (optional)
+     * @return best maneuver found
+     */
+    Maneuver plan(Evaluation *best_evaluation = nullptr);
+
+    /**
+     * @brief Evaluate a batch of maneuvers on all worker threads
+     */
+    void evaluate_batch(const std::vector<Maneuver> &candidates, std::vector<Evaluation> &results) const;
+
+    uint64_t evaluations() const { return evaluations_; }
+
+private:
+    Maneuver random_maneuver(std::mt19937 &rng) const;
+    Maneuver perturb(const Maneuver &maneuver, float step, std::mt19937 &rng) const;
+    void clamp(Maneuver &maneuver) const;
+
+    const ManeuverModel &model_;
+    PlannerConfig config_;
+    unsigned threads_;
+    uint64_t evaluations_{0};
+};
+
+} // namespace aic_excitation